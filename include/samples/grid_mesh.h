@@ -0,0 +1,67 @@
+/*
+ * grid_mesh.h
+ *
+ * Builds the adjacency of regular grids for the tests.
+ *
+ * The vertices of an nx-by-ny-by-nz grid are numbered x fastest, then
+ * y, then z, and every adjacency list comes out in increasing order
+ * without the vertex itself.  A neighbor differs by one in a single
+ * coordinate (five point in 2D, seven point in 3D), or by at most one
+ * in every coordinate if box is true (nine point in 2D).
+ *
+ */
+
+#ifndef GRID_MESH_H_
+#define GRID_MESH_H_
+
+/*
+ * appends the grid as vertices base, base+1, ... whose lists start at
+ * adjList[nnz].  Sets adjHead for those vertices, but not the one after
+ * the last.  Returns nnz past the end of the grid's lists.
+ */
+static int
+appendGrid( const int nx, const int ny, const int nz, const bool box,
+	    const int base, int nnz, int * adjHead, int * adjList ) {
+  for( int z=0; z<nz; ++z ) {
+    for( int y=0; y<ny; ++y ) {
+      for( int x=0; x<nx; ++x ) {
+	adjHead[ base + (z*ny+y)*nx+x ] = nnz;
+	for( int dz=-1; dz<=1; ++dz ) {
+	  for( int dy=-1; dy<=1; ++dy ) {
+	    for( int dx=-1; dx<=1; ++dx ) {
+	      const int nOff = ( dx != 0 ) + ( dy != 0 ) + ( dz != 0 );
+	      if ( ( nOff == 0 ) || ( ( nOff > 1 ) && ( !box ) ) ) { continue; }
+	      const int xx = x+dx;
+	      const int yy = y+dy;
+	      const int zz = z+dz;
+	      if ( ( xx<0 ) || ( xx>=nx ) || ( yy<0 ) || ( yy>=ny ) ||
+		   ( zz<0 ) || ( zz>=nz ) ) { continue; }
+	      adjList[ nnz++ ] = base + (zz*ny+yy)*nx+xx;
+	    }
+	  }
+	}
+      }
+    }
+  }
+  return nnz;
+}
+
+/* k-by-k five point grid, adjList needs 4*k*k entries */
+static void
+makeFivePointGrid( const int k, int * adjHead, int * adjList ) {
+  adjHead[ k*k ] = appendGrid( k, k, 1, false, 0, 0, adjHead, adjList );
+}
+
+/* k-by-k nine point grid, adjList needs 8*k*k entries */
+static void
+makeNinePointGrid( const int k, int * adjHead, int * adjList ) {
+  adjHead[ k*k ] = appendGrid( k, k, 1, true, 0, 0, adjHead, adjList );
+}
+
+/* k-by-k-by-k seven point grid, adjList needs 6*k*k*k entries */
+static void
+makeSevenPointGrid( const int k, int * adjHead, int * adjList ) {
+  adjHead[ k*k*k ] = appendGrid( k, k, k, false, 0, 0, adjHead, adjList );
+}
+
+#endif
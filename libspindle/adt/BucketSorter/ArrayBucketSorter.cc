@@ -35,6 +35,28 @@ ArrayBucketSorter::~ArrayBucketSorter() {
   delete[] key;
 }
 
+bool
+ArrayBucketSorter::resize( const int nBuckets, const int nItems ) {
+  if ( ( nBuckets < 0 ) || ( nItems < 0 ) ) { return false; }
+  if ( nBuckets > bucketCapacity ) {
+    delete[] bucket;
+    bucket = new int[ nBuckets ];
+    bucketCapacity = nBuckets;
+  }
+  if ( nItems > itemCapacity ) {
+    delete[] next;
+    delete[] prev;
+    delete[] key;
+    next = new int[ nItems ];
+    prev = new int[ nItems ];
+    key  = new int[ nItems ];
+    itemCapacity = nItems;
+  }
+  nBucketsMax = nBuckets;
+  nItemsMax = nItems;
+  return ArrayBucketSorter::reset();
+}
+
 void 
 ArrayBucketSorter::validate() {
   if ( currentState == VALID ) { return;}
@@ -207,6 +229,8 @@ ArrayBucketSorter::loadObject( SpindleArchive& ar ) {
   next   = new int[nItemsMax];
   prev   = new int[nItemsMax];
   key    = new int[nItemsMax];
+  bucketCapacity = nBucketsMax;
+  itemCapacity = nItemsMax;
 
   // A better way to do this would be to reset the sorter
   // at this point and read in (item,key) pairs, inserting
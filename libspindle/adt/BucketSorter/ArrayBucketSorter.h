@@ -77,6 +77,10 @@ protected:
   /// array mapping each vertex in structure to its bucket
   int *key;              
   //    length==(nItemsMax)
+
+  /// allocated lengths of bucket[] and of next[], prev[] and key[]
+  int bucketCapacity;
+  int itemCapacity;
 public:
   
   /**
@@ -94,6 +98,12 @@ public:
    */
   virtual ~ArrayBucketSorter();
 
+  /**
+   * change the number of keys and items.  Reallocates only when
+   * growing, and leaves the sorter empty.
+   */
+  bool resize( const int nBuckets, const int nItems );
+
   /**
    *
    */
@@ -237,13 +247,15 @@ protected:
 };
 
 inline ArrayBucketSorter::ArrayBucketSorter() 
-: nBucketsMax(0), nItemsMax(0){
+: nBucketsMax(0), nItemsMax(0), bucket(0), next(0), prev(0), key(0),
+  bucketCapacity(0), itemCapacity(0) {
   currentState = EMPTY;
 }
   
 
 inline ArrayBucketSorter::ArrayBucketSorter(const int nBucketsMax_, const int nItems) 
-  : nBucketsMax(nBucketsMax_), nItemsMax(nItems) {
+  : nBucketsMax(nBucketsMax_), nItemsMax(nItems), 
+    bucketCapacity(nBucketsMax_), itemCapacity(nItems) {
     incrementInstanceCount( ArrayBucketSorter::MetaData );
     bucket = new int[nBucketsMax];  
     next   = new int[nItemsMax]; 
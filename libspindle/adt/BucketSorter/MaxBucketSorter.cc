@@ -0,0 +1,82 @@
+//
+// MaxBucketSorter.cc
+//
+//  $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+
+#include "spindle/MaxBucketSorter.h"
+
+#ifndef SPINDLE_ARCHIVE_H_
+#include "spindle/SpindleArchive.h"
+#endif
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+MaxBucketSorter::MaxBucketSorter() {
+  incrementInstanceCount( MaxBucketSorter::MetaData );
+  bucket = 0;
+  next = 0;
+  prev = 0;
+  key = 0;
+  nInserted = 0;
+  isInsertFront = true;
+  maxBucket = FLAG;
+}
+
+MaxBucketSorter::MaxBucketSorter( const int nBuckets, const int nItems )
+  : ArrayBucketSorter( nBuckets, nItems ) {
+  incrementInstanceCount( MaxBucketSorter::MetaData );
+  maxBucket = FLAG;
+}
+
+MaxBucketSorter::~MaxBucketSorter() {
+  decrementInstanceCount( MaxBucketSorter::MetaData );
+}
+
+bool
+MaxBucketSorter::resize( const int nBuckets, const int nItems ) {
+  if ( !ArrayBucketSorter::resize( nBuckets, nItems ) ) { return false; }
+  maxBucket = FLAG;
+  return true;
+}
+
+bool
+MaxBucketSorter::reset() {
+  maxBucket = FLAG;
+  return ArrayBucketSorter::reset();
+}
+
+void
+MaxBucketSorter::storeObject( SpindleArchive& ar ) const {
+  ArrayBucketSorter::storeObject( ar );
+  ar << maxBucket;
+}
+
+void
+MaxBucketSorter::loadObject( SpindleArchive& ar ) {
+  // ArrayBucketSorter::loadObject() allocates its own arrays
+  delete[] bucket;
+  delete[] next;
+  delete[] prev;
+  delete[] key;
+  ArrayBucketSorter::loadObject( ar );
+  ar >> maxBucket;
+  currentState = VALID;
+}
+
+SPINDLE_IMPLEMENT_PERSISTANT( MaxBucketSorter, ArrayBucketSorter )
@@ -0,0 +1,189 @@
+//
+// MaxBucketSorter.h
+//
+//  $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+//=====================================================================
+//
+// A bucket sorter used as a max priority queue over a bounded range of
+// integer keys.  Unlike ArrayBucketSorter, keys are not hashed: each key
+// in [0,nBucketsMax) has its own bucket, and the largest non-empty
+// bucket is tracked so that extractMax() is O(1) amortized.
+//
+
+#ifndef SPINDLE_MAX_BUCKET_SORTER_H_
+#define SPINDLE_MAX_BUCKET_SORTER_H_
+
+#ifndef SPINDLE_ARRAY_BUCKET_SORTER_H_
+#include "spindle/ArrayBucketSorter.h"
+#endif
+
+SPINDLE_BEGIN_NAMESPACE
+
+/**
+ * @memo max priority queue for items with small non-negative integer keys.
+ * @type class
+ *
+ * Every key must lie in #[0,nBucketsMax)#.  The sorter remembers the
+ * largest non-empty bucket.  Inserting or raising a key moves it up in
+ * O(1); #extractMax()# scans down past buckets that became empty.  When
+ * keys mostly increase, as in a Sloan ordering, the total cost of these
+ * scans is bounded by the key range plus the number of operations.  This
+ * is cheaper than the O(log n) of a #BinaryHeap#.
+ *
+ * Ties are broken by the insertion mode of #ArrayBucketSorter#.  By
+ * default, the most recently inserted item comes out first.
+ *
+ * @see ArrayBucketSorter
+ * @see BinaryHeap
+ * @author agent
+ */
+class MaxBucketSorter : public ArrayBucketSorter {
+  SPINDLE_DECLARE_PERSISTANT( MaxBucketSorter )
+
+protected:
+  /// largest non-empty bucket, FLAG if empty
+  int maxBucket;
+
+public:
+  /** default constructor */
+  MaxBucketSorter();
+
+  /** constructor, keys in [0,nBuckets), items in [0,nItems) */
+  MaxBucketSorter( const int nBuckets, const int nItems );
+
+  /** destructor */
+  virtual ~MaxBucketSorter();
+
+  /**
+   * change the capacity.  Reallocates only when growing, and
+   * leaves the sorter empty.
+   */
+  bool resize( const int nBuckets, const int nItems );
+
+  /** resets the sorter to its initial (empty) state */
+  bool reset();
+
+  /**
+   * @return true if insert was successful, false if the item was
+   *         already inserted or either argument is out of range
+   */
+  bool insert( const int Key, const int Item );
+
+  /**
+   * @return true if item is found and removed,
+   *         false if item is not found
+   */
+  bool remove( const int Item );
+
+  /**
+   * add #delta# to the key of #Item#
+   * @return false if the item is not inserted or the new key is out of range
+   */
+  bool incrementKey( const int delta, const int Item );
+
+  /**
+   * subtract #delta# from the key of #Item#
+   * @return false if the item is not inserted or the new key is out of range
+   */
+  bool decrementKey( const int delta, const int Item );
+
+  /**
+   * remove and return the item with the largest key
+   * @return the item, or -1 if empty
+   */
+  int extractMax();
+
+  /**
+   * @return the item with the largest key without removing it,
+   *         -1 if empty
+   */
+  int queryMax() const;
+
+  /**
+   * @return the largest key of a non-empty bucket, -1 if none.
+   */
+  int queryMaxBucket() const;
+
+  /** @return the number of buckets */
+  int queryNBuckets() const { return nBucketsMax; }
+
+  /** @return the number of items that may be inserted */
+  int queryNItems() const { return nItemsMax; }
+};
+
+inline bool
+MaxBucketSorter::insert( const int Key, const int Item ) {
+  if ( ( Key < 0 ) || ( Key >= nBucketsMax ) ) { return false; }
+  if ( !ArrayBucketSorter::insert( Key, Item ) ) { return false; }
+  if ( Key > maxBucket ) { maxBucket = Key; }
+  return true;
+}
+
+inline bool
+MaxBucketSorter::remove( const int Item ) {
+  if ( !ArrayBucketSorter::remove( Item ) ) { return false; }
+  while ( ( maxBucket >= 0 ) && ( bucket[ maxBucket ] == FLAG ) ) { --maxBucket; }
+  return true;
+}
+
+inline bool
+MaxBucketSorter::incrementKey( const int delta, const int Item ) {
+  if ( ( Item < 0 ) || ( Item >= nItemsMax ) ) { return false; }
+  const int oldKey = key[ Item ];
+  if ( oldKey == FLAG ) { return false; }
+  const int newKey = oldKey + delta;
+  if ( ( newKey < 0 ) || ( newKey >= nBucketsMax ) ) { return false; }
+  removeItem( Item );
+  if ( isInsertFront ) {
+    insertFront( newKey, Item, newKey );
+  } else {
+    insertBack( newKey, Item, newKey );
+  }
+  if ( newKey > maxBucket ) {
+    maxBucket = newKey;
+  } else {
+    while ( bucket[ maxBucket ] == FLAG ) { --maxBucket; }
+  }
+  return true;
+}
+
+inline bool
+MaxBucketSorter::decrementKey( const int delta, const int Item ) {
+  return incrementKey( -delta, Item );
+}
+
+inline int
+MaxBucketSorter::extractMax() {
+  if ( maxBucket < 0 ) { return FLAG; }
+  const int Item = bucket[ maxBucket ];
+  removeItem( Item );
+  --nInserted;
+  while ( ( maxBucket >= 0 ) && ( bucket[ maxBucket ] == FLAG ) ) { --maxBucket; }
+  return Item;
+}
+
+inline int
+MaxBucketSorter::queryMax() const {
+  return ( maxBucket < 0 ) ? FLAG : bucket[ maxBucket ];
+}
+
+inline int
+MaxBucketSorter::queryMaxBucket() const {
+  return maxBucket;
+}
+
+SPINDLE_END_NAMESPACE
+
+#endif
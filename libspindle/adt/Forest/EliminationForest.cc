@@ -25,6 +25,10 @@
 #include "spindle/PermutationMap.h"
 #endif
 
+#ifndef SPINDLE_THREAD_TEAM_H_
+#include "spindle/ThreadTeam.h"
+#endif
+
 #ifdef HAVE_NAMESPACES
 using namespace SPINDLE_NAMESPACE;
 #endif
@@ -137,6 +141,202 @@ EliminationForest::EliminationForest( const Graph* graph, const int n, const int
     g = graph;
 }
 
+EliminationForest::EliminationForest( const Graph* graph, 
+				      const SharedPtr<PermutationMap>& perm,
+				      const int nThreads ) {
+  incrementInstanceCount( EliminationForest::MetaData );
+  g = graph;
+  const int n = g->size();
+  GenericForest::resize(n);
+  parent.resize(n);
+  parent.init(-1);
+  if ( perm.isNull() ) { 
+    createParallel( 0, 0, nThreads );
+  } else { 
+    createParallel( perm->getOld2New().lend(), perm->getNew2Old().lend(), 
+		    nThreads );
+  }
+  currentState = UNKNOWN;
+  createChildSibling();
+  createDoubleLink();
+}
+
+//
+// Everything below works in the new ordering.  Rows [lo,hi) are a
+// block.  par[] and anc[] are the etree and the (path compressed)
+// ancestor of each vertex in the new ordering.
+//
+// The etree only depends on which vertices are connected in the
+// subgraphs induced by the first k vertices, for all k.  A block's forest
+// connects the same vertices as the block's own edges, so it can stand in
+// for them.  To merge two adjacent blocks, the rows of the second one are
+// redone with the edges of its forest plus the edges to the first block.
+// The first block is final as it is.
+//
+struct ETreeBlocks { 
+  const Graph * g;
+  const int * old2new;
+  const int * new2old;
+  int * par;
+  int * anc;
+  int * childHead;  // children of the second half of a merge
+  int * childList;
+  const int * blockBegin;
+  int width;        // number of blocks in each half of a merge
+  int nBlocks;
+};
+
+static inline void
+linkToRow( int jj, const int ii, int * par, int * anc ) {
+  // find the root of the tree containing `jj'
+  while( ( anc[jj] != -1 ) && ( anc[jj] != ii ) ) {
+    const int temp = anc[jj];
+    anc[jj] = ii; 
+    jj = temp;
+  }
+  // make `ii' the root of this subtree, if not already true
+  if ( anc[jj] == -1 ) {
+    anc[jj] = ii;
+    par[jj] = ii;
+  }
+}
+
+static void
+etreeBlockTask( void * arg, const int begin, const int end, const int ) {
+  ETreeBlocks * b = (ETreeBlocks *) arg;
+  const int * adjHead = b->g->getAdjHead().lend();
+  const int * adjList = b->g->getAdjList().lend();
+  for( int blk=begin; blk<end; ++blk ) { 
+    const int lo = b->blockBegin[ blk ];
+    const int hi = b->blockBegin[ blk+1 ];
+    for( int ii=lo; ii<hi; ++ii ) { 
+      b->par[ii] = -1;
+      b->anc[ii] = -1;
+      const int i = ( b->new2old == 0 ) ? ii : b->new2old[ii];
+      for( int k=adjHead[i]; k<adjHead[i+1]; ++k ) { 
+	const int jj = ( b->old2new == 0 ) ? adjList[k] : b->old2new[ adjList[k] ];
+	if ( ( jj >= lo ) && ( jj < ii ) ) { 
+	  linkToRow( jj, ii, b->par, b->anc );
+	}
+      }
+    }
+  }
+}
+
+static void
+etreeMergeTask( void * arg, const int begin, const int end, const int ) {
+  ETreeBlocks * b = (ETreeBlocks *) arg;
+  const int * adjHead = b->g->getAdjHead().lend();
+  const int * adjList = b->g->getAdjList().lend();
+  int * par = b->par;
+  int * anc = b->anc;
+  int * childHead = b->childHead;
+  int * childList = b->childList;
+  for( int grp=begin; grp<end; ++grp ) { 
+    const int firstBlock = 2 * grp * b->width;
+    const int midBlock = firstBlock + b->width;
+    if ( midBlock >= b->nBlocks ) { 
+      continue; // nothing to merge with
+    }
+    const int lastBlock = ( midBlock + b->width < b->nBlocks ) ? midBlock + b->width : b->nBlocks;
+    const int lo = b->blockBegin[ firstBlock ];
+    const int mid = b->blockBegin[ midBlock ];
+    const int hi = b->blockBegin[ lastBlock ];
+
+    // list the children in the forest of [mid,hi) in childList[mid,hi),
+    // those of ii start at childHead[ii].  childHead[hi] is the end.
+    {for( int ii=mid; ii<=hi; ++ii ) { 
+      childHead[ii] = 0;
+    }}
+    {for( int ii=mid; ii<hi; ++ii ) { 
+      if ( par[ii] != -1 ) { 
+	childHead[ par[ii]+1 ]++;
+      }
+    }}
+    childHead[mid] = mid;
+    {for( int ii=mid; ii<hi; ++ii ) { 
+      childHead[ii+1] += childHead[ii];
+    }}
+    {for( int ii=mid; ii<hi; ++ii ) { 
+      if ( par[ii] != -1 ) { 
+	childList[ childHead[ par[ii] ]++ ] = ii;
+      }
+    }}
+    // childHead[ii] is now the end of ii's children, the begin of ii+1's
+    {for( int ii=hi; ii>mid; --ii ) { 
+      childHead[ii] = childHead[ii-1];
+    }}
+    childHead[mid] = mid;
+    {for( int ii=mid; ii<hi; ++ii ) { 
+      par[ii] = -1;
+      anc[ii] = -1;
+    }}
+
+    // redo the rows of the second half
+    for( int ii=mid; ii<hi; ++ii ) { 
+      for( int k=childHead[ii]; k<childHead[ii+1]; ++k ) { 
+	linkToRow( childList[k], ii, par, anc );
+      }
+      const int i = ( b->new2old == 0 ) ? ii : b->new2old[ii];
+      for( int k=adjHead[i]; k<adjHead[i+1]; ++k ) { 
+	const int jj = ( b->old2new == 0 ) ? adjList[k] : b->old2new[ adjList[k] ];
+	if ( ( jj >= lo ) && ( jj < mid ) ) { 
+	  linkToRow( jj, ii, par, anc );
+	}
+      }
+    }
+  }
+}
+
+void
+EliminationForest::createParallel( const int * old2new, const int * new2old,
+				   const int nThreads ) {
+  const int n = g->size();
+  ThreadTeam team( nThreads );
+  team.setMinChunkSize( 1 );
+  int nBlocks = team.queryNThreads();
+  if ( nBlocks > n ) { 
+    nBlocks = ( n > 0 ) ? n : 1;
+  }
+
+  SharedArray<int> par( n );
+  SharedArray<int> anc( n );
+  SharedArray<int> childHead( n+1 );
+  SharedArray<int> childList( n );
+  SharedArray<int> blockBegin( nBlocks+1 );
+  {for( int blk=0; blk<=nBlocks; ++blk ) { 
+    blockBegin[blk] = (int) ( ( (double) n * blk ) / nBlocks );
+  }}
+
+  ETreeBlocks b;
+  b.g = g;
+  b.old2new = old2new;
+  b.new2old = new2old;
+  b.par = par.begin();
+  b.anc = anc.begin();
+  b.childHead = childHead.begin();
+  b.childList = childList.begin();
+  b.blockBegin = blockBegin.lend();
+  b.nBlocks = nBlocks;
+
+  team.run( etreeBlockTask, &b, nBlocks );
+  for( b.width = 1; b.width < nBlocks; b.width *= 2 ) { 
+    const int nGroups = ( nBlocks + 2*b.width - 1 ) / ( 2*b.width );
+    team.run( etreeMergeTask, &b, nGroups );
+  }
+
+  // back to the original ordering
+  int * parent_ = parent.begin();
+  {for( int ii=0; ii<n; ++ii ) { 
+    const int i = ( new2old == 0 ) ? ii : new2old[ii];
+    if ( par[ii] == -1 ) { 
+      parent_[i] = -1;
+    } else { 
+      parent_[i] = ( new2old == 0 ) ? par[ii] : new2old[ par[ii] ];
+    }
+  }}
+}
+
 EliminationForest::~EliminationForest() {
   decrementInstanceCount( EliminationForest::MetaData );
 }
@@ -53,10 +53,17 @@ public:
   EliminationForest( const Graph* graph );
   EliminationForest( const Graph* graph, const SharedPtr<PermutationMap>& perm );
   EliminationForest( const Graph* graph, const int n, const int* Parent );
+  // Same as above, but the rows are cut into one block per thread.  The
+  // blocks' forests are built concurrently and merged pairwise.  A null
+  // perm is the identity.
+  EliminationForest( const Graph* graph, const SharedPtr<PermutationMap>& perm, 
+		     const int nThreads );
   virtual ~EliminationForest();
 
 private:
   const Graph* g;
+  void createParallel( const int * old2new, const int * new2old, 
+		       const int nThreads );
 
 public:
   typedef int Key;
@@ -81,6 +88,9 @@ public:
   const_preorder_iterator end_preorder() const { return GenericForest::end_preorder(); }
   const_generic_iterator create_generic_iterator() const { return GenericForest::create_generic_iterator(); }
 
+  // fill postorder[] with the nodes in the order of begin_postorder()
+  bool createPostorder( int * postorder, const int nThreads=1 ) const { return GenericForest::createPostorder( postorder, nThreads ); }
+
 };
 
 SPINDLE_END_NAMESPACE 
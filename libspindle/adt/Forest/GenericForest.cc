@@ -29,6 +29,10 @@
 #include "spindle/SpindleSystem.h"
 #endif
 
+#ifndef SPINDLE_THREAD_TEAM_H_
+#include "spindle/ThreadTeam.h"
+#endif
+
 #ifdef HAVE_NAMESPACES
 using namespace SPINDLE_NAMESPACE;
 #endif
@@ -392,6 +396,108 @@ GenericForest::loadObject( SpindleArchive& ar ) {
 }
 #undef __FUNC__
 
+//
+// the nodes at one depth, for the tasks of createPostorder()
+//
+struct ForestLevel { 
+  const int * child;
+  const int * nextSibling;
+  const int * nodes;   // the nodes at this depth
+  int * size;          // number of nodes in each subtree
+  int * start;         // first postorder position of each subtree
+  int * postorder;
+};
+
+static void
+subtreeSizeTask( void * arg, const int begin, const int end, const int ) {
+  ForestLevel * l = (ForestLevel *) arg;
+  for( int k=begin; k<end; ++k ) { 
+    const int v = l->nodes[k];
+    int sz = 1;
+    for( int c = l->child[v]; c != -1; c = l->nextSibling[c] ) { 
+      sz += l->size[c];
+    }
+    l->size[v] = sz;
+  }
+}
+
+static void
+subtreeStartTask( void * arg, const int begin, const int end, const int ) {
+  ForestLevel * l = (ForestLevel *) arg;
+  for( int k=begin; k<end; ++k ) { 
+    const int v = l->nodes[k];
+    int pos = l->start[v];
+    for( int c = l->child[v]; c != -1; c = l->nextSibling[c] ) { 
+      l->start[c] = pos;
+      pos += l->size[c];
+    }
+    l->postorder[ pos ] = v;  // parent comes after all its children
+  }
+}
+
+bool
+GenericForest::createPostorder( int * postorder, const int nThreads ) const {
+  if ( currentState != VALID ) { return false; }
+  const int n = nNodes;
+  if ( n == 0 ) { 
+    return true;
+  }
+  ThreadTeam team( nThreads );
+
+  // list the nodes by depth, roots first
+  SharedArray<int> byDepth( n );
+  SharedArray<int> depthBegin( n+1 );
+  int * nodes = byDepth.begin();
+  int nDepths = 0;
+  int tail = 0;
+  for( int r = firstRoot; r != -1; r = nextSibling[r] ) { 
+    nodes[ tail++ ] = r;
+  }
+  depthBegin[0] = 0;
+  for( int head = 0; head < tail; ) { 
+    const int levelEnd = tail;
+    depthBegin[ ++nDepths ] = levelEnd;
+    for( ; head < levelEnd; ++head ) { 
+      for( int c = child[ nodes[head] ]; c != -1; c = nextSibling[c] ) { 
+	nodes[ tail++ ] = c;
+      }
+    }
+  }
+  if ( tail != n ) { 
+    return false; // not a forest
+  }
+
+  SharedArray<int> size( n );
+  SharedArray<int> start( n );
+  ForestLevel l;
+  l.child = child.lend();
+  l.nextSibling = nextSibling.lend();
+  l.size = size.begin();
+  l.start = start.begin();
+  l.postorder = postorder;
+
+  // subtree sizes, deepest nodes first
+  {for( int d=nDepths-1; d>=0; --d ) { 
+    l.nodes = nodes + depthBegin[d];
+    team.run( subtreeSizeTask, &l, depthBegin[d+1] - depthBegin[d] );
+  }}
+
+  // the trees are visited in the order of the roots
+  {
+    int pos = 0;
+    for( int k=depthBegin[0]; k<depthBegin[1]; ++k ) { 
+      start[ nodes[k] ] = pos;
+      pos += size[ nodes[k] ];
+    }
+  }
+  // then place each node after its children, shallowest nodes first
+  {for( int d=0; d<nDepths; ++d ) { 
+    l.nodes = nodes + depthBegin[d];
+    team.run( subtreeStartTask, &l, depthBegin[d+1] - depthBegin[d] );
+  }}
+  return true;
+}
+
 constGenericForestPostorderIterator::constGenericForestPostorderIterator (const GenericForest& forest) 
   : myForest(forest) { 
     curNode = myForest.firstRoot; 
@@ -121,6 +121,11 @@ private:
   bool graftTreeToOther( const node oldRoot, const node newParent );
   const SharedArray<int>& getParent() const { return parent; }
 
+  // fill postorder[] with the nodes in the order of begin_postorder().
+  // Subtree sizes and offsets are computed one depth at a time, with
+  // the nodes at each depth split among nThreads threads.
+  bool createPostorder( int * postorder, const int nThreads=1 ) const;
+
   // Iterator Access
   const_postorder_iterator begin_postorder() const ;
   const_postorder_iterator end_postorder() const ;
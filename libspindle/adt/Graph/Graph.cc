@@ -348,10 +348,15 @@ Graph::validate() {
     currentState=INVALID;
     FEXIT;
   }
+  // Read through const references, so that borrowed arrays (say, from
+  // a SnapshotFile) are not cloned unless they really must change.
+  const SharedArray<int>& head = adjHead;
+  const SharedArray<int>& list = adjList;
+
   // 2. now determine nVtxs 
   int possibility1 = adjHead.size() - 1;
   int possibility2 = 0;
-  {for(const int * cur = adjList.begin(), * stop = adjList.end(); cur != stop; ++cur ) {
+  {for(const int * cur = list.begin(), * stop = list.end(); cur != stop; ++cur ) {
     possibility2 = ( possibility2 < *cur ) ? *cur : possibility2;
   }}
   possibility2++;  // add one
@@ -367,7 +372,7 @@ Graph::validate() {
   } else { 
     nVtxs = possibility2;
   }
-  nEdges = adjHead[nVtxs]/2;
+  nEdges = head[nVtxs]/2;
   nBoundVtxs = possibility1 - nVtxs;
   nNonZeros = adjList.size();
 
@@ -378,12 +383,12 @@ Graph::validate() {
   {for (int i=0; i<nVtxs; ++i) {
     haveErrors = 0;
     int lastIdx = -1;  // something less than anything else
-    {for (int j=adjHead[i]; j<adjHead[i+1]; ++j) {
-      if (lastIdx >= adjList[j]) {
+    {for (int j=head[i]; j<head[i+1]; ++j) {
+      if (lastIdx >= list[j]) {
         haveErrors = 1;
 	break;
       }
-      lastIdx = adjList[j];
+      lastIdx = list[j];
     }}
     if ( haveErrors > 0 ) {
       if ( edgeWeight.size() == 0 ) {
@@ -410,14 +415,14 @@ Graph::validate() {
   adjSelf.resize( nVtxs );
   int extractSelfEdges = 0;
   {for (int i=0; i<nVtxs; ++i ) {
-    adjSelf[i] = adjHead[i+1];
-    for ( int j=adjHead[i]; j<adjHead[i+1]; ++j ) {
-      if ( adjList[j]== i ) { // if index
+    adjSelf[i] = head[i+1];
+    for ( int j=head[i]; j<head[i+1]; ++j ) {
+      if ( list[j]== i ) { // if index
 	adjSelf[i] = -j;
 	++extractSelfEdges;
 	break; // breaks j-loop to next iteration of i-loop
       } 
-      if ( adjList[j] > i ) {
+      if ( list[j] > i ) {
 	adjSelf[i] = j;
 	break; // breaks j-loop to next iteration of i-loop
       }
@@ -484,7 +489,7 @@ Graph::validate() {
     }
   }
   nNonZeros = adjList.size();
-  nEdges = adjHead[ nVtxs ] / 2;
+  nEdges = head[ nVtxs ] / 2;
   nBoundVtxs = adjHead.size() - ( nVtxs + 1 );
   currentState = VALID;
   FEXIT;
@@ -516,6 +521,46 @@ Graph::setGhostNodes( const int nBoundVtxs, const int nCutEdges ) {
 }
 #undef __FUNC__
     
+#define __FUNC__ "bool Graph::borrow( const int NVtxs, const int *AdjHead, const int *AdjList, " \
+"const int *VtxWeights, const int* EdgeWeights, const bool knownValid )"
+bool
+Graph::borrow( const int NVtxs, const int *AdjHead, const int *AdjList, 
+	       const int *VtxWeights, const int* EdgeWeights,
+	       const bool knownValid ) { 
+  FENTER;
+  FCALL reset();
+  if ( (NVtxs <= 0 ) || ( AdjHead == 0 ) || ( AdjList == 0 ) ) {
+    ERROR(SPINDLE_ERROR_ARG_BADPTR,"Invalid arguments.");
+    currentState = INVALID;
+    FRETURN( false );
+  }
+  nVtxs = NVtxs;
+  nNonZeros = AdjHead[ nVtxs ];
+  nEdges = nNonZeros;
+  adjHead.borrow( AdjHead, nVtxs+1 );
+  adjList.borrow( AdjList, nNonZeros );
+  if ( VtxWeights != 0 ) {
+    vtxWeight.borrow( VtxWeights, nVtxs );
+  }
+  if ( EdgeWeights != 0 ) {
+    edgeWeight.borrow( EdgeWeights, nNonZeros );
+  }
+  currentState = UNKNOWN;
+  if ( knownValid ) {
+    // rows are sorted and hold no self edges, so the higher neighbors
+    // of vertex i start at the first entry greater than i
+    adjSelf.resize( nVtxs );
+    {for( int i=0; i<nVtxs; ++i ) {
+      adjSelf[i] = upper_bound( AdjList + AdjHead[i], AdjList + AdjHead[i+1], i ) - AdjList;
+    }}
+    nEdges = nNonZeros / 2;
+    nBoundVtxs = 0;
+    currentState = VALID;
+  }
+  FRETURN( true );
+}
+#undef __FUNC__
+
 #define __FUNC__ "bool Graph::reset()"
 bool
 Graph::reset() {
@@ -97,6 +97,16 @@ public:
   SharedArray<int>& getEdgeWeight() { currentState=UNKNOWN; return edgeWeight; }
 
   bool setGhostNodes( const int nBoundVtxs, const int nCutEdges );
+
+  // read-only access to arrays that outlive the graph, such as those of
+  // a SnapshotFile.  They are copied only if the graph must change them.
+  // If the caller knows the arrays to be those of a valid graph (rows
+  // sorted, no duplicate or self edges, no boundary vertices), pass
+  // knownValid and the graph is valid without validate() reading every
+  // edge.
+  bool borrow( const int NVtxs, const int *AdjHead, const int *AdjList, 
+	       const int *VtxWeights=0, const int* EdgeWeights=0,
+	       const bool knownValid=false );
 };
 
 SPINDLE_END_NAMESPACE
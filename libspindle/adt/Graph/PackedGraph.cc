@@ -0,0 +1,225 @@
+//
+// PackedGraph.cc -- a read-only graph with delta encoded adjacency lists
+//
+// $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+//
+
+#include "spindle/PackedGraph.h"
+
+#ifndef SPINDLE_GRAPH_H_
+#include "spindle/Graph.h"
+#endif
+
+#ifndef SPINDLE_SYSTEM_H_
+#include "spindle/SpindleSystem.h"
+#endif
+
+#include <limits.h>
+#include <stdlib.h>
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+// number of bytes taking d seven bits at a time
+static inline int
+PackedGraph_nBytes( unsigned int d ) {
+  int n = 1;
+  while( d >= 0x80 ) {
+    d >>= 7;
+    ++n;
+  }
+  return n;
+}
+
+static inline unsigned char *
+PackedGraph_encode( unsigned char * p, unsigned int d ) {
+  while( d >= 0x80 ) {
+    *p++ = (unsigned char) ( ( d & 0x7f ) | 0x80 );
+    d >>= 7;
+  }
+  *p++ = (unsigned char) d;
+  return p;
+}
+
+// the difference from a vertex to its first neighbor, zig-zag encoded
+static inline unsigned int
+PackedGraph_first( const int vtx, const int adj ) {
+  return ( adj >= vtx ) ? 2u * (unsigned int) ( adj - vtx )
+    : 2u * (unsigned int) ( vtx - adj ) - 1u;
+}
+
+#ifdef __FUNC__
+#undef __FUNC__
+#endif
+
+#define __FUNC__ "PackedGraph::PackedGraph()"
+PackedGraph::PackedGraph() {
+  FENTER;
+  packedList = 0;
+  FCALL reset();
+  FEXIT;
+}
+#undef __FUNC__
+
+#define __FUNC__ "PackedGraph::PackedGraph( const Graph * graph )"
+PackedGraph::PackedGraph( const Graph * graph ) {
+  FENTER;
+  packedList = 0;
+  FCALL reset();
+  FCALL pack( graph );
+  FEXIT;
+}
+#undef __FUNC__
+
+PackedGraph::~PackedGraph() {
+  free( packedList );
+}
+
+bool
+PackedGraph::reset() {
+  nVtxs = 0;
+  nEdges = 0;
+  nBytes = 0;
+  valid = false;
+  blockHead.reset();
+  packedHead.reset();
+  free( packedList );
+  packedList = 0;
+  vtxWeight.reset();
+  return true;
+}
+
+#define __FUNC__ "bool PackedGraph::pack( const Graph * graph )"
+bool
+PackedGraph::pack( const Graph * graph ) {
+  FENTER;
+  reset();
+  if ( ( graph == 0 ) || ( !graph->isValid() ) ) {
+    ERROR( SPINDLE_ERROR_ARG_INVALID, "Cannot pack an invalid graph." );
+    FRETURN( false );
+  }
+  if ( graph->queryNBoundVtxs() > 0 ) {
+    ERROR( SPINDLE_ERROR_ARG_INVALID, "Cannot pack a graph with boundary vertices." );
+    FRETURN( false );
+  }
+  const int n = graph->queryNVtxs();
+  const int * head = graph->getAdjHead().lend();
+  const int * list = graph->getAdjList().lend();
+
+  // 1. count the bytes of each list, its length first
+  const int nBlocks = ( n + blockSize - 1 ) / blockSize;
+  FCALL blockHead.resize( nBlocks + 1 );
+  FCALL packedHead.resize( n );
+  size_t * l_blockHead = blockHead.begin();
+  unsigned int * l_packedHead = packedHead.begin();
+  size_t total = 0;
+  {for( int i=0; i<n; ++i ) {
+    if ( i % blockSize == 0 ) {
+      l_blockHead[ i / blockSize ] = total;
+    }
+    const size_t offset = total - l_blockHead[ i / blockSize ];
+    if ( offset > UINT_MAX ) {
+      ERROR( SPINDLE_ERROR_ARG_INVALID, "Vertices %d to %d pack into more than %u bytes.",
+	     i - i % blockSize, i, UINT_MAX );
+      blockHead.reset();
+      packedHead.reset();
+      FRETURN( false );
+    }
+    l_packedHead[i] = (unsigned int) offset;
+    total += PackedGraph_nBytes( (unsigned int) ( head[i+1] - head[i] ) );
+    if ( head[i] < head[i+1] ) {
+      total += PackedGraph_nBytes( PackedGraph_first( i, list[ head[i] ] ) );
+      for( int j=head[i]+1; j<head[i+1]; ++j ) {
+	total += PackedGraph_nBytes( (unsigned int) ( list[j] - list[j-1] - 1 ) );
+      }
+    }
+  }}
+  l_blockHead[ nBlocks ] = total;
+
+  // 2. then pack them
+  if ( ( packedList = (unsigned char *) malloc( ( total > 0 ) ? total : 1 ) ) == 0 ) {
+    ERROR( SPINDLE_ERROR_MEM, "Cannot allocate %.0f bytes for the packed lists.",
+	   (double) total );
+    blockHead.reset();
+    packedHead.reset();
+    FRETURN( false );
+  }
+  unsigned char * p = packedList;
+  {for( int i=0; i<n; ++i ) {
+    p = PackedGraph_encode( p, (unsigned int) ( head[i+1] - head[i] ) );
+    if ( head[i] == head[i+1] ) {
+      continue;
+    }
+    p = PackedGraph_encode( p, PackedGraph_first( i, list[ head[i] ] ) );
+    for( int j=head[i]+1; j<head[i+1]; ++j ) {
+      p = PackedGraph_encode( p, (unsigned int) ( list[j] - list[j-1] - 1 ) );
+    }
+  }}
+
+  if ( graph->getVtxWeight().size() == n ) {
+    FCALL vtxWeight.import( graph->getVtxWeight().lend(), n );
+  }
+  nVtxs = n;
+  nEdges = graph->queryNEdges();
+  nBytes = total;
+  valid = true;
+  FRETURN( true );
+}
+#undef __FUNC__
+
+int
+PackedGraph::deg( const int i ) const {
+  if ( ( i < 0 ) || ( i >= nVtxs ) ) {
+    return -1;
+  }
+  if ( vtxWeight.size() == 0 ) {
+    return nAdj(i);
+  }
+  const int * weight = vtxWeight.lend();
+  int temp = 0;
+  for( const_iterator cur = begin_adj(i), stop = end_adj(i); cur != stop; ++cur ) {
+    temp += weight[ *cur ];
+  }
+  return temp;
+}
+
+#define __FUNC__ "Graph * PackedGraph::createGraph() const"
+Graph *
+PackedGraph::createGraph() const {
+  FENTER;
+  if ( !valid ) {
+    FRETURN( 0 );
+  }
+  int * head = new int[ nVtxs+1 ];
+  int * list = new int[ 2*nEdges ];
+  head[0] = 0;
+  {for( int i=0; i<nVtxs; ++i ) {
+    int * dest = list + head[i];
+    for( const_iterator cur = begin_adj(i), stop = end_adj(i); cur != stop; ++cur ) {
+      *dest++ = *cur;
+    }
+    head[i+1] = dest - list;
+  }}
+  Graph * graph = new Graph( nVtxs, (const int *) head, (const int *) list,
+			     ( vtxWeight.size() == 0 ) ? 0 : vtxWeight.lend(), 0 );
+  delete[] list;
+  delete[] head;
+  graph->validate();
+  FRETURN( graph );
+}
+#undef __FUNC__
@@ -0,0 +1,205 @@
+//
+// PackedGraph.h -- a read-only graph with delta encoded adjacency lists
+//
+// $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+//
+
+#ifndef SPINDLE_PACKED_GRAPH_H_
+#define SPINDLE_PACKED_GRAPH_H_
+
+#ifndef SPINDLE_H_
+#include "spindle/spindle.h"
+#endif
+
+#ifndef SPINDLE_AUTO_ARRAY_H_
+#include "spindle/SharedArray.h"
+#endif
+
+#ifdef REQUIRE_OLD_CXX_HEADER_SUFFIX
+#include "iterator.h"
+#else
+#include <iterator>
+using namespace std;
+#endif
+
+SPINDLE_BEGIN_NAMESPACE
+
+class Graph;
+
+/**
+ * @memo a read-only copy of a Graph with its adjacency lists packed into bytes
+ * @type class
+ *
+ * The adjacency list of each vertex is stored as its length followed by
+ * the differences between consecutive neighbors, seven bits to a byte
+ * with the high bit set on all but the last byte of a number.  The
+ * first neighbor is stored relative to the vertex itself.  Since a
+ * valid Graph has sorted adjacency lists without self edges, most
+ * differences of a well numbered graph fit in one byte, a quarter of
+ * an #int#.
+ *
+ * #begin_adj(i)# and #end_adj(i)# return input iterators that decode
+ * the neighbors of #i# in increasing order, which is all that
+ * BreadthFirstSearch, PseudoDiameter, RCMEngine and SloanEngine need.
+ * Each takes a PackedGraph in place of a Graph through #setGraph()#.
+ * The vertex weights are kept as they are; edge weights are dropped.
+ *
+ * Each list is found from a #size_t# offset shared by a block of 64
+ * vertices and a 32 bit offset within the block, so the packed lists
+ * may exceed 4 GB as long as no 64 consecutive vertices do.
+ *
+ * Once packed, the Graph may be deleted.  To avoid holding both in
+ * memory, pack a Graph borrowed from a SnapshotFile: its pages are
+ * the operating system's to drop.
+ *
+ * @author agent
+ * @version #$Id$#
+ * @see Graph
+ */
+class PackedGraph {
+public:
+  /**
+   * decodes one adjacency list.  Only iterators over the same list
+   * may be compared.
+   */
+  class const_iterator : public input_iterator< int, ptrdiff_t > {
+    friend class PackedGraph;
+  private:
+    const unsigned char * p;  // next byte to decode
+    int cur;                  // current neighbor
+    int nLeft;                // neighbors left, including cur
+
+    static unsigned int decode( const unsigned char *& p );
+    const_iterator( const unsigned char * first, const int vtx );
+  public:
+    const_iterator() : p(0), cur(0), nLeft(0) {}
+    int operator*() const { return cur; }
+    const_iterator& operator++();
+    const_iterator operator++(int) { const_iterator temp = *this; ++(*this); return temp; }
+    bool operator==( const const_iterator& it ) const { return nLeft == it.nLeft; }
+    bool operator!=( const const_iterator& it ) const { return nLeft != it.nLeft; }
+  };
+
+private:
+  enum { blockSize = 64 };              // vertices sharing a blockHead
+
+  int nVtxs;
+  int nEdges;
+  size_t nBytes;
+  bool valid;
+
+  SharedArray<size_t> blockHead;        // first byte of each block of vertices
+  SharedArray<unsigned int> packedHead; // first byte of each list in its block
+  unsigned char * packedList;           // nBytes long, from malloc()
+  SharedArray<int> vtxWeight;           // length = nVtxs or zero
+
+public:
+  /** empty, not valid */
+  PackedGraph();
+  /** packs a copy of #graph# */
+  PackedGraph( const Graph * graph );
+  ~PackedGraph();
+
+  /**
+   * pack a copy of #graph#, replacing what was here.
+   * @return false if #graph# is not valid, has boundary vertices, or
+   *         a block of vertices packs into more than UINT_MAX bytes.
+   */
+  bool pack( const Graph * graph );
+
+  /** forget the graph */
+  bool reset();
+
+  bool isValid() const { return valid; }
+
+  int queryNVtxs() const { return nVtxs; }
+  int queryNEdges() const { return nEdges; }
+  int queryNNonZeros() const { return 2*nEdges; }
+  int size() const { return nVtxs; }
+  /** number of bytes holding the adjacency lists */
+  size_t queryNBytes() const { return nBytes; }
+
+  /** degree of vertex #i#, weighted as in GraphBase::deg() */
+  int deg( const int i ) const;
+
+  /** number of neighbors of vertex #i#, whether weighted or not */
+  int nAdj( const int i ) const
+    { const unsigned char * p = list( i ); return (int) const_iterator::decode( p ); }
+
+  //iterate over adjacency list of vertex i
+  const_iterator begin_adj( const int i ) const { return const_iterator( list( i ), i ); }
+  const_iterator   end_adj( const int i ) const { return const_iterator(); }
+
+  const SharedArray<int>& getVtxWeight() const { return vtxWeight; }
+
+  /**
+   * unpack into a new Graph, without edge weights.
+   * @return 0 if not valid
+   */
+  Graph * createGraph() const;
+
+private:
+  // private copy and assignment constructors
+  PackedGraph( const PackedGraph& );
+  PackedGraph& operator=( const PackedGraph& );
+
+  // first byte of the list of vertex i
+  const unsigned char * list( const int i ) const
+    { return packedList + blockHead.lend()[ i / blockSize ]
+	+ packedHead.lend()[i]; }
+};
+
+inline unsigned int
+PackedGraph::const_iterator::decode( const unsigned char *& p ) {
+  unsigned int b = *p++;
+  if ( b < 0x80 ) {
+    return b;
+  }
+  unsigned int d = b & 0x7f;
+  int shift = 7;
+  do {
+    b = *p++;
+    d |= ( b & 0x7f ) << shift;
+    shift += 7;
+  } while( b >= 0x80 );
+  return d;
+}
+
+inline
+PackedGraph::const_iterator::const_iterator( const unsigned char * first,
+					     const int vtx ) {
+  p = first;
+  nLeft = (int) decode( p );
+  cur = vtx;
+  if ( nLeft > 0 ) {
+    // the first neighbor is stored zig-zag: 2*d for d >= 0, -2*d-1 for d < 0
+    const unsigned int z = decode( p );
+    cur += ( z & 1 ) ? ( -1 - (int) ( z >> 1 ) ) : (int) ( z >> 1 );
+  }
+}
+
+inline PackedGraph::const_iterator&
+PackedGraph::const_iterator::operator++() {
+  if ( --nLeft > 0 ) {
+    cur += (int) decode( p ) + 1;
+  }
+  return *this;
+}
+
+SPINDLE_END_NAMESPACE
+
+#endif
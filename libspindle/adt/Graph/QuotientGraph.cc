@@ -23,6 +23,7 @@
 
 #include <string.h>
 #include <strings.h> // defines bzero
+#include <limits.h>
 
 #ifdef REQUIRE_OLD_CXX_HEADER_SUFFIX
 #include <iomanip.h>
@@ -101,26 +102,78 @@ T myHash(InputIterator first, InputIterator last, T init) {
 using namespace SPINDLE_NAMESPACE;
 #endif
 
+// largest position in adjList_, kept well clear of overflowing the
+// byte count of the allocation
+#ifdef SPINDLE_LARGE_GRAPHS
+static const double QuotientGraph_maxOffset = (double) ( LONG_MAX / sizeof(int) );
+#else
+static const double QuotientGraph_maxOffset = (double) INT_MAX;
+#endif
+// the larger of space and minSpace, cut down to limit
+static inline QuotientGraph::Offset
+QuotientGraph_space( const double space, const double minSpace, const double limit ) {
+  const double s = ( space > minSpace ) ? space : minSpace;
+  return (QuotientGraph::Offset) ( ( s < limit ) ? s : limit );
+}
+
+void
+QuotientGraph::setOffsetLimit( const double limit ) {
+  offsetLimit = ( ( limit <= 0 ) || ( limit > QuotientGraph_maxOffset ) ) ?
+    QuotientGraph_maxOffset : limit;
+}
+
 #ifdef __FUNC__
 #undef __FUNC__
 #endif
 
 #define __FUNC__ "QuotientGraph::QuotientGraph( const Graph* graph )"
 QuotientGraph::QuotientGraph( const Graph* graph ) {
-  if ( graph != 0 && graph->isValid() ) {
-    n = graph->queryNVtxs();
-    if ( graph->getVtxWeight().size() == n ) {
-      initialize( graph->queryNVtxs(), graph->getAdjHead().lend(), graph->getAdjList().lend(), 
-		  graph->getVtxWeight().lend() );
-    } else {
-      initialize( graph->queryNVtxs(), graph->getAdjHead().lend(), graph->getAdjList().lend(), 0 );
-    }
+  n = 0;
+  nCapacity = 0;
+  adjListCapacity = 0;
+  maxSpace = 0;
+  adjList_ = 0;
+  adjHead_ = 0;
+  parent_ = 0;
+  nEnodes_ = 0;
+  nSnodes_ = 0;
+  weight_ = 0;
+  setDiff_ = 0;
+  externDeg_ = 0;
+  next_ = 0;
+  prev_ = 0;
+  updateList_ = 0;
+  visited_ = 0;
+  sorter = 0;
+  offsetLimit = QuotientGraph_maxOffset;
+  setGraph( graph );
+}
+#undef __FUNC__
+
+#define __FUNC__ "bool QuotientGraph::setGraph( const Graph* graph )"
+bool
+QuotientGraph::setGraph( const Graph* graph ) {
+  hasGraph = false;
+  if ( graph == 0 || !graph->isValid() ) { 
+    return false;
+  }
+  n = graph->queryNVtxs();
+  const int * vwgt = ( graph->getVtxWeight().size() == n ) ? graph->getVtxWeight().lend() : 0;
+  if ( !initialize( graph->queryNVtxs(), graph->getAdjHead().lend(), 
+		    graph->getAdjList().lend(), vwgt ) ) { 
+    return false;
   }
+  if ( threadTeam.queryNThreads() > 1 ) { 
+    // the scratch space of the other threads is n long
+    setNThreads( threadTeam.queryNThreads() );
+  }
+  hasGraph = true;
+  return true;
 }
 #undef __FUNC__
 
-#define __FUNC__ "void QuotientGraph::initialize( const int nVertices, const int *AdjHead, const int *AdjList, const int *weights )" 
-void 
+#define __FUNC__ "bool QuotientGraph::initialize( const int nVertices, const int *AdjHead, const int *AdjList, const int *weights )" 
+bool 
 QuotientGraph::initialize( const int nVertices, const int *AdjHead, const int *AdjList, const int *vwgt ) {
   FENTER;
   initFinalizeTimer[0].start();
@@ -160,47 +213,60 @@ QuotientGraph::initialize( const int nVertices, const int *AdjHead, const int *A
   // userForceCompressMixAdjVtxs = -1;
   // userNAdjClqBound = -1;
 
-  int nnz = AdjHead[n] + n;
-  maxSpace = ( ( nnz * 1.3 ) > nnz + n ) ? (int)(nnz * 1.3) : nnz + n;
-  if ( (adjList_ = (int *) malloc( maxSpace * sizeof(int) ) ) == 0 ) {
-    // not enough memory, 
-    if ( maxSpace == nnz + n ) { 
+  // room for the lists plus a self edge per vertex, and up to 30% more
+  // to postpone defragmenting.  Offsets are computed in double so that
+  // a graph too large for Offset is caught instead of wrapping around.
+  const double nnz = (double) AdjHead[n] + n;
+  const double minSpace = nnz + n;
+  if ( minSpace > offsetLimit ) { 
+    WARNING( "graph needs %.0f entries of work space, but offsets stop at %.0f.  "
+	     "Reconfigure with --enable-large-graphs.", minSpace, offsetLimit );
+    FRETURN( false );
+  }
+  maxSpace = QuotientGraph_space( nnz * 1.3, minSpace, offsetLimit );
+  // keep the adjList of a previous graph if it is long enough
+  if ( maxSpace > adjListCapacity ) { 
+    free( adjList_ );
+    adjListCapacity = 0;
+    // not enough memory, try again with less elbow room
+    const double elbowRoom[] = { 1.3, 1.2, 1.1, 0.0 };
+    {for( int i=0; i<4; ++i ) {
+      maxSpace = QuotientGraph_space( nnz * elbowRoom[i], minSpace, offsetLimit );
+      if ( ( adjList_ = (int *) malloc( maxSpace * sizeof(int) ) ) != 0 ) { 
+	break;
+      }
+      if ( maxSpace == (Offset) minSpace ) { 
+	break;
+      }
+    }}
+    if ( adjList_ == 0 ) { 
       cerr << "not enough memory!" << endl;
       exit( -1 );
     }
-    // try again.
-    maxSpace = ( ( nnz * 1.2 ) > nnz + n ) ? (int)(nnz * 1.2) : nnz + n;
-    if ( (adjList_ = (int *) malloc( maxSpace * sizeof(int) ) ) == 0 ) {
-      // not enough memory, 
-      if ( maxSpace == nnz + n ) { 
-	cerr << "not enough memory!" << endl;
-	exit( -1 );
-      }
-      // try again.
-      maxSpace = ( ( nnz * 1.1 ) > nnz + n ) ? (int)(nnz * 1.1) : nnz + n;
-      if ( (adjList_ = (int *) malloc( maxSpace * sizeof(int) ) ) == 0 ) {
-	// not enough memory, 
-	if ( maxSpace == nnz + n ) { 
-	  cerr << "not enough memory!" << endl;
-	  exit( -1 );
-	}
-	// try again.
-	maxSpace = nnz + n;
-	if ( (adjList_ = (int *) malloc( maxSpace * sizeof(int) ) ) == 0 ) {
-	  // not enough memory, 
-	  cerr << "not enough memory!" << endl;
-	  exit( -1 );
-	} // end maxSpace = nnz + n;
-      } // end maxSpace = max( 1.1 * nnz, nnz+n );
-    } // end maxSpace = max ( 1.2 * nnz, nnz+n );
-  } // end maxSpace = max( 1.3 * nnz, nnz+n );
+    adjListCapacity = maxSpace;
+  } // end maxSpace > adjListCapacity
+
+  // likewise the arrays of length n
+  if ( n > nCapacity ) { 
+    freeArrays();
+    adjHead_    = new Offset [n];
+    nSnodes_    = new int [n];
+    nEnodes_    = new int [n];
+    parent_     = new int [n];
+    next_       = new int [n];
+    prev_       = new int [n];
+    updateList_ = new int [n+1];
+    visited_    = new int [n];
+    setDiff_    = new int [n];
+    weight_     = new int [n];
+    externDeg_  = new int [n];
+    nCapacity = n;
+  }
 
   // need to copy AdjList to adjList_, but need to add a 
   // self edge at the beginning of each list.
-  adjHead_ = new int [ n ]; 
-  nSnodes_ = new int [ n ];
   { 
-    register int curidx = 0;
+    register Offset curidx = 0;
     {for ( register int i=0; i<n; ++i ) {
       adjList_[curidx] = i;
       adjHead_[i] = curidx;
@@ -220,34 +286,48 @@ QuotientGraph::initialize( const int nVertices, const int *AdjHead, const int *A
   
   {
     register int * restrict ip;
-    nEnodes_    = ip = new int [n];   {for (register int i=0; i<n; ++i) *ip++ = 1;}
-    parent_     = ip = new int [n];   {for (register int i=0; i<n; ++i) *ip++ = i;}
-    next_       = ip = new int [n];   {for (register int i=0; i<n; ++i) *ip++ = i;}
-    prev_       = ip = new int [n];   {for (register int i=0; i<n; ++i) *ip++ = i;}
-    updateList_ = ip = new int [n+1]; {for (register int i=0; i<n; ++i) *ip++ = -1;}
+    ip = nEnodes_;    {for (register int i=0; i<n; ++i) *ip++ = 1;}
+    ip = parent_;     {for (register int i=0; i<n; ++i) *ip++ = i;}
+    ip = next_;       {for (register int i=0; i<n; ++i) *ip++ = i;}
+    ip = prev_;       {for (register int i=0; i<n; ++i) *ip++ = i;}
+    ip = updateList_; {for (register int i=0; i<n; ++i) *ip++ = -1;}
     updateList_[n] = n;
-    visited_    = ip = new int [n];   {bzero( (char *) ip, n*sizeof(int) );}
-    setDiff_    = ip = new int [n];   {bzero( (char *) ip, n*sizeof(int) );}
+    bzero( (char *) visited_, n*sizeof(int) );
+    bzero( (char *) setDiff_, n*sizeof(int) );
     if ( vwgt == 0 ) {
-      weight_ = ip = new int [n]; {for (int i=0; i<n; ++i) *ip++ = 1;}
-      externDeg_ = ip = new int [n];   {for (int i=0; i<n; ++i) *ip++ = nSnodes_[i]; }
+      ip = weight_;    {for (int i=0; i<n; ++i) *ip++ = 1;}
+      ip = externDeg_; {for (int i=0; i<n; ++i) *ip++ = nSnodes_[i]; }
     } else {
-      weight_ = new int [n];
       memcpy( weight_, vwgt, sizeof(int) * n );
-      externDeg_ = ip = new int [n];   {for (int i=0; i<n; ++i) *ip++ = 0; }
+      ip = externDeg_; {for (int i=0; i<n; ++i) *ip++ = 0; }
       {for (register int i=0; i<n; ++i) {
-	for(register int j=adjHead_[i]+1, j_max = adjHead_[i]+nSnodes_[i]+1; j<j_max; ++j ) {
+	for(register Offset j=adjHead_[i]+1, j_max = adjHead_[i]+nSnodes_[i]+1; j<j_max; ++j ) {
 	  externDeg_[i] += weight_[adjList_[j]];
 	}
       }}
     }
   }
-  sorter = new ArrayBucketSorter(n,n);  
-  FEXIT;
+  if ( sorter == 0 ) { 
+    sorter = new ArrayBucketSorter(n,n);  
+  } else { 
+    sorter->resize(n,n);
+  }
+  degreeList.resize(0);
+  delayedVtxs.resize(0);
+  reachableNeighbors.resize(0);
+  purgedVtxs.resize(0);
+  FRETURN( true );
 }
 #undef __FUNC__
 
 QuotientGraph::~QuotientGraph() {
+  freeArrays();
+  delete sorter;
+  free( adjList_ );
+}
+
+void
+QuotientGraph::freeArrays() { 
   delete[] adjHead_;
   delete[] nEnodes_;
   delete[] nSnodes_;
@@ -261,8 +341,7 @@ QuotientGraph::~QuotientGraph() {
   if ( setDiff_ != 0 ) { 
     delete[] setDiff_;
   }
-  delete sorter;
-  free( adjList_ );
+  nCapacity = 0;
 }
 
 int 
@@ -270,11 +349,18 @@ QuotientGraph::deg( const int i ) const {
   register const int * const restrict weight = weight_;
   register	 int * const restrict visited = visited_;
   int degree = 0;
+  if ( i<0 || i>=n || adjHead_[i]<0 || nEnodes_[i]<0 ) { 
+    return degree;
+  }
   int stamp = nextStamp();
   visited[ i ] = stamp;
 
-  for ( const int * e = enode_begin(i), * stop_e = enode_end(i); e != stop_e; ++e ) { 
-    for ( const int * s = snode_begin(*e), *stop_s = snode_end(*e); s != stop_s; ++s ) { 
+  const NodeView me = lendNodeView( i );
+  for ( const int * e = me.enode_begin(), * stop_e = me.enode_end(); e != stop_e; ++e ) { 
+    // the enodes of i include i itself, which is not eliminated
+    const int * s = ( *e == i ) ? me.snode_begin() : clique_begin( *e );
+    const int * stop_s = ( *e == i ) ? me.snode_end() : clique_end( *e );
+    for ( ; s != stop_s; ++s ) { 
       if ( visited[ *s ] < stamp ) { 
 	visited[ *s ] = stamp;
 	degree += weight[*s];
@@ -284,6 +370,66 @@ QuotientGraph::deg( const int i ) const {
   return degree;
 }
 
+// same as deg( i ), but with caller supplied scratch space 
+// so that several threads can compute degrees at once.
+int 
+QuotientGraph::deg( const int i, int * visited, int& stamp ) const { 
+  register const int * const restrict weight = weight_;
+  int degree = 0;
+  if ( (++stamp) >= LARGEINT ) {
+    bzero( (char *) visited, n*sizeof(int) );
+    stamp = 1;
+  }
+  visited[ i ] = stamp;
+
+  const NodeView me = lendNodeView( i );
+  for ( const int * e = me.enode_begin(), * stop_e = me.enode_end(); e != stop_e; ++e ) { 
+    // the enodes of i include i itself, which is not eliminated
+    const int * s = ( *e == i ) ? me.snode_begin() : clique_begin( *e );
+    const int * stop_s = ( *e == i ) ? me.snode_end() : clique_end( *e );
+    for ( ; s != stop_s; ++s ) { 
+      if ( visited[ *s ] < stamp ) { 
+	visited[ *s ] = stamp;
+	degree += weight[*s];
+      }
+    }
+  }
+  return degree;
+}
+
+bool
+QuotientGraph::setNThreads( const int nThreads ) {
+  if ( !threadTeam.setNThreads( nThreads ) ) { 
+    return false;
+  }
+  const int nExtra = threadTeam.queryNThreads() - 1;
+  threadVisited.resize( 0 );
+  threadVisited.insert( threadVisited.end(), nExtra * n, 0 );
+  threadStamp.resize( 0 );
+  threadStamp.insert( threadStamp.end(), nExtra, 0 );
+  return true;
+}
+
+// NOTE: called concurrently by ThreadTeam::run(), no FENTER/TRACE here.
+void
+QuotientGraph::computeDegreeTask( void * qgraph, const int begin, const int end, 
+				  const int threadID ) {
+  QuotientGraph * g = (QuotientGraph *) qgraph;
+  const int * list = &(g->degreeList[0]);
+  int * externDeg = g->externDeg_;
+  if ( threadID == 0 ) { 
+    for( int k=begin; k<end; ++k ) { 
+      externDeg[ list[k] ] = g->deg( list[k] ); //deg() is really external degree
+    }
+  } else { 
+    int * visited = &(g->threadVisited[0]) + (threadID-1) * g->n;
+    int & stamp = g->threadStamp[ threadID-1 ];
+    for( int k=begin; k<end; ++k ) { 
+      externDeg[ list[k] ] = g->deg( list[k], visited, stamp );
+    }
+  }
+}
+
 #define __FUNC__ "bool QuotientGraph::eliminateSupernode( const int i )"
 bool QuotientGraph::eliminateSupernode( const int i ) {
   FENTER;
@@ -317,7 +463,7 @@ bool QuotientGraph::eliminateSupernode( const int i ) {
   lastENode = i;
 
   eliminateSupernodeTimer[0].start();
-  int mySrc = adjHead_[i];     // where my information comes from 
+  Offset mySrc = adjHead_[i];  // where my information comes from 
   int myNEnodes = nEnodes_[i]; // number of enodes
   int myNSnodes = nSnodes_[i]; // number of supernodes
   if ( updateList_[n] == n ) { // if the update list is empty
@@ -331,7 +477,7 @@ bool QuotientGraph::eliminateSupernode( const int i ) {
   // II: assemble enode from eliminated snode
   //
   {
-    register       int * const restrict adjHead = adjHead_;
+    register    Offset * const restrict adjHead = adjHead_;
     register       int * const restrict adjList = adjList_;
     register       int * const restrict nEnodes = nEnodes_;
     register       int * const restrict nSnodes = nSnodes_;
@@ -351,16 +497,16 @@ bool QuotientGraph::eliminateSupernode( const int i ) {
       adjList[ mySrc ] = -1;    // flag location as unused.
       mySrc = ++adjHead[i];     // set pointer past inital enode
       int new_weight = 0;
-      for(register int cur = mySrc, stop = mySrc+myNSnodes; cur<stop;++cur ) {
+      for(register Offset cur = mySrc, stop = mySrc+myNSnodes; cur<stop;++cur ) {
 	new_weight += weight[adjList[cur]];
       }
       weight[i] = new_weight; // weight of a clique is the sum of its adjacent vtxs.
       setDiff[i] = new_weight;
     } else {                   // build new element in freeSpace
-      int pack_begin = mySrc;
-      int pack_end   = mySrc+myNSnodes+myNEnodes;
+      Offset pack_begin = mySrc;
+      Offset pack_end   = mySrc+myNSnodes+myNEnodes;
       int new_weight = 0;
-      int dest = freeSpace;          // place where enode is assembled
+      Offset dest = freeSpace;          // place where enode is assembled
       const int stamp = nextStamp(); // get the next stamp
       visited[ i ] = stamp;          // mark "i" as visited
       /////////////////////////////////////////////////////////////
@@ -368,7 +514,7 @@ bool QuotientGraph::eliminateSupernode( const int i ) {
       // II a. for all adjacent enodes...
       //
       {
-	for ( int j = mySrc, j_stop = mySrc+myNEnodes; j<j_stop; ++j) {
+	for ( Offset j = mySrc, j_stop = mySrc+myNEnodes; j<j_stop; ++j) {
 	  int enode = adjList[j];   
 	  if ( enode < 0 ) {        // skip invalid numbers
 	    continue;
@@ -385,7 +531,7 @@ bool QuotientGraph::eliminateSupernode( const int i ) {
 	  if ( enode != i ) { // if current enode is not the one we're just creating
 	    // for all snodes adjacent to enode
 	    // Mark all snodes adj to adj enodes as visited
-	    for ( int k = adjHead[enode], k_stop = adjHead[enode]+nSnodes[enode]; 
+	    for ( Offset k = adjHead[enode], k_stop = adjHead[enode]+nSnodes[enode]; 
 		  k < k_stop; ++k ) {
 	      // NOTE:
 	      //      Since enodes have no adjacent enodes nEnodes[enode] 
@@ -414,7 +560,7 @@ bool QuotientGraph::eliminateSupernode( const int i ) {
 		adjList[ adjHead[i] ] = enode;
 		nEnodes[i] = j_stop - j;    // store number of enodes not absorbed
 		// store beginning of partially assembled new adjList
-		int oldFreeSpace = freeSpace;  
+		Offset oldFreeSpace = freeSpace;  
 		// store number of snodes done in current enode
 		int nSnodesDone = k - adjHead[ enode ];
 		// store number of snodes already in partially assembled enode
@@ -487,7 +633,7 @@ bool QuotientGraph::eliminateSupernode( const int i ) {
       // II b. Now copy any unvisited adjacent snodes
       //
       {
-	for ( int k = mySrc + myNEnodes, stop_k = mySrc + myNEnodes + myNSnodes ; 
+	for ( Offset k = mySrc + myNEnodes, stop_k = mySrc + myNEnodes + myNSnodes ; 
 	      k < stop_k; ++k ) { 
 	  int snode = adjList[k];
 	  if ( snode < 0 ) {                // if we happened upon unused space
@@ -516,7 +662,7 @@ bool QuotientGraph::eliminateSupernode( const int i ) {
 	    nEnodes[i] = 0;             // don't have any more enodes
 	    nSnodes[i] = stop_k - k;    // we know exactly how many snodes
 	    // store beginning of partially assembled new adjList
-	    int oldFreeSpace = freeSpace;  
+	    Offset oldFreeSpace = freeSpace;  
 	    // store number of snodes already in partially assembled enode
 	    int nItems = dest - freeSpace;
 
@@ -565,7 +711,7 @@ bool QuotientGraph::eliminateSupernode( const int i ) {
       // II.b. Now place the newly formed element, if possible
       //
       {
-	int cleanup_begin = freeSpace + myNSnodes;  //space that needs reclaiming later
+	Offset cleanup_begin = freeSpace + myNSnodes;  //space that needs reclaiming later
 	// int cleanup_end = freeSpace + myNSnodes;     
 #if ( SPINDLE_QGRAPH_REPACK_AGGRESIVE > 0 )
 	if ( (pack_end - pack_begin) < myNSnodes ) { 
@@ -697,7 +843,7 @@ bool QuotientGraph::eliminateSupernode( const int i ) {
     register       int * const restrict updateList = updateList_;
     int head = updateList[n];   // head == n implies list is empty, 
                                 // updateList[j] == n implies end of list
-    for ( register int j = mySrc, j_stop = mySrc + myNSnodes; j<j_stop; ++j ) {
+    for ( register Offset j = mySrc, j_stop = mySrc + myNSnodes; j<j_stop; ++j ) {
       int s = adjList[ j ];
       if ( parent[ s ] < 0 ) { // if outmatched
 	int outmatchedBy = n + parent[ s ];
@@ -868,7 +1014,7 @@ void
 QuotientGraph::computeSetDiffs( const int stamp ) {
   FENTER;
 
-  register const int * const restrict adjHead = adjHead_;
+  register const Offset * const restrict adjHead = adjHead_;
   register       int * const restrict adjList = adjList_;
   register const int * const restrict nEnodes = nEnodes_;
   register const int * const restrict nSnodes = nSnodes_;
@@ -884,11 +1030,11 @@ QuotientGraph::computeSetDiffs( const int stamp ) {
   //
 
   int me = lastEliminatedNode.back();
-  int head = adjHead[ me ];
+  Offset head = adjHead[ me ];
   int nItems = 0;
 
   // for all snodes adjacent to last eliminated node
-  for ( int i = head, stop_i = head + nSnodes[ me ]; i<stop_i; ++i ) {
+  for ( Offset i = head, stop_i = head + nSnodes[ me ]; i<stop_i; ++i ) {
     int s = adjList[ i ];
     int ancestor = s;
     while ( adjHead[ ancestor ] < 0 ) {  // while snode is compressed
@@ -908,7 +1054,7 @@ QuotientGraph::computeSetDiffs( const int stamp ) {
 	//      so nEnodes[s] only has enodes other than newest enode.
 	
 	// for all enodes, e, adjacent to supernode,s
-	for ( int j = adjHead[ s ] , stop_j = adjHead[s] + nEnodes[s] ; j <stop_j; ++j ) {
+	for ( Offset j = adjHead[ s ] , stop_j = adjHead[s] + nEnodes[s] ; j <stop_j; ++j ) {
 	  int e = adjList[ j ];          
 	  if ( ( parent[e] != e ) && ( parent[e]>0 ) ) {  
 	                        // if element is absorbed
@@ -933,7 +1079,7 @@ QuotientGraph::computeSetDiffs( const int stamp ) {
 #if ( SPINDLE_QGRAPH_REPACK_AGGRESSIVE > 0 ) 
   // flag unused spaces as available for reclaimation.
   int oldNItems = nSnodes[ me ];
-  for ( int k = head+nItems, stop_k = head+oldNItems; k < stop_k ; ++k ) { 
+  for ( Offset k = head+nItems, stop_k = head+oldNItems; k < stop_k ; ++k ) { 
     adjList[ k ] = -1;
   }
 #endif
@@ -951,7 +1097,7 @@ QuotientGraph::computeSetDiffs( const int stamp ) {
 void 
 QuotientGraph::stripOldEntriesAndPackIntoBucketSorter( const int stamp ) {
   FENTER;
-  register const int * const restrict adjHead = adjHead_;
+  register const Offset * const restrict adjHead = adjHead_;
   register       int * const restrict adjList = adjList_;
   register       int * const restrict nEnodes = nEnodes_;
   register       int * const restrict nSnodes = nSnodes_;
@@ -963,7 +1109,7 @@ QuotientGraph::stripOldEntriesAndPackIntoBucketSorter( const int stamp ) {
   register const int * const restrict visited = visited_;
 
   int me = lastEliminatedNode.back();
-  int head = adjHead[ me ];
+  Offset head = adjHead[ me ];
   
   ////////////////////////////////
   //
@@ -971,20 +1117,20 @@ QuotientGraph::stripOldEntriesAndPackIntoBucketSorter( const int stamp ) {
   //
   // int nleft = n - totEliminatedNodes;
   // for all snodes adjacent to newest formed enode...
-  for ( int i = head, stop_i = head + nSnodes[ me ]; i<stop_i; ++i ) {
+  for ( Offset i = head, stop_i = head + nSnodes[ me ]; i<stop_i; ++i ) {
     int s = adjList[i];                      // name of the snode
     while ( adjHead[ s ] < 0 ) {             // while it has been merged
       s = parent[ s ];                       // find its parent
     }
     adjList[i] = s;                          // write the parent back
-    register int src  = adjHead[ s ];        // beginning of s space
-    register int dest = adjHead[ s ];
+    register Offset src  = adjHead[ s ];     // beginning of s space
+    register Offset dest = adjHead[ s ];
     int degree = weight[ me ] - weight[ s ]; // degree of snode s
     // int dfill  = degree;
     int hashval = 0; // -(s+1);                     // include snode in hashval
       
     // forall  enodes, e, adjacent to snode, s
-    for ( const int  stop = adjHead[ s ] + nEnodes[ s ];  src<stop; ++src ) {
+    for ( const Offset stop = adjHead[ s ] + nEnodes[ s ];  src<stop; ++src ) {
       int e = adjList[ src ];           // 
       if ( e<0 || e>=n || e == me || weight[e]==0) {   // if e is bad value, or e is me
 	;                               //    ... skip to next iteration
@@ -1016,7 +1162,7 @@ QuotientGraph::stripOldEntriesAndPackIntoBucketSorter( const int stamp ) {
     ASSERT( newNEnodes >= 0, "cannot have a negative number of enodes");
 
     // forall snodes, z, adjacent to snode, s. 
-    for( const int stop = adjHead[s] + nEnodes[s] + nSnodes[s]; src < stop; ++src ) {
+    for( const Offset stop = adjHead[s] + nEnodes[s] + nSnodes[s]; src < stop; ++src ) {
       int z = adjList[ src ];
       if ( nEnodes[z] > 0) {            // if z is an snode
 	if ( visited[z] < stamp ) {     // if z is not in adj(me) 
@@ -1060,7 +1206,7 @@ void
 QuotientGraph::QuotientGraph::scanBucketSorterForSupernodes( VertexList& removeNodes ) {
   FENTER;
 
-  register int * const restrict adjHead = adjHead_;
+  register Offset * const restrict adjHead = adjHead_;
   register int * const restrict adjList = adjList_;
   register int * const restrict nEnodes = nEnodes_;
   register int * const restrict nSnodes = nSnodes_;
@@ -1079,10 +1225,10 @@ QuotientGraph::QuotientGraph::scanBucketSorterForSupernodes( VertexList& removeN
   // Do this by examining all unique hash keys for all
   // snodes adj to me
   int me = lastEliminatedNode.back();
-  int head = adjHead[ me ];
+  Offset head = adjHead[ me ];
   
   // for all snodes adjacent to newest formed enode...
-  for ( int i = head, stop_i = head + nSnodes[ me ]; i<stop_i; ++i ) {
+  for ( Offset i = head, stop_i = head + nSnodes[ me ]; i<stop_i; ++i ) {
     int s = adjList[i]; 
     int bucket = sorter->queryBucket( s );       // get current bucket of snode s
     if ( bucket == -1 ) {                        // if bucket == -1, 
@@ -1120,7 +1266,7 @@ QuotientGraph::QuotientGraph::scanBucketSorterForSupernodes( VertexList& removeN
 	  if ( lastTargetScattered != targetNode ) {  
 	    // if we haven't marked this one yet
 	    stamp = nextStamp();                      //    get new timestamp
-	    for( register int j = adjHead[ targetNode ], 
+	    for( register Offset j = adjHead[ targetNode ], 
 		   stop_j = adjHead[ targetNode ] + nSnodes[ targetNode ] 
 		                                  + nEnodes[ targetNode ];
 		 j < stop_j; ++j ) {
@@ -1130,7 +1276,7 @@ QuotientGraph::QuotientGraph::scanBucketSorterForSupernodes( VertexList& removeN
 	  }
 	  // Now we are ready to check the candidate node
 	  {
-	    for( register int j = adjHead[ candidateNode ], 
+	    for( register Offset j = adjHead[ candidateNode ], 
 		   stop_j = adjHead[ candidateNode ] + nSnodes[ candidateNode ] 
 		   + nEnodes[ candidateNode ];
 		 j < stop_j; ++j ) {
@@ -1167,7 +1313,7 @@ QuotientGraph::QuotientGraph::scanBucketSorterForSupernodes( VertexList& removeN
 	  // clean up the space
 	  int z = candidateNode;
 #if ( SPINDLE_QGRAPH_REPACK_AGGRESSIVE > 0 )
-	  for( int k = adjHead[ z ], stop_k = adjHead[ z ]+nEnodes[ z ]; 
+	  for( Offset k = adjHead[ z ], stop_k = adjHead[ z ]+nEnodes[ z ]; 
 	       k < stop_k; ++k ) { 
 	    adjList[ k ] = -1;
 	  }
@@ -1195,7 +1341,7 @@ void
 QuotientGraph::pruneNonPrincipalSupernodes( VertexList& updateNodes ) {
   FENTER;
  
-  register const int * const restrict adjHead = adjHead_;
+  register const Offset * const restrict adjHead = adjHead_;
   register       int * const restrict adjList = adjList_;
   register       int * const restrict nSnodes = nSnodes_;
   register const int * const restrict parent = parent_;
@@ -1205,11 +1351,11 @@ QuotientGraph::pruneNonPrincipalSupernodes( VertexList& updateNodes ) {
   // Prune non-principal supernodes from me
   //
   int me = lastEliminatedNode.back();
-  int head = adjHead[ me ];
+  Offset head = adjHead[ me ];
 
-  int dest = head;
+  Offset dest = head;
   int mySNodes = nSnodes[ me ];
-  for ( int i = head, stop_i = head + mySNodes; i<stop_i; ++i ) {
+  for ( Offset i = head, stop_i = head + mySNodes; i<stop_i; ++i ) {
     int s = adjList[i]; 
     if ( parent[s] == s ) {       // if s is principal snode
       adjList[ dest ] = s;        //  ... copy it
@@ -1224,7 +1370,7 @@ QuotientGraph::pruneNonPrincipalSupernodes( VertexList& updateNodes ) {
   
 #if ( SPINDLE_QGRAPH_REPACK_AGGRESSIVE > 0 ) 
   // mark remaining space, if any, as usable
-  for ( int i = dest, stop_i = head+mySNodes; i<stop_i; ++i ) {
+  for ( Offset i = dest, stop_i = head+mySNodes; i<stop_i; ++i ) {
     adjList[ i ] = -1;
   }
 #endif
@@ -1268,7 +1414,7 @@ void
 QuotientGraph::xferNewEnodesToEnodeListsOfReachSet() {
   FENTER;
 
-  register const int * const restrict adjHead = adjHead_;
+  register const Offset * const restrict adjHead = adjHead_;
   register 	 int * const restrict adjList = adjList_;
   register 	 int * const restrict nEnodes = nEnodes_;
   register 	 int * const restrict nSnodes = nSnodes_;
@@ -1282,10 +1428,10 @@ QuotientGraph::xferNewEnodesToEnodeListsOfReachSet() {
   // forall reachable nodes, r, requiring degree update
   for ( int r = updateList[ n ]; r < n ; r = updateList[ r ] ) {
     // forall snodes, s, in adj(r)
-    int head = adjHead[ r ];
-    int snode_begin = head + nEnodes[ r ];
-    int snode_end = snode_begin + nSnodes[ r ];
-    for ( int i = snode_begin, stop_i = snode_end; i < stop_i; ++i ) { 
+    Offset head = adjHead[ r ];
+    Offset snode_begin = head + nEnodes[ r ];
+    Offset snode_end = snode_begin + nSnodes[ r ];
+    for ( Offset i = snode_begin, stop_i = snode_end; i < stop_i; ++i ) { 
       int s = adjList[ i ]; 
       if ( nEnodes[ s ] < 0 ) { // implies s was eliminated at (n+nEnodes[s])
 	std::swap( adjList[i], adjList[ snode_begin ] ); // swap current with first snode
@@ -1307,7 +1453,7 @@ QuotientGraph::xferNewEnodesToEnodeListsOfReachSet() {
 
 void
 QuotientGraph::cleanEnodes() {
-  register const int * const restrict adjHead = adjHead_;
+  register const Offset * const restrict adjHead = adjHead_;
   register 	 int * const restrict adjList = adjList_;
   register const int * const restrict updateList = updateList_;
   register 	 int * const restrict nEnodes = nEnodes_;
@@ -1317,10 +1463,10 @@ QuotientGraph::cleanEnodes() {
 
   for ( int r = updateList[n];  r < n ; r = updateList[ r ] ) {
     // for all reachable nodes in the update list
-    const int head = adjHead[ r ];
-    int snode_begin = head + nEnodes[ r ];
-    int snode_end = snode_begin + nSnodes[ r ];
-    int cur = head;
+    const Offset head = adjHead[ r ];
+    Offset snode_begin = head + nEnodes[ r ];
+    Offset snode_end = snode_begin + nSnodes[ r ];
+    Offset cur = head;
     const int stamp = nextStamp();
     while ( cur < snode_begin ) {      // while there are enodes
       int e = adjList[ cur ];          //   get next adj enode
@@ -1349,7 +1495,7 @@ QuotientGraph::cleanEnodes() {
 }
 
 void QuotientGraph::cleanSnodes() {
-  register const int * const restrict adjHead = adjHead_;
+  register const Offset * const restrict adjHead = adjHead_;
   register 	 int * const restrict adjList = adjList_;
   register const int * const restrict updateList = updateList_;
   register const int * const restrict nEnodes = nEnodes_;
@@ -1359,10 +1505,10 @@ void QuotientGraph::cleanSnodes() {
 
   for ( int r = updateList[n];  r < n ; r = updateList[ r ] ) {
     // for all reachable nodes in the update list
-    const int head = adjHead[ r ];
-    const int snode_begin = head + nEnodes[ r ];
-    int snode_end = snode_begin + nSnodes[ r ];
-    int cur = head;
+    const Offset head = adjHead[ r ];
+    const Offset snode_begin = head + nEnodes[ r ];
+    Offset snode_end = snode_begin + nSnodes[ r ];
+    Offset cur = head;
     const int stamp = nextStamp();
 
     // first flag all the enodes of r
@@ -1378,8 +1524,8 @@ void QuotientGraph::cleanSnodes() {
       if ( parent[s] != s && parent[s]>0) {      //   if it is not principal and not outmatched
 	keepit = false;
       } else {                                   //   else if it is principal
-	int iter = adjHead[ s ];
-	const int stop = iter + nEnodes[ s ];
+	Offset iter = adjHead[ s ];
+	const Offset stop = iter + nEnodes[ s ];
 	for (;iter < stop; ++iter ) {                //     for all enodes of s
 	  if ( visited[ adjList[ iter ] ] == stamp) {//       if its flagged (ie common enode with r)
 	    keepit = false;
@@ -1438,7 +1584,7 @@ QuotientGraph::sortReachSet( int &adj1Head, int &adj2Head, int &adjNHead ) {
 void 
 QuotientGraph::stripOldEntriesFromAdjListsOfReachSet(int &adj2Head, int &adjNHead ) {
   FENTER;
-  register const int * const restrict adjHead = adjHead_;
+  register const Offset * const restrict adjHead = adjHead_;
   register 	 int * const restrict adjList = adjList_;
   register 	 int * const restrict nEnodes = nEnodes_;
   register 	 int * const restrict nSnodes = nSnodes_;
@@ -1465,11 +1611,11 @@ QuotientGraph::stripOldEntriesFromAdjListsOfReachSet(int &adj2Head, int &adjNHea
     // First strip off all the unneeded entries
     //
     const int stamp = nextStamp();          // get new timestamp;
-    const int head = adjHead[ r ];          // start of enode list
-    int snode_begin = head + nEnodes[ r ];  // start of snode list
-    int snode_end = snode_begin + nSnodes[ r ]; // end of snode list
-    const int end = snode_end;
-    register int cur = head;                      
+    const Offset head = adjHead[ r ];       // start of enode list
+    Offset snode_begin = head + nEnodes[ r ]; // start of snode list
+    Offset snode_end = snode_begin + nSnodes[ r ]; // end of snode list
+    const Offset end = snode_end;
+    register Offset cur = head;                      
     register int degree = 0;
     visited[ r ] = stamp;             // flag myself
     while( cur < snode_begin ) {      // while there are enodes
@@ -1485,7 +1631,7 @@ QuotientGraph::stripOldEntriesFromAdjListsOfReachSet(int &adj2Head, int &adjNHea
 	  visited[ e ] = stamp;       //        mark it 
 	  ++cur;                      //        advance to next item
 	  // for all snodes, z, adj to enode e....
-	  for ( register int j = adjHead[ e ] ,
+	  for ( register Offset j = adjHead[ e ] ,
 		  stop_j = adjHead[ e ] + nSnodes[ e ];
 		j < stop_j; ++j ) {
 	    const int z = adjList[ j ];
@@ -1568,7 +1714,7 @@ void
 QuotientGraph::compressAndOutmatchReachSet( int adj2Head, VertexList &removeNodes ) {
   FENTER;
   
-  register 	 int * const restrict adjHead = adjHead_;
+  register 	 Offset * const restrict adjHead = adjHead_;
   register 	 int * const restrict adjList = adjList_;
   register 	 int * const restrict nEnodes = nEnodes_;
   register 	 int * const restrict nSnodes = nSnodes_;
@@ -1590,12 +1736,12 @@ QuotientGraph::compressAndOutmatchReachSet( int adj2Head, VertexList &removeNode
     if ( parent[ s ] != s ) {               // if this snode has already been compressed
       continue;                             // go to next snode
     }
-    int head = adjHead[ s ];                // start of enode list
-    int snode_begin = head + nEnodes[ s ];  // start of snode list
+    Offset head = adjHead[ s ];             // start of enode list
+    Offset snode_begin = head + nEnodes[ s ]; // start of snode list
     bool marked_one_enode = false;
     
     // for all enodes, e, adjacent to snode s
-    for ( int i = head, stop_i = snode_begin; i < stop_i; ++i ) { 
+    for ( Offset i = head, stop_i = snode_begin; i < stop_i; ++i ) { 
       int stamp; // used later
       int e = adjList[ i ];
       if ( e == s ) {          // if skip self edges
@@ -1605,7 +1751,7 @@ QuotientGraph::compressAndOutmatchReachSet( int adj2Head, VertexList &removeNode
 	stamp = nextStamp();
 	
 	// for all snodes, z,  adjacent to enode, e
-	for ( int j = adjHead[ e ] , stop_j = adjHead[ e ] + nSnodes[ e ];
+	for ( Offset j = adjHead[ e ] , stop_j = adjHead[ e ] + nSnodes[ e ];
 	      j < stop_j; ++j ) { 
 	  int z = adjList[ j ];
 	  visited[ z ] = stamp;
@@ -1613,7 +1759,7 @@ QuotientGraph::compressAndOutmatchReachSet( int adj2Head, VertexList &removeNode
 	marked_one_enode = true;                 // now we have marked our first enode
       } else if ( marked_one_enode == true ) {   // if we are on our second enode...
 	// for all snodes, z,  adjacent to enode, e
-	for ( int j = adjHead[ e ] , stop_j = adjHead[ e ] + nSnodes[ e ];
+	for ( Offset j = adjHead[ e ] , stop_j = adjHead[ e ] + nSnodes[ e ];
 	      j < stop_j; ++j ) { 
 	  int z = adjList[ j ];
 	  if ( z != s && visited[z] == stamp ) {  
@@ -1642,7 +1788,7 @@ QuotientGraph::compressAndOutmatchReachSet( int adj2Head, VertexList &removeNode
 	      prev[ z ] = prev_s;
 #if ( SPINDLE_QGRAPH_REPACK_AGGRESSIVE >  0 )
 	      // finally clean up the space
-	      for( int k = adjHead[ z ], stop_k = adjHead[ z ]+nEnodes[ z ]; 
+	      for( Offset k = adjHead[ z ], stop_k = adjHead[ z ]+nEnodes[ z ]; 
 		   k < stop_k; ++k ) { 
 		adjList[ k ] = -1;
 	      }
@@ -1676,7 +1822,7 @@ QuotientGraph::resetReachSet( int adj1Head, int adj2Head, int adjNHead, VertexLi
 
   register const int * const restrict parent = parent_;
   register 	 int * const restrict updateList = updateList_;
-  register const int * const restrict adjHead = adjHead_;
+  register const Offset * const restrict adjHead = adjHead_;
   register const int * const restrict adjList = adjList_;
   register const int * const restrict weight = weight_;
   register const int * const restrict nEnodes = nEnodes_;
@@ -1698,8 +1844,8 @@ QuotientGraph::resetReachSet( int adj1Head, int adj2Head, int adjNHead, VertexLi
       degree = weight[ adjList[ adjHead[ r ] + 1 ] ];
       degree -= weight[ r ];
       // NOTE: iterate over snodes
-      int cur = adjHead[ r ] + nEnodes[ r ];
-      const int stop = cur + nSnodes[ r ];
+      Offset cur = adjHead[ r ] + nEnodes[ r ];
+      const Offset stop = cur + nSnodes[ r ];
       for( ; cur != stop; ++cur ) { 
 	degree += weight[ adjList[ cur ] ];
       }
@@ -1728,8 +1874,8 @@ QuotientGraph::resetReachSet( int adj1Head, int adj2Head, int adjNHead, VertexLi
       // now flag all snodes adj to enode1
       {
 	// NOTE: iterating over enodes (nEnodes[] is not useful here!)
-	int cur = adjHead[ enode1 ];
-	const int stop = cur + nSnodes[ enode1 ];
+	Offset cur = adjHead[ enode1 ];
+	const Offset stop = cur + nSnodes[ enode1 ];
 	for( ; cur != stop; ++cur ) { 
 	  visited[ adjList[ cur ] ] = stamp;
 	}
@@ -1737,8 +1883,8 @@ QuotientGraph::resetReachSet( int adj1Head, int adj2Head, int adjNHead, VertexLi
       // now if any snode of enode2 is flagged, subtract its weight 
       { 
 	// NOTE: iterating over enodes (nEnodes is not useful here!)
-	int cur = adjHead[ enode2 ];
-	const int stop = cur + nSnodes[ enode2 ];
+	Offset cur = adjHead[ enode2 ];
+	const Offset stop = cur + nSnodes[ enode2 ];
 	for( ; cur != stop; ++cur ) { 
 	  if ( visited[ adjList[ cur ] ] == stamp ) { 
 	    degree -= weight[ adjList[ cur ] ];
@@ -1753,18 +1899,22 @@ QuotientGraph::resetReachSet( int adj1Head, int adj2Head, int adjNHead, VertexLi
   }
 
   // FINALLY DO ALL THE OTHERS
+  // NOTE: these need a full degree computation, so they are
+  //       collected first and then handed to the threadTeam.
+  resetReachSetTimer[2].start();
+  degreeList.resize( 0 );
   r = adjNHead;
   while( r < n ) { 
-    resetReachSetTimer[2].start();
     int temp = updateList[ r ];
     updateList[ r ] = -1;
     if ( parent[ r ] == r ) {
-      updateNodes.push_back(r);
-      externDeg[ r ] = deg(r); // - weight[ r ]; //deg() is really external degree
+      degreeList.push_back( r );
     }
     r = temp;
-    resetReachSetTimer[2].stop();
   }    
+  threadTeam.run( computeDegreeTask, (void *) this, degreeList.size() );
+  updateNodes.insert( updateNodes.end(), degreeList.begin(), degreeList.end() );
+  resetReachSetTimer[2].stop();
   updateList[ n ] = n;
   lastEliminatedNode.resize(0);
   FEXIT;
@@ -1888,11 +2038,11 @@ QuotientGraph::printTinyGraph( ostream& outstr ) const {
   cout << "}" << endl;
 }
 
-int 
+QuotientGraph::Offset 
 QuotientGraph::defragAdjList() { 
   FENTER;
 
-  register       int * const restrict adjHead = adjHead_;
+  register       Offset * const restrict adjHead = adjHead_;
   register       int * const restrict adjList = adjList_;
   register const int * const restrict parent = parent_;
   register const int * const restrict nSnodes = nSnodes_;
@@ -1904,22 +2054,22 @@ QuotientGraph::defragAdjList() {
   // we must repack the data, but the heads of the lists
   // are not stored monotonically, so we must repack the data
   // in its current order to avoid overwriting data
-  typedef vector< pair< int, int> > SorterType;
+  typedef vector< pair< Offset, int> > SorterType;
   static SorterType vecSorter; // static data in a function... its constructed once 
   vecSorter.reserve(n); // reserve memory for at least n
   vecSorter.resize(0);  // reset to zero
 
   {for ( int i=0; i<n; ++i ) { // for all vertices and cliques...
     if ( parent[i]==i || parent[i]<0 ) { // if its principal snode, enode, or outmatched
-      vecSorter.push_back( pair< int , int >( adjHead[i], i ) );
+      vecSorter.push_back( pair< Offset, int >( adjHead[i], i ) );
       // insert the list_head and index into vecSorter
     }
   }}
   // now sort the pairs.
-  sort( vecSorter.begin(), vecSorter.end(), pair_first_less<int,int>() );
+  sort( vecSorter.begin(), vecSorter.end(), pair_first_less<Offset,int>() );
 
-  int src = 0;  // where to copy _from_ in adjList array 
-  int dest = 0; // where to copy _to_ in adjList array
+  Offset src = 0;  // where to copy _from_ in adjList array 
+  Offset dest = 0; // where to copy _to_ in adjList array
   for (SorterType::iterator cur=vecSorter.begin(), stop = vecSorter.end(); 
        cur != stop; ++ cur ) {
     // for all items in the vecSorter  ( which are all principal items )
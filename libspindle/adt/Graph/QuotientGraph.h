@@ -50,6 +50,10 @@ using namespace std;
 #include "spindle/Graph.h"
 #endif
 
+#ifndef SPINDLE_THREAD_TEAM_H_
+#include "spindle/ThreadTeam.h"
+#endif
+
 #ifndef LARGEINT
 #  ifdef MAXINT
 #    define LARGEINT MAXINT
@@ -65,6 +69,15 @@ class QuotientGraph {
 public:
   typedef ArrayBucketSorter BucketSorter;
   typedef vector<int> VertexList;
+  // A position in adjList_.  It holds nnz + n entries plus elbow room,
+  // which passes 2^31 long before the Graph does, so configuring with
+  // --enable-large-graphs (SPINDLE_LARGE_GRAPHS) makes it a long.
+  // Vertex numbers, weights and degrees stay int either way.
+#ifdef SPINDLE_LARGE_GRAPHS
+  typedef long Offset;
+#else
+  typedef int Offset;
+#endif
 
 private:
   int lastENode;
@@ -72,9 +85,13 @@ private:
   int n;              // the size of the symmetric matrix
   int maxint;         // the largest positive integer
   int * adjList_;     // the adjacency list of enodes and snodes (should be at least nnz + n )
-  int freeSpace;      // the first index into adjList that is unused.
-  int maxSpace;       // the total size of adjList;
-  int * adjHead_;     // index into adjList.
+  Offset freeSpace;   // the first index into adjList that is unused.
+  Offset maxSpace;    // the total size of adjList;
+  Offset adjListCapacity; // the allocated size of adjList, at least maxSpace
+  int nCapacity;      // the allocated length of the arrays below, at least n
+  bool hasGraph;      // false if the last setGraph() failed
+  double offsetLimit; // the largest position setGraph() accepts
+  Offset * adjHead_;  // index into adjList.
   // NOTES:
   // adjHead[] < 0 implies that the node was compressed.
   // parent[] array should be used to advance to the principal node
@@ -131,11 +148,24 @@ private:
 
   BucketSorter * sorter;
 
-  void initialize( const int nVertices, const int *AdjHead, const int *AdjList, 
+  // The external degrees of the general reach set are recomputed
+  // concurrently by threadTeam in resetReachSet().  Thread 0 uses
+  // visited_ and nextStamp(), thread t>0 uses the t-1st slice of 
+  // threadVisited and its own stamp in threadStamp.
+  ThreadTeam threadTeam;
+  VertexList degreeList;       // principal snodes awaiting a new degree
+  vector<int> threadVisited;   // (nThreads-1) * n timestamps
+  vector<int> threadStamp;     // last stamp used by threads 1..nThreads-1
+  static void computeDegreeTask( void * qgraph, const int begin, const int end, 
+				 const int threadID );
+  int deg( const int i, int * visited, int& stamp ) const;
+
+  bool initialize( const int nVertices, const int *AdjHead, const int *AdjList, 
 		   const int *vwgt );
+  void freeArrays();
 
   // This is a possible subroutine of eliminateSupernode()
-  int defragAdjList();
+  Offset defragAdjList();
 
   // The following are subroutines of update for single elimination
   void computeSetDiffs( const int stamp );
@@ -160,6 +190,14 @@ public:
   //  QuotientGraph( const int nVertices, const int *AdjHead, const int *AdjList );
 
   ~QuotientGraph();
+
+  // starts over with another graph.  The arrays of the previous one
+  // are kept and reused when they are long enough.  Returns false
+  // if the graph is not valid or needs more work space than an
+  // Offset can address.
+  bool setGraph( const Graph* graph );
+  // true iff the last setGraph(), or the constructor, succeeded
+  bool isValid() const { return hasGraph; }
   /*  
   int queryNEliminatedNbrs(int i) { return (i==0)? 1 : i ; } // HACK
   void reset() { }
@@ -238,6 +276,11 @@ public:
   // void printLongGraph( ostream& outstr = cout );
   
 protected:
+  // lowers the largest offset the next setGraph() accepts, so that a
+  // subclass in a test can trip the overflow check with a small graph.
+  // 0 (or anything above what an Offset holds) restores the default.
+  void setOffsetLimit( const double limit );
+
   // used for timestamping mechanism
 #ifndef mutable
   // mutable is a recognized keyword
@@ -292,6 +335,43 @@ public:
   const int* snode_end( const int i ) const ;
   int deg( const int i ) const ;
 
+  // Unchecked, packed view of the adjacency of one node.  Holds
+  // the enode and snode ranges together with the weight and external
+  // degree, so a hot loop reads the per-node arrays once instead of
+  // repeating the range and sign tests of enode_begin(), snode_end(), etc.
+  // NOTE: the node must be a principal, uneliminated snode (adjHead[i]>=0
+  //       and nEnodes[i]>=0).  No checks are made.  For the snodes of an
+  //       eliminated enode use clique_begin() and clique_end().
+  class NodeView { 
+  public:
+    const int * enodes;    // first adjacent enode
+    const int * snodes;    // first adjacent snode (also end of enodes)
+    const int * snodesEnd; // one past the last adjacent snode
+    int weight;            // weight of the node
+    int externDeg;         // external degree
+
+    const int* enode_begin() const { return enodes; }
+    const int* enode_end() const { return snodes; }
+    const int* snode_begin() const { return snodes; }
+    const int* snode_end() const { return snodesEnd; }
+    int nEnodes() const { return snodes - enodes; }
+    int nSnodes() const { return snodesEnd - snodes; }
+  };
+  NodeView lendNodeView( const int i ) const ;
+
+  // Unchecked range of the snodes adjacent to an eliminated enode, its
+  // clique.  NOTE: e must be a principal enode (adjHead[e]>=0 and
+  // nEnodes[e]<0).  No checks are made.
+  const int* clique_begin( const int e ) const { return adjList_ + adjHead_[e]; }
+  const int* clique_end( const int e ) const { return adjList_ + adjHead_[e] + nSnodes_[e]; }
+
+  // Use up to nThreads threads for the degree recomputation in update().
+  // The result is identical for any number of threads.  Requires 
+  // (nThreads-1)*n ints of extra scratch space.  Returns false if
+  // nThreads<1.  (see ThreadTeam)
+  bool setNThreads( const int nThreads );
+  int queryNThreads() const { return threadTeam.queryNThreads(); }
+
   const int queryNCompressedNodes() const { return nCompressedNodes; }
   const int queryNOutmatchedNodes() const { return nOutmatchedNodes; }
   const int queryNDefrags() const { return nDefrags; }
@@ -357,6 +437,16 @@ QuotientGraph::snode_end( const int i ) const {
   }
 }
 
+inline QuotientGraph::NodeView
+QuotientGraph::lendNodeView( const int i ) const {
+  NodeView view;
+  view.enodes = adjList_ + adjHead_[i];
+  view.snodes = view.enodes + nEnodes_[i];
+  view.snodesEnd = view.snodes + nSnodes_[i];
+  view.weight = weight_[i];
+  view.externDeg = externDeg_[i];
+  return view;
+}
 
 inline int 
 QuotientGraph::eliminatedAt( const int vtx ) const {
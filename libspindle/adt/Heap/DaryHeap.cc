@@ -0,0 +1,228 @@
+//
+// DaryHeap.cc -- a 4-ary max heap with separate key and item arrays
+//
+//  $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+
+#include "spindle/DaryHeap.h"
+
+#ifdef REQUIRE_OLD_CXX_HEADER_SUFFIX
+#include <algo.h>
+#else
+#include <algorithm>
+using namespace std;
+#endif
+
+/*
+ * Unlike BinaryHeap, this heap is stored from 0..(n-1).
+ * The children of node A are FIRST_CHILD(A) .. FIRST_CHILD(A)+D-1.
+ */
+
+#define PARENT(A)       (((A)-1)/D)
+#define FIRST_CHILD(A)  ((A)*D+1)
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+DaryHeap::DaryHeap( const int maxSize_, const int maxItem_ )
+  : maxSize( 0 ), maxItem( 0 ), key( 0 ), item( 0 ), pos( 0 ), nItems( 0 ) {
+  resize( maxSize_, maxItem_ );
+}
+
+DaryHeap::DaryHeap( const int maxSize_, const int maxItem_, const int values[], const int nValues )
+  : maxSize( 0 ), maxItem( 0 ), key( 0 ), item( 0 ), pos( 0 ), nItems( 0 ) {
+  resize( maxSize_, maxItem_ );
+  nItems = nValues;
+  {for( int i=0; i<nItems; ++i ) {
+    key[i] = values[i];
+    item[i] = i;
+    pos[i] = i;
+  }}
+  {for( int i=PARENT(nItems-1); i>=0; --i ) {
+    siftDown( i );
+  }}
+}
+
+bool
+DaryHeap::resize( const int maxSize_, const int maxItem_ ) {
+  if ( ( maxSize_ < 0 ) || ( maxItem_ < 0 ) ) { return false; }
+  maxSize = maxSize_;
+  maxItem = maxItem_;
+  // keep the arrays non-empty so the cached pointers are never null
+  keyArray.resize( maxSize + 1 );
+  itemArray.resize( maxSize + 1 );
+  map.resize( maxItem + 1 );
+  map.init( -1 );
+  key = keyArray.begin();
+  item = itemArray.begin();
+  pos = map.begin();
+  nItems = 0;
+  return true;
+}
+
+void
+DaryHeap::siftUp( int i, const Key k, const Item it ) {
+  // move smaller ancestors down until the hole at i fits k
+  while ( i > 0 ) {
+    const int parent = PARENT(i);
+    if ( key[parent] >= k ) { break; }
+    key[i] = key[parent];
+    item[i] = item[parent];
+    pos[ item[i] ] = i;
+    i = parent;
+  }
+  key[i] = k;
+  item[i] = it;
+  pos[it] = i;
+}
+
+void
+DaryHeap::siftDown( int i ) {
+  const Key k = key[i];
+  const Item it = item[i];
+  for(;;) {
+    const int first = FIRST_CHILD(i);
+    if ( first >= nItems ) { break; }
+    int largest = first;
+    if ( first + D <= nItems ) {
+      // all four children exist: compare them pairwise
+      const int a = ( key[first+1] > key[first] ) ? first+1 : first;
+      const int b = ( key[first+3] > key[first+2] ) ? first+3 : first+2;
+      largest = ( key[b] > key[a] ) ? b : a;
+    } else {
+      {for( int c=first+1; c<nItems; ++c ) {
+	largest = ( key[c] > key[largest] ) ? c : largest;
+      }}
+    }
+    if ( key[largest] <= k ) { break; }
+    key[i] = key[largest];
+    item[i] = item[largest];
+    pos[ item[i] ] = i;
+    i = largest;
+  }
+  key[i] = k;
+  item[i] = it;
+  pos[it] = i;
+}
+
+int
+DaryHeap::extractMax() {
+  if ( nItems == 0 ) { return -1; }
+  const int max = item[0];
+  pos[max] = -1;
+  --nItems;
+  if ( nItems > 0 ) {
+    key[0] = key[nItems];
+    item[0] = item[nItems];
+    siftDown( 0 );
+  }
+  return max;
+}
+
+int
+DaryHeap::insert( const int Key, const int Item ) {
+  if ( ( Item < 0 ) || ( Item >= maxItem ) ) { return -1; }
+  if ( nItems == maxSize ) { return -1; }
+  if ( pos[Item] >= 0 ) { return -1; }
+  siftUp( nItems++, Key, Item );
+  return 0;
+}
+
+int
+DaryHeap::incrementPriority( const int addToKey, const int Item ) {
+  if ( addToKey < 0 ) {
+    return decrementPriority( -addToKey, Item );
+  }
+  if ( ( Item < 0 ) || ( Item >= maxItem ) ) { return -1; }
+  const int i = pos[Item];
+  if ( i < 0 ) { return -1; }
+  siftUp( i, key[i] + addToKey, Item );
+  return 0;
+}
+
+int
+DaryHeap::decrementPriority( const int subtractFromKey, const int Item ) {
+  if ( subtractFromKey < 0 ) {
+    return incrementPriority( -subtractFromKey, Item );
+  }
+  if ( ( Item < 0 ) || ( Item >= maxItem ) ) { return -1; }
+  const int i = pos[Item];
+  if ( i < 0 ) { return -1; }
+  key[i] -= subtractFromKey;
+  siftDown( i );
+  return 0;
+}
+
+int
+DaryHeap::incrementPriorities( const int items[], const int addToKeys[], const int n ) {
+  int result = 0;
+  if ( n <= 0 ) { return result; }
+  if ( batchArray.size() < n ) {
+    batchArray.resize( n );
+  }
+  int * batch = batchArray.begin();
+  int nBatch = 0;
+
+  // 1. decreases can move other items down, so do them before anything else
+  {for( int i=0; i<n; ++i ) {
+    if ( addToKeys[i] < 0 ) {
+      if ( decrementPriority( -addToKeys[i], items[i] ) != 0 ) { result = -1; }
+    }
+  }}
+
+  // 2. apply all increases without moving anything
+  {for( int i=0; i<n; ++i ) {
+    if ( addToKeys[i] < 0 ) { continue; }
+    const int it = items[i];
+    if ( ( it < 0 ) || ( it >= maxItem ) || ( pos[it] < 0 ) ) { result = -1; continue; }
+    if ( addToKeys[i] == 0 ) { continue; }
+    key[ pos[it] ] += addToKeys[i];
+    batch[ nBatch++ ] = pos[it];
+  }}
+
+  // 3. sift up from the top down.  A sift only touches ancestors of its
+  //    start, which are never waiting to be processed, so the recorded
+  //    positions stay valid and each sift sees a proper heap above it.
+  sort( batch, batch + nBatch );
+  nBatch = unique( batch, batch + nBatch ) - batch;
+  {for( int i=0; i<nBatch; ++i ) {
+    const int p = batch[i];
+    siftUp( p, key[p], item[p] );
+  }}
+  return result;
+}
+
+void
+DaryHeap::print( FILE* stream ) const {
+  fprintf( stream, "Heap.size = %d\n", size() );
+  if ( nItems > 0 ) {
+    printSubTree( stream, 0, 0 );
+  }
+}
+
+void
+DaryHeap::printSubTree( FILE* stream, const int root, const int depth ) const {
+  // children are printed around their parent, as in BinaryHeap::print()
+  const int first = FIRST_CHILD(root);
+  {for( int c=first; ( c < first + D/2 ) && ( c < nItems ); ++c ) {
+    printSubTree( stream, c, depth+1 );
+  }}
+  fprintf( stream, "%*s<%d, %d>\n", depth*5, "", key[root], item[root] );
+  {for( int c=first + D/2; ( c < first + D ) && ( c < nItems ); ++c ) {
+    printSubTree( stream, c, depth+1 );
+  }}
+}
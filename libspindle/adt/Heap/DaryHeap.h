@@ -0,0 +1,132 @@
+//
+// DaryHeap.h -- a 4-ary max heap with separate key and item arrays
+//
+//  $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+// This heap has the same interface as BinaryHeap, but every node has
+// four children.  The tree is half as deep, and the four children of a
+// node are adjacent in a plain int array of keys, so choosing the
+// largest one touches a single cache line and compiles to branch free
+// code.  Items live in a parallel array and are only moved once the
+// destination of a sift is known.
+//
+// incrementPriorities() applies a whole set of priority changes (e.g.
+// all neighbors of a vertex just numbered by Sloan) before restoring
+// heap order once.
+//
+
+#ifndef SPINDLE_DARY_HEAP_H_
+#define SPINDLE_DARY_HEAP_H_
+
+#ifndef SPINDLE_H_
+#include "spindle/spindle.h"
+#endif
+
+#ifndef SPINDLE_AUTO_ARRAY_H_
+#include "spindle/SharedArray.h"
+#endif
+
+#ifdef REQUIRE_OLD_CXX_HEADER_SUFFIX
+#include <stdio.h>
+#else
+#include <cstdio>
+using namespace std;
+#endif
+
+SPINDLE_BEGIN_NAMESPACE
+
+/**
+ * @memo max heap of items 0..maxItem-1 with four children per node
+ * @type class
+ *
+ * A drop in replacement for #BinaryHeap#.  Every item can be in the heap
+ * at most once, and its position is kept in a map so that its priority
+ * can be changed in O(log n).  Methods that can fail return 0 on
+ * success and -1 otherwise.
+ *
+ * @see BinaryHeap
+ * @author agent
+ */
+class DaryHeap {
+public:
+  typedef int Item;
+  typedef int Key;
+  enum { D = 4 };      // number of children per node
+
+private:
+  int  maxSize;
+  Item maxItem;
+
+  SharedArray<int> keyArray;      // keyArray[0] is the root
+  SharedArray<int> itemArray;
+  SharedArray<int> map;           // position of each item, -1 if absent
+  SharedArray<int> batchArray;    // scratch for incrementPriorities()
+
+  int * key;                      // cached pointers into the arrays above
+  int * item;
+  int * pos;
+
+  int nItems;
+
+  void siftUp( int i, const Key k, const Item it );
+  void siftDown( int i );
+  void printSubTree( FILE* stream, const int root, const int depth ) const;
+
+public:
+  /** constructor, at most #maxSize_# items numbered 0..#maxItem_#-1 */
+  DaryHeap( const int maxSize_, const int maxItem_ );
+  /** constructor, items 0..nvals-1 with the given keys */
+  DaryHeap( const int maxSize_, const int maxItem_, const int values[], const int nvals );
+  ~DaryHeap() {}
+
+  /** change the capacity, empties the heap */
+  bool resize( const int maxSize_, const int maxItem_ );
+  /** remove the item of largest key, -1 if empty */
+  int extractMax();
+  int insert( const int Key, const int Item );
+  int incrementPriority( const int addToKey, const int Item );
+  int decrementPriority( const int subtractFromKey, const int Item );
+  /**
+   * add #addToKeys[i]# to the key of #items[i]# for all #0<=i<n#.
+   * Items may repeat.  Decreases are applied first, one at a time;
+   * the increases are then applied together and sifted up in order of
+   * heap position, which visits each path to the root at most once.
+   * Items not in the heap are skipped and make the call return -1.
+   */
+  int incrementPriorities( const int items[], const int addToKeys[], const int n );
+  /** true if #Item# is currently in the heap */
+  bool isInserted( const int Item ) const;
+  void print( FILE* stream=stdout ) const;
+  const int size() const { return nItems; }
+  bool peekMax( int &Key, int &Item ) const;
+};
+
+inline bool
+DaryHeap::isInserted( const int Item ) const {
+  return ( Item >= 0 ) && ( Item < maxItem ) && ( pos[ Item ] >= 0 );
+}
+
+inline bool
+DaryHeap::peekMax( int &Key, int &Item ) const {
+  if ( nItems == 0 ) { return false; }
+  Key = key[0];
+  Item = item[0];
+  return true;
+}
+
+SPINDLE_END_NAMESPACE
+
+#endif
@@ -213,7 +213,7 @@ Matrix::validate(){
   // 2. now deterimine nRows, nCols;
   nCols = colPtr.size() - 1;
   nRows = 0;
-  {for( const int * cur = rowIdx.begin(), *stop = rowIdx.end(); cur != stop; ++cur ){ 
+  {for( const int * cur = rowIdx.lend(), *stop = cur + rowIdx.size(); cur != stop; ++cur ){ 
     nRows = ( *cur > nRows ) ? *cur : nRows; 
   }}
   ++nRows;
@@ -29,6 +29,12 @@
 #include "spindle/PermutationMap.h"
 #endif
 
+#ifndef SPINDLE_MAPPED_FILE_H_
+#include "spindle/MappedFile.h"
+#endif
+
+#include <limits.h>
+
 #ifdef REQUIRE_OLD_CXX_HEADER_SUFFIX
 #include "pair.h"
 #include "vector.h"
@@ -45,6 +51,146 @@
 using namespace SPINDLE_NAMESPACE;
 #endif
 
+//
+// the vertex lines of a Chaco file are cut into pieces that are
+// handled concurrently: first the numbers on each line are counted,
+// then the lines are parsed straight into the adjacency arrays.
+//
+struct ChacoFile_piece {
+  const char * begin;
+  const char * end;
+  vector< int > nNumbers;  // numbers on each vertex line
+  int firstVtx;            // vertex of the first line
+  int nLines;              // vertex lines to parse, the rest are extra
+  const char * badLine;    // 0 if none
+};
+
+struct ChacoFile_parse {
+  vector< ChacoFile_piece > pieces;
+  int nVtxs;
+  bool readVtxNumbers;
+  bool readVtxWeights;
+  bool readEdgeWeights;
+  const int * adjHead;
+  int * adjList;
+  int * edgeWeight;   // 0 unless readEdgeWeights
+  int * vtxWeight;    // 0 unless readVtxWeights
+  int * old2new;      // 0 unless readVtxNumbers
+};
+
+static void
+ChacoFile_countTask( void * arg, const int begin, const int end, const int ) {
+  ChacoFile_parse& parse = *(ChacoFile_parse *) arg;
+  for( int k=begin; k<end; ++k ) { 
+    ChacoFile_piece& piece = parse.pieces[k];
+    const char * p = piece.begin;
+    const char * last = piece.end;
+    while ( p < last ) { 
+      if ( *p == '%' ) { // comment
+	p = MappedFile::skipLine( p, last );
+	continue;
+      }
+      int n = 0;
+      while ( ( p < last ) && ( *p != '\n' ) ) { 
+	p = MappedFile::skipBlanks( p, last );
+	if ( ( p == last ) || ( *p == '\n' ) ) { 
+	  break;
+	}
+	++n;
+	while ( ( p < last ) && ( *p != ' ' ) && ( *p != '\t' ) && 
+		( *p != '\r' ) && ( *p != '\n' ) ) { 
+	  ++p;
+	}
+      }
+      piece.nNumbers.push_back( n );
+      p = MappedFile::skipLine( p, last );
+    }
+  }
+}
+
+// the next number on the line, which must be followed by a blank
+static inline const char *
+ChacoFile_nextInt( const char * p, const char * end, int& value ) { 
+  p = MappedFile::scanInt( MappedFile::skipBlanks( p, end ), end, value );
+  if ( ( p != 0 ) && ( p < end ) && ( *p != ' ' ) && ( *p != '\t' ) &&
+       ( *p != '\r' ) && ( *p != '\n' ) ) { 
+    return 0;
+  }
+  return p;
+}
+
+static void
+ChacoFile_parseTask( void * arg, const int begin, const int end, const int ) {
+  ChacoFile_parse& parse = *(ChacoFile_parse *) arg;
+  for( int k=begin; k<end; ++k ) { 
+    ChacoFile_piece& piece = parse.pieces[k];
+    const char * p = piece.begin;
+    const char * last = piece.end;
+    for( int vtx=piece.firstVtx; vtx<piece.firstVtx+piece.nLines; ++vtx ) { 
+      while ( ( p < last ) && ( *p == '%' ) ) { // comment
+	p = MappedFile::skipLine( p, last );
+      }
+      const char * line = p;
+      int value;
+      if ( parse.readVtxNumbers ) { 
+	p = ChacoFile_nextInt( p, last, value );
+	if ( ( p == 0 ) || ( value < 1 ) || ( value > parse.nVtxs ) ) { 
+	  piece.badLine = line;
+	  return;
+	}
+	parse.old2new[ vtx ] = value - 1;
+      }
+      if ( parse.readVtxWeights ) { 
+	p = ChacoFile_nextInt( p, last, value );
+	if ( p == 0 ) { 
+	  piece.badLine = line;
+	  return;
+	}
+	parse.vtxWeight[ vtx ] = value;
+      }
+      // check the order as we go, and sort only if we must
+      bool isSorted = true;
+      int prev = -1;
+      for( int j=parse.adjHead[ vtx ]; j<parse.adjHead[ vtx+1 ]; ++j ) { 
+	p = ChacoFile_nextInt( p, last, value );
+	if ( ( p == 0 ) || ( value < 1 ) || ( value > parse.nVtxs ) ) { 
+	  piece.badLine = line;
+	  return;
+	}
+	parse.adjList[ j ] = value - 1;
+	isSorted = isSorted && ( prev <= value - 1 );
+	prev = value - 1;
+	if ( parse.readEdgeWeights ) { 
+	  p = ChacoFile_nextInt( p, last, parse.edgeWeight[ j ] );
+	  if ( p == 0 ) { 
+	    piece.badLine = line;
+	    return;
+	  }
+	}
+      }
+      if ( !isSorted ) { 
+	int * adj = parse.adjList + parse.adjHead[ vtx ];
+	const int degree = parse.adjHead[ vtx+1 ] - parse.adjHead[ vtx ];
+	if ( parse.readEdgeWeights ) { 
+	  int * weight = parse.edgeWeight + parse.adjHead[ vtx ];
+	  vector< pair< int, int > > pairList( degree );
+	  {for( int j=0; j<degree; ++j ) { 
+	    pairList[j] = pair< int, int >( adj[j], weight[j] );
+	  }}
+	  sort( pairList.begin(), pairList.end(), pair_first_less<int,int>() );
+	  {for( int j=0; j<degree; ++j ) { 
+	    adj[j] = pairList[j].first;
+	    weight[j] = pairList[j].second;
+	  }}
+	} else { 
+	  sort( adj, adj + degree );
+	}
+      }
+      p = MappedFile::skipLine( p, last );
+    }
+  }
+}
+
 bool 
 ChacoFile::read( FILE * stream ) {  
   // Quit if file pointer isn't valid 
@@ -53,188 +199,220 @@ ChacoFile::read( FILE * stream ) {
     return 0;
   }
 
-  const int bufferSz = 128*1024;
-  char buffer[ bufferSz ];
-  char * info = buffer;
+  MappedFile file;
+  if ( !file.map( stream ) ) { 
+    cerr << "Cannot read file." << endl;
+    return 0;
+  }
+  const char * p = file.begin();
+  const char * end = file.end();
 
   // skip over commented lines
-  do {
-    info = fgets(buffer, bufferSz,stream);
-  } while ( (info != NULL) && ( info[0] == '%') );
-
-  char *token;    // pointer to current token
-  if ( (info != NULL) && (token = strtok(info," \t")) ) {
-    nVtxs = atoi( token );
+  while ( ( p < end ) && ( *p == '%' ) ) { 
+    p = MappedFile::skipLine( p, end );
   }
 
-  if ( (token = strtok(0," \t")) ) {
-    nEdges = atoi( token );
-    nNonZeros = 2*nEdges;
+  // header: number of vertices and edges, and the optional format code
+  int code = 0;
+  p = MappedFile::scanInt( MappedFile::skipBlanks( p, end ), end, nVtxs );
+  if ( p != 0 ) { 
+    p = MappedFile::scanInt( MappedFile::skipBlanks( p, end ), end, nEdges );
   }
-  nBoundVtxs = 0; // no boundary vertices in Chaco files
-  
-  bool read_edgeWeights; // read edge weights?
-  bool read_vtxWeights; // read vertex weights?
-  bool read_vtxNumbers;
-  if ( (token = strtok(0," \t")) ) {
-    int temp = atoi(token);
-    read_vtxWeights = ((temp/10) == 1);
-    read_edgeWeights = (((temp%10)/10) == 1);
-    read_vtxNumbers = (((temp%100)/10) == 1);
-  } else {
-    read_vtxWeights = false;
-    read_edgeWeights = false;
-    read_vtxNumbers = false;
+  if ( ( p == 0 ) || ( nVtxs < 0 ) || ( nEdges < 0 ) ) { 
+    cerr << "Cannot read number of vertices and edges." << endl;
+    return 0;
   }
-
-  PermutationMap vtxPermutationMap(nVtxs);
-  int *old2new = 0;
-  vector< pair<int,int> > pairList( nNonZeros );
-  adjHead.resize( nVtxs + 1 );
-  adjList.resize( nNonZeros );
-  if ( read_vtxWeights ) {
-    vtxWeight.resize( nVtxs );
+  {
+    const char * q = MappedFile::scanInt( MappedFile::skipBlanks( p, end ), end, code );
+    if ( q != 0 ) { 
+      p = q;
+    } else { 
+      code = 0;
+    }
   }
-  if ( read_edgeWeights ) {
-    edgeWeight.resize( nNonZeros );
-    // pairList.reserve( nNonZeros );
+  if ( ( code < 0 ) || ( code > 111 ) || ( ( code % 10 ) > 1 ) || ( ( code / 10 ) % 10 > 1 ) ) { 
+    cerr << "Unknown format code " << code << "." << endl;
+    return 0;
   }
-  if ( read_vtxNumbers ) {
-    old2new = vtxPermutationMap.getOld2New().give();
+  p = MappedFile::skipLine( p, end );
+  nBoundVtxs = 0; // no boundary vertices in Chaco files
+
+  ChacoFile_parse parse;
+  parse.nVtxs = nVtxs;
+  parse.readEdgeWeights = ( ( code % 10 ) == 1 );
+  parse.readVtxWeights = ( ( ( code / 10 ) % 10 ) == 1 );
+  parse.readVtxNumbers = ( ( code / 100 ) == 1 );
+  const int nLeading = ( parse.readVtxNumbers ? 1 : 0 ) + ( parse.readVtxWeights ? 1 : 0 );
+  const int nPerEdge = ( parse.readEdgeWeights ? 2 : 1 );
+
+  // count the numbers on each line
+  {
+    const int nPieces = team.queryNThreads();
+    vector< const char * > bounds;
+    MappedFile::splitAtLines( p, end, nPieces, bounds );
+    parse.pieces.resize( nPieces );
+    for( int k=0; k<nPieces; ++k ) { 
+      parse.pieces[k].begin = bounds[k];
+      parse.pieces[k].end = bounds[k+1];
+      parse.pieces[k].badLine = 0;
+    }
   }
+  team.run( ChacoFile_countTask, &parse, parse.pieces.size() );
 
-  int curIdx = 0;
-  {for (int i=0; i<nVtxs; i++) { // For every vertex in the graph ...
-    
-    // ... start a new column in the matrix
-    adjHead[i] = curIdx;
-    
-    // ... get next line of data from the file
-    do {
-      if ( ( info = fgets(buffer,bufferSz,stream) ) == NULL) {
-	cerr << "Input file ended prematurely." << endl;
+  // ... which gives the adjacency lists' sizes
+  adjHead.resize( nVtxs + 1 );
+  adjHead[0] = 0;
+  int vtx = 0;
+  {for( int k=0; k<(int) parse.pieces.size(); ++k ) { 
+    ChacoFile_piece& piece = parse.pieces[k];
+    piece.firstVtx = vtx;
+    piece.nLines = ( (int) piece.nNumbers.size() < nVtxs - vtx ) ? 
+      piece.nNumbers.size() : nVtxs - vtx;
+    for( int i=0; i<piece.nLines; ++i, ++vtx ) { 
+      const int n = piece.nNumbers[i] - nLeading;
+      if ( ( n < 0 ) || ( ( n % nPerEdge ) != 0 ) ) { 
+	cerr << "Line of vertex " << vtx+1 << " has " << piece.nNumbers[i] 
+	     << " numbers." << endl;
 	return 0;
       }
-    } while ( ( info != NULL ) && ( info[0] == '%' ) );
-    token = strtok( info," \t" );
-    
-    // ... get the vertex permutation (if neccessary)
-    if ( read_vtxNumbers ) {
-      old2new[i]=atoi( token );
-      token = strtok( 0, " \t" );
-    }
-
-    // ... strip of diagonal value if neccessary.
-    if (read_vtxWeights) {
-      vtxWeight[i] = atoi( token );
-      token = strtok( 0, " \t" );
-    } 
-
-    // ... now insert the diagonal
-    //// no!  no diagonals in a graph
-    //    if ( read_edgeWeights ) {
-    //      if ( read_vtxWeights ) {
-    //	        pairList[curIdx++] = pair<int,int>(i,vtxWeight[i]);
-    //      } else {
-    //   	pairList[curIdx++] = pair<int,int>(i,0);
-    //      }
-    //    } else {
-    //      adjList[curIdx++] = i;
-    //    }
-
-    // for every element on the line
-    while( (curIdx < nNonZeros) && (token != NULL) && (*token != '\n') ) {  
-      int edge = atoi(token);
-      token = strtok( 0, " \t" );
-      int edge_weight = 1;      
-      if (read_edgeWeights) {
-	edge_weight = atoi(token);
-	token = strtok( 0, " \t" );
-	pairList[curIdx++] = pair<int,int>(edge-1, edge_weight);
-      } else {
-	adjList[curIdx++] = edge-1;
+      if ( adjHead[ vtx ] > INT_MAX - n / nPerEdge ) { 
+	cerr << "Too many edges." << endl;
+	return 0;
       }
+      adjHead[ vtx+1 ] = adjHead[ vtx ] + n / nPerEdge;
     }
   }}
-  adjHead[nVtxs] = curIdx;
+  if ( vtx < nVtxs ) { 
+    cerr << "Input file ended prematurely." << endl;
+    return 0;
+  }
+  nNonZeros = adjHead[ nVtxs ];
+  if ( nNonZeros != 2*nEdges ) { 
+    cerr << "Warning: expected " << 2*nEdges << " edge entries, found " 
+	 << nNonZeros << "." << endl;
+  }
 
-  // Now do the post-processing...
-  
-  // ... first sort the edge lists
-  if ( read_edgeWeights) {
-    for(int i=0;i<nVtxs;i++) {
-      sort( pairList.begin()+adjHead[i], pairList.begin() +adjHead[i+1], pair_first_less<int,int>() );
-    }
-  } else {
-    for (int i=0;i<nVtxs;i++) {
-      sort( adjList.begin()+adjHead[i], adjList.begin()+adjHead[i+1] );
-    }
+  // now parse the lines into place
+  PermutationMap vtxPermutationMap(nVtxs);
+  adjList.resize( nNonZeros );
+  parse.adjHead = adjHead.lend();
+  parse.adjList = adjList.begin();
+  parse.edgeWeight = 0;
+  parse.vtxWeight = 0;
+  parse.old2new = 0;
+  if ( parse.readEdgeWeights ) { 
+    edgeWeight.resize( nNonZeros );
+    parse.edgeWeight = edgeWeight.begin();
+  } else { 
+    edgeWeight.reset();
+  }
+  if ( parse.readVtxWeights ) { 
+    vtxWeight.resize( nVtxs );
+    parse.vtxWeight = vtxWeight.begin();
+  } else { 
+    vtxWeight.reset();
   }
+  if ( parse.readVtxNumbers ) { 
+    parse.old2new = vtxPermutationMap.getOld2New().give();
+  }
+  team.run( ChacoFile_parseTask, &parse, parse.pieces.size() );
+  if ( parse.readVtxNumbers ) { 
+    vtxPermutationMap.getOld2New().take( parse.old2new, nVtxs );
+  }
+  {for( int k=0; k<(int) parse.pieces.size(); ++k ) { 
+    if ( parse.pieces[k].badLine != 0 ) { 
+      int badVtx = parse.pieces[k].firstVtx;
+      const char * q = parse.pieces[k].begin;
+      while( q < parse.pieces[k].badLine ) { 
+	if ( *q != '%' ) { 
+	  ++badVtx;
+	}
+	q = MappedFile::skipLine( q, parse.pieces[k].badLine );
+      }
+      cerr << "Cannot read line of vertex " << badVtx+1 << "." << endl;
+      return 0;
+    }
+  }}
     
-  // ... next, reorder the edge list if the vertices are out of order
-  if ( read_vtxNumbers ) {
-    vtxPermutationMap.getOld2New().take( old2new, nVtxs );
+  // ... finally, reorder the edge list if the vertices are out of order
+  if ( parse.readVtxNumbers ) {
     vtxPermutationMap.validate();
     if ( ! vtxPermutationMap.isValid() ) {
       cerr << "Vertex PermutationMap problem" << endl;
+      return 0;
     }
     const int* new2old = vtxPermutationMap.getNew2Old().lend();
     SharedArray<int> permAdjHead( nVtxs + 1 );
-    if ( read_edgeWeights ) {
-      vector< pair< int, int > > permPairList( nVtxs );
-      int newIdx = 0;
-      for( int i=0; i<nVtxs; i++ ) {
-	permAdjHead[i] = newIdx;
-	int p=new2old[i];
-	for (int j=adjHead[p]; j<adjHead[p+1]; j++ ) {
-	  permPairList[newIdx++] = pairList[j];
-	}
+    SharedArray<int> permAdjList( nNonZeros );
+    SharedArray<int> permEdgeWeight( parse.readEdgeWeights ? nNonZeros : 0 );
+    SharedArray<int> permVtxWeight( parse.readVtxWeights ? nVtxs : 0 );
+    int newIdx = 0;
+    for( int i=0; i<nVtxs; i++ ) {
+      permAdjHead[i] = newIdx;
+      int old=new2old[i];
+      if ( parse.readVtxWeights ) { 
+	permVtxWeight[i] = vtxWeight[old];
       }
-      permAdjHead[nVtxs] = adjHead[nVtxs];
-      pairList.swap( permPairList );
-    } else {
-      SharedArray<int> permAdjList( nVtxs );
-      int newIdx = 0;
-      for( int i=0; i<nVtxs; i++ ) {
-	permAdjHead[i] = newIdx;
-	int p=new2old[i];
-	for (int j=adjHead[p]; j<adjHead[p+1]; j++ ) {
-	  permAdjList[newIdx++] = adjList[j];
+      for (int j=adjHead[old]; j<adjHead[old+1]; j++ ) {
+	if ( parse.readEdgeWeights ) { 
+	  permEdgeWeight[newIdx] = edgeWeight[j];
 	}
+	permAdjList[newIdx++] = adjList[j];
       }
-      permAdjHead[nVtxs] = adjHead[nVtxs];
-      adjList.swap( permAdjList );
     }
+    permAdjHead[nVtxs] = adjHead[nVtxs];
     adjHead.swap( permAdjHead );
+    adjList.swap( permAdjList );
+    if ( parse.readEdgeWeights ) { 
+      edgeWeight.swap( permEdgeWeight );
+    }
+    if ( parse.readVtxWeights ) { 
+      vtxWeight.swap( permVtxWeight );
+    }
   }
+  return true;
+}    
 
-  // ... finally, extract the pairList into adjList and edgeWeight
-  //     if necessary
-  if ( read_edgeWeights ) {
-    for( int i=0; i<nVtxs; i++ ) {
-      for ( int j=adjHead[i]; j<adjHead[i+1]; j++ ) {
-	adjList[j] = pairList[i].first;
-	edgeWeight[j] = pairList[i].second;
+//
+// the weight written for vertex j: its vertex weight, else the weight
+// of its self edge (an older convention), else 1
+//
+static inline int
+ChacoFile_vtxWeight( const int j, const int * adjHead, const int * adjList,
+		     const int * vtxWeight, const int * edgeWeight ) { 
+  if ( vtxWeight != 0 ) { 
+    return vtxWeight[j];
+  }
+  if ( edgeWeight != 0 ) { 
+    for( int i=adjHead[j]; i<adjHead[j+1]; i++ ) { 
+      if ( adjList[i] == j ) { 
+	return edgeWeight[i];
       }
     }
   }
-  return true;
-}    
+  return 1;
+}
 
 bool 
 ChacoFile::write( FILE * stream ) {
+  // same code as in the file: +1 for edge weights, +10 for vertex weights
   int myCode;
-  bool write_edgeWeights;
-  bool write_vtxWeights;
   if (CODE == -1) {
-    write_edgeWeights = ( edgeWeight.notNull() );
-    write_vtxWeights = ( vtxWeight.notNull() );
-    myCode = 10 * int( write_edgeWeights ) + int( write_vtxWeights );
+    myCode = 10 * int( vtxWeight.notNull() ) + int( edgeWeight.notNull() );
   } else {
     myCode = CODE;
-    write_edgeWeights = ((myCode / 10) == 1);
-    write_vtxWeights = ((myCode % 10) == 1);
   }
+  const int * l_vtxWeight = vtxWeight.notNull() ? vtxWeight.lend() : 0;
+  const int * l_edgeWeight = edgeWeight.notNull() ? edgeWeight.lend() : 0;
+
+  // the file lists each edge once per endpoint and no self edges
+  int nEdges = 0;
+  {for (int j=0; j<nVtxs; j++) {
+    for (int i=adjHead[j]; i<adjHead[j+1]; i++) { 
+      if ( adjList[i] != j ) { nEdges++; }
+    }
+  }}
+  nEdges /= 2;
 
   fprintf(stream,"%%%%ChacoFile\n");
   // Now a big case statement to avoid conditional jumps in a loop.
@@ -242,7 +420,7 @@ ChacoFile::write( FILE * stream ) {
   // on the loop.
   switch(myCode) {
   case 0: // No vertex weights, No edge weights
-    fprintf(stream,"%d %d\n", nVtxs, adjHead[nVtxs]/2 );
+    fprintf(stream,"%d %d\n", nVtxs, nEdges );
     {for (int j=0; j<nVtxs; j++) {
       int i=adjHead[j];
       for ( ; (i<adjHead[j+1]) && (adjList[i]<j); i++) {
@@ -256,7 +434,7 @@ ChacoFile::write( FILE * stream ) {
     }}
     break;
   case 1:    // edge weights, no vertex weights 
-    fprintf( stream, "%d %d 1\n", nVtxs, (adjHead[nVtxs]-nVtxs)/2 );
+    fprintf( stream, "%d %d 1\n", nVtxs, nEdges );
     if ( edgeWeight.isNull() ) { // edge weight == 1
       {for (int j=0; j<nVtxs; j++) {
 	int i=adjHead[j];
@@ -273,91 +451,59 @@ ChacoFile::write( FILE * stream ) {
       {for (int j=0; j<nVtxs; j++) {
 	int i=adjHead[j];
 	for ( ; (i<adjHead[j+1]) && (adjList[i]<j); i++) {
-	  fprintf(stream,"%d %d ",adjList[i]+1, edgeWeight[i]);
+	  fprintf(stream,"%d %d ",adjList[i]+1, l_edgeWeight[i]);
 	}
 	if ((i<adjHead[j+1]) && (adjList[i]==j)) { i++; }
 	for ( ; i<adjHead[j+1]; i++) {
-	  fprintf(stream,"%d %d ",adjList[i]+1, edgeWeight[i]);
+	  fprintf(stream,"%d %d ",adjList[i]+1, l_edgeWeight[i]);
 	}
 	fprintf( stream, "\n");
       }}
     }
     break;
   case 10: // vertex weights, but no edge weights
-    fprintf( stream, "%d %d 10\n", nVtxs, (adjHead[nVtxs]-nVtxs)/2 );
-    if ( vtxWeight.isNull() && edgeWeight.isNull() ) { // vertex weights are 1
-       {for (int j=0; j<nVtxs; j++) {
-	fprintf( stream, "1 " );
-	int i=adjHead[j];
-	for ( ; (i<adjHead[j+1]) && (adjList[i]<j); i++) {
-	  fprintf( stream, "%d ", adjList[i]+1 );
-	}
-	if ((i<adjHead[j+1]) && (adjList[i]==j)) { i++; }
-	for ( ; i<adjHead[j+1]; i++) {
-	  fprintf( stream, "%d ", adjList[i]+1 );
-	}
-	fprintf( stream, "\n");
-       }}
-    } else if ( vtxWeight.isNull() /* && edgeWeight.notNull() */ ) { // vertex weights are edgeWeight[diag]
-      {for (int j=0; j<nVtxs; j++) {
-	int diag;
-	for(diag=adjHead[j]; diag<adjHead[j+1]; diag++) { 
-	  if (adjList[diag] == j) {
-	    break;
-	  }
-	}
-	fprintf( stream, "%d ", edgeWeight[diag] );
-	int i=adjHead[j];
-	for( ; i<diag; i++) {
-	  fprintf( stream, "%d ", adjList[i]+1 );
-	}
-	if ((i<adjHead[j+1]) && (adjList[i]==j)) { i++; }
-	for ( ; i<adjHead[j+1]; i++) {
-	  fprintf( stream, "%d ", adjList[i]+1 );
-	}
-	fprintf( stream, "\n");
-      }}
-    } else { // vertex weights are vtxWeight[j]
+    fprintf( stream, "%d %d 10\n", nVtxs, nEdges );
+    {for (int j=0; j<nVtxs; j++) {
+      fprintf( stream, "%d ", 
+	       ChacoFile_vtxWeight( j, adjHead.lend(), adjList.lend(), l_vtxWeight, l_edgeWeight ) );
+      int i=adjHead[j];
+      for ( ; (i<adjHead[j+1]) && (adjList[i]<j); i++) {
+	fprintf( stream, "%d ", adjList[i]+1 );
+      }
+      if ((i<adjHead[j+1]) && (adjList[i]==j)) { i++; }
+      for ( ; i<adjHead[j+1]; i++) {
+	fprintf( stream, "%d ", adjList[i]+1 );
+      }
+      fprintf( stream, "\n");
+    }}
+    break;
+  case 11: // vertex weights and edge weights
+    fprintf( stream, "%d %d 11\n", nVtxs, nEdges );
+    if ( edgeWeight.isNull() ) { // edge weights are 1
       {for (int j=0; j<nVtxs; j++) {
-	fprintf( stream, "%d ", vtxWeight[j] );
+	fprintf( stream, "%d ", 
+		 ChacoFile_vtxWeight( j, adjHead.lend(), adjList.lend(), l_vtxWeight, 0 ) );
 	int i=adjHead[j];
 	for ( ; (i<adjHead[j+1]) && (adjList[i]<j); i++) {
-	  fprintf( stream, "%d ", adjList[i]+1 );
+	  fprintf( stream, "%d 1 ", adjList[i]+1 );
 	}
 	if ((i<adjHead[j+1]) && (adjList[i]==j)) { i++; }
 	for ( ; i<adjHead[j+1]; i++) {
-	  fprintf( stream, "%d ", adjList[i]+1 );
+	  fprintf( stream, "%d 1 ", adjList[i]+1 );
 	}
 	fprintf( stream, "\n");
       }}
-    }
-    break;
-  case 11: // vertex weights and edge weights
-    fprintf( stream, "%d %d 11\n", nVtxs, (adjHead[nVtxs]-nVtxs)/2 );
-    if ( edgeWeight.isNull() ) { // vertex weights are 1
-      fprintf( stream, "1 ");
-      {for (int j=0; j<nVtxs; j++) {
-	int i=adjHead[j];
-	for ( ; i<adjHead[j+1]; i++) {
-	  fprintf( stream, "%d 1 ", adjList[i]+1);
-	}
-      }}
-    } else {  // vertex weights are edgeWeight[diag], edge weights are edgeWeight[i]
+    } else {  // edge weights are edgeWeight[i]
       {for (int j=0; j<nVtxs; j++) {
-	int diag;
-	for(diag=adjHead[j]; diag<adjHead[j+1]; diag++) { 
-	  if (adjList[diag] == j) {
-	    break;
-	  }
-	}
-	fprintf( stream, "%d ", edgeWeight[diag] );
+	fprintf( stream, "%d ", 
+		 ChacoFile_vtxWeight( j, adjHead.lend(), adjList.lend(), l_vtxWeight, l_edgeWeight ) );
 	int i=adjHead[j];
-	for( ; i<diag; i++) {
-	  fprintf( stream, "%d %d ", adjList[i]+1, edgeWeight[i]);
+	for ( ; (i<adjHead[j+1]) && (adjList[i]<j); i++) {
+	  fprintf( stream, "%d %d ", adjList[i]+1, l_edgeWeight[i] );
 	}
 	if ((i<adjHead[j+1]) && (adjList[i]==j)) { i++; }
 	for ( ; i<adjHead[j+1]; i++) {
-	  fprintf( stream, "%d %d ", adjList[i]+1, edgeWeight[i]);
+	  fprintf( stream, "%d %d ", adjList[i]+1, l_edgeWeight[i] );
 	}
 	fprintf( stream, "\n");
       }}
@@ -36,11 +36,20 @@
 #include "spindle/GraphBase.h"
 #endif
 
+#ifndef SPINDLE_THREAD_TEAM_H_
+#include "spindle/ThreadTeam.h"
+#endif
+
 SPINDLE_BEGIN_NAMESPACE 
 /**
  * @memo Reads and writes symmetric (possibly weighted) Graphs in Chaco format
  * @type class
  *
+ * MeTiS files are read as well, as long as they have no vertex sizes
+ * or multiple vertex weights.  Lines may be any length.  The file is
+ * mapped into memory (see MappedFile) and its lines are parsed in
+ * pieces, one per thread.  Adjacency lists that are already in order
+ * are not sorted again.
  *
  * @author Gary Kumfert
  * @version #$Id: ChacoFile.h,v 1.3 2000/04/01 19:55:01 kumfert Exp $#
@@ -50,17 +59,18 @@ class ChacoFile:  public TextDataFile, public GraphBase {
 private:
 
   int CODE;
+  ThreadTeam team;
 
 public:  
 
-  static const int HAVE_VERTEX_WEIGHTS = 1;
-  static const int HAVE_EDGE_WEIGHTS = 10;
+  static const int HAVE_EDGE_WEIGHTS = 1;
+  static const int HAVE_VERTEX_WEIGHTS = 10;
   static const int HAVE_EXPLICIT_VERTEX_ORDER = 100;
 
   /**@name constructors/destructors */
   //@{
   /// default constructor
-  ChacoFile() { CODE = -1; }
+  ChacoFile() { CODE = -1; team.setMinChunkSize( 1 ); }
   /// destructor
   ~ChacoFile() {}
   //@}
@@ -79,9 +89,18 @@ public:
   //@{
   /**
    * @memo set which (if any) weights to include in Chaco file.
-   * @param code 0 for unweighted, +1 if edge weighted, +10 if vertex weighted
+   * @param code 0 for unweighted, +1 if edge weighted, +10 if vertex
+   *        weighted, as in the file.  -1 (the default) writes the
+   *        weights the graph has.
    */
   bool setCode (const int code);
+  /**
+   * read with up to #nThreads# threads.  The graph is the same for
+   * any number of threads.
+   */
+  bool setNThreads( const int nThreads ) { return team.setNThreads( nThreads ); }
+  /// query the number of threads used by read()
+  int queryNThreads() const { return team.queryNThreads(); }
   //@}
 };
   
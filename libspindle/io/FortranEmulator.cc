@@ -20,109 +20,305 @@
 
 #include "spindle/FortranEmulator.h"
 
+#ifndef SPINDLE_MAPPED_FILE_H_
+#include "spindle/MappedFile.h"
+#endif
+
+#ifdef REQUIRE_OLD_CXX_HEADER_SUFFIX
+#include <string.h>
+#include <vector.h>
+#else
+#include <string>
+#include <vector>
+using namespace std;
+#endif
+
+#include <ctype.h>
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+
 #ifdef HAVE_NAMESPACES
 using namespace SPINDLE_NAMESPACE;
 #endif
 
-bool 
-FortranEmulator::readArray( FILE * stream, 
-			    const char * format,
-			    const int nLines,
-			    int * array,
-			    const int arraySz) {
-  char line[82];
-  int intsPerLine;
-  int colsPerInt;
-  int calculatedLines;
-  char expanded_line[162];
-  int err;
-  if ( ( err = sscanf(format," (%d%*c%d)", &intsPerLine, &colsPerInt)) < 2 ) {
-    cerr << "Error: FortranEmulator::readArray()" << endl;
-    cerr << "       Problem performing sscanf() on integer format \'" << format << "\'" << endl;
-    cerr << "       Only scanned " << err << " of the two numbers." << endl;
-    cerr << "       intsPerLine=" << intsPerLine << "   colsPerInt=" << colsPerInt << endl;
+// read an unsigned number in a format, or return 0
+static const char *
+FortranEmulator_number( const char * p, int& value ) { 
+  while ( *p == ' ' ) { ++p; }
+  if ( !isdigit( *p ) ) { 
+    return 0;
+  }
+  value = 0;
+  while ( isdigit( *p ) ) { 
+    value = 10 * value + ( *p++ - '0' );
+  }
+  while ( *p == ' ' ) { ++p; }
+  return p;
+}
+
+bool
+FortranEmulator::compile( const char * format, Format& compiled ) { 
+  compiled.perLine = 1;
+  compiled.width = 0;
+  compiled.digits = 0;
+  compiled.scale = 0;
+  compiled.type = ' ';
+  const char * p = format;
+  while ( *p == ' ' ) { ++p; }
+  if ( *p++ != '(' ) { 
     return false;
   }
-  calculatedLines = arraySz/intsPerLine + ( (arraySz%intsPerLine == 0) ? 0 : 1 );
-  if ((nLines != -1) && (calculatedLines != nLines)) { 
-    cerr << "Warning: FortranEmulator::readArray()" << endl 
-	 << "         calculated " << calculatedLines << " lines, not " << nLines 
-	 << "as specified." << endl;
+  // optional scale factor, as in (1P,4E20.12) or (1P4E20.12)
+  int count = 1;
+  bool negative = false;
+  while ( *p == ' ' ) { ++p; }
+  if ( *p == '-' ) { 
+    negative = true;
+    ++p;
   }
-  int curIdx = 0;
-  int curLine = 0;
-  for( curLine=0; curLine < calculatedLines; curLine++) {
-    // First get the line from the stream
-    if (fgets(line, 82, stream ) == NULL) { 
-      cerr << "Error: cannot read " << nLines << "th part of intarray." << endl;
+  const char * q = FortranEmulator_number( p, count );
+  if ( q != 0 ) { 
+    p = q;
+  } else if ( negative ) { 
+    return false;
+  }
+  if ( toupper( *p ) == 'P' ) { 
+    compiled.scale = negative ? -count : count;
+    count = 1;
+    ++p;
+    while ( ( *p == ' ' ) || ( *p == ',' ) ) { ++p; }
+    if ( ( q = FortranEmulator_number( p, count ) ) != 0 ) { 
+      p = q;
+    }
+  } else if ( negative ) { 
+    return false;
+  }
+  compiled.perLine = count;
+  compiled.type = toupper( *p++ );
+  if ( strchr( "IEDFG", compiled.type ) == 0 ) { 
+    return false;
+  }
+  if ( ( p = FortranEmulator_number( p, compiled.width ) ) == 0 ) { 
+    return false;
+  }
+  if ( *p == '.' ) { 
+    if ( ( p = FortranEmulator_number( p+1, compiled.digits ) ) == 0 ) { 
       return false;
     }
-    // Then write the line to the expanded line, inserting spaces when appropriate
-    char *src = line;
-    char *dest = expanded_line;
-    for ( int j=1; ( (j<=80) && (*src!='\0') ); j++) {
-      *dest++ = *src++;
-      if (j%colsPerInt == 0) { *dest++ = ' '; }
+  }
+  if ( toupper( *p ) == 'E' ) { // exponent width, as in E15.7E3
+    int junk;
+    if ( ( p = FortranEmulator_number( p+1, junk ) ) == 0 ) { 
+      return false;
     }
-    *dest='\0';
-    // Now we have expanded_line with all the required spaces.
-    for (char *token = strtok( expanded_line," \t"); (token != NULL) && (curIdx < arraySz) ; token=strtok(0," \t") ) {
-      int temp = atoi(token) -1;
-      if (temp < 0 ) { break; }
-      array[curIdx++] = temp;
-    } // end for all tokens on line
-  } // end for all lines
-  return ( (curLine == calculatedLines) && (arraySz == curIdx) );
+  }
+  return ( *p == ')' ) && ( compiled.perLine > 0 ) && ( compiled.width > 0 );
 }
 
+//
+// scan one number that ends at a blank or at the end of its field.
+// Returns the position after it, or 0 if it is bad.
+//
+static const char *
+FortranEmulator_scan( const char * p, const char * end, 
+		      const FortranEmulator::Format&, int& value ) {
+  p = MappedFile::scanInt( p, end, value );
+  if ( ( p == 0 ) || ( ( p != end ) && ( *p != ' ' ) && ( *p != '\t' ) ) || ( value < 1 ) ) { 
+    return 0;
+  }
+  --value; // Fortran indexes from 1
+  return p;
+}
 
+static const char *
+FortranEmulator_scan( const char * p, const char * end, 
+		      const FortranEmulator::Format& format, double& value ) {
+  const char * q = MappedFile::scanDouble( p, end, value );
+  if ( q == 0 ) { 
+    return 0;
+  }
+  bool hasExponent = false;
+  bool hasPoint = false;
+  {for( const char * c=p; c<q; ++c ) { 
+    hasExponent = hasExponent || ( strchr( "eEdD", *c ) != 0 );
+    hasPoint = hasPoint || ( *c == '.' );
+  }}
+  if ( ( q < end ) && ( ( *q == '+' ) || ( *q == '-' ) ) && ( !hasExponent ) ) { 
+    // an exponent too wide for its letter, as in 0.1234-105
+    int exponent;
+    const char * r = MappedFile::scanInt( q, end, exponent );
+    if ( r == 0 ) { 
+      return 0;
+    }
+    string token( p, q );
+    token += 'E';
+    token.append( q, r );
+    value = strtod( token.c_str(), 0 );
+    hasExponent = true;
+    q = r;
+  }
+  if ( ( q != end ) && ( *q != ' ' ) && ( *q != '\t' ) ) { 
+    return 0;
+  }
+  if ( ( format.digits != 0 ) && ( !hasPoint ) ) { 
+    // without a decimal point, the last d digits are the fraction
+    value *= pow( 10.0, -format.digits );
+  }
+  if ( ( format.scale != 0 ) && ( !hasExponent ) ) { 
+    // kP only scales input without an exponent
+    value *= pow( 10.0, -format.scale );
+  }
+  return q;
+}
 
-bool 
-FortranEmulator::readArray( FILE * stream, 
-			    const char * format, 
-			    const int nLines, 
-			    double * array, 
-			    const int arraySz) {
-  char line[82];
-  int doublesPerLine;
-  int colsPerDouble;
-  int Precision;
-  char expanded_line[162];
-  if ( sscanf(format," (%d%*c%d.%d)", &doublesPerLine, &colsPerDouble, &Precision) < 3 ) {
-    if ( sscanf( format," (%*d%*c%d%*c%d.%d)",  
-		 &doublesPerLine, &colsPerDouble, &Precision) < 3 ) {
-      cerr << "Error in Double format " << format <<  endl;
+//
+// decode the fields of one line [begin,end) into array[curIdx...].
+// Each field is normally one number in its columns, but blank fields
+// are skipped and blanks may separate several numbers in one field.
+//
+template< class T >
+static bool
+FortranEmulator_line( const char * begin, const char * end, 
+		      const FortranEmulator::Format& format, 
+		      T * array, int& curIdx, const int arraySz ) {
+  if ( ( end > begin ) && ( end[-1] == '\r' ) ) { 
+    --end;
+  }
+  for( int k=0; ( k<format.perLine ) && ( curIdx<arraySz ); ++k ) { 
+    const char * field = begin + k * format.width;
+    if ( field >= end ) { 
+      break;
+    }
+    const char * fieldEnd = ( end - field > format.width ) ? field + format.width : end;
+    const char * p = MappedFile::skipBlanks( field, fieldEnd );
+    while ( ( p < fieldEnd ) && ( curIdx < arraySz ) ) { 
+      p = FortranEmulator_scan( p, fieldEnd, format, array[ curIdx ] );
+      if ( p == 0 ) {
+	cerr << "Error: FortranEmulator::readArray()" << endl;
+	cerr << "       Bad field \'" << string( field, fieldEnd ) << "\' for format "
+	     << format.perLine << format.type << format.width << endl;
+	return false;
+      }
+      ++curIdx;
+      p = MappedFile::skipBlanks( p, fieldEnd );
+    }
+  }
+  return true;
+}
+
+//
+// read arraySz values of either type from the lines at p
+//
+template< class T >
+static bool
+FortranEmulator_read( const char *& p, const char * end, 
+		      const FortranEmulator::Format& format, const int nLines, 
+		      T * array, const int arraySz ) {
+  const int calculatedLines = arraySz/format.perLine + ( (arraySz%format.perLine == 0) ? 0 : 1 );
+  if ((nLines != -1) && (calculatedLines != nLines)) { 
+    cerr << "Warning: calculated " << calculatedLines << " lines, not " << nLines << endl;
+  }
+  int curIdx = 0;
+  for( int curLine=0; curLine < calculatedLines; curLine++) {
+    if ( p >= end ) { 
+      cerr << "Error: cannot read " << curLine+1 << "th line of array." << endl;
       return false;
     }
+    const char * eol = p;
+    while ( ( eol < end ) && ( *eol != '\n' ) ) { 
+      ++eol;
+    }
+    if ( !FortranEmulator_line( p, eol, format, array, curIdx, arraySz ) ) { 
+      return false;
+    }
+    p = ( eol < end ) ? eol + 1 : end;
   }
- 
-  int calculatedLines = arraySz/doublesPerLine + ( (arraySz%doublesPerLine == 0) ? 0 : 1 );
+  return ( arraySz == curIdx );
+}
+
+//
+// the same from a stream, a line at a time
+//
+template< class T >
+static bool
+FortranEmulator_read( FILE * stream, const FortranEmulator::Format& format, 
+		      const int nLines, T * array, const int arraySz ) {
+  const int calculatedLines = arraySz/format.perLine + ( (arraySz%format.perLine == 0) ? 0 : 1 );
   if ((nLines != -1) && (calculatedLines != nLines)) { 
     cerr << "Warning: calculated " << calculatedLines << " lines, not " << nLines << endl;
   }
+  // room for a whole line, the newline, and the terminating null
+  vector< char > line( format.perLine * format.width + 3 );
   int curIdx = 0;
-  int curLine = 0;
-  for( curLine=0; curLine < calculatedLines; curLine++) {
-    // First get the line from the stream
-    if (fgets(line, 82, stream ) == NULL) { 
-      cerr << "Error: cannot read " << nLines << "th part of intarray." << endl;
+  for( int curLine=0; curLine < calculatedLines; curLine++) {
+    if ( fgets( &line[0], line.size(), stream ) == NULL ) { 
+      cerr << "Error: cannot read " << curLine+1 << "th line of array." << endl;
       return false;
     }
-    // Then write the line to the expanded line, inserting spaces when appropriate
-    char *src = line;
-    char *dest = expanded_line;
-    for ( int j=1; ( (j<=80) && (*src!='\0') ); j++) {
-      *dest++ = *src++;
-      if (j%colsPerDouble == 0) { *dest++ = ' '; }
+    const char * eol = strchr( &line[0], '\n' );
+    if ( eol == 0 ) { 
+      // the rest of an overlong line is past the last field
+      eol = &line[0] + strlen( &line[0] );
+      int c;
+      while ( ( ( c = getc( stream ) ) != EOF ) && ( c != '\n' ) ) {}
+    }
+    if ( !FortranEmulator_line( &line[0], eol, format, array, curIdx, arraySz ) ) { 
+      return false;
     }
-    *dest='\0';
-    // Now we have expanded_line with all the required spaces.
-    for (char *token = strtok( expanded_line," \t"); (token != NULL) && (curIdx<arraySz); token=strtok(0," \t") ) {
-      double temp = atof(token);
-      array[curIdx++] = temp;
-    } // end for all tokens on line
-  } // end for all lines
-  return ( (curLine == calculatedLines) && (arraySz == curIdx) );
+  }
+  return ( arraySz == curIdx );
+}
+
+bool
+FortranEmulator::readArray( const char *& p, const char * end, const Format& format, 
+			    const int nLines, int * array, const int arraySz ) { 
+  if ( format.type != 'I' ) { 
+    cerr << "Error: FortranEmulator::readArray() needs an integer format" << endl;
+    return false;
+  }
+  return FortranEmulator_read( p, end, format, nLines, array, arraySz );
+}
+
+bool
+FortranEmulator::readArray( const char *& p, const char * end, const Format& format, 
+			    const int nLines, double * array, const int arraySz ) { 
+  if ( format.type == 'I' ) { 
+    cerr << "Error: FortranEmulator::readArray() needs a floating point format" << endl;
+    return false;
+  }
+  return FortranEmulator_read( p, end, format, nLines, array, arraySz );
+}
+
+bool 
+FortranEmulator::readArray( FILE * stream, 
+			    const char * format,
+			    const int nLines,
+			    int * array,
+			    const int arraySz) {
+  Format compiled;
+  if ( ( !compile( format, compiled ) ) || ( compiled.type != 'I' ) ) {
+    cerr << "Error: FortranEmulator::readArray()" << endl;
+    cerr << "       Cannot use integer format \'" << format << "\'" << endl;
+    return false;
+  }
+  return FortranEmulator_read( stream, compiled, nLines, array, arraySz );
+}
+
+
+
+bool 
+FortranEmulator::readArray( FILE * stream, 
+			    const char * format, 
+			    const int nLines, 
+			    double * array, 
+			    const int arraySz) {
+  Format compiled;
+  if ( ( !compile( format, compiled ) ) || ( compiled.type == 'I' ) ) {
+    cerr << "Error in Double format " << format <<  endl;
+    return false;
+  }
+  return FortranEmulator_read( stream, compiled, nLines, array, arraySz );
 }
 
 
@@ -53,6 +53,61 @@ SPINDLE_BEGIN_NAMESPACE
  */
 class FortranEmulator { 
 public:
+  /**
+   * @memo a compiled Fortran format such as #(8I10)# or #(1P,4D20.12)#
+   * @type struct
+   */
+  struct Format { 
+    /// fields per line
+    int perLine;
+    /// columns per field
+    int width;
+    /// digits after the decimal point, implied if a field has no point
+    int digits;
+    /// scale factor (the #k# of #kP#)
+    int scale;
+    /// one of #I#, #E#, #D#, #F#, or #G#
+    char type;
+  };
+
+  /**
+   * compile a Fortran format once, so that its fields can be decoded
+   * directly from their columns.
+   * @return false if the format is not a single repeated #I#, #E#,
+   *         #D#, #F#, or #G# edit descriptor.
+   */
+  static bool compile( const char * format, Format& compiled );
+
+  /**
+   * read a formatted array of integers from memory, decrementing each
+   * (Fortran indexes from 1).
+   * @param p the first line, advanced past the lines read.
+   * @param end one past the last byte available
+   * @param format the compiled format.  Must be of type #I#.
+   * @param nLines The number of lines that the array is broken up over, or -1.
+   * @param array The array where the data is to be read into.
+   * @param arraySz The length of the array.
+   * @return true iff the operation succeeds.
+   */
+  static bool readArray( const char *& p, const char * end, const Format& format, 
+			 const int nLines, int * array, const int arraySz );
+  /**
+   * read a formatted array of doubles from memory.  Exponents may be
+   * marked by #E#, #D#, or, if they are too wide, only by their sign.
+   * As in Fortran, a number without a decimal point has an implied one
+   * before its last #digits# digits, so #12345# reads as 12.345 under
+   * #F10.3#.
+   * @param p the first line, advanced past the lines read.
+   * @param end one past the last byte available
+   * @param format the compiled format.  Must not be of type #I#.
+   * @param nLines The number of lines that the array is broken up over, or -1.
+   * @param array The array where the data is to be read into.
+   * @param arraySz The length of the array.
+   * @return true iff the operation succeeds.
+   */
+  static bool readArray( const char *& p, const char * end, const Format& format, 
+			 const int nLines, double * array, const int arraySz );
+
   /**
    * read a formatted array of integers.
    * @param stream a conventional C/C++ #FILE# pointer
@@ -29,6 +29,10 @@
 #include "spindle/FortranEmulator.h"
 #endif
 
+#ifndef SPINDLE_MAPPED_FILE_H_
+#include "spindle/MappedFile.h"
+#endif
+
 #ifndef SPINDLE_SYSTEM_H_
 #include "spindle/SpindleSystem.h"
 #endif
@@ -249,14 +253,40 @@ bool
 HarwellBoeingFile::readData( FILE * stream ) {
   FENTER;
 
+  // map the rest of the file, and compile the formats once
+  MappedFile data;
+  if ( ! data.map( stream ) ) { 
+    ERROR( SPINDLE_ERROR_FILE_READ, "Cannot read data of Harwell Boeing file.  ");
+    FRETURN( false );
+  }
+  const char * p = data.begin();
+  const char * end = data.end();
+  FortranEmulator::Format ptrFormat;
+  FortranEmulator::Format indFormat;
+  FortranEmulator::Format valFormat;
+  FortranEmulator::Format rhsFormat;
+  if ( ( ! FortranEmulator::compile( PTRfmt, ptrFormat ) ) || 
+       ( ! FortranEmulator::compile( INDfmt, indFormat ) ) ) { 
+    ERROR( SPINDLE_ERROR_FILE_MISCERR, "Cannot use formats %s and %s.  ", PTRfmt, INDfmt );
+    FRETURN( false );
+  }
+  if ( ( VALcrd > 0 ) && ( ! FortranEmulator::compile( VALfmt, valFormat ) ) ) { 
+    ERROR( SPINDLE_ERROR_FILE_MISCERR, "Cannot use format %s.  ", VALfmt );
+    FRETURN( false );
+  }
+  if ( ( VALcrd > 0 ) && ( nRHS > 0 ) && ( ! FortranEmulator::compile( RHSfmt, rhsFormat ) ) ) { 
+    ERROR( SPINDLE_ERROR_FILE_MISCERR, "Cannot use format %s.  ", RHSfmt );
+    FRETURN( false );
+  }
+
   colPtr.resize( nCols + 1 );
-  if ( ! FortranEmulator::readArray( stream, PTRfmt, PTRcrd, colPtr.begin(), nCols+1 )) {
+  if ( ! FortranEmulator::readArray( p, end, ptrFormat, PTRcrd, colPtr.begin(), nCols+1 )) {
     ERROR( SPINDLE_ERROR, "in FortranEmulator::readArray( ) for int[].");
     FRETURN( false );
   }
 
   rowIdx.resize( nNonZeros );
-  if ( ! FortranEmulator::readArray( stream, INDfmt, INDcrd, rowIdx.begin(), nNonZeros )) {
+  if ( ! FortranEmulator::readArray( p, end, indFormat, INDcrd, rowIdx.begin(), nNonZeros )) {
     ERROR( SPINDLE_ERROR, "in FortranEmulator::readArray( ) for int[].");
     FRETURN( false );
   }
@@ -266,18 +296,18 @@ HarwellBoeingFile::readData( FILE * stream ) {
     if ( (MATtype[2] == 'A') || (MATtype[2] == 'a') ) { // if Matrix is assembled
       if ( (MATtype[0] == 'C') || (MATtype[0] == 'c') ) { // if Matix is complex assembled
 	realValues.resize( nNonZeros );
-	if ( ! FortranEmulator::readArray( stream, VALfmt, VALcrd/2, realValues.begin(), nNonZeros )) {
+	if ( ! FortranEmulator::readArray( p, end, valFormat, VALcrd/2, realValues.begin(), nNonZeros )) {
 	  ERROR( SPINDLE_ERROR, "in FortranEmulator::readArray( ) for double[].");
 	  FRETURN( false );
 	}
 	imgValues.resize( nNonZeros );
-	if ( ! FortranEmulator::readArray( stream, VALfmt, VALcrd/2, imgValues.begin(), nNonZeros )) {
+	if ( ! FortranEmulator::readArray( p, end, valFormat, VALcrd/2, imgValues.begin(), nNonZeros )) {
 	  ERROR( SPINDLE_ERROR, "in FortranEmulator::readArray( ) for double[].");
 	  FRETURN( false );
 	}
       } else { // matrix is Real assembled
 	realValues.resize( nNonZeros );
-	if ( ! FortranEmulator::readArray( stream, VALfmt, VALcrd, realValues.begin(), nNonZeros )) {
+	if ( ! FortranEmulator::readArray( p, end, valFormat, VALcrd, realValues.begin(), nNonZeros )) {
 	  ERROR( SPINDLE_ERROR, "in FortranEmulator::readArray( ) for double[].");
 	  FRETURN( false );
 	}
@@ -285,18 +315,18 @@ HarwellBoeingFile::readData( FILE * stream ) {
     } else { // Matrix is finite element
       if ( (MATtype[0]=='C') || (MATtype[0]=='c') ) { // if Matix is complex
 	realValues.resize( NEltVal );
-	if ( ! FortranEmulator::readArray( stream, VALfmt, VALcrd/2, realValues.begin(), NEltVal )) {
+	if ( ! FortranEmulator::readArray( p, end, valFormat, VALcrd/2, realValues.begin(), NEltVal )) {
 	  ERROR( SPINDLE_ERROR, "in FortranEmulator::readArray( ) for double[].");
 	  FRETURN( false );
 	}
 	imgValues.resize( NEltVal );
-	if ( ! FortranEmulator::readArray( stream, VALfmt, VALcrd/2, imgValues.begin(), NEltVal )) {
+	if ( ! FortranEmulator::readArray( p, end, valFormat, VALcrd/2, imgValues.begin(), NEltVal )) {
 	  ERROR( SPINDLE_ERROR, "in FortranEmulator::readArray( ) for double[].");
 	  FRETURN( false );
 	}
       } else { // matrix is Real
 	realValues.resize( NEltVal );
-	if ( ! FortranEmulator::readArray( stream, VALfmt, VALcrd, realValues.begin(), NEltVal )) {
+	if ( ! FortranEmulator::readArray( p, end, valFormat, VALcrd, realValues.begin(), NEltVal )) {
 	  ERROR( SPINDLE_ERROR, "in FortranEmulator::readArray( ) for double[].");
 	  FRETURN( false );
 	}
@@ -308,30 +338,30 @@ HarwellBoeingFile::readData( FILE * stream ) {
       if ( ( RHStype[0] == 'F' ) || ( RHStype[0] == 'f' ) ) { // if RHS is a dense vector
 	int nRHSVals = nRows * nRHS;
 	RHS_realValues.resize( nRHSVals );
-	if ( ! FortranEmulator::readArray( stream, RHSfmt, -1, RHS_realValues.begin(), nRHSVals )) {
+	if ( ! FortranEmulator::readArray( p, end, rhsFormat, -1, RHS_realValues.begin(), nRHSVals )) {
 	  cerr << "Error: in FortranEmulator::readArray() for double[]" << endl;
 	  FRETURN( false );
 	}
       } else if ( ( MATtype[2] == 'A' )|| ( MATtype[2] == 'a' ) ) { // RHS is sparse array
 	RHS_colPtr.resize( nRHS + 1 );
-	if ( ! FortranEmulator::readArray( stream, PTRfmt, -1, RHS_colPtr.begin(), nRHS + 1) ) {
+	if ( ! FortranEmulator::readArray( p, end, ptrFormat, -1, RHS_colPtr.begin(), nRHS + 1) ) {
 	  ERROR( SPINDLE_ERROR, "in FortranEmulator::readArray( ) for int[].");
 	  FRETURN( false );
 	}
 	RHS_rowIdx.resize( nRHSind );
-	if ( ! FortranEmulator::readArray( stream, INDfmt, -1, RHS_rowIdx.begin(), nRHSind) ) {
+	if ( ! FortranEmulator::readArray( p, end, indFormat, -1, RHS_rowIdx.begin(), nRHSind) ) {
 	  ERROR( SPINDLE_ERROR, "in FortranEmulator::readArray( ) for int[].");
 	  FRETURN( false );
 	}
 	RHS_realValues.resize( nRHSind );
-	if ( ! FortranEmulator::readArray( stream, RHSfmt, -1, RHS_realValues.begin(), nRHSind )) {
+	if ( ! FortranEmulator::readArray( p, end, rhsFormat, -1, RHS_realValues.begin(), nRHSind )) {
 	  ERROR( SPINDLE_ERROR, "in FortranEmulator::readArray( ) for double[].");
 	  FRETURN( false );
 	}
       } else { // RHS is elemental
 	int nRHSVal = nNonZeros * nRHS;
 	RHS_realValues.resize( nRHSVal );
-	if ( ! FortranEmulator::readArray( stream, RHSfmt, -1, RHS_realValues.begin(), nRHSVal )) {
+	if ( ! FortranEmulator::readArray( p, end, rhsFormat, -1, RHS_realValues.begin(), nRHSVal )) {
 	  ERROR( SPINDLE_ERROR, "in FortranEmulator::readArray( ) for double[].");
 	  FRETURN( false );
 	}
@@ -339,7 +369,7 @@ HarwellBoeingFile::readData( FILE * stream ) {
       if ( ( RHStype[1] == 'G' ) || ( RHStype[1] == 'g' ) ) { // if there are starting guesses
 	int nINIT_Guess = nRows * nRHS;
 	initialGuess.resize( nINIT_Guess );
-	if ( ! FortranEmulator::readArray( stream, RHSfmt, -1, initialGuess.begin(), nINIT_Guess )) {
+	if ( ! FortranEmulator::readArray( p, end, rhsFormat, -1, initialGuess.begin(), nINIT_Guess )) {
 	  ERROR( SPINDLE_ERROR, "in FortranEmulator::readArray( ) for double[].");
 	  FRETURN( false );
 	}
@@ -347,7 +377,7 @@ HarwellBoeingFile::readData( FILE * stream ) {
       if ( ( RHStype[2] == 'X' ) || ( RHStype[2] == 'x' ) ) { // if there are starting guesses
 	int nEXACT_SOLN = nRows * nRHS;
 	exactSolution.resize( nEXACT_SOLN );
-	if ( ! FortranEmulator::readArray( stream, RHSfmt, -1, exactSolution.begin(), nEXACT_SOLN )) {
+	if ( ! FortranEmulator::readArray( p, end, rhsFormat, -1, exactSolution.begin(), nEXACT_SOLN )) {
 	  ERROR( SPINDLE_ERROR, "in FortranEmulator::readArray( ) for double[].");
 	  FRETURN( false );
 	}
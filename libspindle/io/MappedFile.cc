@@ -0,0 +1,242 @@
+//
+// MappedFile.cc
+//
+//  $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+// =========================================================================
+//
+//
+
+#include "spindle/MappedFile.h"
+
+#ifdef REQUIRE_OLD_CXX_HEADER_SUFFIX
+#include <string.h>
+#else
+#include <string>
+using std::string;
+#endif
+
+#include <stdlib.h>
+
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_UNISTD_H)
+#define SPINDLE_MAPPED_FILE_MMAP
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+// powers of ten that are exact in a double
+static const double MappedFile_pow10[] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+MappedFile::MappedFile() {
+  data = "";
+  nBytes = 0;
+  mapBase = 0;
+  mapLength = 0;
+  buffer = 0;
+}
+
+MappedFile::~MappedFile() {
+  unmap();
+}
+
+void
+MappedFile::unmap() {
+#ifdef SPINDLE_MAPPED_FILE_MMAP
+  if ( mapBase != 0 ) {
+    munmap( (char *) mapBase, mapLength );
+  }
+#endif
+  ::free( buffer );
+  data = "";
+  nBytes = 0;
+  mapBase = 0;
+  mapLength = 0;
+  buffer = 0;
+}
+
+bool
+MappedFile::map( FILE * stream ) {
+  unmap();
+  if ( stream == 0 ) {
+    return false;
+  }
+#ifdef SPINDLE_MAPPED_FILE_MMAP
+  {
+    const int fd = fileno( stream );
+    const long pos = ftell( stream );
+    struct stat st;
+    if ( ( pos >= 0 ) && ( fstat( fd, &st ) == 0 ) && S_ISREG( st.st_mode )
+	 && ( st.st_size > (off_t) pos ) ) {
+      // mmap() wants an offset that is a multiple of the page size
+      const long pageSize = sysconf( _SC_PAGESIZE );
+      const off_t offset = ( pageSize > 0 ) ? ( pos - pos % pageSize ) : 0;
+      mapLength = (size_t) ( st.st_size - offset );
+      void * p = mmap( 0, mapLength, PROT_READ, MAP_PRIVATE, fd, offset );
+      if ( p != MAP_FAILED ) {
+#ifdef MADV_SEQUENTIAL
+	madvise( (char *) p, mapLength, MADV_SEQUENTIAL );
+#endif
+	mapBase = p;
+	data = (const char *) p + ( pos - offset );
+	nBytes = (size_t) ( st.st_size - pos );
+	fseek( stream, 0, SEEK_END );
+	return true;
+      }
+      mapLength = 0;
+    }
+  }
+#endif
+  // a pipe, or no mmap(): read the rest of the stream
+  size_t capacity = 64*1024;
+  buffer = (char *) ::malloc( capacity );
+  if ( buffer == 0 ) {
+    return false;
+  }
+  size_t n = 0;
+  for(;;) {
+    if ( n == capacity ) {
+      char * temp = (char *) ::realloc( buffer, 2*capacity );
+      if ( temp == 0 ) {
+	unmap();
+	return false;
+      }
+      buffer = temp;
+      capacity *= 2;
+    }
+    const size_t nRead = fread( buffer + n, 1, capacity - n, stream );
+    n += nRead;
+    if ( nRead == 0 ) {
+      break;
+    }
+  }
+  if ( ferror( stream ) ) {
+    unmap();
+    return false;
+  }
+  data = buffer;
+  nBytes = n;
+  return true;
+}
+
+void
+MappedFile::splitAtLines( const char * begin, const char * end, const int nParts,
+			  vector< const char * >& bounds ) {
+  const int n = ( nParts < 1 ) ? 1 : nParts;
+  const size_t size = end - begin;
+  bounds.resize( n + 1 );
+  bounds[0] = begin;
+  {for( int k=1; k<n; ++k ) {
+    const char * p = begin + ( size / n ) * k;
+    if ( p <= bounds[k-1] ) {
+      p = bounds[k-1];
+    } else if ( p[-1] != '\n' ) {
+      p = skipLine( p, end );
+    }
+    bounds[k] = p;
+  }}
+  bounds[n] = end;
+}
+
+const char *
+MappedFile::scanDouble( const char * p, const char * end, double& value ) {
+  const char * start = p;
+  bool negative = false;
+  if ( ( p < end ) && ( ( *p == '-' ) || ( *p == '+' ) ) ) {
+    negative = ( *p == '-' );
+    ++p;
+  }
+  // mantissa: keep up to 15 significant digits, exactly
+  double mantissa = 0.0;
+  int nSignificant = 0;
+  int nDigits = 0;
+  int exponent = 0;
+  for( ; ( p < end ) && ( *p >= '0' ) && ( *p <= '9' ); ++p, ++nDigits ) {
+    if ( ( nSignificant > 0 ) || ( *p != '0' ) ) {
+      ++nSignificant;
+    }
+    if ( nSignificant <= 15 ) {
+      mantissa = 10.0 * mantissa + ( *p - '0' );
+    } else {
+      ++exponent;
+    }
+  }
+  if ( ( p < end ) && ( *p == '.' ) ) {
+    for( ++p; ( p < end ) && ( *p >= '0' ) && ( *p <= '9' ); ++p, ++nDigits ) {
+      if ( ( nSignificant > 0 ) || ( *p != '0' ) ) {
+	++nSignificant;
+      }
+      if ( nSignificant <= 15 ) {
+	mantissa = 10.0 * mantissa + ( *p - '0' );
+	--exponent;
+      }
+    }
+  }
+  if ( nDigits == 0 ) {
+    return 0;
+  }
+  // exponent, only if digits follow the letter
+  if ( ( p < end ) && ( ( *p == 'e' ) || ( *p == 'E' ) ||
+			( *p == 'd' ) || ( *p == 'D' ) ) ) {
+    const char * q = p + 1;
+    bool negativeExp = false;
+    if ( ( q < end ) && ( ( *q == '-' ) || ( *q == '+' ) ) ) {
+      negativeExp = ( *q == '-' );
+      ++q;
+    }
+    if ( ( q < end ) && ( *q >= '0' ) && ( *q <= '9' ) ) {
+      int e = 0;
+      for( ; ( q < end ) && ( *q >= '0' ) && ( *q <= '9' ); ++q ) {
+	if ( e < 100000 ) {
+	  e = 10 * e + ( *q - '0' );
+	}
+      }
+      exponent += negativeExp ? -e : e;
+      p = q;
+    }
+  }
+  if ( nSignificant <= 15 ) {
+    // both mantissa and power of ten are exact, so one
+    // multiplication or division rounds correctly
+    if ( mantissa == 0.0 ) {
+      value = negative ? -0.0 : 0.0;
+      return p;
+    } else if ( ( exponent >= 0 ) && ( exponent <= 22 ) ) {
+      value = mantissa * MappedFile_pow10[ exponent ];
+      value = negative ? -value : value;
+      return p;
+    } else if ( ( exponent < 0 ) && ( exponent >= -22 ) ) {
+      value = mantissa / MappedFile_pow10[ -exponent ];
+      value = negative ? -value : value;
+      return p;
+    }
+  }
+  // everything else goes to strtod()
+  string token( start, p );
+  {for( string::size_type i=0; i<token.size(); ++i ) {
+    if ( ( token[i] == 'd' ) || ( token[i] == 'D' ) ) {
+      token[i] = 'e';
+    }
+  }}
+  value = strtod( token.c_str(), 0 );
+  return p;
+}
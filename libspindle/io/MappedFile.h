@@ -0,0 +1,162 @@
+//
+// MappedFile.h
+//
+//  $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+// =========================================================================
+//
+//
+
+#ifndef SPINDLE_MAPPED_FILE_H_
+#define SPINDLE_MAPPED_FILE_H_
+
+#ifdef REQUIRE_OLD_CXX_HEADER_SUFFIX
+#include <stdio.h>
+#include <vector.h>
+#else
+#include <cstdio>
+#include <vector>
+using std::vector;
+#endif
+
+#ifndef SPINDLE_H_
+#include "spindle/spindle.h"
+#endif
+
+SPINDLE_BEGIN_NAMESPACE
+
+/**
+ * @memo read-only view of the rest of a file, for fast parsers
+ * @type class
+ *
+ * Maps the remainder of a stream, from its current position to the
+ * end, into memory.  Regular files are mapped with #mmap()# where
+ * #<sys/mman.h># exists; pipes (such as the decompressed files of
+ * #TextDataFile#) are read into a buffer instead.  Either way the
+ * stream is left at its end.
+ *
+ * The static members scan numbers directly from the view, without
+ * copying lines into fixed buffers.  Blanks are spaces, tabs and
+ * carriage returns; newlines end a line and are never skipped by
+ * #skipBlanks()#.
+ *
+ * @author agent
+ * @version #$Id$#
+ */
+class MappedFile {
+private:
+  const char * data;
+  size_t nBytes;
+  void * mapBase;      // start of the mapping, 0 if data is a buffer
+  size_t mapLength;
+  char * buffer;       // the copied bytes if not mapped
+
+  MappedFile( const MappedFile& );
+  MappedFile& operator=( const MappedFile& );
+
+public:
+  /// default constructor
+  MappedFile();
+  /// destructor, unmaps
+  ~MappedFile();
+
+  /**
+   * map from the current position of #stream# to its end.
+   * @return false on a read or memory error.
+   */
+  bool map( FILE * stream );
+  /// release the view
+  void unmap();
+
+  /// first byte
+  const char * begin() const { return data; }
+  /// one past the last byte
+  const char * end() const { return data + nBytes; }
+  /// number of bytes
+  size_t size() const { return nBytes; }
+  /// true if the view is mapped rather than copied
+  bool isMapped() const { return mapBase != 0; }
+
+  /**
+   * cut #[begin,end)# into #nParts# pieces of about the same size that
+   * start at the beginning of a line.  Sets #bounds[0..nParts]#; some
+   * pieces may be empty.
+   */
+  static void splitAtLines( const char * begin, const char * end, const int nParts,
+			    vector< const char * >& bounds );
+
+  /// skip spaces, tabs and carriage returns
+  static const char * skipBlanks( const char * p, const char * end );
+  /// skip past the next newline, or to #end#
+  static const char * skipLine( const char * p, const char * end );
+
+  /**
+   * scan an optionally signed decimal integer at #p#.
+   * @return the position after it, or 0 if there is none or it
+   *         overflows an int.
+   */
+  static const char * scanInt( const char * p, const char * end, int& value );
+
+  /**
+   * scan a floating point number at #p#, as #strtod()# would, but
+   * also accepting Fortran's #D# exponents.  Numbers with at most 15
+   * significant digits and small exponents are converted directly;
+   * the result is correctly rounded either way.
+   * @return the position after it, or 0 if there is none.
+   */
+  static const char * scanDouble( const char * p, const char * end, double& value );
+};
+
+inline const char *
+MappedFile::skipBlanks( const char * p, const char * end ) {
+  while ( ( p < end ) && ( ( *p == ' ' ) || ( *p == '\t' ) || ( *p == '\r' ) ) ) {
+    ++p;
+  }
+  return p;
+}
+
+inline const char *
+MappedFile::skipLine( const char * p, const char * end ) {
+  while ( ( p < end ) && ( *p != '\n' ) ) {
+    ++p;
+  }
+  return ( p < end ) ? p+1 : end;
+}
+
+inline const char *
+MappedFile::scanInt( const char * p, const char * end, int& value ) {
+  bool negative = false;
+  if ( ( p < end ) && ( ( *p == '-' ) || ( *p == '+' ) ) ) {
+    negative = ( *p == '-' );
+    ++p;
+  }
+  if ( ( p == end ) || ( *p < '0' ) || ( *p > '9' ) ) {
+    return 0;
+  }
+  unsigned int v = 0;
+  do {
+    const unsigned int digit = *p - '0';
+    if ( v > ( 2147483647u - digit ) / 10u ) {
+      return 0;
+    }
+    v = 10u * v + digit;
+    ++p;
+  } while ( ( p < end ) && ( *p >= '0' ) && ( *p <= '9' ) );
+  value = negative ? -(int) v : (int) v;
+  return p;
+}
+
+SPINDLE_END_NAMESPACE
+
+#endif
@@ -4,14 +4,10 @@
 
 #ifdef REQUIRE_OLD_CXX_HEADER_SUFFIX
 #include "vector.h"
-#include "function.h"
 #include <strstream.h>
-#include "algo.h" // sort
 #else
 #include <vector>
-#include <functional>
 #include <strstream>
-#include <algorithm>  // sort
 using namespace std;
 #endif
 
@@ -21,6 +17,10 @@ using namespace std;
 
 #include "spindle/MatrixMarketFile.h"
 
+#ifndef SPINDLE_MAPPED_FILE_H_
+#include "spindle/MappedFile.h"
+#endif
+
 
 #ifndef SPINDLE_MATRIX_UTILS_H_
 #include "spindle/MatrixUtils.h"
@@ -33,41 +33,163 @@ using namespace SPINDLE_NAMESPACE;
 #define BUF_SIZE 2048
 static char buffer[BUF_SIZE];
 
-// a little struct to help with converting <I,J,V> triples to compressed column matrices
-struct IJVtriples {
-  int i;
-  int j;
-  int intval; // integer value
-  double rval; // real value
-  double ival; // imaginary value
-  // constructors
-  IJVtriples(int I, int J) 
-    : i(I), j(J), intval(0), rval(0), ival(0) {}
-  IJVtriples(int I, int J, int INTVAL) 
-    : i(I), j(J), intval(INTVAL), rval(0), ival(0) {}
-  IJVtriples(int I, int J, double RVAL) 
-    : i(I), j(J), intval(0), rval(RVAL), ival(0) {}
-  IJVtriples(int I, int J, double RVAL, double IVAL) 
-    : i(I), j(J), intval(0), rval(RVAL), ival(IVAL) {}
+// first element of a vector, or 0 if it is empty
+template< class T >
+static inline T * 
+MatrixMarket_first( vector< T >& v ) {
+  return ( v.empty() ) ? 0 : &v[0];
+}
+
+//
+// parse the entries of one piece of the file into <I,J,V> triples,
+// zero based.  Stops at the first bad line.
+//
+struct MatrixMarket_parse {
+  vector< const char * > bounds;  // pieces of the file
+  int nValues;                    // numbers after I and J on each line
+  int nRows;
+  int nCols;
+  vector< vector< int > > rows;   // for each piece
+  vector< vector< int > > cols;
+  vector< vector< double > > vals; // first value only, empty if pattern
+  vector< const char * > badLine; // for each piece, 0 if none
 };
 
-// a function object that sorts <I,J,V> triples in column major order
-struct IJVtriplesColSort : public binary_function< IJVtriples*, IJVtriples*, bool > {
-  bool operator()(const IJVtriples& first, const IJVtriples& second ) const {
-    if ( first.j < second.j ) { 
-      return true;
-    } else if ( first.j > second.j ) { 
-      return false;
-    } else { 
-      if ( first.i < second.i ) { 
-	return true;
-      } else { 
-	return false;
+static void 
+MatrixMarket_parseTask( void * arg, const int begin, const int end, const int ) {
+  MatrixMarket_parse& parse = *(MatrixMarket_parse *) arg;
+  for( int piece=begin; piece<end; ++piece ) { 
+    vector< int >& I = parse.rows[ piece ];
+    vector< int >& J = parse.cols[ piece ];
+    vector< double >& V = parse.vals[ piece ];
+    const char * p = parse.bounds[ piece ];
+    const char * last = parse.bounds[ piece+1 ];
+    // about 8 bytes per pattern entry, 16 with a value
+    I.reserve( ( last - p ) / ( parse.nValues ? 16 : 8 ) + 1 );
+    J.reserve( I.capacity() );
+    if ( parse.nValues ) { 
+      V.reserve( I.capacity() );
+    }
+    while ( p < last ) { 
+      const char * line = p;
+      p = MappedFile::skipBlanks( p, last );
+      if ( ( p == last ) || ( *p == '\n' ) || ( *p == '%' ) ) {
+	// blank line or comment
+	p = MappedFile::skipLine( p, last );
+	continue;
+      }
+      int i;
+      int j;
+      double val = 0.0;
+      p = MappedFile::scanInt( p, last, i );
+      if ( p != 0 ) { 
+	p = MappedFile::scanInt( MappedFile::skipBlanks( p, last ), last, j );
+      }
+      {for( int k=0; ( p != 0 ) && ( k<parse.nValues ); ++k ) { 
+	double temp;
+	p = MappedFile::scanDouble( MappedFile::skipBlanks( p, last ), last, temp );
+	if ( k == 0 ) { 
+	  val = temp;
+	}
+      }}
+      if ( ( p == 0 ) || ( i < 1 ) || ( i > parse.nRows ) || 
+	   ( j < 1 ) || ( j > parse.nCols ) ) {
+	parse.badLine[ piece ] = line;
+	return;
       }
+      I.push_back( i-1 );
+      J.push_back( j-1 );
+      if ( parse.nValues ) { 
+	V.push_back( val );
+      }
+      p = MappedFile::skipLine( p, last );
     }
   }
+}
+
+//
+// a stable counting sort of triples by key, done in pieces.  Each
+// piece counts its own keys, the counts are added up key by key, then
+// each piece moves its triples to their place.
+//
+struct MatrixMarket_sort {
+  int nKeys;
+  vector< const int * > key;       // for each piece
+  vector< const int * > other;
+  vector< const double * > val;    // 0 if pattern
+  vector< int > length;
+  vector< int > count;             // nKeys per piece, then positions
+  int * outKey;                    // may be 0
+  int * outOther;
+  double * outVal;                 // may be 0
 };
 
+static void
+MatrixMarket_countTask( void * arg, const int begin, const int end, const int ) {
+  MatrixMarket_sort& sort = *(MatrixMarket_sort *) arg;
+  for( int piece=begin; piece<end; ++piece ) { 
+    int * count = MatrixMarket_first( sort.count ) + piece * sort.nKeys;
+    const int * key = sort.key[ piece ];
+    const int n = sort.length[ piece ];
+    {for( int k=0; k<sort.nKeys; ++k ) { 
+      count[k] = 0;
+    }}
+    {for( int i=0; i<n; ++i ) { 
+      ++count[ key[i] ];
+    }}
+  }
+}
+
+static void
+MatrixMarket_moveTask( void * arg, const int begin, const int end, const int ) {
+  MatrixMarket_sort& sort = *(MatrixMarket_sort *) arg;
+  for( int piece=begin; piece<end; ++piece ) { 
+    int * position = MatrixMarket_first( sort.count ) + piece * sort.nKeys;
+    const int * key = sort.key[ piece ];
+    const int * other = sort.other[ piece ];
+    const double * val = sort.val[ piece ];
+    const int n = sort.length[ piece ];
+    for( int i=0; i<n; ++i ) { 
+      const int dest = position[ key[i] ]++;
+      if ( sort.outKey ) { 
+	sort.outKey[ dest ] = key[i];
+      }
+      sort.outOther[ dest ] = other[i];
+      if ( sort.outVal ) { 
+	sort.outVal[ dest ] = ( val ) ? val[i] : 0.0;
+      }
+    }
+  }
+}
+
+//
+// sort the triples, and set start[k] to the first position of key k
+// (if start isn't 0).
+//
+static void
+MatrixMarket_countingSort( const ThreadTeam& team, MatrixMarket_sort& sort, 
+			   int * start ) {
+  const int nPieces = sort.length.size();
+  sort.count.resize( nPieces * sort.nKeys );
+  team.run( MatrixMarket_countTask, &sort, nPieces );
+  int total = 0;
+  for( int k=0; k<sort.nKeys; ++k ) { 
+    if ( start ) { 
+      start[k] = total;
+    }
+    for( int piece=0; piece<nPieces; ++piece ) { 
+      int& count = sort.count[ piece * sort.nKeys + k ];
+      const int n = count;
+      count = total;
+      total += n;
+    }
+  }
+  if ( start ) { 
+    start[ sort.nKeys ] = total;
+  }
+  team.run( MatrixMarket_moveTask, &sort, nPieces );
+}
+
 #define __FUNC__ "bool MatrixMarketFile::read( FILE * stream )"
 bool 
 MatrixMarketFile::read( FILE * stream ) {
@@ -95,34 +217,60 @@ MatrixMarketFile::read( FILE * stream ) {
       format_qualifier = COORDINATE;
     }
   }
+  if ( format_qualifier == ARRAY ) { 
+    ERROR( SPINDLE_ERROR_FILE_MISCERR,"Cannot read array format, only coordinate.");
+    FRETURN( false );
+  }
+  if ( ( nRows < 0 ) || ( nCols < 0 ) || ( nNonZeros < 0 ) ) { 
+    ERROR( SPINDLE_ERROR_FILE_MISCERR,"Negative size: %d x %d with %d nonzeros.", 
+	   nRows, nCols, nNonZeros );
+    FRETURN( false );
+  }
+
+  // 
+  // Get the rest of the file in memory
+  //
+  MappedFile body;
+  if ( !body.map( stream ) ) { 
+    ERROR( SPINDLE_ERROR_FILE_READ, "Cannot read entries." );
+    FRETURN( false );
+  }
 
   //
-  // Now read in the first row of values, checking to
-  // see how much we have.
+  // Now check the first entry for the number (and type) of tokens
   // 
-  vector< IJVtriples > v;
-  v.reserve( nNonZeros );
-  { 
-    // test the next line for the number (and type) of tokens
-    istrstream ist( fgets( buffer, BUF_SIZE, stream ) );
+  int nValues = 0;
+  {
+    const char * p = MappedFile::skipBlanks( body.begin(), body.end() );
+    while( ( p < body.end() ) && ( *p == '\n' ) ) { 
+      p = MappedFile::skipBlanks( p + 1, body.end() );
+    }
+    const char * eol = p;
+    while ( ( eol < body.end() ) && ( *eol != '\n' ) ) { 
+      ++eol;
+    }
+    string first_line( p, eol );
+    istrstream ist( first_line.c_str() );
     string str_i, str_j, str_real, str_img;
-    if ( !( ist >> str_i ) ) { 
-      ERROR( SPINDLE_ERROR_FILE_MISCERR,"Cannot read first row entry.");
-      FRETURN( false );
-    } 
-    if ( !( ist >> str_j ) ) { 
-      ERROR( SPINDLE_ERROR_FILE_MISCERR,"Cannot read first column index.");
-      FRETURN( false );
-    } 
+    if ( nNonZeros > 0 ) { 
+      if ( !( ist >> str_i ) ) { 
+	ERROR( SPINDLE_ERROR_FILE_MISCERR,"Cannot read first row entry.");
+	FRETURN( false );
+      } 
+      if ( !( ist >> str_j ) ) { 
+	ERROR( SPINDLE_ERROR_FILE_MISCERR,"Cannot read first column index.");
+	FRETURN( false );
+      } 
+    }
     if ( !( ist >> str_real ) ) { 
       if ( field_qualifier == UNKNOWN_FIELD ) { 
 	field_qualifier = PATTERN;
-      } else if ( field_qualifier != PATTERN ) { 
+      } else if ( ( field_qualifier != PATTERN ) && ( nNonZeros > 0 ) ) { 
 	WARNING( "cannot read values from non-pattern file:  Assuming field=pattern.");
 	field_qualifier = PATTERN;
       }
-    } else { // if str_real has a value
-      if ( str_real.find('.') == string::npos ) { 
+    } else if ( field_qualifier == UNKNOWN_FIELD ) { 
+      if ( str_real.find_first_of(".eEdD") == string::npos ) { 
 	// no decimal point
 	field_qualifier = INTEGER;
       } else { 
@@ -134,83 +282,106 @@ MatrixMarketFile::read( FILE * stream ) {
       }      
     }
     if ( field_qualifier == COMPLEX ) { 
-      v.push_back( IJVtriples( atoi(str_i.c_str()) -1,
-			       atoi(str_j.c_str()) -1,
-			       atof(str_real.c_str()),
-			       atof(str_img.c_str()) ) );
-    } else if ( field_qualifier == REAL ) { 
-      v.push_back( IJVtriples( atoi(str_i.c_str()) -1,
-			       atoi(str_j.c_str()) -1,
-			       atof(str_real.c_str()) ) );
-    } else if ( field_qualifier == INTEGER ) { 
-      v.push_back( IJVtriples( atoi(str_i.c_str()) -1,
-			       atoi(str_j.c_str()) -1,
-			       atoi(str_real.c_str()) ) );
-    } else if ( field_qualifier == PATTERN ) { 
-      v.push_back( IJVtriples( atoi(str_i.c_str()) -1,
-			       atoi(str_j.c_str()) -1) );
+      nValues = 2;
+    } else if ( ( field_qualifier == REAL ) || ( field_qualifier == INTEGER ) ) { 
+      nValues = 1;
     }
   }
 
-  //    
-  // now scan in the rest of them.
   //
+  // Parse pieces of the file concurrently.
+  //
+  const int nPieces = team.queryNThreads();
+  MatrixMarket_parse parse;
+  MappedFile::splitAtLines( body.begin(), body.end(), nPieces, parse.bounds );
+  parse.nValues = nValues;
+  parse.nRows = nRows;
+  parse.nCols = nCols;
+  parse.rows.resize( nPieces );
+  parse.cols.resize( nPieces );
+  parse.vals.resize( nPieces );
+  parse.badLine.resize( nPieces, (const char *) 0 );
+  team.run( MatrixMarket_parseTask, &parse, nPieces );
 
-  int I;
-  int J;
-  int INTVAL;
-  double RVAL;
-  double IVAL;
-  if (field_qualifier == COMPLEX ) { 
-    for(int i=1; i<nNonZeros; ++i ) {
-      fscanf( stream,"%d%d%lg%lg\n", &I, &J, &RVAL, &IVAL);
-      --I; --J;
-      v.push_back( IJVtriples( I, J, RVAL, IVAL ) );
-    }
-  } else if ( field_qualifier == REAL ) { 
-    for(int i=1; i<nNonZeros; ++i ) {
-      fscanf( stream,"%d%d%lg\n", &I, &J, &RVAL );
-      --I; --J;
-      v.push_back( IJVtriples( I, J, RVAL ) );
-    }
-  } else if ( field_qualifier == INTEGER ) { 
-    for(int i=1; i<nNonZeros; ++i ) {
-      fscanf( stream,"%d%d%d\n", &I, &J, &INTVAL );
-      --I; --J;
-      v.push_back( IJVtriples( I, J, INTVAL ) );
-    }
-  } else if ( field_qualifier == PATTERN ) {
-    for(int i=1; i<nNonZeros; ++i ) {
-      fscanf( stream,"%d%d\n", &I, &J );
-      --I; --J;
-      v.push_back( IJVtriples( I, J ) );
+  int nFound = 0;
+  for( int piece=0; piece<nPieces; ++piece ) { 
+    nFound += parse.rows[ piece ].size();
+    const char * bad = parse.badLine[ piece ];
+    if ( ( bad != 0 ) && ( nFound >= nNonZeros ) ) { 
+      // trailing lines after the last entry are ignored
+      break;
+    } else if ( bad != 0 ) { 
+      int lineNumber = 1;
+      for( const char * p=body.begin(); p<bad; ++p ) { 
+	if ( *p == '\n' ) { 
+	  ++lineNumber;
+	}
+      }
+      ERROR( SPINDLE_ERROR_FILE_MISCERR, 
+	     "Cannot read entry on line %d after the size line.", lineNumber );
+      FRETURN( false );
     }
   }
+  if ( nFound < nNonZeros ) { 
+    ERROR( SPINDLE_ERROR_FILE_TOOSHORT, "File terminated prematurely. Got %d out of %d.  ", 
+	   nFound, nNonZeros );
+    FRETURN( false );
+  }
+  body.unmap();
 
-  // now sort it
-  sort( v.begin(), v.end(), IJVtriplesColSort() );
+  //
+  // Sort by row, then (stably) by column, in pieces.  Any entries 
+  // past nNonZeros are ignored.
+  //
+  vector< int > rowSorted_i( nNonZeros );
+  vector< int > rowSorted_j( nNonZeros );
+  vector< double > rowSorted_v( ( nValues ) ? nNonZeros : 0 );
+  {
+    MatrixMarket_sort byRow;
+    byRow.nKeys = nRows;
+    int remaining = nNonZeros;
+    for( int piece=0; piece<nPieces; ++piece ) { 
+      const int n = ( (int) parse.rows[ piece ].size() < remaining ) ? 
+	parse.rows[ piece ].size() : remaining;
+      remaining -= n;
+      byRow.key.push_back( MatrixMarket_first( parse.rows[ piece ] ) );
+      byRow.other.push_back( MatrixMarket_first( parse.cols[ piece ] ) );
+      byRow.val.push_back( MatrixMarket_first( parse.vals[ piece ] ) );
+      byRow.length.push_back( n );
+    }
+    byRow.outKey = MatrixMarket_first( rowSorted_i );
+    byRow.outOther = MatrixMarket_first( rowSorted_j );
+    byRow.outVal = MatrixMarket_first( rowSorted_v );
+    MatrixMarket_countingSort( team, byRow, 0 );
+  }
+  parse.rows.clear();
+  parse.cols.clear();
+  parse.vals.clear();
 
   colPtr.resize(nCols + 1 );
   rowIdx.resize( nNonZeros );
   realValues.resize( nNonZeros );
-  int lastCol = -1;
-  IJVtriples* cur = v.begin();
-  for ( int i=0; i<nNonZeros; ++i ) { 
-    if ( cur->j != lastCol ) {
-      lastCol = cur->j;
-      colPtr[ lastCol ] = i;
+  {
+    MatrixMarket_sort byCol;
+    byCol.nKeys = nCols;
+    const int chunk = ( nNonZeros + nPieces - 1 ) / nPieces;
+    for( int start=0; start<nNonZeros; start += chunk ) {
+      byCol.key.push_back( &rowSorted_j[ start ] );
+      byCol.other.push_back( &rowSorted_i[ start ] );
+      byCol.val.push_back( ( nValues ) ? &rowSorted_v[ start ] : 0 );
+      byCol.length.push_back( ( nNonZeros - start < chunk ) ? nNonZeros - start : chunk );
     }
-    rowIdx[i] = cur->i;
-    realValues[i] = cur->rval;
-    ++cur;
+    byCol.outKey = 0;
+    byCol.outOther = rowIdx.begin();
+    byCol.outVal = realValues.begin();
+    MatrixMarket_countingSort( team, byCol, colPtr.begin() );
   }
-  colPtr[ nCols ] = nNonZeros; 
   
   if ( symmetry_qualifier == SYMMETRIC ||
        symmetry_qualifier == HERMITIAN ) {
     MatrixUtils::makeSymmetric( this );
   }
-  return true;
+  FRETURN( true );
 }
 #undef __FUNC__
 
@@ -34,6 +34,10 @@
 #include "spindle/MatrixBase.h"
 #endif
 
+#ifndef SPINDLE_THREAD_TEAM_H_
+#include "spindle/ThreadTeam.h"
+#endif
+
 SPINDLE_BEGIN_NAMESPACE
 
 class MatrixMarketFile : public MatrixBase, public TextDataFile {
@@ -49,17 +53,30 @@ protected:
   // reads the specifications, if any
   // returns first line not beginning with "%"
 
+  ThreadTeam team;
+  // parses the entries and sorts them into columns
+
 public:
   MatrixMarketFile() : standard_header(0), comments(""), 
     format_qualifier(UNKNOWN_FORMAT), 
     field_qualifier( UNKNOWN_FIELD), 
-    symmetry_qualifier(UNKNOWN_SYMMETRY){}
+    symmetry_qualifier(UNKNOWN_SYMMETRY){ team.setMinChunkSize( 1 ); }
   virtual ~MatrixMarketFile() {}
   virtual bool read( FILE * stream );
   virtual bool write( FILE * stream );
 
   bool read() { return read( fp ); }
   bool write() { return write( fp ); }
+
+  /**
+   * read coordinate files with up to #nThreads# threads.  The entries
+   * are split into that many pieces at line boundaries, parsed
+   * concurrently, and sorted into columns with a counting sort.  The
+   * matrix is the same for any number of threads.
+   */
+  bool setNThreads( const int nThreads ) { return team.setNThreads( nThreads ); }
+  /** query the number of threads used by read() */
+  int queryNThreads() const { return team.queryNThreads(); }
 };
 
 SPINDLE_END_NAMESPACE
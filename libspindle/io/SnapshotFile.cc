@@ -0,0 +1,430 @@
+//
+// SnapshotFile.cc
+//
+//  $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+// =========================================================================
+//
+//
+
+#include "spindle/SnapshotFile.h"
+
+#ifndef SPINDLE_SYSTEM_H_
+#include "spindle/SpindleSystem.h"
+#endif
+
+#ifndef SPINDLE_GRAPH_H_
+#include "spindle/Graph.h"
+#endif
+
+#ifndef SPINDLE_MATRIX_H_
+#include "spindle/Matrix.h"
+#endif
+
+#include <string.h>
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+//
+// The header is 16 ints:
+//   [0..1]  magic "SPNDLSNP"
+//   [2]     0x01020304 in the writer's byte order
+//   [3]     version
+//   [4]     kind
+//   [5..7]  dims
+//   [8..11] lengths of the four arrays
+//   [12]    flags: SnapshotFile_checked if write() found the arrays valid
+//   [13..15] zero
+// Array k starts at the first multiple of 64 bytes after array k-1.
+//
+static const char SnapshotFile_magic[8] = { 'S','P','N','D','L','S','N','P' };
+static const int SnapshotFile_byteOrder = 0x01020304;
+static const int SnapshotFile_headerSize = 16;
+static const size_t SnapshotFile_align = 64;
+static const int SnapshotFile_checked = 1;
+
+static size_t
+SnapshotFile_roundUp( const size_t n ) {
+  return ( n + SnapshotFile_align - 1 ) / SnapshotFile_align * SnapshotFile_align;
+}
+
+template < class T >
+static void
+SnapshotFile_swap( T * array, const int n ) {
+  {for( int i=0; i<n; ++i ) {
+    char * p = (char *) ( array + i );
+    {for( size_t j=0; j<sizeof(T)/2; ++j ) {
+      const char temp = p[j];
+      p[j] = p[ sizeof(T) - 1 - j ];
+      p[ sizeof(T) - 1 - j ] = temp;
+    }}
+  }}
+}
+
+//
+// write array, padded with zeros to a multiple of 64 bytes.
+//
+template < class T >
+static bool
+SnapshotFile_write( FILE * stream, const T * array, const int n ) {
+  static const char zeros[ 64 ] = { 0 };
+  if ( ( n > 0 ) && ( fwrite( array, sizeof(T), n, stream ) != (size_t) n ) ) {
+    return false;
+  }
+  const size_t nBytes = n * sizeof(T);
+  const size_t nPad = SnapshotFile_roundUp( nBytes ) - nBytes;
+  return ( nPad == 0 ) || ( fwrite( zeros, 1, nPad, stream ) == nPad );
+}
+
+//
+// point dest at the n T's at p: borrowed if they can be used where
+// they are, else copied (and swapped).  Returns true if borrowed.
+//
+template < class T >
+static bool
+SnapshotFile_view( const char * p, const int n, const bool swapped,
+		   SharedArray<T>& dest ) {
+  if ( n == 0 ) {
+    dest.reset();
+    return true;
+  }
+  if ( ( !swapped ) && ( ( (size_t) p ) % sizeof(T) == 0 ) ) {
+    dest.borrow( (const T *) p, n );
+    return true;
+  }
+  dest.resize( n );
+  T * array = dest.begin();
+  memcpy( array, p, n * sizeof(T) );
+  if ( swapped ) {
+    SnapshotFile_swap( array, n );
+  }
+  return false;
+}
+
+// true iff every one of the n entries of array is in [0,bound)
+static bool
+SnapshotFile_inRange( const int * array, const int n, const int bound ) {
+  {for( int i=0; i<n; ++i ) {
+    if ( ( array[i] < 0 ) || ( array[i] >= bound ) ) {
+      return false;
+    }
+  }}
+  return true;
+}
+
+// true iff ptr[0..n] runs from 0 without going back, and every index
+// in idx[0,ptr[n]) is in [0,bound)
+static bool
+SnapshotFile_isValid( const int * ptr, const int n, const int * idx, const int bound ) {
+  if ( ptr[0] != 0 ) {
+    return false;
+  }
+  {for( int i=0; i<n; ++i ) {
+    if ( ptr[i+1] < ptr[i] ) {
+      return false;
+    }
+  }}
+  return SnapshotFile_inRange( idx, ptr[n], bound );
+}
+
+// true iff the graph is one Graph::validate() would leave as it is:
+// every row strictly increasing, without the vertex itself
+static bool
+SnapshotFile_isValidGraph( const int * adjHead, const int nVtxs, const int * adjList ) {
+  if ( ! SnapshotFile_isValid( adjHead, nVtxs, adjList, nVtxs ) ) {
+    return false;
+  }
+  {for( int i=0; i<nVtxs; ++i ) {
+    {for( int j=adjHead[i]; j<adjHead[i+1]; ++j ) {
+      if ( ( adjList[j] == i ) || ( ( j > adjHead[i] ) && ( adjList[j] <= adjList[j-1] ) ) ) {
+	return false;
+      }
+    }}
+  }}
+  return true;
+}
+
+#ifdef __FUNC__
+#undef __FUNC__
+#endif
+
+SnapshotFile::SnapshotFile() {
+  reset();
+}
+
+SnapshotFile::~SnapshotFile() {
+  reset();
+}
+
+void
+SnapshotFile::reset() {
+  ptr.reset();
+  idx.reset();
+  vtxWeight.reset();
+  edgeWeight.reset();
+  realValues.reset();
+  imgValues.reset();
+  data.unmap();
+  kind = EMPTY;
+  dims[0] = dims[1] = dims[2] = 0;
+  zeroCopy = false;
+  checked = false;
+}
+
+#define __FUNC__ "bool SnapshotFile::read( FILE * stream )"
+bool
+SnapshotFile::read( FILE * stream ) {
+  FENTER;
+  reset();
+  if ( ! data.map( stream ) ) {
+    ERROR( SPINDLE_ERROR_FILE_READ, "Cannot read snapshot.  " );
+    FRETURN( false );
+  }
+  int header[ SnapshotFile_headerSize ];
+  if ( data.size() < sizeof( header ) ) {
+    ERROR( SPINDLE_ERROR_FILE_TOOSHORT, "File is too short for a snapshot.  " );
+    FRETURN( false );
+  }
+  memcpy( header, data.begin(), sizeof( header ) );
+  if ( memcmp( header, SnapshotFile_magic, sizeof( SnapshotFile_magic ) ) != 0 ) {
+    ERROR( SPINDLE_ERROR_FILE_MISCERR, "File is not a snapshot.  " );
+    FRETURN( false );
+  }
+  bool swapped = false;
+  if ( header[2] != SnapshotFile_byteOrder ) {
+    SnapshotFile_swap( header + 2, SnapshotFile_headerSize - 2 );
+    swapped = true;
+    if ( header[2] != SnapshotFile_byteOrder ) {
+      ERROR( SPINDLE_ERROR_FILE_MISCERR, "Snapshot has an unknown byte order.  " );
+      FRETURN( false );
+    }
+  }
+  if ( ( header[3] < 1 ) || ( header[3] > SNAPSHOT_VERSION ) ) {
+    ERROR( SPINDLE_ERROR_FILE_MISCERR, "Cannot read snapshot version %d.  ", header[3] );
+    FRETURN( false );
+  }
+  const int * n = header + 8;
+  const size_t size2 = ( header[4] == MATRIX ) ? sizeof(double) : sizeof(int);
+  bool consistent = ( n[0] >= 0 ) && ( n[1] >= 0 ) && ( n[2] >= 0 ) && ( n[3] >= 0 );
+  if ( header[4] == GRAPH ) {
+    consistent = consistent && ( header[5] > 0 ) && ( n[0] == header[5] + 1 ) &&
+      ( ( n[2] == 0 ) || ( n[2] == header[5] ) ) && ( ( n[3] == 0 ) || ( n[3] == n[1] ) );
+  } else if ( header[4] == MATRIX ) {
+    consistent = consistent && ( header[6] > 0 ) && ( n[0] == header[6] + 1 ) &&
+      ( n[1] == header[7] ) && ( ( n[2] == 0 ) || ( n[2] == n[1] ) ) &&
+      ( ( n[3] == 0 ) || ( n[3] == n[1] ) );
+  } else {
+    consistent = false;
+  }
+  if ( ! consistent ) {
+    ERROR( SPINDLE_ERROR_FILE_MISCERR, "Snapshot header is inconsistent.  " );
+    FRETURN( false );
+  }
+
+  // where the arrays are
+  size_t offset[5];
+  offset[0] = sizeof( header );
+  offset[1] = offset[0] + SnapshotFile_roundUp( n[0] * sizeof(int) );
+  offset[2] = offset[1] + SnapshotFile_roundUp( n[1] * sizeof(int) );
+  offset[3] = offset[2] + SnapshotFile_roundUp( n[2] * size2 );
+  offset[4] = offset[3] + n[3] * size2;
+  if ( data.size() < offset[4] ) {
+    ERROR( SPINDLE_ERROR_FILE_TOOSHORT, "Snapshot is %ld bytes short.  ",
+	   (long) ( offset[4] - data.size() ) );
+    FRETURN( false );
+  }
+
+  // borrow from the view (mapped, or the buffer read from a pipe)
+  // whatever needs no swapping or realigning
+  const char * base = data.begin();
+  zeroCopy = SnapshotFile_view( base + offset[0], n[0], swapped, ptr );
+  zeroCopy = SnapshotFile_view( base + offset[1], n[1], swapped, idx ) && zeroCopy;
+  if ( header[4] == GRAPH ) {
+    zeroCopy = SnapshotFile_view( base + offset[2], n[2], swapped, vtxWeight ) && zeroCopy;
+    zeroCopy = SnapshotFile_view( base + offset[3], n[3], swapped, edgeWeight ) && zeroCopy;
+  } else {
+    zeroCopy = SnapshotFile_view( base + offset[2], n[2], swapped, realValues ) && zeroCopy;
+    zeroCopy = SnapshotFile_view( base + offset[3], n[3], swapped, imgValues ) && zeroCopy;
+  }
+  zeroCopy = zeroCopy && data.isMapped();
+  // the pointers must run from 0 to the number of nonzeros without
+  // going back, so a Graph or Matrix never looks outside of the indices.
+  // If the writer checked that, only the ends are looked at.
+  const int * first = ptr.lend();
+  if ( ( first[0] != 0 ) || ( first[ n[0]-1 ] != n[1] ) ) {
+    ERROR( SPINDLE_ERROR_FILE_MISCERR, "Snapshot has %d nonzeros, but its pointers say %d.  ",
+	   n[1], first[ n[0]-1 ] - first[0] );
+    reset();
+    FRETURN( false );
+  }
+  checked = ( ( header[12] & SnapshotFile_checked ) != 0 );
+  {for( int i=1; ( !checked ) && ( i<n[0] ); ++i ) {
+    if ( first[i] < first[i-1] ) {
+      ERROR( SPINDLE_ERROR_FILE_MISCERR, "Snapshot pointer %d is less than the one before.  ", i );
+      reset();
+      FRETURN( false );
+    }
+  }}
+  kind = (Kind) header[4];
+  dims[0] = header[5];
+  dims[1] = header[6];
+  dims[2] = header[7];
+  FRETURN( true );
+}
+#undef __FUNC__
+
+#define __FUNC__ "bool SnapshotFile::write( FILE * stream, const GraphBase * graph )"
+bool
+SnapshotFile::write( FILE * stream, const GraphBase * graph ) {
+  FENTER;
+  if ( ( stream == 0 ) || ( graph == 0 ) || ( graph->queryNVtxs() <= 0 ) ) {
+    ERROR( SPINDLE_ERROR_ARG_BADPTR, "Need a file and a nonempty graph.  " );
+    FRETURN( false );
+  }
+  if ( graph->queryNBoundVtxs() != 0 ) {
+    ERROR( SPINDLE_ERROR_ARG_INVALID, "Cannot write a graph with boundary vertices.  " );
+    FRETURN( false );
+  }
+  const int nVtxs = graph->queryNVtxs();
+  const SharedArray<int>& adjHead = graph->getAdjHead();
+  const SharedArray<int>& adjList = graph->getAdjList();
+  const SharedArray<int>& vtxWeight = graph->getVtxWeight();
+  const SharedArray<int>& edgeWeight = graph->getEdgeWeight();
+  const int nNonZeros = adjHead[ nVtxs ];
+  int header[ SnapshotFile_headerSize ];
+  memset( header, 0, sizeof( header ) );
+  memcpy( header, SnapshotFile_magic, sizeof( SnapshotFile_magic ) );
+  header[2] = SnapshotFile_byteOrder;
+  header[3] = SNAPSHOT_VERSION;
+  header[4] = GRAPH;
+  header[5] = nVtxs;
+  header[6] = graph->queryNEdges();
+  header[8] = nVtxs + 1;
+  header[9] = nNonZeros;
+  header[10] = ( vtxWeight.size() >= nVtxs ) ? nVtxs : 0;
+  header[11] = ( edgeWeight.size() >= nNonZeros ) ? nNonZeros : 0;
+  if ( SnapshotFile_isValidGraph( adjHead.lend(), nVtxs, adjList.lend() ) ) {
+    header[12] = SnapshotFile_checked;
+  }
+  if ( ( fwrite( header, sizeof( header ), 1, stream ) != 1 ) ||
+       ( ! SnapshotFile_write( stream, adjHead.lend(), header[8] ) ) ||
+       ( ! SnapshotFile_write( stream, adjList.lend(), header[9] ) ) ||
+       ( ! SnapshotFile_write( stream, vtxWeight.lend(), header[10] ) ) ||
+       ( ( header[11] > 0 ) &&
+	 ( fwrite( edgeWeight.lend(), sizeof(int), header[11], stream ) != (size_t) header[11] ) ) ) {
+    ERROR( SPINDLE_ERROR_FILE_WRITE, "Cannot write snapshot.  " );
+    FRETURN( false );
+  }
+  FRETURN( true );
+}
+#undef __FUNC__
+
+#define __FUNC__ "bool SnapshotFile::write( FILE * stream, const MatrixBase * matrix )"
+bool
+SnapshotFile::write( FILE * stream, const MatrixBase * matrix ) {
+  FENTER;
+  if ( ( stream == 0 ) || ( matrix == 0 ) || ( matrix->queryNCols() <= 0 ) ) {
+    ERROR( SPINDLE_ERROR_ARG_BADPTR, "Need a file and a nonempty matrix.  " );
+    FRETURN( false );
+  }
+  const int nCols = matrix->queryNCols();
+  const SharedArray<int>& colPtr = matrix->getColPtr();
+  const SharedArray<int>& rowIdx = matrix->getRowIdx();
+  const SharedArray<double>& realValues = matrix->getRealValues();
+  const SharedArray<double>& imgValues = matrix->getImgValues();
+  const int nNonZeros = colPtr[ nCols ];
+  int header[ SnapshotFile_headerSize ];
+  memset( header, 0, sizeof( header ) );
+  memcpy( header, SnapshotFile_magic, sizeof( SnapshotFile_magic ) );
+  header[2] = SnapshotFile_byteOrder;
+  header[3] = SNAPSHOT_VERSION;
+  header[4] = MATRIX;
+  header[5] = matrix->queryNRows();
+  header[6] = nCols;
+  header[7] = nNonZeros;
+  header[8] = nCols + 1;
+  header[9] = nNonZeros;
+  header[10] = ( realValues.size() >= nNonZeros ) ? nNonZeros : 0;
+  header[11] = ( imgValues.size() >= nNonZeros ) ? nNonZeros : 0;
+  if ( SnapshotFile_isValid( colPtr.lend(), nCols, rowIdx.lend(), header[5] ) ) {
+    header[12] = SnapshotFile_checked;
+  }
+  if ( ( fwrite( header, sizeof( header ), 1, stream ) != 1 ) ||
+       ( ! SnapshotFile_write( stream, colPtr.lend(), header[8] ) ) ||
+       ( ! SnapshotFile_write( stream, rowIdx.lend(), header[9] ) ) ||
+       ( ! SnapshotFile_write( stream, realValues.lend(), header[10] ) ) ||
+       ( ( header[11] > 0 ) &&
+	 ( fwrite( imgValues.lend(), sizeof(double), header[11], stream ) != (size_t) header[11] ) ) ) {
+    ERROR( SPINDLE_ERROR_FILE_WRITE, "Cannot write snapshot.  " );
+    FRETURN( false );
+  }
+  FRETURN( true );
+}
+#undef __FUNC__
+
+#define __FUNC__ "bool SnapshotFile::lend( Graph * graph ) const"
+bool
+SnapshotFile::lend( Graph * graph ) const {
+  FENTER;
+  if ( ( graph == 0 ) || ( kind != GRAPH ) ) {
+    ERROR( SPINDLE_ERROR_ARG_INVALID, "Need a graph and a graph snapshot.  " );
+    FRETURN( false );
+  }
+  if ( checked ) {
+    // the writer found a valid graph, take it as it is
+    FRETURN( graph->borrow( dims[0], ptr.lend(), idx.lend(),
+			    vtxWeight.isNull() ? 0 : vtxWeight.lend(),
+			    edgeWeight.isNull() ? 0 : edgeWeight.lend(), true ) );
+  }
+  if ( ! SnapshotFile_inRange( idx.lend(), idx.size(), dims[0] ) ) {
+    ERROR( SPINDLE_ERROR_FILE_MISCERR, "Snapshot has a vertex out of range.  " );
+    FRETURN( false );
+  }
+  if ( ! graph->borrow( dims[0], ptr.lend(), idx.lend(),
+			vtxWeight.isNull() ? 0 : vtxWeight.lend(),
+			edgeWeight.isNull() ? 0 : edgeWeight.lend() ) ) {
+    FRETURN( false );
+  }
+  graph->validate();
+  FRETURN( graph->isValid() );
+}
+#undef __FUNC__
+
+#define __FUNC__ "bool SnapshotFile::lend( Matrix * matrix ) const"
+bool
+SnapshotFile::lend( Matrix * matrix ) const {
+  FENTER;
+  if ( ( matrix == 0 ) || ( kind != MATRIX ) ) {
+    ERROR( SPINDLE_ERROR_ARG_INVALID, "Need a matrix and a matrix snapshot.  " );
+    FRETURN( false );
+  }
+  if ( ( ! checked ) && ( ! SnapshotFile_inRange( idx.lend(), idx.size(), dims[0] ) ) ) {
+    ERROR( SPINDLE_ERROR_FILE_MISCERR, "Snapshot has a row out of range.  " );
+    FRETURN( false );
+  }
+  matrix->reset();
+  matrix->getColPtr().borrow( ptr );
+  matrix->getRowIdx().borrow( idx );
+  if ( realValues.notNull() ) {
+    matrix->getRealValues().borrow( realValues );
+  }
+  if ( imgValues.notNull() ) {
+    matrix->getImgValues().borrow( imgValues );
+  }
+  matrix->validate();
+  FRETURN( matrix->isValid() );
+}
+#undef __FUNC__
@@ -0,0 +1,157 @@
+//
+// SnapshotFile.h -- binary snapshots of Graphs and Matrices
+//
+//  $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+// =========================================================================
+//
+//
+
+#ifndef SPINDLE_SNAPSHOT_FILE_H_
+#define SPINDLE_SNAPSHOT_FILE_H_
+
+#ifndef SPINDLE_H_
+#include "spindle/spindle.h"
+#endif
+
+#ifndef SPINDLE_TEXT_DATA_FILE_H_
+#include "spindle/TextDataFile.h"
+#endif
+
+#ifndef SPINDLE_MAPPED_FILE_H_
+#include "spindle/MappedFile.h"
+#endif
+
+#ifndef SPINDLE_AUTO_ARRAY_H_
+#include "spindle/SharedArray.h"
+#endif
+
+SPINDLE_BEGIN_NAMESPACE
+
+class GraphBase;
+class MatrixBase;
+class Graph;
+class Matrix;
+
+/**
+ * @memo binary snapshot of a Graph or Matrix that loads without parsing
+ * @type class
+ *
+ * A snapshot is a 64 byte header followed by four arrays, each
+ * starting on a 64 byte boundary: #adjHead#, #adjList#, #vtxWeight#
+ * and #edgeWeight# of a Graph, or #colPtr#, #rowIdx#, #realValues#
+ * and #imgValues# of a Matrix.  Missing arrays have length zero.  The
+ * header records a version number and the byte order of the writer.
+ *
+ * #read()# maps the file (see MappedFile) and checks the header and
+ * that the pointers (#adjHead# or #colPtr#) never decrease.  #lend()#
+ * checks that every index is in range, then makes a Graph or Matrix
+ * borrow the mapped arrays and validates it; nothing is copied
+ * unless the Graph or Matrix later changes them, or the file comes
+ * from a pipe, was written on a machine of the other byte order, or
+ * is not aligned.  The SnapshotFile must outlive whatever borrows
+ * from it.
+ *
+ * #write()# marks the snapshot as checked if the arrays are those of
+ * a valid Graph (or have every row in range, for a Matrix).  A checked
+ * snapshot is trusted: #read()# and #lend()# skip the checks that look
+ * at every pointer and index, and a Graph lent from it is valid
+ * without #Graph::validate()#, so loading it takes time in the number
+ * of vertices only.  Only read checked snapshots that come from a
+ * writer you trust; a damaged one is not detected.
+ *
+ * It derives from TextDataFile for #open()# and #close()#, so a
+ * snapshot can be named by a file, a command piped from, or a
+ * compressed file like any other input; one that is not a plain file
+ * is read into memory instead of mapped.
+ *
+ * @author agent
+ * @version #$Id$#
+ */
+class SnapshotFile: public TextDataFile {
+public:
+  /// what a snapshot holds
+  enum Kind { EMPTY = 0, GRAPH = 1, MATRIX = 2 };
+  /// the version written, and the newest one read
+  static const int SNAPSHOT_VERSION = 1;
+
+private:
+  MappedFile data;
+  Kind kind;
+  int dims[3];                     // nVtxs, nEdges, 0 or nRows, nCols, nNonZeros
+  SharedArray<int> ptr;            // adjHead or colPtr
+  SharedArray<int> idx;            // adjList or rowIdx
+  SharedArray<int> vtxWeight;
+  SharedArray<int> edgeWeight;
+  SharedArray<double> realValues;
+  SharedArray<double> imgValues;
+  bool zeroCopy;
+  bool checked;                    // write() found the arrays valid
+
+  void reset();
+
+public:
+  /**@name constructors/destructors */
+  //@{
+  /// default constructor
+  SnapshotFile();
+  /// destructor, unmaps the file
+  ~SnapshotFile();
+  //@}
+
+  /**
+   * map a snapshot from the current position of #stream#.
+   * @return false if it is not a snapshot, is of a newer version,
+   *         is shorter than its header says, or its pointers decrease
+   *         (looked at only if it is not checked).
+   */
+  bool read( FILE * stream );
+  /// read from the opened file
+  bool read() { return read( fp ); }
+
+  /// write a graph.  It must have no boundary vertices.
+  bool write( FILE * stream, const GraphBase * graph );
+  /// write a matrix
+  bool write( FILE * stream, const MatrixBase * matrix );
+  /// write a graph to the opened file
+  bool write( const GraphBase * graph ) { return write( fp, graph ); }
+  /// write a matrix to the opened file
+  bool write( const MatrixBase * matrix ) { return write( fp, matrix ); }
+
+  /// what was read
+  Kind queryKind() const { return kind; }
+  /// true if the arrays were mapped, and none had to be copied
+  bool isZeroCopy() const { return zeroCopy; }
+  /// true if the writer checked the arrays, and they are trusted
+  bool isChecked() const { return checked; }
+
+  /**
+   * make #graph# borrow the arrays of a graph snapshot, and validate it
+   * unless the snapshot is checked.
+   * @return false if this is not a graph snapshot, a vertex is out of
+   *         range, or the graph is not valid.
+   */
+  bool lend( Graph * graph ) const;
+  /**
+   * make #matrix# borrow the arrays of a matrix snapshot, and validate
+   * it.  The rows of an unchecked snapshot are looked at first.
+   * @return false if this is not a matrix snapshot, a row is out of
+   *         range, or the matrix is not valid.
+   */
+  bool lend( Matrix * matrix ) const;
+};
+
+SPINDLE_END_NAMESPACE
+
+#endif
@@ -0,0 +1,202 @@
+//
+// BatchOrdering.cc
+//
+// $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+//
+
+#include "spindle/BatchOrdering.h"
+#include "spindle/OrderingAlgorithm.h"
+#include "spindle/PermutationMap.h"
+#include "spindle/Graph.h"
+
+#ifdef REQUIRE_OLD_CXX_HEADER_SUFFIX
+#include <algo.h>
+#else
+#include <algorithm>
+using namespace std;
+#endif
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+//
+// shared state of one call to BatchOrdering::execute()
+//
+struct BatchJob {
+  const Graph * const * graphs;
+  const int * order;      // indices of the graphs, largest first
+  int nGraphs;
+  volatile int next;      // position in order[] of the next graph to take
+  const BatchOrdering::EngineFactory * factory;
+  OrderingAlgorithm ** engines;
+  PermutationMap ** permutations;
+};
+
+//
+// The team runs one of these per thread.  Each takes graphs one at a
+// time until none are left, so a thread that draws small graphs
+// simply takes more of them.
+//
+static void
+BatchOrdering_workerTask( void * arg, const int, const int, const int threadID ) {
+  BatchJob * job = (BatchJob *) arg;
+  OrderingAlgorithm * engine = job->engines[ threadID ];
+  for(;;) {
+    int pos = job->next;
+    while( ( pos < job->nGraphs ) &&
+	   ( !ThreadTeam::compareAndSwap( &(job->next), pos, pos+1 ) ) ) {
+      pos = job->next;
+    }
+    if ( pos >= job->nGraphs ) {
+      return;
+    }
+    const int i = job->order[ pos ];
+    PermutationMap * perm = 0;
+    if ( job->factory->prepare( engine ) && engine->setGraph( job->graphs[i] ) &&
+	 engine->execute() ) {
+      perm = engine->givePermutation();
+    }
+    job->permutations[i] = perm;
+  }
+}
+
+// sorts graph indices by decreasing number of nonzeros
+class BatchOrdering_largerGraph {
+  const Graph * const * graphs;
+public:
+  BatchOrdering_largerGraph( const Graph * const * graphs_ ) : graphs( graphs_ ) {}
+  bool operator()( const int a, const int b ) const {
+    return graphs[a]->queryNNonZeros() > graphs[b]->queryNNonZeros();
+  }
+};
+
+BatchOrdering::BatchOrdering() {
+  factory = 0;
+  nFailed = 0;
+}
+
+BatchOrdering::BatchOrdering( EngineFactory * factory_ ) {
+  factory = 0;
+  nFailed = 0;
+  setEngineFactory( factory_ );
+}
+
+BatchOrdering::~BatchOrdering() {
+  deletePermutations();
+  deleteEngines();
+  delete factory;
+}
+
+void
+BatchOrdering::deleteEngines() {
+  {for( int i=0; i<(int) engines.size(); ++i ) {
+    delete engines[i];
+  }}
+  engines.resize( 0 );
+}
+
+void
+BatchOrdering::deletePermutations() {
+  {for( int i=0; i<(int) permutations.size(); ++i ) {
+    delete permutations[i];
+  }}
+  permutations.resize( 0 );
+  nFailed = 0;
+}
+
+bool
+BatchOrdering::setEngineFactory( EngineFactory * factory_ ) {
+  if ( factory_ == 0 ) { return false; }
+  if ( factory_ == factory ) { return true; }
+  deleteEngines();
+  delete factory;
+  factory = factory_;
+  return true;
+}
+
+bool
+BatchOrdering::setNThreads( const int nThreads ) {
+  if ( !team.setNThreads( nThreads ) ) { return false; }
+  team.setMinChunkSize( 1 );
+  return true;
+}
+
+bool
+BatchOrdering::execute( const Graph * const graphs[], const int nGraphs ) {
+  deletePermutations();
+  if ( ( factory == 0 ) || ( graphs == 0 ) || ( nGraphs < 0 ) ) { return false; }
+  {for( int i=0; i<nGraphs; ++i ) {
+    if ( ( graphs[i] == 0 ) || ( !graphs[i]->isValid() ) ) { return false; }
+  }}
+
+#ifdef SPINDLE_TRACE_IS_THREAD_SAFE
+  const ThreadTeam& workers = team;
+#else
+  // the engines trace their calls, order one graph after another
+  const ThreadTeam workers( 1 );
+#endif
+  int nWorkers = workers.queryNThreads();
+  nWorkers = ( nWorkers > nGraphs ) ? nGraphs : nWorkers;
+  while( (int) engines.size() < nWorkers ) {
+    OrderingAlgorithm * engine = factory->create();
+    if ( engine == 0 ) { return false; }
+    engines.push_back( engine );
+  }
+
+  vector<int> order( nGraphs );
+  {for( int i=0; i<nGraphs; ++i ) { order[i] = i; }}
+  stable_sort( order.begin(), order.end(), BatchOrdering_largerGraph( graphs ) );
+  permutations.resize( nGraphs, (PermutationMap*) 0 );
+  if ( nGraphs == 0 ) { return true; }
+
+  BatchJob job;
+  job.graphs = graphs;
+  job.order = &(order[0]);
+  job.nGraphs = nGraphs;
+  job.next = 0;
+  job.factory = factory;
+  job.engines = &(engines[0]);
+  job.permutations = &(permutations[0]);
+  workers.run( BatchOrdering_workerTask, &job, nWorkers );
+  // a worker that could not be started leaves its graphs to the others
+
+  {for( int i=0; i<nGraphs; ++i ) {
+    if ( permutations[i] == 0 ) { ++nFailed; }
+  }}
+  return ( nFailed == 0 );
+}
+
+const PermutationMap *
+BatchOrdering::getPermutation( const int i ) const {
+  if ( ( i < 0 ) || ( i >= (int) permutations.size() ) ) { return 0; }
+  return permutations[i];
+}
+
+PermutationMap *
+BatchOrdering::givePermutation( const int i ) {
+  if ( ( i < 0 ) || ( i >= (int) permutations.size() ) ) { return 0; }
+  PermutationMap * temp = permutations[i];
+  permutations[i] = 0;
+  return temp;
+}
+
+const OrderingAlgorithm *
+BatchOrdering::getEngine( const int threadID ) const {
+  if ( ( threadID < 0 ) || ( threadID >= (int) engines.size() ) ) { return 0; }
+  return engines[threadID];
+}
@@ -0,0 +1,169 @@
+//
+// BatchOrdering.h
+//
+// $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+//=======================================================================
+//
+//
+
+#ifndef SPINDLE_BATCH_ORDERING_H_
+#define SPINDLE_BATCH_ORDERING_H_
+
+#ifndef SPINDLE_H_
+#include "spindle/spindle.h"
+#endif
+
+#ifndef SPINDLE_THREAD_TEAM_H_
+#include "spindle/ThreadTeam.h"
+#endif
+
+#ifdef REQUIRE_OLD_CXX_HEADER_SUFFIX
+#include <vector.h>
+#else
+#include <vector>
+using std::vector;
+#endif
+
+SPINDLE_BEGIN_NAMESPACE
+
+class Graph;
+class PermutationMap;
+class OrderingAlgorithm;
+
+/**
+ * @memo orders many independent graphs on a team of threads
+ * @type class
+ *
+ * Each thread keeps one ordering engine and uses it for every graph it
+ * takes, so the arrays an engine keeps between runs are not allocated
+ * anew for each graph.  Idle threads take the next graph from a shared
+ * counter, largest graphs first.
+ *
+ * The engines come from an #EngineFactory#:
+ * #class MyFactory : public BatchOrdering::EngineFactory { #
+ * #public: #
+ * #  OrderingAlgorithm * create() const { #
+ * #    MinPriorityEngine * e = new MinPriorityEngine(); #
+ * #    e->setRandomizeGraph( false ); #
+ * #    return e; #
+ * #  } #
+ * #}; #
+ * #BatchOrdering batch( new MyFactory() ); #
+ * #batch.setNThreads( 4 ); #
+ * #batch.execute( graphs, nGraphs ); #
+ * #PermutationMap * perm = batch.givePermutation( 0 ); #
+ *
+ * NOTE: engines run concurrently, so an engine that shuffles its input
+ *       must not use the global random number generator.
+ *       #MinPriorityEngine# keeps its own, restarted from its seed for
+ *       every graph, so its orderings do not depend on the number of
+ *       threads whether or not its input is shuffled.
+ *
+ * @author agent
+ * @version #$Id$#
+ */
+class BatchOrdering {
+public:
+  /**
+   * @memo makes and prepares the engines of a BatchOrdering
+   * @type class
+   */
+  class EngineFactory {
+  public:
+    /** virtual destructor */
+    virtual ~EngineFactory() {}
+    /**
+     * @return a new engine with all options set, or 0 on error.
+     * Called once per thread, never concurrently.
+     */
+    virtual OrderingAlgorithm * create() const = 0;
+    /**
+     * called before each graph is set, on the engine's own thread.
+     * Override to set per-graph state again, such as a priority
+     * strategy that remembers its previous run.
+     * @return false to skip the graph.
+     */
+    virtual bool prepare( OrderingAlgorithm * engine ) const { return engine != 0; }
+  };
+
+private:
+  EngineFactory * factory;
+  ThreadTeam team;
+  vector< OrderingAlgorithm* > engines;   // one per thread
+  vector< PermutationMap* > permutations; // one per graph, 0 if it failed
+  int nFailed;
+
+  void deleteEngines();
+  void deletePermutations();
+
+public:
+  /** default constructor, requires setEngineFactory() */
+  BatchOrdering();
+
+  /** convenience constructor, takes ownership of #factory_# */
+  BatchOrdering( EngineFactory * factory_ );
+
+  /** destructor */
+  ~BatchOrdering();
+
+  /**
+   * set the factory for the engines.  Takes ownership of #factory_#
+   * and discards all engines made by a previous one.
+   */
+  bool setEngineFactory( EngineFactory * factory_ );
+
+  /**
+   * set the number of threads.  Engines are made as needed and are
+   * kept until the factory changes.
+   */
+  bool setNThreads( const int nThreads );
+
+  /** query the number of threads */
+  int queryNThreads() const { return team.queryNThreads(); }
+
+  /**
+   * order each of #graphs[0..nGraphs)#.  Discards the permutations of
+   * a previous batch that have not been given away.
+   * @return true iff every graph was ordered.
+   */
+  bool execute( const Graph * const graphs[], const int nGraphs );
+
+  /** number of graphs in the last batch */
+  int size() const { return permutations.size(); }
+
+  /** number of graphs in the last batch that could not be ordered */
+  int queryNFailed() const { return nFailed; }
+
+  /**
+   * grant const access to the permutation of #graphs[i]#, or 0 if
+   * it could not be ordered or was given away.
+   */
+  const PermutationMap * getPermutation( const int i ) const;
+
+  /**
+   * surrender the permutation of #graphs[i]#.  The caller must delete it.
+   */
+  PermutationMap * givePermutation( const int i );
+
+  /**
+   * grant const access to the engine of a thread, or 0 if it was not
+   * made yet.
+   */
+  const OrderingAlgorithm * getEngine( const int threadID ) const;
+};
+
+SPINDLE_END_NAMESPACE
+
+#endif
@@ -41,6 +41,26 @@ using namespace SPINDLE_NAMESPACE;
 #define DEBUG_TRACE 0
 //#endif
 
+//
+// Park and Miller's minimal standard generator, computed with Schrage's
+// method so that it does not overflow a 32 bit long.  Each engine uses
+// its own instead of the global rand(), which threads would share.
+//
+class MinPriorityEngine_random {
+private:
+  long state;
+public:
+  MinPriorityEngine_random( const unsigned int seed ) 
+    : state( (long)( seed % 2147483646u ) + 1 ) {}
+  long operator()( const long n ) {
+    state = 16807 * ( state % 127773 ) - 2836 * ( state / 127773 );
+    if ( state <= 0 ) { 
+      state += 2147483647;
+    }
+    return state % n;
+  }
+};
+
 bool
 MinPriorityEngine::setDelta( const int i ) {
   if ( (i<0) || (i>n) ) { 
@@ -55,11 +75,14 @@ MinPriorityEngine::setDelta( const int i ) {
 MinPriorityEngine::MinPriorityEngine() {
   incrementInstanceCount( MinPriorityEngine::MetaData );
   randomizeGraph = true;
+  randomSeed = 1;
+  nThreads = 1;
   qgraph = 0;
   degStruct = 0;
   priorityStrategy = 0;
   explicitOrder = 0;
   workVec = 0;
+  needNewQGraph = true;
   reset();
 }
 #undef __FUNC__
@@ -69,11 +92,14 @@ MinPriorityEngine::MinPriorityEngine( const Graph* graph ) {
   FENTER;
   incrementInstanceCount( MinPriorityEngine::MetaData );
   randomizeGraph = true;
+  randomSeed = 1;
+  nThreads = 1;
   qgraph = 0;
   degStruct = 0;
   priorityStrategy = 0;
   // workVec = 0;
   explicitOrder = 0;
+  needNewQGraph = true;
   reset();
   setGraph( graph );
   FEXIT;
@@ -93,6 +119,9 @@ bool
 MinPriorityEngine::setGraph( const Graph* graph ) {
   FENTER;
   FCALL OrderingAlgorithm::setGraph( graph );
+  // execute() refills the quotient graph, keeping its arrays
+  needNewQGraph = true;
+  purgedVtxs.resize( 0 );
   FRETURN( true );
 }
 #undef __FUNC__
@@ -148,6 +177,22 @@ MinPriorityEngine::reset() {
 }
 #undef __FUNC__
 
+void
+MinPriorityEngine::releaseMemory() { 
+  delete qgraph;
+  qgraph = 0;
+  delete degStruct;
+  degStruct = 0;
+  needNewQGraph = true;
+  VertexList().swap( reachableVtxs );
+  VertexList().swap( mergedVtxs );
+  VertexList().swap( workVtxList );
+  vector< pair< int, int > >().swap( purgedVtxs );
+  if ( priorityStrategy != 0 ) { 
+    priorityStrategy->releaseMemory();
+  }
+}
+
 #define __FUNC__ "bool MinPriorityEngine::setPriorityStrategy( MinPriorityStrategies* strategy )"
 bool MinPriorityEngine::setPriorityStrategy( MinPriorityStrategies* strategy ) { 
   FENTER;
@@ -190,25 +235,35 @@ bool MinPriorityEngine::execute() {
   // 1. if this is the first run for this graph, then
   // there are some additional details to take care of.
   //
-  if ( qgraph == 0 ) { 
+  if ( needNewQGraph ) { 
     //
     // 1.a assign the either the compressed or uncompressed
-    //     graph.
+    //     graph.  A quotient graph and bucket sorter left from 
+    //     a previous graph are refilled, not reallocated.
     //
     TRACE( SPINDLE_TRACE_DEBUG, "Creating Quotient Graph..." );
-    if ( useGraphCompression ) { 
-      qgraph = new QuotientGraph( coarseGraph );
-      n = coarseGraph->queryNVtxs();
+    const Graph * graph = ( useGraphCompression ) ? coarseGraph : fineGraph;
+    n = graph->queryNVtxs();
+    if ( qgraph == 0 ) { 
+      qgraph = new QuotientGraph( graph );
+      if ( nThreads > 1 ) { 
+	qgraph->setNThreads( nThreads );
+      }
     } else { 
-      qgraph = new QuotientGraph( fineGraph );
-      n = fineGraph->queryNVtxs();
+      qgraph->setGraph( graph );
     }
-    
-    if ( degStruct != 0 ) {
-      delete degStruct;
+    if ( !qgraph->isValid() ) { 
+      // too large for the offsets of the quotient graph
+      algorithmicState = INVALID;
+      return false;
     }
+    
     TRACE( SPINDLE_TRACE_DEBUG, "Creating BucketSorter...");
-    degStruct = new BucketSorter(n,n);
+    if ( degStruct == 0 ) {
+      degStruct = new BucketSorter(n,n);
+    } else { 
+      degStruct->resize(n,n);
+    }
     
     if ( explicitOrder != 0 ) { 
       delete[] explicitOrder;
@@ -217,6 +272,7 @@ bool MinPriorityEngine::execute() {
     
     reachableVtxs.reserve(n);
     mergedVtxs.reserve(n);
+    needNewQGraph = false;
   } // end 2
 
   timer.start(); 
@@ -257,14 +313,35 @@ bool MinPriorityEngine::execute() {
   FRETURN( true );
 }
 
+bool
+MinPriorityEngine::initializeStrategy( const int nVtxs ) {
+  if( priorityStrategy == 0 ) {
+    priorityStrategy = new MinPriority_ExternalDegree( nVtxs );
+  } else if ( priorityStrategy->querySize() != nVtxs ) { 
+    // set for a previous graph
+    priorityStrategy->setSize( nVtxs );
+  }
+  return true;
+}
+
+bool
+MinPriorityEngine::requireSetDiffs() {
+  return priorityStrategy->requireSetDiffs();
+}
+
+bool
+MinPriorityEngine::prioritize( const VertexList& reachable, 
+			       const QuotientGraph* g,
+			       BucketSorter* degreeStruct ) {
+  return priorityStrategy->prioritize( reachable, g, degreeStruct );
+}
+
 bool
 MinPriorityEngine::initialize() {
   // First set up the priority strategy if one is 
   // not specified.
-  if( priorityStrategy == 0 ) {
-    priorityStrategy = new MinPriority_ExternalDegree( n );
-  } 
-  if ( priorityStrategy->requireSetDiffs() ) { 
+  initializeStrategy( n );
+  if ( requireSetDiffs() ) { 
     // set differences are  L_e / L_i , where i is last eliminated vtx.
     // this is required for approximate minimum strategys.
     qgraph->enableSingleElimination();  // enables setDiffs and disables outmatching
@@ -294,7 +371,7 @@ MinPriorityEngine::initialize() {
     if ( explicitOrder == 0 ) { 
       for(int i=0; i<n; ++i) { 
 	if ( qgraph->isPrincipal(i) && ( !qgraph->isEliminated(i) ) ) {
-	  int curDeg = qgraph->snode_end(i) - qgraph->snode_begin(i);
+	  int curDeg = qgraph->lendNodeView(i).nSnodes();
 	  if ( curDeg <= maxDeg ) {   // if within tolerance
 	    temp.push_back( i );      //    add it to list
 	  } else {                    // else... get ready to purge from the qgraph
@@ -323,11 +400,12 @@ MinPriorityEngine::initialize() {
 
     // now suffle non-purged vtxs randomly 
     if ( ( explicitOrder == 0 ) && randomizeGraph ) { 
-      random_shuffle( temp.begin(), temp.end() );
+      MinPriorityEngine_random rng( randomSeed );
+      random_shuffle( temp.begin(), temp.end(), rng );
     }
 
     // insert them into the degree Structure
-    priorityStrategy->prioritize( temp, qgraph, degStruct );
+    prioritize( temp, qgraph, degStruct );
   }
 
   // If we have delayed vertices, remove these from the degreeStructure
@@ -433,7 +511,7 @@ MinPriorityEngine::run() {
 			    << current << "   reachable nodes = " << flush;
       if ( qgraph->eliminateSupernode(current) ) { // vertex elimination succeeds.
 	// remove its reachable set from consideration
-	for( const int* cur=qgraph->snode_begin(current), *stop=qgraph->snode_end(current);
+	for( const int* cur=qgraph->clique_begin( current ), *stop=qgraph->clique_end( current );
 	     cur < stop; ++cur ) {
 	  if (DEBUG_TRACE) cout << *cur << ", ";
 	  degStruct->remove(*cur);
@@ -452,7 +530,7 @@ MinPriorityEngine::run() {
       // Add the reachable vertices back
       degreeComputationTimer.start();
       // random_shuffle( reachableVtxs.begin(), reachableVtxs.end() ); // not necessary
-      priorityStrategy->prioritize( reachableVtxs, qgraph, degStruct );
+      prioritize( reachableVtxs, qgraph, degStruct );
       degreeComputationTimer.stop();
       // reachableVtxs.resize(0);
     }
@@ -464,7 +542,7 @@ MinPriorityEngine::run() {
     //    }
 
     stageTimer.stop();
-    if ( ( maxSteps != 1 ) && priorityStrategy->requireSetDiffs() ) {
+    if ( ( maxSteps != 1 ) && requireSetDiffs() ) {
       // set differences are  L_e / L_i , where i is last eliminated vtx.
       // this is required for approximate minimum strategys.
       qgraph->enableSingleElimination();  // enables setDiffs and disables outmatching
@@ -479,7 +557,7 @@ MinPriorityEngine::run() {
 	    "nPrincipalSnode=%d\n",
 	    stage, secs, stepTimer.queryNLaps(), 
 	    n-totEliminated, n-totEliminated-nCompressed);
-    } else if ( ( maxSteps == 1 ) && !(priorityStrategy->requireSetDiffs() ) ){ 
+    } else if ( ( maxSteps == 1 ) && !( requireSetDiffs() ) ){ 
       qgraph->enableMultipleElimination();
       maxSteps = n;
       int totEliminated = qgraph->queryTotEliminated(); // total snodes eliminated
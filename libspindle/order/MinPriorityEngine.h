@@ -85,6 +85,7 @@ public:
 private:
   int n; // original number of supernodes in graph
   bool randomizeGraph; // true iff we want to randomize the graph
+  unsigned int randomSeed; // seeds this engine's own shuffle in each execute()
   BucketSorter *degStruct; // The priority queue of (vertex,priority) pairs.
   QuotientGraph *qgraph;   // The quotient graph
   MinPriorityStrategies *priorityStrategy; // the priority strategy
@@ -101,6 +102,8 @@ private:
   int *workVec;     // temporary work space
   float heavyVtxTolerance; // tolerance for removing highly connected vtxs 
   int * explicitOrder; // an explicit input ordering new2old (optional)
+  int nThreads;        // threads used for the quotient graph update
+  bool needNewQGraph;  // qgraph must be refilled for the current graph
 
 
   //  SharedArray<int> PartitionMap; 
@@ -115,6 +118,24 @@ private:
   bool run();
   bool finalize();
 
+protected:
+  /**@name strategy dispatch 
+   * These are called once at initialization and once per stage.
+   * The defaults forward to the runtime #MinPriorityStrategies#
+   * object; #MinPriorityEngineT# overrides them to bind a strategy
+   * at compile time.
+   */
+  //@{
+  /** create the default strategy if none was set */
+  virtual bool initializeStrategy( const int nVtxs );
+  /** true iff the strategy needs set differences (single elimination) */
+  virtual bool requireSetDiffs();
+  /** reprioritize the reachable set and reinsert into the priority queue */
+  virtual bool prioritize( const VertexList& reachableVtxs, 
+			   const QuotientGraph* g,
+			   BucketSorter* degStruct );
+  //@}
+
 public:  
   /** default constructor */
   MinPriorityEngine();
@@ -134,6 +155,13 @@ public:
   bool setPriorityStrategy( MinPriorityStrategies* PriorityStrategy );
   /** force the input graph to be randomized */
   void setRandomizeGraph( bool randomizeIt ) { randomizeGraph = randomizeIt; }
+  /** 
+   * seed the shuffle of the input graph (default 1).  Each engine
+   * keeps its own generator and restarts it from the seed in every
+   * #execute()#, so engines on different threads do not share state
+   * and the same graph is always shuffled the same way.
+   */
+  void setRandomSeed( const unsigned int seed ) { randomSeed = seed; }
   /** set an explicit input ordering for the graph */
   bool setExplicitOrder( const PermutationMap& perm );
   /** return a const pointer to current priority strategy */
@@ -165,6 +193,29 @@ public:
   }
   /** query the maximum number of supernodes eliminated per update */
   int getMaxSteps() const { return maxSteps; }
+
+  /** 
+   * use up to #n# threads to recompute external degrees after
+   * each stage of multiple elimination.  The ordering is identical
+   * for any number of threads.  Has no effect unless configured 
+   * with #--enable-threads#.  (see ThreadTeam)
+   */
+  bool setNThreads( const int n ) { 
+    if ( n < 1 ) return false;
+    nThreads = n;
+    if ( qgraph != 0 ) qgraph->setNThreads( n );
+    return true;
+  }
+  /** query the number of threads requested */
+  int queryNThreads() const { return nThreads; }
+
+  /**
+   * free the quotient graph, the priority queue and all other work
+   * space.  These are otherwise kept from one graph to the next and
+   * only grow, so that ordering a sequence of similar graphs does
+   * not allocate them anew each time.
+   */
+  virtual void releaseMemory();
   
   //SharedPtr<PermutationMap> getPermutationMap() const;
 
@@ -0,0 +1,97 @@
+//
+// MinPriorityEngineT.h
+//
+// $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+//
+
+#ifndef SPINDLE_MIN_PRIORITY_ENGINE_T_H_
+#define SPINDLE_MIN_PRIORITY_ENGINE_T_H_
+
+#ifndef MIN_PRIORITY_ENGINE_H_
+#include "spindle/MinPriorityEngine.h"
+#endif
+
+#ifndef SPINDLE_MIN_PRIORITY_STRATEGIES_H_
+#include "spindle/MinPriorityStrategies.h"
+#endif
+
+SPINDLE_BEGIN_NAMESPACE
+
+/**
+ * @memo MinPriorityEngine with a priority strategy bound at compile time
+ * @type class
+ *
+ * Identical to #MinPriorityEngine# except that the priority strategy
+ * is a template parameter held by value instead of a
+ * #MinPriorityStrategies*# chosen at run time.  Each reachable
+ * set is reprioritized through #prioritizeReachSet()#, so the
+ * per-vertex #computePriority()# kernel of the strategy is inlined
+ * and no virtual call is made inside the degree update loop.
+ *
+ * #Strategy# must be one of the single-kernel strategies
+ * (#MinPriority_ExternalDegree#, #MinPriority_ApproximateDegree#,
+ * #MinPriority_AMF#, ... ).  The hybrid strategies switch
+ * behavior between stages and should continue to be used through
+ * #MinPriorityEngine::setPriorityStrategy()#.
+ *
+ * Given the same graph and settings, the resulting ordering is
+ * identical to that of #MinPriorityEngine# with the corresponding
+ * runtime strategy.
+ *
+ * @author agent
+ * @version #$Id$#
+ * @see MinPriorityEngine
+ * @see MinPriorityStrategies
+ */
+template< class Strategy >
+class MinPriorityEngineT : public MinPriorityEngine {
+protected:
+  Strategy strategy;  // the statically bound priority strategy
+
+  virtual bool initializeStrategy( const int nVtxs ) {
+    return strategy.setSize( nVtxs );
+  }
+  virtual bool requireSetDiffs() {
+    return strategy.Strategy::requireSetDiffs();
+  }
+  virtual bool prioritize( const VertexList& reachableVtxs,
+			   const QuotientGraph* g,
+			   BucketSorter* degStruct ) {
+    return prioritizeReachSet( strategy, reachableVtxs, g, degStruct );
+  }
+
+public:
+  /** default constructor */
+  MinPriorityEngineT() {}
+  /** convenience constructor */
+  MinPriorityEngineT( const Graph* graph ) : MinPriorityEngine( graph ) {}
+  /** destructor */
+  virtual ~MinPriorityEngineT() {}
+
+  /** also frees the work space of the compiled-in strategy */
+  virtual void releaseMemory() { 
+    MinPriorityEngine::releaseMemory();
+    strategy.releaseMemory();
+  }
+
+  /** grant const access to the compiled-in strategy */
+  const Strategy& lendStrategy() const { return strategy; }
+};
+
+SPINDLE_END_NAMESPACE
+
+#endif
@@ -43,6 +43,8 @@ MinPriorityStrategies::MinPriorityStrategies() {
   visited = 0;
   size = -1;
   lastStamp = 0;
+  weight_ = 0;
+  externDeg_ = 0;
   timer.reset();
 }
 
@@ -50,6 +52,8 @@ MinPriorityStrategies::MinPriorityStrategies( const int Size ) {
   visited = 0;
   size = -1;
   lastStamp = 0;
+  weight_ = 0;
+  externDeg_ = 0;
   setSize( Size );
   timer.reset();
 }
@@ -87,6 +91,13 @@ MinPriorityStrategies::setSize( const int Size ) {
   return true;
 }
 
+void
+MinPriorityStrategies::releaseMemory() {
+  vector<int>().swap( vec );
+  visited = 0;
+  size = -1;
+}
+
 int
 MinPriorityStrategies::getStamp() {
   if (lastStamp >= LARGE_INT ) {
@@ -100,512 +111,200 @@ MinPriorityStrategies::getStamp() {
   return lastStamp;
 }
 
+//
+// The per-vertex kernels (beginPrioritize() and computePriority()) are
+// inlined in the header so that MinPriorityEngineT<> can bind them at
+// compile time.  The virtual prioritize() methods below simply run the
+// same kernel through prioritizeReachSet().
+//
+
 bool
 MinPriority_ExactDegree::prioritize( const VertexList& reachableVtxs, 
-					const QuotientGraph* g, 
-					BucketSorter* degStruct ) {
+                                    const QuotientGraph* g, 
+                                    BucketSorter* degStruct ) {
   timer.start();
-  const int *weight = g->getWeightArray();
-  const int *extdeg = g->getExternDegreeArray();
   TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, 
 	 "\n\tMinPriority_ExactDegree::prioritize(){ // (vtx,degree)\n\t\t" );
-  for( VertexList::const_iterator it=reachableVtxs.begin(), stop=reachableVtxs.end();
-       it != stop; ++it ) {
-    int vtx = *it;
-    if ( g->isEliminated( vtx ) ) { 
-      WARNING("Cannot compute priority of eliminated node %d.  Skipping.",vtx);
-      continue;
-    }
-    int priority = extdeg[vtx] + weight[vtx];
-    TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " (%d,%d) ", vtx, priority );
-    degStruct->insert( priority, vtx );
-  } // end for all reachable vtxs
+  bool success = prioritizeReachSet( *this, reachableVtxs, g, degStruct );
   timer.stop();
   TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " \n\t}" );
-  return true;
+  return success;
 }
 
 bool
 MinPriority_ExternalDegree::prioritize( const VertexList& reachableVtxs, 
-					const QuotientGraph* g, 
-					BucketSorter* degStruct ) {
+                                       const QuotientGraph* g, 
+                                       BucketSorter* degStruct ) {
   timer.start();
-#ifdef DEBUG_MINPRIORITY_STRATEGIES
-  const int *weight = g->getWeightArray();
-#endif
-  bool dumpgraph = false;
-  const int *extdeg = g->getExternDegreeArray();
   TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, 
 	 "\n\tMinPriority_ExternalDegree::prioritize(){ // (vtx,degree)\n\t\t" );
-  for( VertexList::const_iterator it=reachableVtxs.begin(), stop=reachableVtxs.end();
-       it != stop; ++it ) {
-    int vtx = *it;
-    if ( g->isEliminated( vtx ) ) { 
-      WARNING("Cannot compute priority of eliminated node %d.  Skipping.",vtx);
-      continue;
-    }
-    int priority = extdeg[vtx];
+  bool success = prioritizeReachSet( *this, reachableVtxs, g, degStruct );
 #ifdef DEBUG_MINPRIORITY_STRATEGIES
-    int stamp = getStamp();
-    int my_priority = 0;
-    visited[ vtx ] = stamp;
-    for ( const int *e = g->enode_begin(vtx), *stop_e = g->enode_end(vtx); e != stop_e; ++e) { 
-      for ( const int *s = g->snode_begin(*e), *stop_s = g->snode_end(*e); s != stop_s; ++s) { 
-	if ( visited[ *s ] < stamp ) { 
-	  visited[ *s ] = stamp;
-	  my_priority += weight[ *s ];
+  {
+    bool dumpgraph = false;
+    for( VertexList::const_iterator it=reachableVtxs.begin(), stop=reachableVtxs.end();
+	 it != stop; ++it ) {
+      int vtx = *it;
+      if ( g->isEliminated( vtx ) ) { continue; }
+      int priority = externDeg_[vtx];
+      int stamp = getStamp();
+      int my_priority = 0;
+      visited[ vtx ] = stamp;
+      for ( const int *e = g->enode_begin(vtx), *stop_e = g->enode_end(vtx); e != stop_e; ++e) { 
+	for ( const int *s = g->snode_begin(*e), *stop_s = g->snode_end(*e); s != stop_s; ++s) { 
+	  if ( visited[ *s ] < stamp ) { 
+	    visited[ *s ] = stamp;
+	    my_priority += weight_[ *s ];
+	  }
 	}
       }
+      if ( priority != my_priority ) { 
+	cout << "Warning:  priority = " << priority << " but computed a priority = "
+	     << my_priority << " for vertex " << vtx << endl;
+	dumpgraph = true;
+      }
     }
-    if ( priority != my_priority ) { 
-      cout << "Warning:  priority = " << priority << " but computed a priority = "
-	   << my_priority << " for vertex " << vtx << endl;
-      dumpgraph = true;
-    }
+    if ( dumpgraph ) g->printTinyGraph( cout );
+  }
 #endif
-    TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " (%d,%d) ", vtx, priority );
-    degStruct->insert( priority, vtx );
-  } // end for all reachable vtxs
   timer.stop();
   TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " \n\t}" );
-  if ( dumpgraph ) g->printTinyGraph( cout );
-  return true;
+  return success;
 }
 
 bool
 MinPriority_ApproximateDegree::prioritize( const VertexList& reachableVtxs, 
-					      const QuotientGraph* g, 
-					      BucketSorter* degStruct ) {
+                                          const QuotientGraph* g, 
+                                          BucketSorter* degStruct ) {
   timer.start();
-#ifdef DEBUG_MINPRIORITY_STRATEGIES
-  const int *setDiff = g->getSetDiffsArray();
-  const int *weight = g->getWeightArray();
-#endif
-  const int *extdeg = g->getExternDegreeArray();
   TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, 
 	 "\n\tMinPriority_ApproximateDegree::prioritize(){ // (vtx,degree)\n\t\t" );
-  for( VertexList::const_iterator it=reachableVtxs.begin(), stop=reachableVtxs.end();
-       it != stop; ++it ) {
-    int vtx = *it;
-    if ( g->isEliminated( vtx ) ) { 
-      WARNING("Cannot compute priority of eliminated node %d.  Skipping.",vtx);
-      continue;
-    }
-    int priority = extdeg[vtx];
+  bool success = prioritizeReachSet( *this, reachableVtxs, g, degStruct );
 #ifdef DEBUG_MINPRIORITY_STRATEGIES
-    int my_priority = 0;
-    int my_weight = weight[vtx];
-    for ( const int* e= g->enode_begin( vtx), *stop_e = g->enode_end(vtx); e != stop_e; ++e ) { 
-      if ( *e != vtx ) { 
-	my_priority += setDiff[ *e ];
+  {
+    const int *setDiff = g->getSetDiffsArray();
+    for( VertexList::const_iterator it=reachableVtxs.begin(), stop=reachableVtxs.end();
+	 it != stop; ++it ) {
+      int vtx = *it;
+      if ( g->isEliminated( vtx ) ) { continue; }
+      int priority = externDeg_[vtx];
+      int my_priority = 0;
+      int my_weight = weight_[vtx];
+      for ( const int* e= g->enode_begin( vtx), *stop_e = g->enode_end(vtx); e != stop_e; ++e ) { 
+	if ( *e != vtx ) { 
+	  my_priority += setDiff[ *e ];
+	}
+      }
+      if ( my_priority > 0 ) { 
+	my_priority -= my_weight;
+      }
+      for ( const int *s = g->snode_begin(vtx), *stop_s = g->snode_end(vtx); s != stop_s; ++s ) { 
+	my_priority += weight_[ *s ];
+      }
+      if ( priority != my_priority ) { 
+	cout << "Warning:  priority = " << priority << " but computed a priority = "
+	     << my_priority << " for vertex " << vtx << endl;
+	g->printTinyGraph( cout );
       }
     }
-    if ( my_priority > 0 ) { 
-      my_priority -= my_weight;
-    }
-    for ( const int *s = g->snode_begin(vtx), *stop_s = g->snode_end(vtx); s != stop_s; ++s ) { 
-      my_priority += weight[ *s ];
-    }
-    if ( priority != my_priority ) { 
-      cout << "Warning:  priority = " << priority << " but computed a priority = "
-	   << my_priority << " for vertex " << vtx << endl;
-      g->printTinyGraph( cout );
-    }
+  }
 #endif
-    TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " (%d,%d) ", vtx, priority );
-    degStruct->insert( priority, vtx );
-  } // end for all reachable vtxs
   timer.stop();
   TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " \n\t}" );
-  return true;
+  return success;
 }
 
-
-//
-// Rothberg '97
-//
-// score(i) = (d^2 - d ) /2 - (c^2 - c ) /2 
-// where d = ext deg(i) = external degree of node i
-//       c = |C_l \ weight(i)| = where C_l is the largest adjacent clique
 bool
 MinPriority_AMF::prioritize( const VertexList& reachableVtxs, 
-			     const QuotientGraph* g, 
-			     BucketSorter* degStruct ) {
-  // 1. initialization
+                            const QuotientGraph* g, 
+                            BucketSorter* degStruct ) {
   timer.start();
-  const int *weight = g->getWeightArray();
-  const int *extdeg = g->getExternDegreeArray();
   TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, 
 	 "\n\tMinPriority_AMF::prioritize(){ // (vtx,degree)\n\t\t" );
-  // 2. for each vertex in reachable set.
-  for( VertexList::const_iterator it=reachableVtxs.begin(), stop=reachableVtxs.end();
-       it != stop; ++it ) { 
-    int vtx = *it;
-    // 2.a. skip already eliminated vtxs (this is an error)
-    if ( g->isEliminated( vtx ) ) { 
-      WARNING("Cannot compute priority of eliminated node %d.  Skipping.",vtx);
-      continue;
-    }
-    // 2.b. find the adjacent clq of maximum size 
-    int max_clq = 0;
-    {for( const int *curClq = g->enode_begin(vtx), *stopClq = g->enode_end(vtx); 
-	  curClq < stopClq; ++curClq ) {  // for all adjacent cliques...
-      int clq = *curClq;
-      if ( clq != vtx ) {                 //  .... excluding self 
-	int clqWeight = weight[ clq ];
-	max_clq = ( clqWeight > max_clq ) ? clqWeight : max_clq;
-      }
-    }}
-    // 2.c compute score
-    double score; 
-    { 
-      double d = (double) extdeg[ vtx ];  // d = the external degree of the node
-      if ( max_clq > 0 ) { 
-	// c = the size of the largest adjacent clique
-	double c = (double) max_clq - weight[ vtx ]; // c = |C_l \ v |
-	score = ( d * d - d ) / 2 - ( c * c - c ) / 2;
-      } else { 
-	score = ( d * d - d ) / 2;
-      }
-    }
-    // 2.d. insert into degStruct
-    int priority = reduceRangeFromNSquaredToN( score );
-    TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " (%d,%d) ", vtx, priority );
-    degStruct->insert( priority, vtx );
-  } // end for all reachable vtxs
-  // 3. cleanup
+  bool success = prioritizeReachSet( *this, reachableVtxs, g, degStruct );
   timer.stop();
   TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " \n\t}" );
-  return true;
+  return success;
 }
 
-//
-// Rothberg and Eisenstat
-//
-// score(i) = [ (d^2 - d ) - (c^2 - c ) ] / ( 2 *  weight(i) )
-// where d = ext deg(i) = external degree of node i
-//       c = |C_l \ weight(i)| = where C_l is most recently created clique
 bool
 MinPriority_AMMF::prioritize( const VertexList& reachableVtxs, 
-			      const QuotientGraph* g, 
-			      BucketSorter* degStruct ) {
-  // 1. initialization
+                             const QuotientGraph* g, 
+                             BucketSorter* degStruct ) {
   timer.start();
-  const int *weight = g->getWeightArray();
-  const int *extdeg = g->getExternDegreeArray();
-  
-  int C_l = g->queryLastEliminatedNode(); // last eliminated node
-  int max_clq = ( C_l != -1 ) ? weight[ C_l ] : 0 ; 
-  // weight of last eliminated node, if it exists
-
   TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, 
 	 "\n\tMinPriority_AMMF::prioritize(){ // (vtx,degree)\n\t\t" );
-  // 2. for each vertex in the reachable set
-  for( VertexList::const_iterator it=reachableVtxs.begin(), stop=reachableVtxs.end();
-       it != stop; ++it ) {
-    int vtx = *it;
-    // 2.a. skip already eliminated vtxs (an error if they occur)
-    if ( g->isEliminated( vtx ) ) { 
-      WARNING("Cannot compute priority of eliminated node %d.  Skipping.",vtx);
-      continue;
-    }
-    // 2.b compute score
-    double score; 
-    { 
-      int my_weight = weight[ vtx ];
-      double d = (double) extdeg[ vtx ];  // d = the external degree of the node
-      if ( max_clq > 0 ) { 
-	// c = the size of the largest adjacent clique
-	double c = (double) max_clq - my_weight; // c = |C_l \ v |
-	score = ( ( d * d - d ) - ( c * c - c ) ) / ( 2 * my_weight );
-      } else { 
-	score = ( d * d - d ) / ( 2 * my_weight ) ;
-      }
-    }
-    int priority = reduceRangeFromNSquaredToN( score );
-    TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " (%d,%d) ", vtx, priority );
-    degStruct->insert( priority, vtx );
-  } // end for all reachable vtxs
-  // 3. cleanup
+  bool success = prioritizeReachSet( *this, reachableVtxs, g, degStruct );
   timer.stop();
   TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " \n\t}" );
-  return true;
+  return success;
 }
 
-//
-// score(i) = [ (d^2 - d ) - (c^2 - c ) ] /  2  - ( extdeg(i) * weight(i) )
-// where d = ext deg(i) = external degree of node i
-//       c = |C_l \ weight(i)| = where C_l is most recently created clique
 bool
 MinPriority_AMIND::prioritize( const VertexList& reachableVtxs, 
-				const QuotientGraph* g, 
-				BucketSorter* degStruct ) {
-  // 1. initialization
+                              const QuotientGraph* g, 
+                              BucketSorter* degStruct ) {
   timer.start();
-  const int *weight = g->getWeightArray();
-  const int *extdeg = g->getExternDegreeArray();
-  int C_l = g->queryLastEliminatedNode(); // last eliminated node
-  int max_clq = ( C_l != -1 ) ? weight[ C_l ] : 0 ; /* weight of last eliminated node, 
-						     * if it exists
-						     */
   TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, 
 	 "\n\tMinPriority_AMIND::prioritize(){ // (vtx,degree)\n\t\t" );
-
-  // 2. for each vertex in the reachable set.
-  for( VertexList::const_iterator it=reachableVtxs.begin(), stop=reachableVtxs.end();
-       it != stop; ++it ) {
-    int vtx = *it;
-    // 2.a. skip already eliminated vtxs (an error if they occur)
-    if ( g->isEliminated( vtx ) ) { 
-      WARNING("Cannot compute priority of eliminated node %d.  Skipping.",vtx);
-      continue;
-    }
-    // 2.b compute score
-    double score; 
-    { 
-      int my_weight = weight[ vtx ];
-      double d = (double) extdeg[ vtx ];  // d = the external degree of the node
-      if ( max_clq > 0 ) { 
-	// c = the size of the largest adjacent clique
-	double c = (double) max_clq - my_weight; // c = |C_l \ v |
-	score = ( ( d * d - d ) - ( c * c - c ) ) / 2  - (d * my_weight);
-      } else { 
-	score = ( d * d - d ) / 2  - ( d * my_weight ) ;
-      }
-    }  
-    // 2.c. insert into queue
-    int priority = reduceRangeFromNSquaredToN( score );
-    TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " (%d,%d) ", vtx, priority );
-    degStruct->insert( priority, vtx );
-  } // end for all reachable vtxs
-  // 3. cleanup
+  bool success = prioritizeReachSet( *this, reachableVtxs, g, degStruct );
   timer.stop();
   TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " \n\t}" );
-  return true;
+  return success;
 }
 
 bool
 MinPriority_MMMF::prioritize( const VertexList& reachableVtxs, 
-			      const QuotientGraph* g, 
-			      BucketSorter* degStruct ) {
-  // 1. initialization
+                             const QuotientGraph* g, 
+                             BucketSorter* degStruct ) {
   timer.start();
-  const int *weight = g->getWeightArray();
-  const int *extdeg = g->getExternDegreeArray();
   TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, 
 	 "\n\tMinPriority_MAMMF::prioritize(){ // (vtx,degree)\n\t\t" );
-  // 2. for all vertices in reachable set
-  for( VertexList::const_iterator it=reachableVtxs.begin(), stop=reachableVtxs.end();
-       it != stop; ++it ) {
-    int vtx = *it;
-    //  2.a. skip already eliminated vtxs (an error if they occur)
-    if ( g->isEliminated( vtx ) ) { 
-      WARNING("Cannot compute priority of eliminated node %d.  Skipping.",vtx);
-      continue;
-    }
-    //  2.b. find largest clique
-    int max_clq = 0;
-    {for( const int *curClq = g->enode_begin(vtx), *stopClq = g->enode_end(vtx); 
-	  curClq < stopClq; ++curClq ) { // for all adjacent cliques ...
-      int clq = *curClq;
-      if ( clq != vtx ) {                //  .... except self 
-	int clqWeight = weight[ clq ];
-	max_clq = ( clqWeight > max_clq ) ? clqWeight : max_clq;
-      }
-    }}
-    // 2.c compute score
-    double score; 
-    { 
-      int my_weight = weight[ vtx ];
-      double d = (double) extdeg[ vtx ];  // d = the external degree of the node
-      if ( max_clq > 0 ) { 
-	// c = the size of the largest adjacent clique
-	double c = (double) max_clq - my_weight; // c = |C_max \ v |
-	score = ( ( d * d - d ) - ( c * c - c ) ) / ( 2 * my_weight );
-      } else { 
-	score = ( d * d - d ) / ( 2 * my_weight ) ;
-      }
-    }
-    // 2.c. insert new priority into queue
-    int priority = reduceRangeFromNSquaredToN( score );
-    TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " (%d,%d) ", vtx, priority );
-    degStruct->insert( priority, vtx );
-  } // end for all reachable vtxs
-  // 3. cleanup
+  bool success = prioritizeReachSet( *this, reachableVtxs, g, degStruct );
   timer.stop();
   TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " \n\t}" );
-  return true;
+  return success;
 }
 
 bool
 MinPriority_MMIND::prioritize( const VertexList& reachableVtxs, 
-				const QuotientGraph* g, 
-				BucketSorter* degStruct ) {
-  // 1. initialization
+                              const QuotientGraph* g, 
+                              BucketSorter* degStruct ) {
   timer.start();
-  const int *weight = g->getWeightArray();
-  const int *extdeg = g->getExternDegreeArray();
   TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, 
 	 "\n\tMinPriority_MAMIND::prioritize(){ // (vtx,degree)\n\t\t" );
-
-  // 2. for each vertex in the reachable set.
-  for( VertexList::const_iterator it=reachableVtxs.begin(), stop=reachableVtxs.end();
-       it != stop; ++it ) {
-    int vtx = *it;
-    // 2.a. skip if already eliminated (which is an error)
-    if ( g->isEliminated( vtx ) ) { 
-      WARNING("Cannot compute priority of eliminated node %d.  Skipping.",vtx);
-      continue;
-    }
-    // 2.b. find largest clique
-    int max_clq = 0;
-    {for( const int *curClq = g->enode_begin(vtx), *stopClq = g->enode_end(vtx); 
-	  curClq < stopClq; ++curClq ) { // for all adjacent cliques ...
-      int clq = *curClq;
-      if ( clq != vtx ) {                // ... excluding self 
-	int clqWeight = weight[ clq ];
-	max_clq = ( clqWeight > max_clq ) ? clqWeight : max_clq;
-      }
-    }}
-    // 2.c compute score
-    double score; 
-    { 
-      int my_weight = weight[ vtx ];
-      double d = (double) extdeg[ vtx ];  // d = the external degree of the node
-      if ( max_clq > 0 ) { 
-	// c = the size of the largest adjacent clique
-	double c = (double) max_clq - my_weight; // c = |C_max \ v |
-	score = ( ( d * d - d ) - ( c * c - c ) ) / 2  - (d * my_weight);
-      } else { 
-	score = ( d * d - d ) / 2  - ( d * my_weight ) ;
-      }
-    }  
-    // 2.d. insert into degStruct
-    int priority = reduceRangeFromNSquaredToN( score );
-    TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " (%d,%d) ", vtx, priority );
-    degStruct->insert( priority, vtx );
-  } // end for all reachable vtxs
-  // 3. cleanup
+  bool success = prioritizeReachSet( *this, reachableVtxs, g, degStruct );
   timer.stop();
   TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " \n\t}" );
-  return true;
+  return success;
 }
 
-
-
-//
-//  Ng Raghavan 97
-//
-// score(i) = (d^2 - d) - C - ct
-// where d = ext deg(i) = external degree of node i
-//       C = let K be set of partial cliques.
-//           C = \sum_{v \in K} weight(v)^2 - weight(v)
-//       ct = 2 * extdeg( i) * weight(i)
 bool
 MinPriority_MMDF::prioritize( const VertexList& reachableVtxs, 
-			      const QuotientGraph* g, 
-			      BucketSorter* degStruct ) {
+                             const QuotientGraph* g, 
+                             BucketSorter* degStruct ) {
   timer.start();
-  const int *weight = g->getWeightArray();
-  const int *extdeg = g->getExternDegreeArray();
   TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, 
 	 "\n\tMinPriority_MMDF::prioritize(){ // (vtx,degree)\n\t\t" );
-  for( VertexList::const_iterator it=reachableVtxs.begin(), stop=reachableVtxs.end();
-       it != stop; ++it ) {
-    int vtx = *it;
-    if ( g->isEliminated( vtx ) ) { 
-      WARNING("Cannot compute priority of eliminated node %d.  Skipping.",vtx);
-      continue;
-    }
-    int degree = extdeg[vtx];
-    double clq_fill = 0.0;
-    int stamp = getStamp();
-    visited[vtx] = stamp;  // keep from revisiting self
-    {for( const int* curVtx = g->snode_begin(vtx), *stopVtx = g->snode_end(vtx); 
-	  curVtx < stopVtx; ++curVtx ) {
-      // flag all snodes adj to me
-      visited[ *curVtx ] = stamp;
-      int adj = *curVtx;
-      if ( visited[ adj ] < stamp ) {  // if not yet visited
-	visited[ adj ] = stamp;        // visit now
-	// degree += weight[ adj ];       // and add weight of adj to current vtx
-      }
-    }}
-    {for( const int *curClq = g->enode_begin(vtx), *stopClq = g->enode_end(vtx); 
-	  curClq < stopClq; ++curClq ) {
-      // for all adjacent cliques ( including self )
-      int clq = *curClq;
-      double this_clq_fill = 0.0;
-      if ( *curClq != vtx ) {
-	for( const int* curVtx = g->snode_begin(clq), *stopVtx = g->snode_end(clq); 
-	     curVtx < stopVtx; ++curVtx ) {
-	  // for all vertices in each clique
-	  int adj = *curVtx;
-	  if ( visited[ adj ] < stamp ) {  // if not yet visited
-	    visited[ adj ] = stamp;        // visit now
-	    // degree += weight[ adj ];       // and add weight of adj to current vtx
-	    this_clq_fill += (double) weight[ adj ];
-	  }
-	}
-	if ( this_clq_fill > 0.0 ) {
-	  clq_fill += this_clq_fill * ( this_clq_fill - 1 );
-	}
-      } // end else
-    }}
-    double score = (double) degree;
-    score = ( score * ( score - 1.0 )) - clq_fill - ( 2*degree*weight[vtx]) ;
-    int priority = reduceRangeFromNSquaredToN( score );
-    TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " (%d,%d) ", vtx, priority );
-    degStruct->insert( priority, vtx );
-  } // end for all reachable vtxs
+  bool success = prioritizeReachSet( *this, reachableVtxs, g, degStruct );
   timer.stop();
   TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " \n\t}" );
-  return true;
+  return success;
 }
 
-//
-// priority(v_k) = 2 * extdeg( v_k ) - max clique v_k is a member of
-//
 bool
 MinPriority_MMMD::prioritize( const VertexList& reachableVtxs, 
-				 const QuotientGraph* g, 
-				 BucketSorter* degStruct ) {
+                             const QuotientGraph* g, 
+                             BucketSorter* degStruct ) {
   timer.start();
-  const int *weight = g->getWeightArray();
-  const int *extdeg = g->getExternDegreeArray();
   TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, 
 	 "\n\tMinPriority_MMMD::prioritize(){ // (vtx,degree)\n\t\t" );
-  for( VertexList::const_iterator it=reachableVtxs.begin(), stop=reachableVtxs.end();
-       it != stop; ++it ) {
-    int vtx = *it;
-    if ( g->isEliminated( vtx ) ) { 
-      WARNING("Cannot compute priority of eliminated node %d.  Skipping.",vtx);
-      continue;
-    }
-    int degree = extdeg[ vtx ];
-    //int clq_fill = weight[ g->queryLastEliminatedNode() ];
-    int clq_fill = 0;
-    int stamp = getStamp();
-    visited[vtx] = stamp;  // keep from revisiting self
-    {for( const int *curClq = g->enode_begin(vtx), *stopClq = g->enode_end(vtx); 
-	  curClq < stopClq; ++curClq ) {
-      // for all adjacent cliques ( including self )
-      int clq = *curClq;
-      if ( clq == vtx ) { continue; } // skip self clique
-      int this_clq_fill = weight[ clq ];
-      clq_fill = ( this_clq_fill > clq_fill ) ? this_clq_fill : clq_fill ;
-    }}
-    int score = 2*degree - clq_fill;
-    int priority = reduceRangeFromNSquaredToN( score );
-    TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " (%d,%d) ", vtx, priority );
-    degStruct->insert( priority, vtx );
-  } // end for all reachable vtxs
+  bool success = prioritizeReachSet( *this, reachableVtxs, g, degStruct );
   timer.stop();
   TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " \n\t}" );
-  return true;
+  return success;
 }
 
-
 //
 // originally mmd until tol% of vertices have been eliminated, then amd
 //
@@ -716,6 +415,13 @@ MinPriority_AdvancedHybrid::~MinPriority_AdvancedHybrid() {
   }
 }
 
+void
+MinPriority_AdvancedHybrid::releaseMemory() { 
+  MinPriorityStrategies::releaseMemory();
+  if ( strategy1 != 0 ) { strategy1->releaseMemory(); }
+  if ( strategy2 != 0 ) { strategy2->releaseMemory(); }
+}
+
 bool
 MinPriority_AdvancedHybrid::requireSetDiffs() { 
   return ( useStrategy1 ) ? false : true ;
@@ -856,6 +562,13 @@ MinPriority_AdvancedHybrid2::~MinPriority_AdvancedHybrid2() {
   }
 }
 
+void
+MinPriority_AdvancedHybrid2::releaseMemory() { 
+  MinPriorityStrategies::releaseMemory();
+  if ( strategy1 != 0 ) { strategy1->releaseMemory(); }
+  if ( strategy2 != 0 ) { strategy2->releaseMemory(); }
+}
+
 bool
 MinPriority_AdvancedHybrid2::requireSetDiffs() { 
   return ( useStrategy1 ) ? false : true ;
@@ -1005,6 +718,13 @@ MinPriority_TimedHybrid::~MinPriority_TimedHybrid() {
   }
 }
 
+void
+MinPriority_TimedHybrid::releaseMemory() { 
+  MinPriorityStrategies::releaseMemory();
+  if ( strategy1 != 0 ) { strategy1->releaseMemory(); }
+  if ( strategy2 != 0 ) { strategy2->releaseMemory(); }
+}
+
 bool
 MinPriority_TimedHybrid::requireSetDiffs() { 
   return ( useStrategy1 ) ? false : true ;
@@ -139,6 +139,18 @@ protected:
    */
   int reduceRangeFromNSquaredToN( const double priority ) const;
 
+  /**
+   * The weight array of the quotient graph being prioritized.
+   * Cached by #beginPrioritize()# once per call to #prioritize()#.
+   */
+  const int *weight_;
+
+  /**
+   * The external degree array of the quotient graph being
+   * prioritized.  Cached by #beginPrioritize()#.
+   */
+  const int *externDeg_;
+
 public:
   /** 
    * default constructor, requires setSize() later 
@@ -159,6 +171,16 @@ public:
    * set the size of the quotient graph 
    */
   bool setSize( const int Size );
+
+  /**
+   * query the size of the quotient graph
+   */
+  int querySize() const { return size; }
+
+  /**
+   * free #visited#, requires setSize() later
+   */
+  virtual void releaseMemory();
   
   /**
    * return a new integer larger than #lastStamp# that is 
@@ -186,6 +208,19 @@ public:
    * give const access to the basic ordering timer
    */
   const stopwatch& getTimer();
+
+  /**@name per-vertex kernel
+   * Concrete strategies redefine these two (non-virtual) members.
+   * #prioritizeReachSet()# calls them through the static type of
+   * the strategy so the score computation is inlined into the loop
+   * over the reachable set.  See also #MinPriorityEngineT#.
+   */
+  //@{
+  /** cache whatever is constant over one reachable set */
+  void beginPrioritize( const QuotientGraph* g );
+  /** compute the priority of one principal, uneliminated supernode */
+  int computePriority( const QuotientGraph* g, const int vtx );
+  //@}
 };
 
 /**
@@ -198,6 +233,7 @@ public:
  */
 class MinPriority_MultipleElimination : public MinPriorityStrategies {
 public:
+  MinPriority_MultipleElimination() { }
   MinPriority_MultipleElimination( const int Size )
     : MinPriorityStrategies( Size ) { }
   virtual ~MinPriority_MultipleElimination() {}
@@ -218,6 +254,7 @@ public:
  */
 class MinPriority_ApproximateElimination : public MinPriorityStrategies {
 public:
+  MinPriority_ApproximateElimination() { }
   MinPriority_ApproximateElimination( const int Size )
     : MinPriorityStrategies( Size ) { }
   virtual ~MinPriority_ApproximateElimination() {}
@@ -238,6 +275,7 @@ public:
  */
 class MinPriority_ExactDegree : public MinPriority_MultipleElimination {
 public:
+  MinPriority_ExactDegree() { }
   MinPriority_ExactDegree(const int Size) 
     : MinPriority_MultipleElimination( Size ) { }
   virtual ~MinPriority_ExactDegree() {}
@@ -245,6 +283,8 @@ public:
   virtual bool prioritize( const VertexList& reachableVtxs, 
 			   const QuotientGraph* g, 
 			   BucketSorter* degStruct );
+  void beginPrioritize( const QuotientGraph* g );
+  int computePriority( const QuotientGraph* g, const int vtx );
 };
 
 /**
@@ -257,6 +297,7 @@ public:
  */
 class MinPriority_ExternalDegree : public MinPriority_MultipleElimination {
 public:
+  MinPriority_ExternalDegree() { }
   MinPriority_ExternalDegree( const int Size )
     : MinPriority_MultipleElimination( Size ) { }
   virtual ~MinPriority_ExternalDegree() { }
@@ -264,6 +305,8 @@ public:
   virtual bool prioritize( const VertexList& reachableVtxs, 
 			   const QuotientGraph* g, 
 			   BucketSorter* degStruct );
+  void beginPrioritize( const QuotientGraph* g );
+  int computePriority( const QuotientGraph* g, const int vtx );
 };
 
 
@@ -277,6 +320,7 @@ public:
  */
 class MinPriority_ApproximateDegree : public MinPriority_ApproximateElimination {
 public:
+  MinPriority_ApproximateDegree() { }
   MinPriority_ApproximateDegree( const int Size )
     : MinPriority_ApproximateElimination( Size ) { }
   virtual ~MinPriority_ApproximateDegree() { }
@@ -284,6 +328,8 @@ public:
   virtual bool prioritize( const VertexList& reachableVtxs, 
 			   const QuotientGraph* g, 
 			   BucketSorter* degStruct );
+  void beginPrioritize( const QuotientGraph* g );
+  int computePriority( const QuotientGraph* g, const int vtx );
 };
 
 
@@ -297,11 +343,14 @@ public:
  */
 class MinPriority_AMF : public MinPriority_MultipleElimination { 
 public:
+  MinPriority_AMF() { }
   MinPriority_AMF( const int Size ) : MinPriority_MultipleElimination( Size ) { }
   virtual ~MinPriority_AMF() { }
   virtual bool prioritize( const VertexList& reachableVtxs, 
 			   const QuotientGraph* g, 
 			   BucketSorter* degStruct );
+  void beginPrioritize( const QuotientGraph* g );
+  int computePriority( const QuotientGraph* g, const int vtx );
 };
 
 
@@ -314,13 +363,18 @@ public:
  * @see MinPriorityEngine
  */
 class MinPriority_AMMF : public MinPriority_ApproximateElimination { 
+private:
+  int maxClq; // weight of the most recently created clique
 public:
+  MinPriority_AMMF() { }
   MinPriority_AMMF( const int Size ) 
     : MinPriority_ApproximateElimination( Size ) { }
   virtual ~MinPriority_AMMF() { }
   virtual bool prioritize( const VertexList& reachableVtxs, 
 			   const QuotientGraph* g, 
 			   BucketSorter* degStruct );
+  void beginPrioritize( const QuotientGraph* g );
+  int computePriority( const QuotientGraph* g, const int vtx );
 };
 
 /**
@@ -332,13 +386,18 @@ public:
  * @see MinPriorityEngine
  */
 class MinPriority_AMIND : public MinPriority_ApproximateElimination {
+private:
+  int maxClq; // weight of the most recently created clique
 public:
+  MinPriority_AMIND() { }
   MinPriority_AMIND( const int Size ) 
     : MinPriority_ApproximateElimination( Size ) { }
   virtual ~MinPriority_AMIND() { }
   virtual bool prioritize( const VertexList& reachableVtxs, 
 			   const QuotientGraph* g, 
 			   BucketSorter* degStruct );
+  void beginPrioritize( const QuotientGraph* g );
+  int computePriority( const QuotientGraph* g, const int vtx );
 };
 
 /**
@@ -351,12 +410,15 @@ public:
  */
 class MinPriority_MMMF : public MinPriority_MultipleElimination {
 public:
+  MinPriority_MMMF() { }
   MinPriority_MMMF( const int Size ) 
     : MinPriority_MultipleElimination( Size ) {}
   virtual ~MinPriority_MMMF() { }
   virtual bool prioritize( const VertexList& reachableVtxs, 
 			   const QuotientGraph* g, 
 			   BucketSorter* degStruct );
+  void beginPrioritize( const QuotientGraph* g );
+  int computePriority( const QuotientGraph* g, const int vtx );
 };
 
 /**
@@ -369,12 +431,15 @@ public:
  */
 class MinPriority_MMIND : public MinPriority_MultipleElimination { 
 public:
+  MinPriority_MMIND() { }
   MinPriority_MMIND( const int Size ) 
     : MinPriority_MultipleElimination( Size ) { }
   virtual ~MinPriority_MMIND() { }
   virtual bool prioritize( const VertexList& reachableVtxs, 
 			   const QuotientGraph* g, 
 			   BucketSorter* degStruct );
+  void beginPrioritize( const QuotientGraph* g );
+  int computePriority( const QuotientGraph* g, const int vtx );
 };
 
 /**
@@ -387,12 +452,15 @@ public:
  */
 class MinPriority_MMDF : public MinPriority_MultipleElimination { 
 public:
+  MinPriority_MMDF() { }
   MinPriority_MMDF(const int Size) 
     : MinPriority_MultipleElimination( Size ) { }
   virtual ~MinPriority_MMDF() { }
   virtual bool prioritize( const VertexList& reachableVtxs, 
 			   const QuotientGraph* g, 
 			   BucketSorter* degStruct );
+  void beginPrioritize( const QuotientGraph* g );
+  int computePriority( const QuotientGraph* g, const int vtx );
 };
 
 
@@ -406,12 +474,15 @@ public:
  */
 class MinPriority_MMMD : public MinPriority_MultipleElimination {
 public:
+  MinPriority_MMMD() { }
   MinPriority_MMMD(const int Size) 
     : MinPriority_MultipleElimination( Size ) { }
   virtual ~MinPriority_MMMD() { }
   virtual bool prioritize( const VertexList& reachableVtxs, 
 			   const QuotientGraph* g, 
 			   BucketSorter* degStruct );
+  void beginPrioritize( const QuotientGraph* g );
+  int computePriority( const QuotientGraph* g, const int vtx );
 };
 
 
@@ -464,6 +535,7 @@ public:
   MinPriority_AdvancedHybrid();
   MinPriority_AdvancedHybrid( const int Size, const int tol, const int n );
   virtual ~MinPriority_AdvancedHybrid();
+  virtual void releaseMemory();
   virtual bool requireSetDiffs();
   virtual bool prioritize( const VertexList& reachableVtxs, 
 			   const QuotientGraph* g, 
@@ -498,6 +570,7 @@ public:
   MinPriority_AdvancedHybrid2();
   MinPriority_AdvancedHybrid2( const int Size, const float tol, const int n );
   virtual ~MinPriority_AdvancedHybrid2();
+  virtual void releaseMemory();
   virtual bool requireSetDiffs();
   virtual bool prioritize( const VertexList& reachableVtxs, 
 			   const QuotientGraph* g, 
@@ -530,6 +603,7 @@ public:
   MinPriority_TimedHybrid();
   MinPriority_TimedHybrid( const int Size, const float slopeChange );
   ~MinPriority_TimedHybrid();
+  virtual void releaseMemory();
   virtual bool requireSetDiffs();
   virtual bool prioritize( const VertexList& reachableVtxs, 
 			   const QuotientGraph* g, 
@@ -539,6 +613,308 @@ public:
   bool setApproximateEliminationStrategy(  MinPriority_ApproximateElimination * strategy );
 };
 
+/**
+ * @memo reprioritize a reachable set with a statically bound strategy
+ * @type function
+ *
+ * Applies #Strategy::computePriority()# to every uneliminated vertex in
+ * #reachableVtxs# and inserts the result into #degStruct#.  Since
+ * #Strategy# is a template parameter, the per-vertex kernel is bound at
+ * compile time and inlined into this loop.  The #prioritize()# method
+ * of each concrete strategy is a thin wrapper around this function.
+ *
+ * @see MinPriorityEngineT
+ */
+template< class Strategy >
+inline bool 
+prioritizeReachSet( Strategy& strategy, 
+		    const MinPriorityStrategies::VertexList& reachableVtxs, 
+		    const QuotientGraph* g, 
+		    MinPriorityStrategies::BucketSorter* degStruct ) {
+  strategy.beginPrioritize( g );
+  for( MinPriorityStrategies::VertexList::const_iterator it=reachableVtxs.begin(), 
+	 stop=reachableVtxs.end(); it != stop; ++it ) {
+    const int vtx = *it;
+    if ( g->isEliminated( vtx ) ) { 
+      WARNING("Cannot compute priority of eliminated node %d.  Skipping.",vtx);
+      continue;
+    }
+    const int priority = strategy.computePriority( g, vtx );
+    TRACE( SPINDLE_TRACE_MINPRIORITY_SCHEME, " (%d,%d) ", vtx, priority );
+    degStruct->insert( priority, vtx );
+  } // end for all reachable vtxs
+  return true;
+}
+
+inline void
+MinPriorityStrategies::beginPrioritize( const QuotientGraph* g ) {
+  weight_ = g->getWeightArray();
+  externDeg_ = g->getExternDegreeArray();
+}
+
+inline int
+MinPriorityStrategies::computePriority( const QuotientGraph* , const int vtx ) {
+  return externDeg_[vtx];
+}
+
+inline void
+MinPriority_ExactDegree::beginPrioritize( const QuotientGraph* g ) {
+  MinPriorityStrategies::beginPrioritize( g );
+}
+
+inline int
+MinPriority_ExactDegree::computePriority( const QuotientGraph* , const int vtx ) {
+  return externDeg_[vtx] + weight_[vtx];
+}
+
+inline void
+MinPriority_ExternalDegree::beginPrioritize( const QuotientGraph* g ) {
+  MinPriorityStrategies::beginPrioritize( g );
+}
+
+inline int
+MinPriority_ExternalDegree::computePriority( const QuotientGraph* , const int vtx ) {
+  return externDeg_[vtx];
+}
+
+inline void
+MinPriority_ApproximateDegree::beginPrioritize( const QuotientGraph* g ) {
+  MinPriorityStrategies::beginPrioritize( g );
+}
+
+inline int
+MinPriority_ApproximateDegree::computePriority( const QuotientGraph* , const int vtx ) {
+  return externDeg_[vtx];
+}
+
+//
+// Rothberg '97
+//
+// score(i) = (d^2 - d ) /2 - (c^2 - c ) /2 
+// where d = ext deg(i) = external degree of node i
+//       c = |C_l \ weight(i)| = where C_l is the largest adjacent clique
+inline void
+MinPriority_AMF::beginPrioritize( const QuotientGraph* g ) {
+  MinPriorityStrategies::beginPrioritize( g );
+}
+
+inline int
+MinPriority_AMF::computePriority( const QuotientGraph* g, const int vtx ) {
+  const QuotientGraph::NodeView me = g->lendNodeView( vtx );
+  // find the adjacent clq of maximum size 
+  int max_clq = 0;
+  for( const int *curClq = me.enode_begin(), *stopClq = me.enode_end(); 
+       curClq < stopClq; ++curClq ) {  // for all adjacent cliques...
+    const int clq = *curClq;
+    if ( clq != vtx ) {                 //  .... excluding self 
+      const int clqWeight = weight_[ clq ];
+      max_clq = ( clqWeight > max_clq ) ? clqWeight : max_clq;
+    }
+  }
+  double score; 
+  const double d = (double) me.externDeg;  // d = the external degree of the node
+  if ( max_clq > 0 ) { 
+    // c = the size of the largest adjacent clique
+    const double c = (double) max_clq - me.weight; // c = |C_l \ v |
+    score = ( d * d - d ) / 2 - ( c * c - c ) / 2;
+  } else { 
+    score = ( d * d - d ) / 2;
+  }
+  return reduceRangeFromNSquaredToN( score );
+}
+
+//
+// Rothberg and Eisenstat
+//
+// score(i) = [ (d^2 - d ) - (c^2 - c ) ] / ( 2 *  weight(i) )
+// where d = ext deg(i) = external degree of node i
+//       c = |C_l \ weight(i)| = where C_l is most recently created clique
+inline void
+MinPriority_AMMF::beginPrioritize( const QuotientGraph* g ) {
+  MinPriorityStrategies::beginPrioritize( g );
+  const int C_l = g->queryLastEliminatedNode(); // last eliminated node
+  maxClq = ( C_l != -1 ) ? weight_[ C_l ] : 0 ; 
+  // weight of last eliminated node, if it exists
+}
+
+inline int
+MinPriority_AMMF::computePriority( const QuotientGraph* , const int vtx ) {
+  double score; 
+  const int my_weight = weight_[ vtx ];
+  const double d = (double) externDeg_[ vtx ];  // d = the external degree of the node
+  if ( maxClq > 0 ) { 
+    // c = the size of the largest adjacent clique
+    const double c = (double) maxClq - my_weight; // c = |C_l \ v |
+    score = ( ( d * d - d ) - ( c * c - c ) ) / ( 2 * my_weight );
+  } else { 
+    score = ( d * d - d ) / ( 2 * my_weight ) ;
+  }
+  return reduceRangeFromNSquaredToN( score );
+}
+
+//
+// score(i) = [ (d^2 - d ) - (c^2 - c ) ] /  2  - ( extdeg(i) * weight(i) )
+// where d = ext deg(i) = external degree of node i
+//       c = |C_l \ weight(i)| = where C_l is most recently created clique
+inline void
+MinPriority_AMIND::beginPrioritize( const QuotientGraph* g ) {
+  MinPriorityStrategies::beginPrioritize( g );
+  const int C_l = g->queryLastEliminatedNode(); // last eliminated node
+  maxClq = ( C_l != -1 ) ? weight_[ C_l ] : 0 ; 
+  // weight of last eliminated node, if it exists
+}
+
+inline int
+MinPriority_AMIND::computePriority( const QuotientGraph* , const int vtx ) {
+  double score; 
+  const int my_weight = weight_[ vtx ];
+  const double d = (double) externDeg_[ vtx ];  // d = the external degree of the node
+  if ( maxClq > 0 ) { 
+    // c = the size of the largest adjacent clique
+    const double c = (double) maxClq - my_weight; // c = |C_l \ v |
+    score = ( ( d * d - d ) - ( c * c - c ) ) / 2  - (d * my_weight);
+  } else { 
+    score = ( d * d - d ) / 2  - ( d * my_weight ) ;
+  }
+  return reduceRangeFromNSquaredToN( score );
+}
+
+inline void
+MinPriority_MMMF::beginPrioritize( const QuotientGraph* g ) {
+  MinPriorityStrategies::beginPrioritize( g );
+}
+
+inline int
+MinPriority_MMMF::computePriority( const QuotientGraph* g, const int vtx ) {
+  const QuotientGraph::NodeView me = g->lendNodeView( vtx );
+  // find largest clique
+  int max_clq = 0;
+  for( const int *curClq = me.enode_begin(), *stopClq = me.enode_end(); 
+       curClq < stopClq; ++curClq ) { // for all adjacent cliques ...
+    const int clq = *curClq;
+    if ( clq != vtx ) {                //  .... except self 
+      const int clqWeight = weight_[ clq ];
+      max_clq = ( clqWeight > max_clq ) ? clqWeight : max_clq;
+    }
+  }
+  double score; 
+  const int my_weight = me.weight;
+  const double d = (double) me.externDeg;  // d = the external degree of the node
+  if ( max_clq > 0 ) { 
+    // c = the size of the largest adjacent clique
+    const double c = (double) max_clq - my_weight; // c = |C_max \ v |
+    score = ( ( d * d - d ) - ( c * c - c ) ) / ( 2 * my_weight );
+  } else { 
+    score = ( d * d - d ) / ( 2 * my_weight ) ;
+  }
+  return reduceRangeFromNSquaredToN( score );
+}
+
+inline void
+MinPriority_MMIND::beginPrioritize( const QuotientGraph* g ) {
+  MinPriorityStrategies::beginPrioritize( g );
+}
+
+inline int
+MinPriority_MMIND::computePriority( const QuotientGraph* g, const int vtx ) {
+  const QuotientGraph::NodeView me = g->lendNodeView( vtx );
+  // find largest clique
+  int max_clq = 0;
+  for( const int *curClq = me.enode_begin(), *stopClq = me.enode_end(); 
+       curClq < stopClq; ++curClq ) { // for all adjacent cliques ...
+    const int clq = *curClq;
+    if ( clq != vtx ) {                // ... excluding self 
+      const int clqWeight = weight_[ clq ];
+      max_clq = ( clqWeight > max_clq ) ? clqWeight : max_clq;
+    }
+  }
+  double score; 
+  const int my_weight = me.weight;
+  const double d = (double) me.externDeg;  // d = the external degree of the node
+  if ( max_clq > 0 ) { 
+    // c = the size of the largest adjacent clique
+    const double c = (double) max_clq - my_weight; // c = |C_max \ v |
+    score = ( ( d * d - d ) - ( c * c - c ) ) / 2  - (d * my_weight);
+  } else { 
+    score = ( d * d - d ) / 2  - ( d * my_weight ) ;
+  }
+  return reduceRangeFromNSquaredToN( score );
+}
+
+//
+//  Ng Raghavan 97
+//
+// score(i) = (d^2 - d) - C - ct
+// where d = ext deg(i) = external degree of node i
+//       C = let K be set of partial cliques.
+//           C = \sum_{v \in K} weight(v)^2 - weight(v)
+//       ct = 2 * extdeg( i) * weight(i)
+inline void
+MinPriority_MMDF::beginPrioritize( const QuotientGraph* g ) {
+  MinPriorityStrategies::beginPrioritize( g );
+}
+
+inline int
+MinPriority_MMDF::computePriority( const QuotientGraph* g, const int vtx ) {
+  const QuotientGraph::NodeView me = g->lendNodeView( vtx );
+  const int degree = me.externDeg;
+  double clq_fill = 0.0;
+  const int stamp = getStamp();
+  visited[vtx] = stamp;  // keep from revisiting self
+  for( const int* curVtx = me.snode_begin(), *stopVtx = me.snode_end(); 
+       curVtx < stopVtx; ++curVtx ) {
+    // flag all snodes adj to me
+    visited[ *curVtx ] = stamp;
+  }
+  for( const int *curClq = me.enode_begin(), *stopClq = me.enode_end(); 
+       curClq < stopClq; ++curClq ) {
+    // for all adjacent cliques ( excluding self )
+    const int clq = *curClq;
+    if ( clq == vtx ) { continue; }
+    double this_clq_fill = 0.0;
+    for( const int* curVtx = g->clique_begin( clq ), *stopVtx = g->clique_end( clq ); 
+	 curVtx < stopVtx; ++curVtx ) {
+      // for all vertices in each clique
+      const int adj = *curVtx;
+      if ( visited[ adj ] < stamp ) {  // if not yet visited
+	visited[ adj ] = stamp;        // visit now
+	this_clq_fill += (double) weight_[ adj ];
+      }
+    }
+    if ( this_clq_fill > 0.0 ) {
+      clq_fill += this_clq_fill * ( this_clq_fill - 1 );
+    }
+  }
+  double score = (double) degree;
+  score = ( score * ( score - 1.0 )) - clq_fill - ( 2*degree*me.weight) ;
+  return reduceRangeFromNSquaredToN( score );
+}
+
+//
+// priority(v_k) = 2 * extdeg( v_k ) - max clique v_k is a member of
+//
+inline void
+MinPriority_MMMD::beginPrioritize( const QuotientGraph* g ) {
+  MinPriorityStrategies::beginPrioritize( g );
+}
+
+inline int
+MinPriority_MMMD::computePriority( const QuotientGraph* g, const int vtx ) {
+  const QuotientGraph::NodeView me = g->lendNodeView( vtx );
+  const int degree = me.externDeg;
+  int clq_fill = 0;
+  for( const int *curClq = me.enode_begin(), *stopClq = me.enode_end(); 
+       curClq < stopClq; ++curClq ) {
+    // for all adjacent cliques ( excluding self )
+    const int clq = *curClq;
+    if ( clq == vtx ) { continue; } // skip self clique
+    const int this_clq_fill = weight_[ clq ];
+    clq_fill = ( this_clq_fill > clq_fill ) ? this_clq_fill : clq_fill ;
+  }
+  const int score = 2*degree - clq_fill;
+  return reduceRangeFromNSquaredToN( score );
+}
+
 SPINDLE_END_NAMESPACE
 
 #endif
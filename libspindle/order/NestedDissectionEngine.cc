@@ -0,0 +1,488 @@
+//
+// NestedDissectionEngine.cc
+//
+// $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+//
+
+#include "spindle/NestedDissectionEngine.h"
+
+#include "spindle/MinPriorityEngine.h"
+
+#ifdef REQUIRE_OLD_CXX_HEADER_SUFFIX
+#include <algo.h>
+#else
+#include <algorithm>
+using namespace std;
+#endif
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+NestedDissectionEngine::NestedDissectionEngine() {
+  incrementInstanceCount( NestedDissectionEngine::MetaData );
+  maxLeafSize = 128;
+  // every part is a lot of work, so hand them out one at a time
+  team.setMinChunkSize( 1 );
+  reset();
+}
+
+NestedDissectionEngine::NestedDissectionEngine( const Graph* graph ) {
+  incrementInstanceCount( NestedDissectionEngine::MetaData );
+  maxLeafSize = 128;
+  team.setMinChunkSize( 1 );
+  reset();
+  setGraph( graph );
+}
+
+NestedDissectionEngine::~NestedDissectionEngine() {
+  clearSearches();
+  decrementInstanceCount( NestedDissectionEngine::MetaData );
+}
+
+void
+NestedDissectionEngine::clearSearches() {
+  for( int i=0; i<(int)diams.size(); ++i ) {
+    delete diams[i];
+    delete bfss[i];
+  }
+  diams.resize(0);
+  bfss.resize(0);
+  scratch.resize(0);
+}
+
+bool
+NestedDissectionEngine::setGraph( const Graph* graph ) {
+  return OrderingAlgorithm::setGraph( graph );
+}
+
+bool
+NestedDissectionEngine::reset() {
+  nLeaves = 0;
+  nSeparatorVtxs = 0;
+  nLevels = 0;
+  g = 0;
+  dissection_timer.reset();
+  leaf_timer.reset();
+  clearSearches();
+  return OrderingAlgorithm::reset();
+}
+
+bool
+NestedDissectionEngine::setMaxLeafSize( const int maxLeaf ) {
+  if ( maxLeaf < 1 ) { return false; }
+  maxLeafSize = maxLeaf;
+  return true;
+}
+
+bool
+NestedDissectionEngine::execute() {
+  if ( algorithmicState != READY ) { return false; }
+
+  if ( useGraphCompression ) {
+    g = coarseGraph;
+  } else {
+    g = fineGraph;
+  }
+  const int n = g->size();
+  nLeaves = 0;
+  nSeparatorVtxs = 0;
+  nLevels = 0;
+
+  dissection_timer.start();
+  //
+  // 1. everything starts in one part
+  //
+  vtxs.resize( n );
+  partMap.resize( n );
+  {for( int i=0; i<n; ++i ) {
+    vtxs[i] = i;
+    partMap[i] = 0;
+  }}
+
+  //
+  // 2. one set of search objects per thread, all restricted to partMap
+  //
+  clearSearches();
+  const int nThreads = team.queryNThreads();
+  {for( int i=0; i<nThreads; ++i ) {
+    PseudoDiameter * diam = new PseudoDiameter();
+    BreadthFirstSearch * bfs = new BreadthFirstSearch( g );
+    bfs->enablePartitionRestrictions( &partMap[0] );
+    diams.push_back( diam );
+    bfss.push_back( bfs );
+  }}
+  scratch.resize( nThreads );
+
+  //
+  // 3. split all the parts of one level at a time
+  //
+  vector<int> leafBegin;
+  vector<int> leafSize;
+  vector<bool> leafIsClique;
+  vector<int> nextBegin;
+  vector<int> nextSize;
+  partBegin.resize(0);
+  partSize.resize(0);
+  partBegin.push_back( 0 );
+  partSize.push_back( n );
+  while( partBegin.size() > 0 ) {
+    const int nParts = partBegin.size();
+    nFirst.resize( nParts );
+    nSecond.resize( nParts );
+    ++nLevels;
+#ifdef SPINDLE_TRACE_IS_THREAD_SAFE
+    team.run( splitTask, this, nParts );
+#else
+    // the searches trace their calls, split one part after another
+    ThreadTeam( 1 ).run( splitTask, this, nParts );
+#endif
+    {for( int p=0; p<nParts; ++p ) {
+      if ( nFirst[p] < 0 ) {
+	// a search failed, the part can be neither split nor left whole
+	clearSearches();
+	dissection_timer.stop();
+	algorithmicState = INVALID;
+	return false;
+      }
+    }}
+
+    // relabel the second halves and the separators; these are
+    // written only here so that the searches above never see a
+    // partMap that is being changed underneath them.
+    nextBegin.resize(0);
+    nextSize.resize(0);
+    {for( int p=0; p<nParts; ++p ) {
+      const int begin = partBegin[p];
+      const int size = partSize[p];
+      if ( nFirst[p] == 0 ) {
+	leafBegin.push_back( begin );
+	leafSize.push_back( size );
+	leafIsClique.push_back( nSecond[p] != 0 );
+	continue;
+      }
+      const int mid = begin + nFirst[p];
+      const int sep = mid + nSecond[p];
+      {for( int i=mid; i<sep; ++i ) {
+	partMap[ vtxs[i] ] = mid;
+      }}
+      {for( int i=sep; i<begin+size; ++i ) {
+	partMap[ vtxs[i] ] = -1;
+      }}
+      nSeparatorVtxs += begin + size - sep;
+      nextBegin.push_back( begin );
+      nextSize.push_back( nFirst[p] );
+      if ( nSecond[p] > 0 ) {
+	nextBegin.push_back( mid );
+	nextSize.push_back( nSecond[p] );
+      }
+    }}
+    partBegin.swap( nextBegin );
+    partSize.swap( nextSize );
+  }
+  clearSearches();
+  dissection_timer.stop();
+
+  //
+  // 4. order each leaf with minimum degree
+  //
+  leaf_timer.start();
+  nLeaves = leafBegin.size();
+  {for( int i=0; i<nLeaves; ++i ) {
+    if ( leafIsClique[i] ) {
+      continue;  // every order of a clique is free of fill
+    }
+    if ( !orderLeaf( leafBegin[i], leafSize[i] ) ) {
+      leaf_timer.stop();
+      algorithmicState = INVALID;
+      return false;
+    }
+  }}
+  leaf_timer.stop();
+
+  algorithmicState = DONE;
+  return OrderingAlgorithm::recomputePermutations( &vtxs[0] );
+}
+
+void
+NestedDissectionEngine::splitTask( void * arg, const int begin, const int end,
+				   const int threadID ) {
+  NestedDissectionEngine * nd = (NestedDissectionEngine *) arg;
+  for( int p=begin; p<end; ++p ) {
+    nd->splitPart( p, threadID );
+  }
+}
+
+//
+// Splits part p in place.  On exit vtxs[begin,begin+size) lists the
+// first half, then the second half, then the separator, and
+// nFirst[p], nSecond[p] are set.  nFirst[p]==0 means p is a leaf (a
+// clique if nSecond[p]==1), nFirst[p]==-1 that a search failed.
+// Runs concurrently with other parts: touches only its own range of
+// vtxs, its own entries of nFirst/nSecond, and the objects for threadID.
+//
+void
+NestedDissectionEngine::splitPart( const int p, const int threadID ) {
+  const int begin = partBegin[p];
+  const int size = partSize[p];
+  nFirst[p] = 0;
+  nSecond[p] = 0;
+  if ( size <= maxLeafSize ) {
+    return;
+  }
+  int * part = &vtxs[0] + begin;
+
+  // 1. start the pseudo-diameter from a vertex of minimum degree
+  int root = part[0];
+  {for( int i=1; i<size; ++i ) {
+    if ( g->deg( part[i] ) < g->deg( root ) ) {
+      root = part[i];
+    }
+  }}
+  // PseudoDiameter carries short-circuiting limits from one run to the
+  // next, so start from a clean one; otherwise the result would depend
+  // on which parts this thread happened to split before.
+  PseudoDiameter * diam = diams[ threadID ];
+  diam->reset();
+  diam->setGraph( g );
+  diam->enablePartitionRestrictions( &partMap[0] );
+  if ( !diam->setRoot( root ) || !diam->execute() ) {
+    nFirst[p] = -1;
+    return;
+  }
+  int start = diam->queryEndpoints().first;
+  if ( start < 0 ) {
+    start = root;
+  }
+
+  // 2. level structure from that end
+  BreadthFirstSearch * bfs = bfss[ threadID ];
+  if ( !bfs->setRoot( start ) || !bfs->execute() ) {
+    bfs->reset();
+    bfs->setGraph( g );
+    bfs->enablePartitionRestrictions( &partMap[0] );
+    nFirst[p] = -1;
+    return;
+  }
+  const int nVisited = bfs->queryNVisited();
+  const int height = bfs->queryHeight();
+  const int * distance = bfs->getDistance().lend();
+  vector<int>& work = scratch[ threadID ];
+  work.resize( size );
+
+  if ( nVisited < size ) {
+    // 3a. disconnected: this component first, the rest second
+    int nA = 0;
+    int nB = size;
+    {for( int i=0; i<size; ++i ) {
+      if ( distance[ part[i] ] >= 0 ) {
+	work[ nA++ ] = part[i];
+      } else {
+	work[ --nB ] = part[i];
+      }
+    }}
+    {for( int i=0; i<size; ++i ) {
+      part[i] = work[i];
+    }}
+    nFirst[p] = nA;
+    nSecond[p] = size - nA;
+    return;
+  }
+  if ( height < 2 ) {
+    // 3b. start is adjacent to the whole part, so there is no interior
+    //     level to cut along.  A clique has no separator worth taking
+    //     and no order of it makes fill: it stays a leaf as it is.
+    //     Otherwise start alone is the separator, and the rest is split
+    //     again at the next level.
+    const int label = partMap[ start ];
+    bool clique = true;
+    {for( int i=0; ( i<size ) && clique; ++i ) {
+      const int v = part[i];
+      int nInside = 0;
+      for( const int * adj = g->begin_adj(v), *stop = g->end_adj(v); adj != stop; ++adj ) {
+	if ( ( *adj != v ) && ( partMap[ *adj ] == label ) ) {
+	  ++nInside;
+	}
+      }
+      clique = ( nInside == size - 1 );
+    }}
+    if ( clique ) {
+      nSecond[p] = 1;
+      return;
+    }
+    int nA = 0;
+    {for( int i=0; i<size; ++i ) {
+      if ( part[i] != start ) {
+	work[ nA++ ] = part[i];
+      }
+    }}
+    work[ nA ] = start;
+    {for( int i=0; i<size; ++i ) {
+      part[i] = work[i];
+    }}
+    nFirst[p] = nA;
+    nSecond[p] = 0;
+    return;
+  }
+
+  // 3c. choose the separating level.  Of the levels that leave at least
+  //     a fifth of the part on either side pick the narrowest; if none
+  //     does, take the level holding the median vertex.
+  vector<int> levelStart( height + 2, 0 );
+  {for( int i=0; i<size; ++i ) {
+    ++levelStart[ distance[ part[i] ] + 1 ];
+  }}
+  {for( int l=1; l<=height+1; ++l ) {
+    levelStart[l] += levelStart[l-1];
+  }}
+  int sepLevel = -1;
+  {for( int l=1; l<height; ++l ) {
+    const int nBefore = levelStart[l];
+    const int nAfter = size - levelStart[l+1];
+    if ( ( 5 * nBefore < size ) || ( 5 * nAfter < size ) ) {
+      continue;
+    }
+    if ( ( sepLevel == -1 ) ||
+	 ( levelStart[l+1] - levelStart[l] < levelStart[sepLevel+1] - levelStart[sepLevel] ) ) {
+      sepLevel = l;
+    }
+  }}
+  if ( sepLevel == -1 ) {
+    sepLevel = 1;
+    while( ( sepLevel < height - 1 ) && ( 2 * levelStart[sepLevel+1] <= size ) ) {
+      ++sepLevel;
+    }
+  }
+
+  // 4. a vertex on the separating level with no neighbor beyond it
+  //    does not separate anything; move it to the first half.
+  int nA = 0;
+  int nS = 0;
+  {for( int i=0; i<size; ++i ) {
+    const int v = part[i];
+    const int d = distance[v];
+    bool first = ( d < sepLevel );
+    if ( d == sepLevel ) {
+      first = true;
+      for( const int * adj = g->begin_adj(v), *stop = g->end_adj(v); adj != stop; ++adj ) {
+	if ( distance[ *adj ] == sepLevel + 1 ) {
+	  first = false;
+	  break;
+	}
+      }
+      if ( !first ) {
+	work[ size - (++nS) ] = v;
+	continue;
+      }
+    }
+    if ( first ) {
+      work[ nA++ ] = v;
+    }
+  }}
+  int nB = nA;
+  {for( int i=0; i<size; ++i ) {
+    if ( distance[ part[i] ] > sepLevel ) {
+      work[ nB++ ] = part[i];
+    }
+  }}
+  {for( int i=0; i<size; ++i ) {
+    part[i] = work[i];
+  }}
+  nFirst[p] = nA;
+  nSecond[p] = nB - nA;
+}
+
+//
+// orders vtxs[begin,begin+size) by minimum degree on the induced subgraph
+//
+bool
+NestedDissectionEngine::orderLeaf( const int begin, const int size ) {
+  if ( size < 3 ) {
+    return true;
+  }
+  int * leaf = &vtxs[0] + begin;
+  const int label = partMap[ leaf[0] ];
+
+  // number the leaf vertices locally, reusing partMap, then
+  // build the induced subgraph.
+  int nnz = 0;
+  {for( int i=0; i<size; ++i ) {
+    partMap[ leaf[i] ] = -2 - i;
+  }}
+  {for( int i=0; i<size; ++i ) {
+    for( const int * adj = g->begin_adj(leaf[i]), *stop = g->end_adj(leaf[i]); adj != stop; ++adj ) {
+      if ( partMap[*adj] <= -2 ) {
+	++nnz;
+      }
+    }
+  }}
+  if ( nnz == 0 ) {
+    {for( int i=0; i<size; ++i ) {
+      partMap[ leaf[i] ] = label;
+    }}
+    return true;
+  }
+  int * adjHead = new int[ size + 1 ];
+  int * adjList = new int[ nnz ];
+  int * vtxWeight = 0;
+  const bool weighted = ( g->getVtxWeight().size() == g->size() );
+  if ( weighted ) {
+    vtxWeight = new int[ size ];
+  }
+  nnz = 0;
+  {for( int i=0; i<size; ++i ) {
+    adjHead[i] = nnz;
+    for( const int * adj = g->begin_adj(leaf[i]), *stop = g->end_adj(leaf[i]); adj != stop; ++adj ) {
+      if ( partMap[*adj] <= -2 ) {
+	adjList[ nnz++ ] = -2 - partMap[*adj];
+      }
+    }
+    // local numbers follow the order of vtxs, not of the graph, so the
+    // row must be sorted before Graph::validate() sees it
+    sort( adjList + adjHead[i], adjList + nnz );
+    if ( weighted ) {
+      vtxWeight[i] = g->getVtxWeight()[ leaf[i] ];
+    }
+  }}
+  adjHead[size] = nnz;
+  {for( int i=0; i<size; ++i ) {
+    partMap[ leaf[i] ] = label;
+  }}
+
+  Graph subgraph( size, adjHead, adjList, vtxWeight, (int*) 0 );
+  subgraph.validate();
+  if ( !subgraph.isValid() ) {
+    return false;
+  }
+  MinPriorityEngine leafOrder( &subgraph );
+  leafOrder.setRandomizeGraph( false );
+  if ( !leafOrder.execute() ) {
+    return false;
+  }
+  const PermutationMap * perm = leafOrder.getPermutation();
+  if ( ( perm == 0 ) || ( !perm->isValid() ) ) {
+    return false;
+  }
+  const int * new2Old = perm->getNew2Old().lend();
+  vector<int> local( leaf, leaf + size );
+  {for( int i=0; i<size; ++i ) {
+    leaf[i] = local[ new2Old[i] ];
+  }}
+  return true;
+}
+
+SPINDLE_IMPLEMENT_DYNAMIC( NestedDissectionEngine, SpindleAlgorithm )
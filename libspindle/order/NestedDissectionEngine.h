@@ -0,0 +1,203 @@
+//
+// NestedDissectionEngine.h
+//
+// $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+//=======================================================================
+//
+//
+
+#ifndef SPINDLE_NESTED_DISSECTION_ENGINE_H_
+#define SPINDLE_NESTED_DISSECTION_ENGINE_H_
+
+#ifndef SPINDLE_H_
+#include "spindle/spindle.h"
+#endif
+
+#ifndef SPINDLE_ORDERING_ALGORITHM_H_
+#include "spindle/OrderingAlgorithm.h"
+#endif
+
+#ifndef SPINDLE_PERMUTATION_H_
+#include "spindle/PermutationMap.h"
+#endif
+
+#ifndef SPINDLE_BFS_H_
+#include "spindle/BreadthFirstSearch.h"
+#endif
+
+#ifndef SPINDLE_PSEUDO_DIAM_H_
+#include "spindle/PseudoDiameter.h"
+#endif
+
+#ifndef SPINDLE_THREAD_TEAM_H_
+#include "spindle/ThreadTeam.h"
+#endif
+
+#include "spindle/Graph.h"
+
+#ifdef REQUIRE_OLD_CXX_HEADER_SUFFIX
+#include <vector.h>
+#else
+#include <vector>
+using std::vector;
+#endif
+
+SPINDLE_BEGIN_NAMESPACE
+
+/**
+ * @memo does a nested dissection ordering using level structure separators
+ * @type class
+ *
+ * Each part of the graph is split by a breadth first search from one
+ * end of a pseudo-diameter.  The level closest to the middle (preferring
+ * narrow levels) becomes the separator, after dropping separator vertices
+ * that have no neighbor on the far side.  The two halves are numbered
+ * first, the separator last.  A part that is disconnected is simply split
+ * into one component and the rest, with an empty separator.
+ *
+ * If the end of the pseudo-diameter is adjacent to the whole part, that
+ * vertex alone is the separator, unless the part is a clique.
+ *
+ * Parts no larger than #maxLeafSize# vertices are leaves, and are
+ * ordered with a #MinPriorityEngine# on the induced subgraph.  A larger
+ * clique is a leaf too, since no separator helps it, and is left in the
+ * order it has.  If a search fails on a larger part, #execute()#
+ * returns false.
+ *
+ * All parts at the same depth of the dissection are independent, so they
+ * are split concurrently if #setNThreads()# is given more than one thread
+ * and the library was configured with #--enable-threads#.  The result
+ * does not depend on the number of threads.  Leaves are ordered serially.
+ *
+ * @see BreadthFirstSearch
+ * @see PseudoDiameter
+ * @see MinPriorityEngine
+ * @author agent
+ * @version #$Id$#
+ */
+class NestedDissectionEngine : public OrderingAlgorithm {
+
+public:
+  /**
+   * default constructor
+   */
+  NestedDissectionEngine();
+
+  /**
+   * convenience constructor
+   */
+  NestedDissectionEngine( const Graph* graph );
+
+  /**
+   * virtual destructor
+   */
+  virtual ~NestedDissectionEngine();
+
+  /**
+   * execute algorithm
+   */
+  virtual bool execute();
+
+  /**
+   * reset algorithm to EMPTY state
+   */
+  virtual bool reset();
+
+  /**
+   * set graph
+   */
+  virtual bool setGraph( const Graph* graph );
+
+  /**
+   * parts with at most this many vertices are not dissected further
+   * (default is 128).  Returns false if #maxLeaf < 1#.
+   */
+  bool setMaxLeafSize( const int maxLeaf );
+
+  /** query the maximum leaf size */
+  int queryMaxLeafSize() const { return maxLeafSize; }
+
+  /**
+   * set the number of threads used to split the parts at each level
+   * of the dissection.  Returns false if #nThreads < 1#.
+   */
+  bool setNThreads( const int nThreads ) { return team.setNThreads( nThreads ); }
+
+  /** query the number of threads that will be used */
+  int queryNThreads() const { return team.queryNThreads(); }
+
+  /** @return the number of leaves in the dissection tree */
+  int queryNLeaves() const { return nLeaves; }
+
+  /** @return the total number of separator vertices */
+  int queryNSeparatorVtxs() const { return nSeparatorVtxs; }
+
+  /** @return the number of levels in the dissection tree */
+  int queryNLevels() const { return nLevels; }
+
+  /**
+   * time spent finding separators
+   */
+  const stopwatch& getDissectionTimer() const { return dissection_timer; }
+
+  /**
+   * time spent ordering the leaves
+   */
+  const stopwatch& getLeafTimer() const { return leaf_timer; }
+
+private:
+  stopwatch dissection_timer;
+  stopwatch leaf_timer;
+
+  int maxLeafSize;
+  int nLeaves;
+  int nSeparatorVtxs;
+  int nLevels;
+
+  ThreadTeam team;
+
+  const Graph * g;        // graph being ordered (fine or coarse)
+
+  // vtxs[begin, begin+size) lists the vertices of a part.  The range is
+  // also the set of positions the part occupies in the final ordering.
+  vector<int> vtxs;
+  // label of the part each vertex belongs to, the begin of its range.
+  // Separator vertices are -1.
+  vector<int> partMap;
+
+  // the parts at the current level, and how each was split
+  vector<int> partBegin;
+  vector<int> partSize;
+  vector<int> nFirst;     // vertices in the first half (0 if leaf)
+  vector<int> nSecond;    // vertices in the second half
+
+  // one set of search objects and scratch per thread
+  vector< PseudoDiameter * > diams;
+  vector< BreadthFirstSearch * > bfss;
+  vector< vector<int> > scratch;
+
+  void clearSearches();
+  static void splitTask( void * arg, const int begin, const int end,
+			 const int threadID );
+  void splitPart( const int part, const int threadID );
+  bool orderLeaf( const int begin, const int size );
+
+  SPINDLE_DECLARE_DYNAMIC( NestedDissectionEngine )
+
+};
+
+SPINDLE_END_NAMESPACE
+
+#endif
@@ -28,6 +28,10 @@
 #include "spindle/Graph.h"
 #endif
 
+#ifndef SPINDLE_PACKED_GRAPH_H_
+#include "spindle/PackedGraph.h"
+#endif
+
 #ifndef SPINDLE_GRAPH_COMPRESSOR_H_
 #include "spindle/GraphCompressor.h"
 #endif
@@ -46,6 +50,7 @@ using namespace SPINDLE_NAMESPACE;
 
 OrderingAlgorithm::OrderingAlgorithm() { 
   fineGraph = 0;
+  packedGraph = 0;
   coarseGraph = 0;
   compressionRatio = 0.9;
   compressor = new GraphCompressor();
@@ -55,6 +60,7 @@ OrderingAlgorithm::OrderingAlgorithm() {
 }
 OrderingAlgorithm::OrderingAlgorithm(const Graph* graph) { 
   fineGraph = 0;
+  packedGraph = 0;
   coarseGraph = 0;
   compressionRatio = 0.9;
   compressor = new GraphCompressor();
@@ -67,6 +73,7 @@ OrderingAlgorithm::OrderingAlgorithm(const Graph* graph) {
 bool
 OrderingAlgorithm::reset() {
   fineGraph =0; // never delete since we never own this.
+  packedGraph =0;
   if ( coarseGraph != 0 ) { 
     delete coarseGraph;
     coarseGraph =0;
@@ -100,10 +107,12 @@ OrderingAlgorithm::setGraph( const Graph* graph) {
     return false;
   }
   fineGraph = graph;
+  packedGraph = 0;
   if ( finePermutation == 0 ) { 
     finePermutation = new PermutationMap( fineGraph->queryNVtxs() );
   } else { 
     finePermutation->resize( fineGraph->queryNVtxs() );
+    finePermutation->reset();  // may hold the ordering of a previous graph
   }
 
   compressor->reset();
@@ -115,6 +124,44 @@ OrderingAlgorithm::setGraph( const Graph* graph) {
   return true;
 }
 
+bool
+OrderingAlgorithm::setGraph( const PackedGraph* ) { 
+  return false;
+}
+
+bool
+OrderingAlgorithm::setPackedGraph( const PackedGraph* graph ) { 
+  if ( !graph || !graph->isValid() ) {
+    algorithmicState = INVALID;
+    return false;
+  }
+  if ( algorithmicState == INVALID ) { 
+    return false;
+  }
+  fineGraph = 0;
+  packedGraph = graph;
+  if ( finePermutation == 0 ) { 
+    finePermutation = new PermutationMap( packedGraph->queryNVtxs() );
+  } else { 
+    finePermutation->resize( packedGraph->queryNVtxs() );
+    finePermutation->reset();  // may hold the ordering of a previous graph
+  }
+
+  // the GraphCompressor needs a Graph
+  compressor->reset();
+  useGraphCompression = false;
+  if ( coarseGraph != 0 ) { 
+    delete coarseGraph;
+    coarseGraph = 0;
+  }
+  if ( coarsePermutation != 0 ) { 
+    delete coarsePermutation;
+    coarsePermutation = 0;
+  }
+  algorithmicState = READY;
+  return true;
+}
+
 bool OrderingAlgorithm::setCompressionRatio( const float ratio ) { 
   if ( algorithmicState == INVALID ) { return false; }
   if ( ratio > 1.0 ) { return false; }
@@ -125,7 +172,9 @@ bool OrderingAlgorithm::setCompressionRatio( const float ratio ) {
     return true;
   } 
   compressionRatio = ratio;
-  recomputeCompression();
+  if ( fineGraph != 0 ) { 
+    recomputeCompression();
+  }
   return true;
 }
 
@@ -147,6 +196,7 @@ void OrderingAlgorithm::recomputeCompression() {
       coarsePermutation = new PermutationMap ( coarseGraph->queryNVtxs() );
     } else { 
       coarsePermutation->resize( coarseGraph->queryNVtxs() );
+      coarsePermutation->reset();
     }
   } else {
     if ( coarseGraph != 0 ) { 
@@ -182,10 +232,11 @@ OrderingAlgorithm::givePermutation()  {
 bool OrderingAlgorithm::recomputePermutations(const int *new2old, const int *old2new) {
   if ( algorithmicState != DONE ) { return 0; }
   if ( !useGraphCompression ) { 
+    const int n = ( fineGraph != 0 ) ? fineGraph->queryNVtxs() : packedGraph->queryNVtxs();
     if ( new2old != 0 ) { 
-      finePermutation->getNew2Old().import( new2old, fineGraph->queryNVtxs() );
+      finePermutation->getNew2Old().import( new2old, n );
     } else if ( old2new != 0 ) { 
-      finePermutation->getOld2New().import( old2new, fineGraph->queryNVtxs() );
+      finePermutation->getOld2New().import( old2new, n );
     } 
     finePermutation->validate();
     if ( !finePermutation->isValid() ) { 
@@ -46,6 +46,7 @@ SPINDLE_BEGIN_NAMESPACE
 // forward declarations
 class PermutationMap;
 class Graph;
+class PackedGraph;
 class GraphCompressor;
 
 
@@ -76,6 +77,10 @@ protected:
    * points to the input graph
    */
   const Graph * fineGraph;
+  /**
+   * points to the input graph if it was packed, then #fineGraph# is 0
+   */
+  const PackedGraph * packedGraph;
   /**
    * points to the internal compressed graph, or 0
    */
@@ -137,6 +142,12 @@ protected:
    */
   bool recomputePermutations(const int *new2old=0, const int *old2new=0);
 
+  /**
+   * sets #packedGraph# for derived classes that override 
+   * #setGraph( const PackedGraph* )#.  Packed graphs are never compressed.
+   */
+  bool setPackedGraph( const PackedGraph* graph );
+
 
 public:
   /**
@@ -163,6 +174,14 @@ public:
    */
   virtual bool setGraph( const Graph* graph );
 
+  /**
+   * order a packed graph instead.  Only orderings that just stream the
+   * neighbors of each vertex can, the others return false.
+   * @param graph should be valid.
+   * @see PackedGraph
+   */
+  virtual bool setGraph( const PackedGraph* graph );
+
   /**
    * set the tolerance for the compression ratio.
    * if the ratio of vertices in the compressed graph to the 
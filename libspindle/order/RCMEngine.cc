@@ -20,10 +20,16 @@
 
 #include "spindle/RCMEngine.h"
 
+#ifndef SPINDLE_PACKED_GRAPH_H_
+#include "spindle/PackedGraph.h"
+#endif
+
 #ifdef REQUIRE_OLD_CXX_HEADER_SUFFIX
 #include <iostream.h>
+#include <algo.h>
 #else
 #include <iostream>
+#include <algorithm>
 using namespace std;
 #endif
 
@@ -33,6 +39,184 @@ using namespace SPINDLE_NAMESPACE;
 
 //static char invalidGraph[] = "Error: invalid graph detected.";
 
+//
+// The tasks below run on the threads of RCMEngine's team.
+//
+
+struct RCMNumbering { 
+  const int * vtxList;
+  int * old2New;
+  int last;             // number of vtxList[0]
+};
+
+static void
+RCMNumbering_task( void * arg, const int begin, const int end, const int ) { 
+  RCMNumbering * r = (RCMNumbering *) arg;
+  for( int i=begin; i<end; ++i ) { 
+    r->old2New[ r->vtxList[i] ] = r->last - i;
+  }
+}
+
+// degree of v as G::deg() has it, without the trace its operator[] uses
+static inline int
+RCMEngine_deg( const Graph * g, const int v ) { 
+  const int * adjHead = g->getAdjHead().lend();
+  if ( g->getVtxWeight().size() == 0 ) { 
+    return adjHead[v+1] - adjHead[v];
+  }
+  const int * adjList = g->getAdjList().lend();
+  const int * vtxWeight = g->getVtxWeight().lend();
+  int temp = 0;
+  for( int j=adjHead[v]; j<adjHead[v+1]; ++j ) { 
+    if ( adjList[j] != v ) { 
+      temp += vtxWeight[ adjList[j] ];
+    }
+  }
+  return temp;
+}
+
+static inline int
+RCMEngine_deg( const PackedGraph * g, const int v ) { 
+  return g->deg( v );
+}
+
+// number of neighbors of v, ignoring vertex weights
+static inline int
+RCMEngine_nAdj( const Graph * g, const int v ) { 
+  const int * adjHead = g->getAdjHead().lend();
+  return adjHead[v+1] - adjHead[v];
+}
+
+static inline int
+RCMEngine_nAdj( const PackedGraph * g, const int v ) { 
+  return g->nAdj( v );
+}
+
+template< class G >
+struct RCMMinDegree { 
+  const G * g;
+  const int * vtxList;
+  int * minPos;         // position of the first minimum found by each thread
+};
+
+template< class G >
+static void
+RCMMinDegree_task( void * arg, const int begin, const int end, const int threadID ) { 
+  RCMMinDegree<G> * r = (RCMMinDegree<G> *) arg;
+  int best = r->minPos[ threadID ];
+  int bestDeg = ( best < 0 ) ? -1 : RCMEngine_deg( r->g, r->vtxList[best] );
+  for( int i=begin; i<end; ++i ) { 
+    const int v = r->vtxList[i];
+    const int deg = RCMEngine_deg( r->g, v );
+    if ( ( best < 0 ) || ( deg < bestDeg ) || ( ( deg == bestDeg ) && ( i < best ) ) ) { 
+      best = i;
+      bestDeg = deg;
+    }
+  }
+  r->minPos[ threadID ] = best;
+}
+
+//
+// shared state of one level of RCMEngine::sortLevels().  The level is
+// order[ blockBegin[0] .. blockBegin[nBlocks] ), its children are at
+// distance childDistance.  G is a Graph or a PackedGraph.
+//
+template< class G >
+struct RCMLevel { 
+  const G * g;
+  const int * distance;
+  const int * vtxList;
+  int * order;
+  volatile int * parent;
+  const int * blockBegin;
+  int * blockCount;     // children of each block, then where they go
+  int childDistance;
+  int unclaimed;        // parent of a vertex of the component not yet placed
+  int mark;
+};
+
+template< class G >
+static void
+RCMLevel_markTask( void * arg, const int begin, const int end, const int ) { 
+  RCMLevel<G> * l = (RCMLevel<G> *) arg;
+  for( int i=begin; i<end; ++i ) { 
+    l->parent[ l->vtxList[i] ] = l->mark;
+  }
+}
+
+template< class G >
+static void
+RCMLevel_findParentsTask( void * arg, const int begin, const int end, const int ) { 
+  RCMLevel<G> * l = (RCMLevel<G> *) arg;
+  for( int blk=begin; blk<end; ++blk ) { 
+    for( int j=l->blockBegin[blk]; j<l->blockBegin[blk+1]; ++j ) { 
+      const int i = l->order[j];
+      for( typename G::const_iterator cur = l->g->begin_adj(i), stop = l->g->end_adj(i);
+	   cur != stop; ++cur ) { 
+	const int w = *cur;
+	if ( ( l->parent[w] < 0 ) || ( l->distance[w] != l->childDistance ) ) { continue; }
+	int old = l->parent[w];
+	while( ( j < old ) && ( !ThreadTeam::compareAndSwap( l->parent + w, old, j ) ) ) { 
+	  old = l->parent[w];
+	}
+      }
+    }
+  }
+}
+
+template< class G >
+static void
+RCMLevel_countChildrenTask( void * arg, const int begin, const int end, const int ) { 
+  RCMLevel<G> * l = (RCMLevel<G> *) arg;
+  for( int blk=begin; blk<end; ++blk ) { 
+    int count = 0;
+    for( int j=l->blockBegin[blk]; j<l->blockBegin[blk+1]; ++j ) { 
+      const int i = l->order[j];
+      for( typename G::const_iterator cur = l->g->begin_adj(i), stop = l->g->end_adj(i);
+	   cur != stop; ++cur ) { 
+	if ( l->parent[ *cur ] == j ) { ++count; }
+      }
+    }
+    l->blockCount[blk] = count;
+  }
+}
+
+// orders children by degree, then by vertex as the adjacency lists do
+template< class G >
+struct RCMDegreeLess { 
+  const G * g;
+  RCMDegreeLess( const G * g_ ) : g( g_ ) {}
+  bool operator()( const int v, const int w ) const { 
+    const int degV = RCMEngine_nAdj( g, v );
+    const int degW = RCMEngine_nAdj( g, w );
+    return ( degV < degW ) || ( ( degV == degW ) && ( v < w ) );
+  }
+};
+
+template< class G >
+static void
+RCMLevel_placeChildrenTask( void * arg, const int begin, const int end, const int ) { 
+  RCMLevel<G> * l = (RCMLevel<G> *) arg;
+  const RCMDegreeLess<G> byDegree( l->g );
+  for( int blk=begin; blk<end; ++blk ) { 
+    int * dest = l->order + l->blockCount[blk];
+    for( int j=l->blockBegin[blk]; j<l->blockBegin[blk+1]; ++j ) { 
+      const int i = l->order[j];
+      int * first = dest;
+      for( typename G::const_iterator cur = l->g->begin_adj(i), stop = l->g->end_adj(i);
+	   cur != stop; ++cur ) { 
+	const int w = *cur;
+	if ( l->parent[w] == j ) { 
+	  *(dest++) = w;
+	}
+      }
+      if ( dest - first > 1 ) { 
+	sort( first, dest, byDegree );
+      }
+    }
+  }
+}
+
 RCMEngine::RCMEngine() {
   incrementInstanceCount( RCMEngine::MetaData );
   bfs = new BreadthFirstSearch();
@@ -58,9 +242,16 @@ RCMEngine::~RCMEngine() {
 
 bool 
 RCMEngine::setGraph( const Graph* graph ) {
+  nVtxsNumbered = 0;
   return  OrderingAlgorithm::setGraph( graph );
 }
 
+bool 
+RCMEngine::setGraph( const PackedGraph* graph ) {
+  nVtxsNumbered = 0;
+  return  OrderingAlgorithm::setPackedGraph( graph );
+}
+
 bool
 RCMEngine::reset() {
   //
@@ -70,6 +261,8 @@ RCMEngine::reset() {
 
   // erase all information from previous runs.
   nVtxsNumbered = 0; // set number of vertices numbered back to 0
+  degreeSorting = false;
+  team.setNThreads( 1 );
   ordering_timer.reset();
   diagnostic_timer.reset();
   bfs->reset();
@@ -77,6 +270,13 @@ RCMEngine::reset() {
   return OrderingAlgorithm::reset();
 }
 
+bool
+RCMEngine::setNThreads( const int nThreads ) {
+  if ( algorithmicState == INVALID ) { return false; }
+  return bfs->setNThreads( nThreads ) && diam->setNThreads( nThreads ) 
+    && team.setNThreads( nThreads );
+}
+
 bool 
 RCMEngine::setPseudoDiamShrinkingStrategy( PseudoDiamShrinkingStrategy * shrink ) {
   if ( algorithmicState == INVALID ) { return false; }
@@ -90,18 +290,29 @@ bool
 RCMEngine::execute() {
   if ( algorithmicState != READY ) { return false; }
   
-  const Graph* g;
   int * old2New;
   if ( useGraphCompression ) { 
-    g = coarseGraph;
     old2New = coarsePermutation->getOld2New().begin();
   } else { 
-    g = fineGraph;
     old2New = finePermutation->getOld2New().begin();
   }
     
   diagnostic_timer.start();
+  if ( packedGraph != 0 ) { 
+    numberComponents( packedGraph, old2New );
+  } else if ( useGraphCompression ) { 
+    numberComponents( (const Graph *) coarseGraph, old2New );
+  } else { 
+    numberComponents( fineGraph, old2New );
+  }
+  algorithmicState = DONE;
+  diagnostic_timer.stop();
+  return OrderingAlgorithm::recomputePermutations();
+}
 
+template< class G >
+void
+RCMEngine::numberComponents( const G* g, int * old2New ) {
   bfs->setGraph( g );
   diam->setGraph( g );
 
@@ -123,14 +334,7 @@ RCMEngine::execute() {
 
       //  find vtx of minimum degree in component
       const int* vertexList = bfs->getNew2Old().lend();  
-      int cur_min_idx = vertexList[0];
-      int cur_min = g->deg( cur_min_idx );
-      {for(int j=1; j<bfs->queryNVisited(); ++j) {
-	if ( g->deg( vertexList[j] ) < cur_min ) {
-	  cur_min_idx = vertexList[j];
-	  cur_min = g->deg( cur_min_idx );
-	} 
-      }}
+      int cur_min_idx = findMinDegreeVtx( g, vertexList, bfs->queryNVisited() );
     
       // now compute a psuedo-diameter on that component
       // starting from the vertex of minimum degree
@@ -141,20 +345,14 @@ RCMEngine::execute() {
       // perform the ordering on that component
       executeFrom( endpoint.second , g, old2New);
       if (nVtxsNumbered == n) { // if I've numbered them all
-	diagnostic_timer.stop(); 
-	algorithmicState = DONE;
-	return OrderingAlgorithm::recomputePermutations();
+	break;
       }
     }
   }}
-  // gets here if we number individual
-  // vertices last
-  algorithmicState = DONE;
-  diagnostic_timer.stop();
-  return OrderingAlgorithm::recomputePermutations();
 }
 
-bool RCMEngine::executeFrom( const int endVtx, const Graph* g, int * old2New ) {
+template< class G >
+bool RCMEngine::executeFrom( const int endVtx, const G* g, int * old2New ) {
   //
   // 1. Verify that startVtx and endVtx are valid vertices 
   //
@@ -170,13 +368,128 @@ bool RCMEngine::executeFrom( const int endVtx, const Graph* g, int * old2New ) {
 
   const int* vtxList = bfs->getNew2Old().lend();
   int nVtxs = bfs->queryNVisited();
-  
-  {for(int i=nVtxs-1; i>=0; i--) { 
-    old2New[vtxList[i]] = nVtxsNumbered++;
-  }}
+
+  //
+  // 3. relabel the levels if the neighbors are to be sorted by degree
+  //
+  if ( degreeSorting ) { 
+    if ( !sortLevels( g, endVtx, nVtxs ) ) { 
+      ordering_timer.stop();
+      return false;
+    }
+    vtxList = cmOrder.lend();
+  }
+
+  //
+  // 4. number them in reverse
+  //
+  RCMNumbering numbering;
+  numbering.vtxList = vtxList;
+  numbering.old2New = old2New;
+  numbering.last = nVtxsNumbered + nVtxs - 1;
+  team.run( RCMNumbering_task, &numbering, nVtxs );
+  nVtxsNumbered += nVtxs;
   ordering_timer.stop();
   return true;
 }
 
+template< class G >
+int 
+RCMEngine::findMinDegreeVtx( const G* g, const int vtxList[], const int nVtxs ) const { 
+  // the first one of minimum degree in vtxList
+  const int nThreads = team.queryNThreads();
+  vector<int> minPos( nThreads, -1 );
+  RCMMinDegree<G> search;
+  search.g = g;
+  search.vtxList = vtxList;
+  search.minPos = &(minPos[0]);
+  team.run( RCMMinDegree_task<G>, &search, nVtxs );
+  int best = -1;
+  {for( int t=0; t<nThreads; ++t ) { 
+    const int pos = minPos[t];
+    if ( pos < 0 ) { continue; }
+    if ( ( best < 0 ) || ( g->deg( vtxList[pos] ) < g->deg( vtxList[best] ) ) ||
+	 ( ( g->deg( vtxList[pos] ) == g->deg( vtxList[best] ) ) && ( pos < best ) ) ) { 
+      best = pos;
+    }
+  }}
+  return vtxList[best];
+}
+
+//
+// Computes the Cuthill-McKee order of the component of root into
+// cmOrder[0..nVtxs), using the distances of the search just done from
+// root.  A vertex at distance d+1 is a child of its neighbor at
+// distance d that was numbered first, and each vertex's children are
+// numbered together in order of increasing degree.  So once a level is
+// numbered, the next one is fixed too: each of its vertices finds its
+// parent with an atomic minimum, each block of the level counts the
+// children of its vertices, a prefix sum over the blocks says where
+// they go, and each block writes and sorts them there.
+//
+template< class G >
+bool 
+RCMEngine::sortLevels( const G* g, const int root, const int nVtxs ) { 
+  const int n = g->size();
+  if ( parent.size() != n ) { 
+    parent.resize( n );
+    parent.init( -1 );
+  }
+  cmOrder.resize( nVtxs );
+
+  // smallest number of vertices in a level worth giving to a thread
+  const int minBlockSize = 256;
+  const int maxBlocks = 4 * team.queryNThreads();
+  vector<int> blockBegin( maxBlocks + 1 );
+  vector<int> blockCount( maxBlocks + 1 );
+
+  RCMLevel<G> level;
+  level.g = g;
+  level.distance = bfs->getDistance().lend();
+  level.order = cmOrder.begin();
+  level.parent = parent.begin();
+  level.blockBegin = &(blockBegin[0]);
+  level.blockCount = &(blockCount[0]);
+  level.unclaimed = n;
+
+  // mark the component, only its vertices may be claimed
+  level.mark = level.unclaimed;
+  level.vtxList = bfs->getNew2Old().lend();
+  team.run( RCMLevel_markTask<G>, &level, nVtxs );
+
+  level.order[0] = root;
+  int begin = 0;
+  int end = 1;
+  while( begin < end ) { 
+    const int width = end - begin;
+    int nBlocks = width / minBlockSize;
+    nBlocks = ( nBlocks > maxBlocks ) ? maxBlocks : nBlocks;
+    nBlocks = ( nBlocks < 1 ) ? 1 : nBlocks;
+    {for( int blk=0; blk<=nBlocks; ++blk ) { 
+      blockBegin[blk] = begin + (int) ( ( (double) width * blk ) / nBlocks );
+    }}
+    level.childDistance = level.distance[ level.order[ begin ] ] + 1;
+    team.run( RCMLevel_findParentsTask<G>, &level, nBlocks, 1 );
+    team.run( RCMLevel_countChildrenTask<G>, &level, nBlocks, 1 );
+    int next = end;
+    {for( int blk=0; blk<nBlocks; ++blk ) { 
+      const int count = blockCount[blk];
+      blockCount[blk] = next;
+      next += count;
+    }}
+    if ( next > nVtxs ) { 
+      break; // cannot happen with the distances of a complete search
+    }
+    team.run( RCMLevel_placeChildrenTask<G>, &level, nBlocks, 1 );
+    begin = end;
+    end = next;
+  }
+
+  // leave parent[] as it was for the next component
+  level.mark = -1;
+  team.run( RCMLevel_markTask<G>, &level, nVtxs );
+  return ( end == nVtxs );
+}
+
 SPINDLE_IMPLEMENT_DYNAMIC( RCMEngine, SpindleAlgorithm )
 
@@ -46,6 +46,10 @@
 #include "spindle/PseudoDiameter.h"
 #endif
 
+#ifndef SPINDLE_THREAD_TEAM_H_
+#include "spindle/ThreadTeam.h"
+#endif
+
 #include "spindle/Graph.h"
 
 SPINDLE_BEGIN_NAMESPACE
@@ -91,6 +95,12 @@ public:
    */
   virtual bool setGraph( const Graph* graph );
 
+  /**
+   * order a PackedGraph instead.  Its neighbors are decoded as the
+   * searches go; graph compression is not used.
+   */
+  virtual bool setGraph( const PackedGraph* graph );
+
   /**
    * set shrinking strategy
    */
@@ -112,6 +122,33 @@ public:
   bool disablePartitionRestrictions()  // default
     { return bfs->disablePartitionRestrictions(); }
 
+  /**
+   * let the searches for pseudo-peripheral vertices and the ordering
+   * itself use up to #nThreads# threads.  The ordering is the same for
+   * any number of threads.  #reset()# goes back to one thread.
+   */
+  bool setNThreads( const int nThreads );
+
+  /**
+   * @return number of threads used by each search
+   */
+  int queryNThreads() const { return bfs->queryNThreads(); }
+
+  /**
+   * number the unnumbered neighbors of each vertex in order of
+   * increasing degree (ties by vertex number), as in the classic
+   * Cuthill-McKee algorithm.  The levels are relabeled one at a time,
+   * each on all threads, and give the same ordering for any number of
+   * threads.
+   */
+  void enableDegreeSorting() { degreeSorting = true; }
+
+  /**
+   * number the unnumbered neighbors of each vertex in adjacency order,
+   * which is the order the breadth first search visits them (default).
+   */
+  void disableDegreeSorting() { degreeSorting = false; }
+
   /**
    * grant const access to the breadth first search object.
    */
@@ -139,6 +176,11 @@ private:
   stopwatch diagnostic_timer;
 
   int nVtxsNumbered;
+  bool degreeSorting;
+  ThreadTeam team;
+
+  SharedArray<int> cmOrder;  // Cuthill-McKee order of the current component
+  SharedArray<int> parent;   // position of a vertex's parent in cmOrder
 
   //  const Graph* g;
   BreadthFirstSearch* bfs;
@@ -147,7 +189,11 @@ private:
   //  SharedArray<int> old2New;
 
   void numberVertices( const int startVtx, const int vtxList[], const int nVtxs );
-  bool executeFrom( const int endVtx, const Graph* g, int * old2New  );
+  // G is a Graph or a PackedGraph
+  template< class G > void numberComponents( const G* g, int * old2New );
+  template< class G > bool executeFrom( const int endVtx, const G* g, int * old2New  );
+  template< class G > int findMinDegreeVtx( const G* g, const int vtxList[], const int nVtxs ) const;
+  template< class G > bool sortLevels( const G* g, const int root, const int nVtxs );
 
   SPINDLE_DECLARE_DYNAMIC( RCMEngine )
 
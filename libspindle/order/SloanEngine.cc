@@ -25,6 +25,10 @@
 #include "spindle/GraphCompressor.h"
 #endif
 
+#ifndef SPINDLE_PACKED_GRAPH_H_
+#include "spindle/PackedGraph.h"
+#endif
+
 #ifdef REQUIRE_OLD_CXX_HEADER_SUFFIX
 #include <iostream.h>
 #include <limits.h>
@@ -64,6 +68,8 @@ SloanEngine::SloanEngine() {
   incrementInstanceCount( SloanEngine::MetaData );
   bfs = 0;
   heap = 0;
+  daryHeap = 0;
+  buckets = 0;
   reset();
 }
 
@@ -71,6 +77,8 @@ SloanEngine::SloanEngine( const Graph* graph ) {          // unweighted Graph co
   incrementInstanceCount( SloanEngine::MetaData );
   bfs = 0;
   heap = 0;
+  daryHeap = 0;
+  buckets = 0;
   reset();
   setGraph( graph );
 }  
@@ -78,13 +86,51 @@ SloanEngine::SloanEngine( const Graph* graph ) {          // unweighted Graph co
 
 SloanEngine::~SloanEngine() {
   delete heap;
+  delete daryHeap;
+  delete buckets;
   delete bfs;
   decrementInstanceCount( SloanEngine::MetaData );
 }
 
 bool
 SloanEngine::setGraph( const Graph* graph ) {
-  return OrderingAlgorithm::setGraph( graph );
+  if ( !OrderingAlgorithm::setGraph( graph ) ) { 
+    return false;
+  }
+  if ( nVtxsNumbered != 0 ) { 
+    // forget the previous graph, its start and end vertices included
+    nVtxsNumbered = 0;
+    startVtxs.resize(0);
+    endVtxs.resize(0);
+  }
+  if ( classDetected ) { 
+    // the class found for the previous graph may not fit this one
+    setClass( 0 );
+    classDetected = false;
+  }
+  return true;
+}
+
+bool
+SloanEngine::setGraph( const PackedGraph* graph ) {
+  if ( !OrderingAlgorithm::setPackedGraph( graph ) ) { 
+    return false;
+  }
+  if ( nVtxsNumbered != 0 ) { 
+    nVtxsNumbered = 0;
+    startVtxs.resize(0);
+    endVtxs.resize(0);
+  }
+  if ( classDetected ) { 
+    setClass( 0 );
+    classDetected = false;
+  }
+  return true;
+}
+
+int
+SloanEngine::deg( const int vtx ) const {
+  return ( packedGraph != 0 ) ? packedGraph->deg( vtx ) : g->deg( vtx );
 }
 
 bool
@@ -95,9 +141,14 @@ SloanEngine::reset() {
   g = 0;
   nVtxsTotal = 0;
   setClass( 0 );
+  classDetected = false;
   VertexWeight = 0;
   forceEndVtxsLast = false;
   makeStartVtxsInWavefront = false;
+  useDaryHeap = false;
+  useBucketQueue = false;
+  bucketQueueActive = false;
+  bucketOffset = 0;
 
   disablePartitionRestrictions();
   disableRefinement();
@@ -251,7 +302,9 @@ SloanEngine::execute() {
   // assign the engine to work on the correct graph and permutation
   //
   //  int * old2New;
-  if ( useGraphCompression ) { 
+  if ( packedGraph != 0 ) { 
+    g = 0;
+  } else if ( useGraphCompression ) { 
     g = coarseGraph;
     //old2New = coarsePermutation->getOld2New().begin();
   } else { 
@@ -262,32 +315,50 @@ SloanEngine::execute() {
   // if this is the first run for this graph, then
   // there are some additional details to take care of
   if ( nVtxsNumbered == 0 ) { 
-    const int n = g->queryNVtxs();
+    const int n = ( packedGraph != 0 ) ? packedGraph->queryNVtxs() : g->queryNVtxs();
     if ( bfs == 0 ) {
-      bfs = new BreadthFirstSearch( g );
+      bfs = new BreadthFirstSearch();
+    }
+    if ( packedGraph != 0 ) {
+      bfs->setGraph( packedGraph );
     } else {
       bfs->setGraph( g );
     }
     if ( heap == 0 ) {
       heap = new Heap( n, n );
     }
+    if ( useDaryHeap && ( daryHeap == 0 ) ) {
+      daryHeap = new DaryHeap( n, n );
+    }
     if ( diam.isNull() ) {
-      diam.take( new PseudoDiameter( g ) );
+      diam.take( new PseudoDiameter() );
+    }
+    if ( packedGraph != 0 ) {
+      diam->setGraph( packedGraph );
     } else {
       diam->setGraph( g );
     }
     if ( n != nVtxsTotal ) {
       nVtxsTotal = n;
       heap->resize(n,n);
+      if ( daryHeap != 0 ) {
+	daryHeap->resize(n,n);
+      }
       status.resize( n );
       wavefront.resize( n );
       oldWavefront.resize( n );
       initial_priority.resize( n );
       new2Old_1.resize(n);
       new2Old_2.resize(n);
+      bumpItems.resize(n);
+      bumpDeltas.resize(n);
     }
-    if (g->getVtxWeight().size() != 0) {
-      vtxWeight.borrow( g->getVtxWeight() );
+    const SharedArray<int>& graphVtxWeight = 
+      ( packedGraph != 0 ) ? packedGraph->getVtxWeight() : g->getVtxWeight();
+    if ( graphVtxWeight.size() != 0) {
+      vtxWeight.borrow( graphVtxWeight );
+    } else if ( vtxWeight.notNull() ) {
+      vtxWeight.reset();  // borrowed from a previous graph
     }
     nodeStatus *sp;    
     sp = status.begin(); {for(int i=0; i<n; i++) { *sp++ = INACTIVE; }} 
@@ -349,7 +420,7 @@ SloanEngine::execute() {
     break;
   }
   totalExecutionTimer.stop();
-  if (nVtxsNumbered >= g->size()) { 
+  if (nVtxsNumbered >= nVtxsTotal) { 
     algorithmicState = DONE;
     return OrderingAlgorithm::recomputePermutations(new2Old_1.begin());
   }
@@ -369,9 +440,9 @@ SloanEngine::orderEverything() {
   //
   // 1. use Sloan to number the rest.
   //
-  {for (int i=0; i<g->size(); ++i) {            // for all vertices
+  {for (int i=0; i<nVtxsTotal; ++i) {            // for all vertices
     if (status[i] == NUMBERED) { continue; }   // ... not yet numbered
-    if (( status[i] == INACTIVE ) && (g->deg(i) <  1) ) { // number small ones
+    if (( status[i] == INACTIVE ) && (deg(i) <  1) ) { // number small ones
       new2old_1[ nVtxsNumbered ] = i;
       new2old_2[ nVtxsNumbered ] = i;
       status[i] = NUMBERED;
@@ -403,7 +474,7 @@ SloanEngine::orderEverything() {
     setStartVtx( endpoint.first );
     setEndVtx( endpoint.second );
     orderComponent();  // then perform the ordering on the component.
-    if (nVtxsNumbered >= g->size()) { 
+    if (nVtxsNumbered >= nVtxsTotal) { 
       algorithmicState = DONE;
       return true;
     }
@@ -530,6 +601,7 @@ SloanEngine::orderComponent() {
 	numberVerticesKeptTimer += case2Overhead;
 	numberVerticesRejectedTimer += case1Overhead;
 	setClass(2);
+	classDetected = true;
 	// copy the regions back to the array
 	memcpy( wavefront.begin() + begin, oldWavefront.begin() + begin, (end-begin)*sizeof(int) );
 	memcpy( new2Old_1.begin() + begin, new2Old_2.begin() + begin, (end-begin)*sizeof(int) );
@@ -539,6 +611,7 @@ SloanEngine::orderComponent() {
 	numberVerticesKeptTimer += case1Overhead;
 	numberVerticesRejectedTimer += case2Overhead;
 	setClass(1);
+	classDetected = true;
       } // end if
     } // end switch
   } // end else if (weightingScheme == DETERMINED_BY_CLASS)
@@ -556,14 +629,15 @@ SloanEngine::numberVertices( const int* vtxList, const int nVtxs) {
   computeInitialPriority(vtxList, nVtxs);
 
   //
-  // 2. Initialize Heap and status[]
+  // 2. Initialize Heap (or buckets) and status[]
   //
+  chooseQueue(vtxList, nVtxs);
   {for (int i=0; i<nVtxs; i++ ) {
     status[ vtxList[i] ] = INACTIVE;
   }}
   for( vector<int>::const_iterator cur=startVtxs.begin(), stop=startVtxs.end(); cur != stop; ++cur ) {
     if ( status[ *cur ] == INACTIVE ) {
-      heap->insert( initial_priority[ *cur ] , *cur );
+      queueInsert( initial_priority[ *cur ] , *cur );
       status[ *cur ] = PREACTIVE; 
     }
   }
@@ -578,7 +652,7 @@ SloanEngine::numberVertices( const int* vtxList, const int nVtxs) {
 	if ( (status[ i ] != NUMBERED) && (status[ i ] != ACTIVE ) ) {
 	  status[ i ] = ACTIVE; 
 	  int weight_i = LocalWeight;
-	  heap->incrementPriority( weight_i, i );
+	  queueIncrement( weight_i, i );
 	  secondOrderNeighbors( weight_i, i );
 	}
       }
@@ -588,7 +662,7 @@ SloanEngine::numberVertices( const int* vtxList, const int nVtxs) {
 	if ( ( status[ i ] != NUMBERED ) && ( status[ i ] != ACTIVE ) ) {
 	  status[ i ] = ACTIVE; 
 	  int weight_i = LocalWeight * vtxWeight[i]; // here's the only difference
-	  heap->incrementPriority( weight_i, i );
+	  queueIncrement( weight_i, i );
 	  secondOrderNeighbors( weight_i, i );
 	}
       }
@@ -599,9 +673,21 @@ SloanEngine::numberVertices( const int* vtxList, const int nVtxs) {
   // 3. Now do the ordering
   // 
   if (VertexWeight == 0) {
-    unweightedOrdering(nVtxs);
+    if ( packedGraph != 0 ) { 
+      unweightedOrdering( packedGraph, nVtxs );
+    } else { 
+      unweightedOrdering( g, nVtxs );
+    }
   } else {
-    weightedOrdering(nVtxs);
+    if ( packedGraph != 0 ) { 
+      weightedOrdering( packedGraph, nVtxs );
+    } else { 
+      weightedOrdering( g, nVtxs );
+    }
+  }
+  // leave the buckets empty for the next component
+  if ( bucketQueueActive ) {
+    while( buckets->size() > 0 ) { buckets->extractMax(); }
   }
 
 }
@@ -623,7 +709,7 @@ SloanEngine::computeInitialPriority( const int vtxList[], const int nVtxs ) {
     {for( int i = 0; i<nVtxs; i++) {
       vtx = vtxList[i];
       initial_priority[vtx] = ( (GlobalWeight * dist[vtx])
-	                      - (LocalWeight  * g->deg(vtx)) );
+	                      - (LocalWeight  * deg(vtx)) );
     }}
   } else if ((RefinementWeight == 0) && (VertexWeight != 0)) { 
     //
@@ -634,7 +720,7 @@ SloanEngine::computeInitialPriority( const int vtxList[], const int nVtxs ) {
     {for( int i = 0; i<nVtxs; i++) {
       vtx = vtxList[i];
       initial_priority[vtx] = ( (GlobalWeight * dist[vtx])
-	                      - (LocalWeight  * g->deg(vtx))
+	                      - (LocalWeight  * deg(vtx))
 	                      + (VertexWeight * vwgt[vtx]) );
     }}
   } else if ((RefinementWeight != 0) && (VertexWeight == 0)) { 
@@ -646,7 +732,7 @@ SloanEngine::computeInitialPriority( const int vtxList[], const int nVtxs ) {
       {for( int i = 0; i<nVtxs; i++) {
 	vtx = vtxList[i];
 	initial_priority[vtx] = ( (GlobalWeight     * dist[vtx])
-	                        - (LocalWeight      * g->deg(vtx))
+	                        - (LocalWeight      * deg(vtx))
 	                        - (RefinementWeight * vtx) );
       }} 
     } else { // if ( explicitOrder.nonNull() )
@@ -658,7 +744,7 @@ SloanEngine::computeInitialPriority( const int vtxList[], const int nVtxs ) {
       {for( int i = 0; i<nVtxs; i++) {
 	vtx = vtxList[i];
 	initial_priority[vtx] = ( (GlobalWeight     * dist[vtx])
-	                        - (LocalWeight      * g->deg(vtx))
+	                        - (LocalWeight      * deg(vtx))
 			        - (RefinementWeight * inputOld2New[vtx]) );
       }}
     }
@@ -672,7 +758,7 @@ SloanEngine::computeInitialPriority( const int vtxList[], const int nVtxs ) {
       {for( int i = 0; i<nVtxs; i++) {
 	vtx = vtxList[i];
 	initial_priority[vtx] = ( (GlobalWeight     * dist[vtx])
- 	                        - (LocalWeight      * g->deg(vtx))
+ 	                        - (LocalWeight      * deg(vtx))
 		                + (VertexWeight     * vwgt[vtx])
 		                - (RefinementWeight * vtx) );
       }} 
@@ -686,7 +772,7 @@ SloanEngine::computeInitialPriority( const int vtxList[], const int nVtxs ) {
       {for( int i = 0; i<nVtxs; i++) {
 	vtx = vtxList[i];
 	initial_priority[vtx] = ( (GlobalWeight     * dist[vtx])
-	                        - (LocalWeight      * g->deg(vtx))
+	                        - (LocalWeight      * deg(vtx))
 			        + (VertexWeight     * vwgt[vtx])
 			        - (RefinementWeight * inputOld2New[vtx]) );
       }}
@@ -711,18 +797,89 @@ SloanEngine::computeInitialPriority( const int vtxList[], const int nVtxs ) {
   }
 }
 
+void
+SloanEngine::chooseQueue( const int vtxList[], const int nVtxs ) {
+  bucketQueueActive = false;
+  if ( ( !useBucketQueue ) || ( nVtxs <= 0 ) || ( LocalWeight < 0 ) ) { return; }
+
+  // Priorities only grow from their initial values.  Every vertex gains
+  // at most 2*LocalWeight*w when it is inserted and 3*LocalWeight*w per
+  // neighbor afterwards (w is the largest vertex weight), plus
+  // LocalWeight*w if it is a start vertex forced into the wavefront.
+  int maxVwgt = 1;
+  if ( VertexWeight != 0 ) {
+    const int * vwgt = vtxWeight.lend();
+    maxVwgt = 0;
+    {for( int i=0; i<nVtxs; ++i ) {
+      const int w = vwgt[ vtxList[i] ];
+      if ( w < 0 ) { return; }
+      maxVwgt = ( w > maxVwgt ) ? w : maxVwgt;
+    }}
+  }
+  const int * l_initial_priority = initial_priority.lend();
+  int minPriority = l_initial_priority[ vtxList[0] ];
+  {for( int i=1; i<nVtxs; ++i ) {
+    const int p = l_initial_priority[ vtxList[i] ];
+    minPriority = ( p < minPriority ) ? p : minPriority;
+  }}
+  const double growth = ((double) LocalWeight) * maxVwgt;
+  double maxPriority = minPriority;
+  {for( int i=0; i<nVtxs; ++i ) {
+    const int vtx = vtxList[i];
+    const double p = l_initial_priority[vtx] + growth * ( 3.0 * deg(vtx) + 3.0 );
+    maxPriority = ( p > maxPriority ) ? p : maxPriority;
+  }}
+
+  // Scanning down for the next non-empty bucket costs up to the range,
+  // so only use buckets when that is linear in the component size.
+  // Every numbered vertex also lifts the maximum by about LocalWeight,
+  // and the next extraction scans back down, so large local weights
+  // relative to the global weight favor the heap as well.
+  const double range = maxPriority - minPriority + 1.0;
+  if ( range > 8.0 * nVtxs + 1024.0 ) { return; }
+  if ( growth > 64.0 * ( ( GlobalWeight > 1 ) ? GlobalWeight : 1 ) ) { return; }
+  const int nBuckets = (int) range;
+  if ( buckets == 0 ) {
+    buckets = new MaxBucketSorter( nBuckets, nVtxsTotal );
+  } else if ( ( nBuckets > buckets->queryNBuckets() ) || 
+	      ( nVtxsTotal != buckets->queryNItems() ) ) {
+    int newNBuckets = 2 * buckets->queryNBuckets();
+    newNBuckets = ( nBuckets > newNBuckets ) ? nBuckets : newNBuckets;
+    buckets->resize( newNBuckets, nVtxsTotal );
+  }
+  bucketOffset = minPriority;
+  bucketQueueActive = true;
+}
+
+void
+SloanEngine::switchToHeap() {
+  // A priority fell outside the bucket range (e.g. a vertex outside the
+  // component was reached).  Move everything to the heap and finish there.
+  bucketQueueActive = false;
+  while( buckets->size() > 0 ) {
+    const int key = buckets->queryMaxBucket();
+    const int vtx = buckets->extractMax();
+    if ( useDaryHeap ) {
+      daryHeap->insert( key + bucketOffset, vtx );
+    } else {
+      heap->insert( key + bucketOffset, vtx );
+    }
+  }
+}
+
+template< class G >
 void 
-SloanEngine::unweightedOrdering(const int nVtxs) {
+SloanEngine::unweightedOrdering( const G* graph, const int nVtxs ) {
   int nActive= (makeStartVtxsInWavefront) ? startVtxs.size() : 0;
   int * new2old = new2Old_1.begin();
   nodeStatus * l_status = status.begin();
   int * l_initial_priority = initial_priority.begin();
   
   // 5. test for termination
-  for( int k=0; (k<nVtxs) && (heap->size()>0) ; k++) {
+  for( int k=0; (k<nVtxs) && (queueSize()>0) ; k++) {
     
     // 6. Find highest priority node in heap
-    int i = heap->extractMax(); 
+    int i = queueExtractMax(); 
     ////cdbg << "Selected Vertex=" << i << ", iteration=" << k << ", nVtxsNumbered=" << nVtxsNumbered << endl;
     
     // 7. Label vertex
@@ -736,7 +893,7 @@ SloanEngine::unweightedOrdering(const int nVtxs) {
     // 9. for all j \in \adj(i) do 
     if (status_i == ACTIVE) {
       nActive--;
-      for(Graph::const_iterator cur=g->begin_adj(i), stop=g->end_adj(i); cur != stop; ++cur) {
+      for(typename G::const_iterator cur=graph->begin_adj(i), stop=graph->end_adj(i); cur != stop; ++cur) {
 	int j = *cur;
 	////cdbg << "\tExamining neighbor " << j << "...";
 	switch( l_status[j] ) {
@@ -746,14 +903,14 @@ SloanEngine::unweightedOrdering(const int nVtxs) {
 	  l_status[j] = ACTIVE; nActive++;
 	  weight_j = l_initial_priority[j] + 2 * LocalWeight;
 	  ////cdbg << "Case ACTIVE/INACTIVE:  node=" << j << " added with weight=" << weight_j << endl;
-	  heap->insert(weight_j, j);
+	  queueInsert(weight_j, j);
 	  break;
 	case 1: // status_i==ACTIVE, l_status[j]==PREACTIVE
 	  l_status[j] = ACTIVE; nActive++;
 	  weight_j = LocalWeight ;
 	  ////cdbg << "Case ACTIVE/PREACTIVE:  node=" << j << " incremented by weight=" << weight_j << endl;
-	  heap->incrementPriority( weight_j, j );
-	  secondOrderNeighbors( weight_j, j );
+	  queueIncrement( weight_j, j );
+	  secondOrderNeighbors( graph, weight_j, j );
 	  break;
 	case 2: // status_i==ACTIVE, l_status[j]==ACTIVE
 	  ////cdbg << "Case ACTIVE/ACTIVE:" << endl;
@@ -767,7 +924,7 @@ SloanEngine::unweightedOrdering(const int nVtxs) {
 	} // end switch
       } // end adj_i loop
     } else if (status_i == PREACTIVE) {
-      for(Graph::const_iterator cur=g->begin_adj(i), stop=g->end_adj(i); cur != stop; ++cur) {
+      for(typename G::const_iterator cur=graph->begin_adj(i), stop=graph->end_adj(i); cur != stop; ++cur) {
 	int j = *cur;
 	////cdbg << "\tExamining neighbor " << j << "...";
 	switch( l_status[j] ) {
@@ -777,22 +934,22 @@ SloanEngine::unweightedOrdering(const int nVtxs) {
 	  l_status[j] = ACTIVE; nActive++;
 	  weight_j = l_initial_priority[j] + 2 * LocalWeight ;
 	  ////cdbg << "Case PREACTIVE/INACTIVE:  node=" << j << " added with weight=" << weight_j << endl;
-	  heap->insert(weight_j, j);
+	  queueInsert(weight_j, j);
 	  weight_j = LocalWeight;
-	  secondOrderNeighbors( weight_j, j );
+	  secondOrderNeighbors( graph, weight_j, j );
 	  break;
 	case 1: // status_i==PREACTIVE, l_status[j]==PREACTIVE
 	  l_status[j] = ACTIVE; nActive++;
 	  weight_j = 2 * LocalWeight ;
 	  ////cdbg << "Case PREACTIVE/PREACTIVE:  node=" << j << " incremented by weight=" << weight_j << endl;
-	  heap->incrementPriority( weight_j, j );
+	  queueIncrement( weight_j, j );
 	  weight_j = LocalWeight;
-	  secondOrderNeighbors( weight_j, j );
+	  secondOrderNeighbors( graph, weight_j, j );
 	  break;
 	case 2: // status_i==PREACTIVE, l_status[j]==ACTIVE
 	  weight_j = LocalWeight ;
 	  ////cdbg << "Case PREACTIVE/ACTIVE:  node=" << j << " incremented by weight=" << weight_j << endl;
-	  heap->incrementPriority( weight_j, j );
+	  queueIncrement( weight_j, j );
 	  break;
 	case 3: // status_i==PREACTIVE, l_status[j]==NUMBERED
 	  ////cdbg << "Case PREACTIVE/NUMBERED:" << endl;
@@ -811,7 +968,8 @@ SloanEngine::unweightedOrdering(const int nVtxs) {
 
 
 
-void SloanEngine::weightedOrdering(const int nVtxs) {
+template< class G >
+void SloanEngine::weightedOrdering( const G* graph, const int nVtxs ) {
   int nActive= (makeStartVtxsInWavefront) ? startVtxs.size() : 0;
   int* new2old = new2Old_1.begin();
   nodeStatus * l_status = status.begin();
@@ -819,10 +977,10 @@ void SloanEngine::weightedOrdering(const int nVtxs) {
   const int * vwgt = vtxWeight.lend();
 
   // 5. test for termination
-  for( int k=0; (k<nVtxs) && (heap->size()>0) ; k++) {
+  for( int k=0; (k<nVtxs) && (queueSize()>0) ; k++) {
     
     // 6. Find highest priority node in heap
-    int i = heap->extractMax(); 
+    int i = queueExtractMax(); 
     ////cdbg << "Selected Vertex=" << i << ", iteration=" << k << ", nVtxsNumbered=" << nVtxsNumbered << endl;
     
     // 7. Label vertex
@@ -836,7 +994,7 @@ void SloanEngine::weightedOrdering(const int nVtxs) {
     // 9. for all j \in \adj(i) do 
     if (status_i == ACTIVE) {
       nActive--;
-      for(Graph::const_iterator cur=g->begin_adj(i), stop=g->end_adj(i); cur != stop; ++cur) {
+      for(typename G::const_iterator cur=graph->begin_adj(i), stop=graph->end_adj(i); cur != stop; ++cur) {
 	int j = *cur;
 	////cdbg << "\tExamining neighbor " << j << "...";
 	switch( l_status[j] ) {
@@ -846,14 +1004,14 @@ void SloanEngine::weightedOrdering(const int nVtxs) {
 	  l_status[j] = ACTIVE; nActive++;
 	  weight_j = l_initial_priority[j] + LocalWeight * ( vwgt[i] + vwgt[j] );
 	  ////cdbg << "Case ACTIVE/INACTIVE:  node=" << j << " added with weight=" << weight_j << endl;
-	  heap->insert(weight_j, j);
+	  queueInsert(weight_j, j);
 	  break;
 	case 1: // status_i==ACTIVE, l_status[j]==PREACTIVE
 	  l_status[j] = ACTIVE; nActive++;
 	  weight_j = LocalWeight * vwgt[j];
 	  ////cdbg << "Case ACTIVE/PREACTIVE:  node=" << j << " incremented by weight=" << weight_j << endl;
-	  heap->incrementPriority( weight_j, j );
-	  secondOrderNeighbors( weight_j, j );
+	  queueIncrement( weight_j, j );
+	  secondOrderNeighbors( graph, weight_j, j );
 	  break;
 	case 2: // status_i==ACTIVE, l_status[j]==ACTIVE
 	  ////cdbg << "Case ACTIVE/ACTIVE:" << endl;
@@ -867,7 +1025,7 @@ void SloanEngine::weightedOrdering(const int nVtxs) {
 	} // end switch
       } // end adj_i loop
     } else if (status_i == PREACTIVE) {
-      for(Graph::const_iterator cur=g->begin_adj(i), stop=g->end_adj(i); cur != stop; ++cur) {
+      for(typename G::const_iterator cur=graph->begin_adj(i), stop=graph->end_adj(i); cur != stop; ++cur) {
 	int j = *cur;
 	////cdbg << "\tExamining neighbor " << j << "...";
 	switch( l_status[j] ) {
@@ -876,22 +1034,22 @@ void SloanEngine::weightedOrdering(const int nVtxs) {
 	  l_status[j] = ACTIVE; nActive++;
 	  weight_j = l_initial_priority[j] + LocalWeight * ( vwgt[i] + vwgt[j] );
 	  ////cdbg << "Case PREACTIVE/INACTIVE:  node=" << j << " added with weight=" << weight_j << endl;
-	  heap->insert(weight_j, j);
+	  queueInsert(weight_j, j);
 	  weight_j = LocalWeight * vwgt[j];
-	  secondOrderNeighbors( weight_j, j );
+	  secondOrderNeighbors( graph, weight_j, j );
 	  break;
 	case 1: // status_i==PREACTIVE, l_status[j]==PREACTIVE
 	  l_status[j] = ACTIVE; nActive++;
 	  weight_j = LocalWeight * ( vwgt[i] + vwgt[j] );
 	  ////cdbg << "Case PREACTIVE/PREACTIVE:  node=" << j << " incremented by weight=" << weight_j << endl;
-	  heap->incrementPriority( weight_j, j );
+	  queueIncrement( weight_j, j );
 	  weight_j = LocalWeight * vwgt[j];
-	  secondOrderNeighbors( weight_j, j );
+	  secondOrderNeighbors( graph, weight_j, j );
 	  break;
 	case 2: // status_i==PREACTIVE, l_status[j]==ACTIVE
 	  weight_j = LocalWeight * vwgt[j];
 	  ////cdbg << "Case PREACTIVE/ACTIVE:  node=" << j << " incremented by weight=" << weight_j << endl;
-	  heap->incrementPriority( weight_j, j );
+	  queueIncrement( weight_j, j );
 	  break;
 	case 3: // status_i==PREACTIVE, l_status[j]==NUMBERED
 	  ////cdbg << "Case PREACTIVE/NUMBERED:" << endl;
@@ -911,9 +1069,23 @@ void SloanEngine::weightedOrdering(const int nVtxs) {
 
 
 void SloanEngine::secondOrderNeighbors( const int weight, const int vtx ) {
+  if ( packedGraph != 0 ) { 
+    secondOrderNeighbors( packedGraph, weight, vtx );
+  } else { 
+    secondOrderNeighbors( g, weight, vtx );
+  }
+}
+
+template< class G >
+void SloanEngine::secondOrderNeighbors( const G* graph, const int weight, const int vtx ) {
   nodeStatus * l_status = status.begin();
   int * l_initial_priority = initial_priority.begin();
-  for(Graph::const_iterator cur=g->begin_adj(vtx), stop=g->end_adj(vtx); cur != stop; ++cur ) {
+  // with the 4-ary heap, collect the bumps and restore heap order once
+  const bool batch = useDaryHeap && !bucketQueueActive;
+  int * l_bumpItems = bumpItems.begin();
+  int * l_bumpDeltas = bumpDeltas.begin();
+  int nBumps = 0;
+  for(typename G::const_iterator cur=graph->begin_adj(vtx), stop=graph->end_adj(vtx); cur != stop; ++cur ) {
     int k = *cur;
     if (k == vtx) continue;
     ////cdbg << "\t\tExamining second order neighbor " << k << " ...";
@@ -923,17 +1095,27 @@ void SloanEngine::secondOrderNeighbors( const int weight, const int vtx ) {
       l_status[k] = PREACTIVE;
       weight_k = l_initial_priority[k] + weight;
       ////cdbg << " INACTIVE: adding to heap with weight=" << weight_k << ". " << endl;
-      heap->insert( weight_k, k );
+      queueInsert( weight_k, k );
       break;
     case 1: // PREACTIVE
       weight_k = weight;
       ////cdbg << " PREACTIVE: incrementing weight by " << weight_k << ". " << endl;
-      heap->incrementPriority( weight_k, k );
+      if ( batch ) {
+	l_bumpItems[ nBumps ] = k;
+	l_bumpDeltas[ nBumps++ ] = weight_k;
+      } else {
+	queueIncrement( weight_k, k );
+      }
       break;
     case 2: // ACTIVE
       weight_k = weight;
       ////cdbg << " ACTIVE: incrementing weight by " << weight_k << ". " << endl;
-      heap->incrementPriority( weight_k, k );
+      if ( batch ) {
+	l_bumpItems[ nBumps ] = k;
+	l_bumpDeltas[ nBumps++ ] = weight_k;
+      } else {
+	queueIncrement( weight_k, k );
+      }
       break;
     case 3: // NUMBERED
       ////cdbg << " NUMBERED: do nothing. " << endl;
@@ -943,6 +1125,9 @@ void SloanEngine::secondOrderNeighbors( const int weight, const int vtx ) {
       break;
     } // end switch
   } // end for k = adj(vtx) loop
+  if ( nBumps > 0 ) {
+    daryHeap->incrementPriorities( l_bumpItems, l_bumpDeltas, nBumps );
+  }
 }
 
 SPINDLE_IMPLEMENT_DYNAMIC( SloanEngine, SpindleAlgorithm )
@@ -41,6 +41,14 @@
 #include "spindle/BinaryHeap.h"
 #endif
 
+#ifndef SPINDLE_DARY_HEAP_H_
+#include "spindle/DaryHeap.h"
+#endif
+
+#ifndef SPINDLE_MAX_BUCKET_SORTER_H_
+#include "spindle/MaxBucketSorter.h"
+#endif
+
 #ifndef SPINDLE_PERMUTATION_H_
 #include "spindle/PermutationMap.h"
 #endif
@@ -95,6 +103,11 @@ public:
 
   virtual bool setGraph( const Graph* graph );
 
+  /**
+   * order a PackedGraph instead.  Its neighbors are decoded as the
+   * ordering goes; graph compression is not used.
+   */
+  virtual bool setGraph( const PackedGraph* graph );
 
   /** @name explicit manipulation of start and end nodes*/
   //@{
@@ -188,6 +201,34 @@ public:
   void enableMakeStartVtxsInWavefront() { makeStartVtxsInWavefront = true; } 
   //@}
 
+  /** @name Priority queue
+   *  By default every vertex is selected with a #BinaryHeap#.  Two
+   *  faster queues can be enabled.  Both break ties between equal
+   *  priorities differently, so the ordering can differ from the
+   *  default one (it is just as good, but not bit for bit the same).
+   *
+   *  A #DaryHeap# stores its keys apart from the items and takes all
+   *  the priority increments caused by numbering a vertex as one batch.
+   *
+   *  Sloan priorities are integers, and over one connected component they
+   *  span a range bounded by the BFS height and the weighted degrees.
+   *  When that range is small compared to the component, a
+   *  #MaxBucketSorter# can replace the heap, making each priority
+   *  update O(1) instead of O(log n).
+   */
+  //@{
+  /** use buckets whenever the priority range is small enough */
+  void enableBucketQueue() { useBucketQueue = true; }
+  /** always use a heap (default) */
+  void disableBucketQueue() { useBucketQueue = false; }
+  /** true if the last component was numbered with the bucket queue */
+  bool queryUsedBucketQueue() const { return bucketQueueActive; }
+  /** use the 4-ary heap with batched increments */
+  void enableDaryHeap() { useDaryHeap = true; }
+  /** use the binary heap (default) */
+  void disableDaryHeap() { useDaryHeap = false; }
+  //@}
+
   /** @name const access to internal classes */
   //@{
   /** @name timers */
@@ -216,6 +257,14 @@ public:
    * Heap is used to select each node
    */
   const Heap* getHeap() const;
+  /**
+   * used instead of the binary heap if enabled
+   */
+  const DaryHeap* getDaryHeap() const;
+  /**
+   * used instead of the heap when priorities span a small range
+   */
+  const MaxBucketSorter* getBucketSorter() const;
   //@}
   /** @name wavefront */
   //@{
@@ -230,6 +279,7 @@ private:
   typedef enum{ INACTIVE, PREACTIVE, ACTIVE, NUMBERED } nodeStatus;
   enum{ DONT_KNOW, CLASS_1, CLASS_2 } classOfGraph;
   enum{ DETERMINED_BY_CLASS, DETERMINED_BY_USER } weightingScheme;
+  bool classDetected;  // classOfGraph was DONT_KNOW until a run chose it
   enum{ ENABLED, DISABLED } normalizedWeighting;
 
   int GlobalWeight;
@@ -250,6 +300,8 @@ private:
   SharedArray<int> vtxWeight;                   
   SharedArray<int> new2Old_1;
   SharedArray<int> new2Old_2;
+  SharedArray<int> bumpItems;               // batched priority increments
+  SharedArray<int> bumpDeltas;
 
   const int * alternateGlobalPriority;     
   const PermutationMap * explicitOrder;
@@ -257,6 +309,12 @@ private:
   const Graph* g;
   BFS* bfs;
   Heap* heap;
+  DaryHeap* daryHeap;
+  MaxBucketSorter* buckets;
+  bool useDaryHeap;
+  bool useBucketQueue;
+  bool bucketQueueActive;
+  int bucketOffset;         // priority of key 0 in buckets
   SharedPtr< PseudoDiameter > diam;
 
   stopwatch totalExecutionTimer;    // total execution
@@ -270,9 +328,19 @@ private:
   void setNVtxsNumbered( const int new_nVtxsNumbered ) ;
   void numberVertices( const int vtxList[], const int nVtxs );
   void computeInitialPriority( const int vtxList[], const int nVtxs );
-  void unweightedOrdering( const int nVtxs );
-  void weightedOrdering( const int nVtxs );
+  int deg( const int vtx ) const;
+  // G is a Graph or a PackedGraph
+  template< class G > void unweightedOrdering( const G* graph, const int nVtxs );
+  template< class G > void weightedOrdering( const G* graph, const int nVtxs );
+  template< class G > void secondOrderNeighbors( const G* graph, const int weight, const int vtx );
   void secondOrderNeighbors( const int weight, const int vtx );
+
+  void chooseQueue( const int vtxList[], const int nVtxs );
+  void switchToHeap();
+  void queueInsert( const int priority, const int vtx );
+  void queueIncrement( const int delta, const int vtx );
+  int queueExtractMax();
+  int queueSize() const;
   
   bool orderEverything();
   bool orderComponent();
@@ -409,6 +477,58 @@ SloanEngine::getHeap() const {
 }
 
 
+inline const DaryHeap*
+SloanEngine::getDaryHeap() const {
+  return daryHeap;
+}
+
+inline const MaxBucketSorter*
+SloanEngine::getBucketSorter() const {
+  return buckets;
+}
+
+inline void
+SloanEngine::queueInsert( const int priority, const int vtx ) {
+  if ( bucketQueueActive ) {
+    if ( buckets->insert( priority - bucketOffset, vtx ) ) { return; }
+    switchToHeap();
+  }
+  if ( useDaryHeap ) {
+    daryHeap->insert( priority, vtx );
+  } else {
+    heap->insert( priority, vtx );
+  }
+}
+
+inline void
+SloanEngine::queueIncrement( const int delta, const int vtx ) {
+  if ( bucketQueueActive ) {
+    if ( buckets->incrementKey( delta, vtx ) ) { return; }
+    switchToHeap();
+  }
+  if ( useDaryHeap ) {
+    daryHeap->incrementPriority( delta, vtx );
+  } else {
+    heap->incrementPriority( delta, vtx );
+  }
+}
+
+inline int
+SloanEngine::queueExtractMax() {
+  if ( bucketQueueActive ) {
+    return buckets->extractMax();
+  }
+  return ( useDaryHeap ) ? daryHeap->extractMax() : heap->extractMax();
+}
+
+inline int
+SloanEngine::queueSize() const {
+  if ( bucketQueueActive ) {
+    return buckets->size();
+  }
+  return ( useDaryHeap ) ? daryHeap->size() : heap->size();
+}
+
 inline const SharedArray<int>&
 SloanEngine::getWavefront() const {
   return wavefront;
@@ -40,6 +40,10 @@
 #include "spindle/SpindleSystem.h"
 #endif
 
+#ifndef SPINDLE_ARENA_H_
+#include "spindle/SpindleArena.h"
+#endif
+
 SPINDLE_BEGIN_NAMESPACE
 
 template<class T>
@@ -98,6 +102,10 @@ private:
   typedef alloc Alloc;
   typedef simple_alloc< T, Alloc > T_alloc;
 
+  // from the current SpindleArena if there is one, else from T_alloc
+  static T* allocateArray( const int n );
+  static void deallocateArray( T* p, const int n );
+
   // private copy and assignment constructors
   SharedArray<T>& operator=( const SharedArray<T>& ) { return *this; }
   void free();
@@ -112,13 +120,31 @@ inline void SharedArray<T>::makePrivateCopy() {
   FENTER;
   if ( maxSize > 0 ) { FEXIT; } // already own array
   const T* src = array;
-  T* dest = T_alloc::allocate( sz );
+  T* dest = allocateArray( sz );
+  array = dest;
   for( int i=0; i<sz; i++) { *dest++ = *src++; }
   maxSize = sz; // ownArray == true
   FEXIT;
 }
 #undef __FUNC__
 
+template < class T >
+inline T* SharedArray<T>::allocateArray( const int n ) {
+  SpindleArena * arena = SpindleArena::current();
+  if ( arena != 0 ) {
+    T* p = (T*) arena->allocate( n * sizeof(T) );
+    if ( p != 0 ) { return p; }
+  }
+  return T_alloc::allocate( n );
+}
+
+template < class T >
+inline void SharedArray<T>::deallocateArray( T* p, const int n ) {
+  if ( !SpindleArena::deallocate( p, n * sizeof(T) ) ) {
+    T_alloc::deallocate( p, n );
+  }
+}
+
 template < class T >
 inline SharedArray<T>::SharedArray()
   : array(0), sz(0), maxSize( -1 )
@@ -152,7 +178,7 @@ inline SharedArray<T>::SharedArray(const int length) {
   FENTER;
   WARN_IF( length < 0, "Constructing an SharedArray<T> of length<=0, (requested length = %d).", length);
   if (length > 0 ) {
-    array = T_alloc::allocate( length );
+    array = allocateArray( length );
     sz = length;
     maxSize = length;  // own the length of memory
   } else {
@@ -327,7 +353,7 @@ inline void SharedArray<T>::import( const T* p, const int length ) {
   ASSERT( length > 0 ,"Cannot import an array of length=%d", length);
 
   free();
-  array = T_alloc::allocate( length );
+  array = allocateArray( length );
   const T* src = p;
   T* dest = array;
   for (int i=0; i<length; i++) { *dest++ = *src++; }
@@ -344,7 +370,7 @@ inline void SharedArray<T>::import( const SharedArray<T>& src ) {
   free();
   maxSize = ( src.maxSize > src.sz ) ? src.maxSize : src.sz ;
   sz = src.sz;
-  array = T_alloc::allocate( maxSize );
+  array = allocateArray( maxSize );
   const T* source = src.array;
   T* dest = array;
   const int size = sz;
@@ -445,14 +471,14 @@ inline void SharedArray<T>::resize( const int n ) {
   if ( n == 0 ) {
     reset();
   } else if ( array == 0 ) {
-    FCALL take( T_alloc::allocate( n ), n );
+    FCALL take( allocateArray( n ), n );
   } else if ( ( maxSize > 0 ) && ( n <= maxSize ) ) { // if own array and size <= n;
     sz = n;
   } else if (( maxSize < 0 ) && ( n <= sz )) { // if don't own array, but size is okay
     makePrivateCopy();
     sz = n;
   } else {
-    FCALL take( T_alloc::allocate( n ), n );
+    FCALL take( allocateArray( n ), n );
   } 
   FEXIT;
 }
@@ -463,7 +489,7 @@ template < class T >
 inline void SharedArray<T>::free() {
   FENTER;
   if ( (maxSize > 0) && (array != 0) ) { 
-    T_alloc::deallocate( array, maxSize );
+    deallocateArray( array, maxSize );
   }
   maxSize = -1;
   sz = 0;
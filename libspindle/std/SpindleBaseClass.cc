@@ -41,6 +41,16 @@ static const ClassMetaData SpindleBaseClass_MetaData = {
 
 static int UniqueIDNumber = 0;
 
+// objects are made on several threads, so hand out ids atomically
+static int
+SpindleBaseClass_nextIDNumber() {
+#if defined(SPINDLE_HAVE_PTHREADS) && defined(__GNUC__)
+  return __sync_fetch_and_add( &UniqueIDNumber, 1 );
+#else
+  return UniqueIDNumber++;
+#endif
+}
+
 const ClassMetaData* SpindleBaseClass::MetaData = &SpindleBaseClass_MetaData;
 
 static const registry_init registry_init_dummy_class( &SpindleBaseClass_MetaData );
@@ -62,11 +72,11 @@ SpindleBaseClass::~SpindleBaseClass() {
   decrementInstanceCount( SpindleBaseClass::MetaData );
 }
 
-SpindleBaseClass::SpindleBaseClass() : idNumber(UniqueIDNumber++) {  
+SpindleBaseClass::SpindleBaseClass() : idNumber(SpindleBaseClass_nextIDNumber()) {  
   incrementInstanceCount( SpindleBaseClass::MetaData );
 }
 
-SpindleBaseClass::SpindleBaseClass( const SpindleBaseClass& src ) : idNumber(UniqueIDNumber++) {
+SpindleBaseClass::SpindleBaseClass( const SpindleBaseClass& src ) : idNumber(SpindleBaseClass_nextIDNumber()) {
   // dummy use of src to keep compiler from complaining
   (void) src;
 }
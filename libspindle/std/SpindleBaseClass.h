@@ -132,8 +132,10 @@ inline void
 SpindleBaseClass::incrementInstanceCount( const ClassMetaData* metaData ) {
   ClassMetaData* thisData = (ClassMetaData*) metaData; // cast away const-ness
   if ( thisData != 0 ) {
-#ifdef SPINDLE__NO_INSTANCE_COUNT
+#if defined(SPINDLE__NO_INSTANCE_COUNT)
     ;
+#elif defined(SPINDLE_HAVE_PTHREADS) && defined(__GNUC__)
+    __sync_fetch_and_add( &(thisData->nCreated), 1 ); // engines are made on several threads
 #else
     thisData->nCreated++;
 #endif
@@ -144,8 +146,10 @@ inline void
 SpindleBaseClass::decrementInstanceCount( const ClassMetaData* metaData ) {
   ClassMetaData* thisData = (ClassMetaData*) metaData;
   if ( thisData != 0 ) {
-#ifdef SPINDLE__NO_INSTANCE_COUNT
+#if defined(SPINDLE__NO_INSTANCE_COUNT)
     ;
+#elif defined(SPINDLE_HAVE_PTHREADS) && defined(__GNUC__)
+    __sync_fetch_and_add( &(thisData->nDestroyed), 1 );
 #else
     thisData->nDestroyed++;
 #endif
@@ -0,0 +1,304 @@
+//
+// SpindleArena.cc
+//
+// $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify , distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+//
+
+#include "spindle/SpindleArena.h"
+
+#include <stdlib.h>
+
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+
+#ifdef SPINDLE_HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+// every allocation is a multiple of this, so any type may go there
+static const size_t SpindleArena_align = 16;
+// mapped blocks are rounded up to a multiple of this
+static const size_t SpindleArena_hugePageSize = 2*1024*1024;
+// blocks are aligned to and rounded up to a multiple of this, so every
+// granule of the address space is either all arena or not at all
+static const int SpindleArena_granuleBits = 16;
+static const size_t SpindleArena_granule = ( (size_t) 1 ) << SpindleArena_granuleBits;
+
+static inline size_t
+SpindleArena_roundUp( const size_t n, const size_t multiple ) {
+  return ( ( n + multiple - 1 ) / multiple ) * multiple;
+}
+
+//
+// the current arena of each thread
+//
+#if defined(SPINDLE_HAVE_PTHREADS) && defined(__GNUC__)
+static __thread SpindleArena * SpindleArena_current = 0;
+#else
+static SpindleArena * SpindleArena_current = 0;
+#endif
+
+//
+// the arena owning each granule, in two levels indexed by the high and
+// low bits of the granule number.  That covers addresses below 2^47.
+// Leaves are made on demand and never freed, and entries are only
+// written (under the lock) when a block is made or released, so
+// deallocate() reads the map without a lock.
+//
+static const int SpindleArena_leafBits = 16;
+static const int SpindleArena_rootBits = 15;
+typedef SpindleArena * volatile SpindleArena_Leaf;
+static SpindleArena_Leaf * volatile SpindleArena_map[ 1 << SpindleArena_rootBits ];
+#ifdef SPINDLE_HAVE_PTHREADS
+static pthread_mutex_t SpindleArena_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static inline SpindleArena *
+SpindleArena_owner( const void * p ) {
+  const size_t granule = ( (size_t) p ) >> SpindleArena_granuleBits;
+  const size_t root = granule >> SpindleArena_leafBits;
+  if ( root >= ( ( (size_t) 1 ) << SpindleArena_rootBits ) ) { return 0; }
+  SpindleArena_Leaf * leaf = SpindleArena_map[ root ];
+  if ( leaf == 0 ) { return 0; }
+  return leaf[ granule & ( ( ( (size_t) 1 ) << SpindleArena_leafBits ) - 1 ) ];
+}
+
+//
+// record owner for the granules of [base,base+size).  Returns false if
+// the block lies outside of the map or a leaf cannot be made.
+//
+static bool
+SpindleArena_setOwner( const char * base, const size_t size, SpindleArena * owner ) {
+  const size_t first = ( (size_t) base ) >> SpindleArena_granuleBits;
+  const size_t last = ( ( (size_t) base ) + size - 1 ) >> SpindleArena_granuleBits;
+  if ( ( last >> SpindleArena_leafBits ) >= ( ( (size_t) 1 ) << SpindleArena_rootBits ) ) {
+    return false;
+  }
+  bool success = true;
+#ifdef SPINDLE_HAVE_PTHREADS
+  pthread_mutex_lock( &SpindleArena_lock );
+#endif
+  {for( size_t g=first; g<=last; ++g ) {
+    const size_t root = g >> SpindleArena_leafBits;
+    if ( ( SpindleArena_map[ root ] == 0 ) && ( owner == 0 ) ) {
+      continue;  // nothing to clear
+    }
+    if ( SpindleArena_map[ root ] == 0 ) {
+      SpindleArena_Leaf * leaf = (SpindleArena_Leaf *)
+	::calloc( ( (size_t) 1 ) << SpindleArena_leafBits, sizeof(SpindleArena_Leaf) );
+      if ( leaf == 0 ) {
+	success = false;
+	break;
+      }
+#if defined(SPINDLE_HAVE_PTHREADS) && defined(__GNUC__)
+      __sync_synchronize(); // readers must see the zeroed leaf before its address
+#endif
+      SpindleArena_map[ root ] = leaf;
+    }
+    SpindleArena_map[ root ][ g & ( ( ( (size_t) 1 ) << SpindleArena_leafBits ) - 1 ) ] = owner;
+  }}
+#ifdef SPINDLE_HAVE_PTHREADS
+  pthread_mutex_unlock( &SpindleArena_lock );
+#endif
+  if ( ( !success ) && ( owner != 0 ) ) {
+    SpindleArena_setOwner( base, size, 0 );
+  }
+  return success;
+}
+
+#ifdef HAVE_SYS_MMAN_H
+// map size bytes at a multiple of align, trimming the excess
+static char *
+SpindleArena_mapAligned( const size_t size, const size_t align ) {
+  void * p = mmap( 0, size + align, PROT_READ | PROT_WRITE,
+		   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+  if ( p == MAP_FAILED ) { return 0; }
+  char * mapped = (char *) p;
+  char * base = (char *) SpindleArena_roundUp( (size_t) mapped, align );
+  if ( base > mapped ) {
+    munmap( mapped, base - mapped );
+  }
+  if ( mapped + align > base ) {
+    munmap( base + size, ( mapped + align ) - base );
+  }
+  return base;
+}
+#endif
+
+SpindleArena::SpindleArena() {
+  blocks = 0;
+  nBlocks = 0;
+  blockCapacity = 0;
+  top = limit = last = 0;
+  blockSize = 1024*1024;
+  hugePageThreshold = SpindleArena_hugePageSize;
+  nBytesUsed = 0;
+  nBytesReserved = 0;
+  nHugePageBlocks = 0;
+}
+
+SpindleArena::SpindleArena( const size_t blockSize_ ) {
+  blocks = 0;
+  nBlocks = 0;
+  blockCapacity = 0;
+  top = limit = last = 0;
+  blockSize = ( blockSize_ < 4*SpindleArena_align ) ? 4*SpindleArena_align :
+    SpindleArena_roundUp( blockSize_, SpindleArena_align );
+  hugePageThreshold = SpindleArena_hugePageSize;
+  nBytesUsed = 0;
+  nBytesReserved = 0;
+  nHugePageBlocks = 0;
+}
+
+SpindleArena::~SpindleArena() {
+  release();
+  ::free( blocks );
+  if ( SpindleArena_current == this ) {
+    SpindleArena_current = 0;
+  }
+}
+
+//
+// get a block of at least minSize bytes from the system.  If
+// makeCurrent, later small allocations are carved from it.
+//
+bool
+SpindleArena::newBlock( const size_t minSize, const bool makeCurrent ) {
+  if ( nBlocks == blockCapacity ) {
+    const int newCapacity = ( blockCapacity == 0 ) ? 16 : 2*blockCapacity;
+    Block * temp = (Block *) ::realloc( blocks, newCapacity * sizeof(Block) );
+    if ( temp == 0 ) { return false; }
+    blocks = temp;
+    blockCapacity = newCapacity;
+  }
+  Block& block = blocks[ nBlocks ];
+  block.base = 0;
+  block.start = 0;
+  block.size = SpindleArena_roundUp( minSize, SpindleArena_granule );
+#ifdef HAVE_SYS_MMAN_H
+  if ( ( hugePageThreshold > 0 ) && ( minSize >= hugePageThreshold ) ) {
+    const size_t size = SpindleArena_roundUp( minSize, SpindleArena_hugePageSize );
+    block.base = SpindleArena_mapAligned( size, SpindleArena_hugePageSize );
+    if ( block.base != 0 ) {
+      block.size = size;
+#ifdef MADV_HUGEPAGE
+      if ( madvise( block.base, block.size, MADV_HUGEPAGE ) == 0 ) {
+	++nHugePageBlocks;
+      }
+#endif
+    }
+  }
+  if ( block.base == 0 ) {
+    block.base = SpindleArena_mapAligned( block.size, SpindleArena_granule );
+  }
+#endif
+  if ( block.base == 0 ) {
+    block.start = (char *) ::malloc( block.size + SpindleArena_granule );
+    if ( block.start == 0 ) { return false; }
+    block.base = (char *) SpindleArena_roundUp( (size_t) block.start, SpindleArena_granule );
+  }
+  if ( !SpindleArena_setOwner( block.base, block.size, this ) ) {
+#ifdef HAVE_SYS_MMAN_H
+    if ( block.start == 0 ) {
+      munmap( block.base, block.size );
+      return false;
+    }
+#endif
+    ::free( block.start );
+    return false;
+  }
+  nBytesReserved += block.size;
+  ++nBlocks;
+  if ( makeCurrent ) {
+    top = block.base;
+    limit = block.base + block.size;
+    last = 0;
+  }
+  return true;
+}
+
+void *
+SpindleArena::allocate( const size_t nBytes ) {
+  const size_t size = SpindleArena_roundUp( ( nBytes == 0 ) ? 1 : nBytes,
+					    SpindleArena_align );
+  if ( size > (size_t) ( limit - top ) ) {
+    if ( size > blockSize / 4 ) {
+      // too big to share a block: give it one of its own and keep
+      // carving the current block
+      if ( !newBlock( size, false ) ) { return 0; }
+      nBytesUsed += size;
+      return blocks[ nBlocks-1 ].base;
+    }
+    if ( !newBlock( blockSize, true ) ) { return 0; }
+  }
+  last = top;
+  top += size;
+  nBytesUsed += size;
+  return last;
+}
+
+void
+SpindleArena::release() {
+  {for( int i=0; i<nBlocks; ++i ) {
+    SpindleArena_setOwner( blocks[i].base, blocks[i].size, 0 );
+#ifdef HAVE_SYS_MMAN_H
+    if ( blocks[i].start == 0 ) {
+      munmap( blocks[i].base, blocks[i].size );
+      continue;
+    }
+#endif
+    ::free( blocks[i].start );
+  }}
+  nBlocks = 0;
+  top = limit = last = 0;
+  nBytesUsed = 0;
+  nBytesReserved = 0;
+  nHugePageBlocks = 0;
+}
+
+SpindleArena *
+SpindleArena::current() {
+  return SpindleArena_current;
+}
+
+void
+SpindleArena::setCurrent( SpindleArena * arena ) {
+  SpindleArena_current = arena;
+}
+
+bool
+SpindleArena::deallocate( void * p, const size_t nBytes ) {
+  if ( p == 0 ) { return false; }
+  SpindleArena * arena = SpindleArena_owner( p );
+  if ( arena == 0 ) { return false; }
+  // only the thread allocating from the arena may take space back
+  if ( arena == SpindleArena_current ) {
+    const size_t size = SpindleArena_roundUp( ( nBytes == 0 ) ? 1 : nBytes,
+					      SpindleArena_align );
+    if ( ( p == arena->last ) && ( arena->last + size == arena->top ) ) {
+      arena->top = arena->last;
+      arena->last = 0;
+      arena->nBytesUsed -= size;
+    }
+  }
+  return true;
+}
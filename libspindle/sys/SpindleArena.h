@@ -0,0 +1,164 @@
+//
+// SpindleArena.h
+//
+// $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify , distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+//
+//
+
+#ifndef SPINDLE_ARENA_H_
+#define SPINDLE_ARENA_H_
+
+#ifndef SPINDLE_H_
+#include "spindle/spindle.h"
+#endif
+
+#include <stddef.h>
+
+SPINDLE_BEGIN_NAMESPACE
+
+/**
+ * @memo region allocator for the arrays of an ordering run
+ * @type class
+ *
+ * Hands out memory by bumping a pointer through large blocks and gives
+ * all of it back at once in #release()# or the destructor.  While an
+ * arena is the current one of a thread, every #SharedArray<T># that
+ * thread allocates (and with it the arrays of #Graph#,
+ * #PermutationMap#, #CompressionMap#, #EliminationForest#, ...) is
+ * drawn from the arena instead of the heap:
+ * #SpindleArena arena; #
+ * #{ #
+ * #  SpindleArena::Scope scope( &arena ); #
+ * #  MinPriorityEngine engine( &graph ); #
+ * #  engine.execute(); #
+ * #  ... #
+ * #} // engine destroyed first #
+ * #arena.release(); #
+ *
+ * Freeing an array that came from an arena costs nothing, whichever
+ * arena is current.  On the thread the arena is current on, the space
+ * of the most recent allocation is reused; elsewhere it waits for
+ * #release()#.  Blocks are aligned to 64 KB and recorded in a map from
+ * address to arena that is only ever added to, so telling arena memory
+ * from heap memory takes two loads and no lock.  Blocks of at least
+ * #queryHugePageThreshold()# bytes are mapped on their own and, where
+ * the system supports it, backed by huge pages.
+ *
+ * NOTE: every object holding arena memory must be destroyed before the
+ *       arena is released.  An arena may be current on one thread at
+ *       a time only; threads of a #ThreadTeam# start with no current
+ *       arena and so allocate from the heap.
+ *
+ * @author agent
+ * @version #$Id$#
+ */
+class SpindleArena {
+public:
+  /**
+   * @memo makes an arena the current one of this thread until the
+   *       scope ends
+   * @type class
+   */
+  class Scope {
+  private:
+    SpindleArena * previous;
+    Scope( const Scope& );
+    Scope& operator=( const Scope& );
+  public:
+    /** #arena# may be 0 to allocate from the heap within the scope */
+    Scope( SpindleArena * arena ) : previous( SpindleArena::current() ) {
+      SpindleArena::setCurrent( arena );
+    }
+    /** restores the arena that was current before */
+    ~Scope() { SpindleArena::setCurrent( previous ); }
+  };
+
+private:
+  struct Block {
+    char * base;     // aligned start of the block
+    char * start;    // what malloc() returned, 0 if from mmap()
+    size_t size;
+  };
+  Block * blocks;
+  int nBlocks;
+  int blockCapacity;
+  char * top;        // next free byte in the current block
+  char * limit;      // end of the current block
+  char * last;       // start of the most recent allocation, or 0
+  size_t blockSize;
+  size_t hugePageThreshold;
+  size_t nBytesUsed;
+  size_t nBytesReserved;
+  int nHugePageBlocks;
+
+  bool newBlock( const size_t minSize, const bool makeCurrent );
+
+  SpindleArena( const SpindleArena& );
+  SpindleArena& operator=( const SpindleArena& );
+
+public:
+  /** default constructor: blocks of 1 MB */
+  SpindleArena();
+  /** constructor with the size of the blocks, in bytes */
+  SpindleArena( const size_t blockSize_ );
+  /** destructor, releases all memory */
+  ~SpindleArena();
+
+  /**
+   * @return at least #nBytes# of memory aligned for any type, or 0 if
+   *         the system is out of memory.
+   */
+  void * allocate( const size_t nBytes );
+
+  /** free all memory of the arena in one shot */
+  void release();
+
+  /**
+   * blocks this large or larger get their own mapping and are backed
+   * by huge pages if possible (default is 2 MB).  0 turns it off.
+   */
+  void setHugePageThreshold( const size_t nBytes ) { hugePageThreshold = nBytes; }
+  /** query the huge page threshold */
+  size_t queryHugePageThreshold() const { return hugePageThreshold; }
+
+  /** query the number of bytes handed out since the last release */
+  size_t queryNBytesUsed() const { return nBytesUsed; }
+  /** query the number of bytes obtained from the system */
+  size_t queryNBytesReserved() const { return nBytesReserved; }
+  /** query the number of blocks */
+  int queryNBlocks() const { return nBlocks; }
+  /** query the number of blocks that were advised to use huge pages */
+  int queryNHugePageBlocks() const { return nHugePageBlocks; }
+
+  /** the current arena of this thread, or 0 */
+  static SpindleArena * current();
+  /** make #arena# the current arena of this thread, 0 for the heap */
+  static void setCurrent( SpindleArena * arena );
+
+  /**
+   * give back #nBytes# at #p# if they came from a live arena.  Only
+   * the thread the arena is current on moves its free pointer, so this
+   * is safe while the arena allocates on another thread.
+   * @return false if #p# is not arena memory; the caller must then
+   *         free it itself.
+   */
+  static bool deallocate( void * p, const size_t nBytes );
+};
+
+SPINDLE_END_NAMESPACE
+
+#endif
@@ -0,0 +1,328 @@
+//
+// ThreadTeam.cc
+//
+// $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify , distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+//
+
+#include "spindle/ThreadTeam.h"
+
+#ifdef SPINDLE_HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+#ifdef SPINDLE_HAVE_PTHREADS
+//
+// shared state for one call to ThreadTeam::run()
+//
+struct ThreadTeamJob {
+  ThreadTeam::Task task;
+  void * arg;
+  int n;
+  int chunkSize;
+  int nextChunk;          // next unclaimed index, protected by lock
+  pthread_mutex_t lock;
+};
+
+//
+// the threads of a team.  They are started by the first run() that
+// needs them and wait between calls for the next job, so a run() costs
+// a broadcast and a wait instead of creating and joining threads.
+//
+struct ThreadTeamPool {
+  pthread_mutex_t lock;   // protects everything below except job
+  pthread_cond_t wake;    // signalled when a job is posted or at shutdown
+  pthread_cond_t done;    // signalled when the last helper finishes a job
+  pthread_t * threads;    // helpers 1..nStarted-1; 0 is the caller
+  int nStarted;
+  int generation;         // incremented for every job posted
+  int nJobThreads;        // helpers with threadID < nJobThreads take part
+  int nBusy;              // helpers still working on the current job
+  bool running;           // a run() is using the pool
+  bool shutdown;
+  ThreadTeamJob job;
+};
+
+struct ThreadTeamWorker {
+  ThreadTeamPool * pool;
+  int threadID;
+};
+
+// claim chunks until the range is exhausted
+static void
+ThreadTeam_work( ThreadTeamJob * job, const int threadID ) {
+  for(;;) {
+    pthread_mutex_lock( &(job->lock) );
+    const int begin = job->nextChunk;
+    job->nextChunk += job->chunkSize;
+    pthread_mutex_unlock( &(job->lock) );
+    if ( begin >= job->n ) {
+      return;
+    }
+    const int end = ( begin + job->chunkSize < job->n ) ? begin + job->chunkSize : job->n;
+    (*(job->task))( job->arg, begin, end, threadID );
+  }
+}
+
+// serializes lockedCompareAndSwap()
+static pthread_mutex_t ThreadTeam_casLock = PTHREAD_MUTEX_INITIALIZER;
+
+// serializes starting a pool and claiming it for a run()
+static pthread_mutex_t ThreadTeam_poolLock = PTHREAD_MUTEX_INITIALIZER;
+
+extern "C" {
+  static void *
+  ThreadTeam_start( void * worker ) {
+    ThreadTeamWorker * w = (ThreadTeamWorker *) worker;
+    ThreadTeamPool * pool = w->pool;
+    const int threadID = w->threadID;
+    delete w;
+    int seen = 0;
+    pthread_mutex_lock( &(pool->lock) );
+    for(;;) {
+      while( ( !pool->shutdown ) && ( pool->generation == seen ) ) {
+	pthread_cond_wait( &(pool->wake), &(pool->lock) );
+      }
+      if ( pool->shutdown ) {
+	break;
+      }
+      seen = pool->generation;
+      if ( threadID < pool->nJobThreads ) {
+	pthread_mutex_unlock( &(pool->lock) );
+	ThreadTeam_work( &(pool->job), threadID );
+	pthread_mutex_lock( &(pool->lock) );
+	if ( --(pool->nBusy) == 0 ) {
+	  pthread_cond_signal( &(pool->done) );
+	}
+      }
+    }
+    pthread_mutex_unlock( &(pool->lock) );
+    return 0;
+  }
+}
+
+// start nThreads-1 helpers; stops early if one cannot be created
+static ThreadTeamPool *
+ThreadTeam_startPool( const int nThreads ) {
+  ThreadTeamPool * pool = new ThreadTeamPool;
+  pthread_mutex_init( &(pool->lock), 0 );
+  pthread_cond_init( &(pool->wake), 0 );
+  pthread_cond_init( &(pool->done), 0 );
+  pthread_mutex_init( &(pool->job.lock), 0 );
+  pool->threads = new pthread_t[ nThreads ];
+  pool->nStarted = 1;
+  pool->generation = 0;
+  pool->nJobThreads = 0;
+  pool->nBusy = 0;
+  pool->running = false;
+  pool->shutdown = false;
+  for( int i=1; i<nThreads; ++i ) {
+    ThreadTeamWorker * w = new ThreadTeamWorker;
+    w->pool = pool;
+    w->threadID = i;
+    if ( pthread_create( pool->threads + i, 0, ThreadTeam_start, w ) != 0 ) {
+      delete w;
+      break;
+    }
+    ++(pool->nStarted);
+  }
+  return pool;
+}
+
+static void
+ThreadTeam_stopPool( ThreadTeamPool * pool ) {
+  pthread_mutex_lock( &(pool->lock) );
+  pool->shutdown = true;
+  pthread_cond_broadcast( &(pool->wake) );
+  pthread_mutex_unlock( &(pool->lock) );
+  for( int i=1; i<pool->nStarted; ++i ) {
+    pthread_join( pool->threads[i], 0 );
+  }
+  pthread_mutex_destroy( &(pool->job.lock) );
+  pthread_cond_destroy( &(pool->done) );
+  pthread_cond_destroy( &(pool->wake) );
+  pthread_mutex_destroy( &(pool->lock) );
+  delete[] pool->threads;
+  delete pool;
+}
+#endif
+
+ThreadTeam::ThreadTeam() {
+  nThreads = 1;
+  minChunkSize = 256;
+  pool = 0;
+}
+
+ThreadTeam::ThreadTeam( const int nThreads_ ) {
+  nThreads = 1;
+  minChunkSize = 256;
+  pool = 0;
+  setNThreads( nThreads_ );
+}
+
+ThreadTeam::ThreadTeam( const ThreadTeam& src ) {
+  nThreads = src.nThreads;
+  minChunkSize = src.minChunkSize;
+  pool = 0;
+}
+
+ThreadTeam&
+ThreadTeam::operator=( const ThreadTeam& src ) {
+  if ( this != &src ) {
+    setNThreads( src.nThreads );
+    minChunkSize = src.minChunkSize;
+  }
+  return *this;
+}
+
+ThreadTeam::~ThreadTeam() {
+  stop();
+}
+
+void
+ThreadTeam::stop() {
+#ifdef SPINDLE_HAVE_PTHREADS
+  if ( pool != 0 ) {
+    ThreadTeam_stopPool( pool );
+    pool = 0;
+  }
+#endif
+}
+
+bool
+ThreadTeam::isAvailable() {
+#ifdef SPINDLE_HAVE_PTHREADS
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool
+ThreadTeam::setNThreads( const int n ) {
+  if ( n < 1 ) {
+    return false;
+  }
+  if ( n != nThreads ) {
+    stop();
+  }
+  nThreads = n;
+  return true;
+}
+
+int
+ThreadTeam::queryNThreads() const {
+  return ( isAvailable() ) ? nThreads : 1;
+}
+
+bool
+ThreadTeam::setMinChunkSize( const int minChunk ) {
+  if ( minChunk < 1 ) {
+    return false;
+  }
+  minChunkSize = minChunk;
+  return true;
+}
+
+bool
+ThreadTeam::run( Task task, void * arg, const int n ) const {
+  return run( task, arg, n, minChunkSize );
+}
+
+bool
+ThreadTeam::run( Task task, void * arg, const int n, const int minChunk ) const {
+  if ( n <= 0 ) {
+    return true;
+  }
+#ifdef SPINDLE_HAVE_PTHREADS
+  const int chunk = ( minChunk < 1 ) ? 1 : minChunk;
+  int nWorkers = nThreads;
+  if ( nWorkers > n / chunk ) {
+    nWorkers = n / chunk;
+  }
+  if ( nWorkers > 1 ) {
+    // claim the pool, starting it on first use.  A team already running
+    // a job (e.g. called again from one of its own tasks) runs serially.
+    pthread_mutex_lock( &ThreadTeam_poolLock );
+    if ( pool == 0 ) {
+      ((ThreadTeam *) this)->pool = ThreadTeam_startPool( nThreads );
+    }
+    ThreadTeamPool * p = pool;
+    const bool claimed = !( p->running );
+    p->running = true;
+    pthread_mutex_unlock( &ThreadTeam_poolLock );
+
+    if ( claimed ) {
+      const bool success = ( nWorkers <= p->nStarted );
+      if ( nWorkers > p->nStarted ) {
+	nWorkers = p->nStarted;
+      }
+      ThreadTeamJob * job = &(p->job);
+      job->task = task;
+      job->arg = arg;
+      job->n = n;
+      // about four chunks per thread to even out the load
+      job->chunkSize = n / ( 4 * nWorkers );
+      if ( job->chunkSize < chunk ) {
+	job->chunkSize = chunk;
+      }
+      job->nextChunk = 0;
+
+      pthread_mutex_lock( &(p->lock) );
+      p->nJobThreads = nWorkers;
+      p->nBusy = nWorkers - 1;
+      ++(p->generation);
+      pthread_cond_broadcast( &(p->wake) );
+      pthread_mutex_unlock( &(p->lock) );
+
+      ThreadTeam_work( job, 0 );  // calling thread is thread 0
+
+      pthread_mutex_lock( &(p->lock) );
+      while( p->nBusy > 0 ) {
+	pthread_cond_wait( &(p->done), &(p->lock) );
+      }
+      pthread_mutex_unlock( &(p->lock) );
+
+      pthread_mutex_lock( &ThreadTeam_poolLock );
+      p->running = false;
+      pthread_mutex_unlock( &ThreadTeam_poolLock );
+      return success;
+    }
+  }
+#endif
+  (*task)( arg, 0, n, 0 );
+  return true;
+}
+
+bool
+ThreadTeam::lockedCompareAndSwap( volatile int * addr, const int oldValue,
+				  const int newValue ) {
+#ifdef SPINDLE_HAVE_PTHREADS
+  pthread_mutex_lock( &ThreadTeam_casLock );
+#endif
+  const bool swapped = ( *addr == oldValue );
+  if ( swapped ) {
+    *addr = newValue;
+  }
+#ifdef SPINDLE_HAVE_PTHREADS
+  pthread_mutex_unlock( &ThreadTeam_casLock );
+#endif
+  return swapped;
+}
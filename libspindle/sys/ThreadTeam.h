@@ -0,0 +1,169 @@
+//
+// ThreadTeam.h
+//
+// $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify , distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+//
+//
+
+#ifndef SPINDLE_THREAD_TEAM_H_
+#define SPINDLE_THREAD_TEAM_H_
+
+#ifndef SPINDLE_H_
+#include "spindle/spindle.h"
+#endif
+
+/**
+ * @type macro
+ * @name SPINDLE_TRACE_IS_THREAD_SAFE
+ *
+ * Defined unless #SPINDLE_ENABLE_STACK_TRACE# or
+ * #SPINDLE_ENABLE_LIMITED_TRACE# is.  Neither trace is thread safe, so
+ * code that hands a #ThreadTeam# tasks which use FENTER/FRETURN, TRACE,
+ * WARNING, or ERROR runs them on #ThreadTeam(1)# when it is not defined.
+ *
+ * Used in #ThreadTeam.h#
+ */
+#if !defined(SPINDLE_ENABLE_STACK_TRACE) && !defined(SPINDLE_ENABLE_LIMITED_TRACE)
+#define SPINDLE_TRACE_IS_THREAD_SAFE
+#endif
+
+// the threads of a team, defined in ThreadTeam.cc
+struct ThreadTeamPool;
+
+SPINDLE_BEGIN_NAMESPACE
+
+/**
+ * @memo fork-join team of threads for parallel loops
+ * @type class
+ *
+ * Runs a task over an index range #[0,n)# on up to #nThreads# threads.
+ * The range is cut into chunks that idle threads claim one at a time
+ * from a shared counter, so a thread with cheap chunks picks up more of
+ * them.  Every call returns only after all chunks have been processed.
+ *
+ * Threads are only used if the library was configured with
+ * #--enable-threads# (which defines #SPINDLE_HAVE_PTHREADS#).  Otherwise,
+ * or if #nThreads# is 1, or if the range is too small to be worth
+ * splitting, the task is called once on the whole range by the calling
+ * thread.  Callers must therefore produce the same result no matter how
+ * the range is split.
+ *
+ * The extra threads are started by the first #run()# that needs them
+ * and then wait for the next call, so a team can be run once per level
+ * of a search without creating threads each time.  They are stopped
+ * when the team is destroyed or its number of threads changes.  A
+ * #run()# made while the same team is still running a job (from one of
+ * its tasks, or from another thread) is done serially.
+ *
+ * NOTE: tasks run concurrently and must not use FENTER/FRETURN, TRACE,
+ *       WARNING, or ERROR, since the stack trace and the trace
+ *       streams are not thread safe.  Where a task cannot avoid them,
+ *       run it on #ThreadTeam(1)# unless #SPINDLE_TRACE_IS_THREAD_SAFE#
+ *       is defined.
+ *
+ * @author agent
+ * @version #$Id$#
+ */
+class ThreadTeam {
+public:
+  /**
+   * A task processes the indices #[begin,end)#.  #threadID# is in
+   * #[0,queryNThreads())# and may be used to select per-thread scratch
+   * space.  #arg# is passed through unchanged.
+   */
+  typedef void (*Task)( void * arg, const int begin, const int end,
+			const int threadID );
+
+private:
+  int nThreads;
+  int minChunkSize;
+  ThreadTeamPool * pool;  // started on demand by run()
+
+  /** joins the threads, if any were started */
+  void stop();
+
+public:
+  /** default constructor: one thread */
+  ThreadTeam();
+  /** convenience constructor */
+  ThreadTeam( const int nThreads_ );
+  /** copies the settings, not the threads */
+  ThreadTeam( const ThreadTeam& src );
+  /** copies the settings, not the threads */
+  ThreadTeam& operator=( const ThreadTeam& src );
+  /** destructor, stops the threads */
+  ~ThreadTeam();
+
+  /** true iff compiled with POSIX thread support */
+  static bool isAvailable();
+
+  /**
+   * set the number of threads to use.  Returns false if
+   * #n < 1#.  If threads are unavailable, #n# is accepted but only
+   * one thread is ever used.
+   */
+  bool setNThreads( const int n );
+  /** query the number of threads that will be used */
+  int queryNThreads() const;
+
+  /**
+   * ranges with fewer than #2 * minChunk# indices are run serially
+   * (default is 256).
+   */
+  bool setMinChunkSize( const int minChunk );
+  /** query the minimum chunk size */
+  int queryMinChunkSize() const { return minChunkSize; }
+
+  /**
+   * apply #task# to #[0,n)#.  Returns false if a thread could not be
+   * created; in that case the remaining chunks are still completed by
+   * the threads that did start (at least the calling thread).
+   */
+  bool run( Task task, void * arg, const int n ) const;
+  /**
+   * same as above, but ranges are split into chunks of at least
+   * #minChunk# indices instead of the team's minimum chunk size.
+   */
+  bool run( Task task, void * arg, const int n, const int minChunk ) const;
+
+  /**
+   * atomically replace #*addr# by #newValue# if it still equals
+   * #oldValue#.  Returns true iff the replacement was made.  Tasks may
+   * use this to claim shared entries.  Uses the compiler's atomic
+   * builtins where available, and a single lock otherwise.
+   */
+  static bool compareAndSwap( volatile int * addr, const int oldValue,
+			      const int newValue );
+
+private:
+  static bool lockedCompareAndSwap( volatile int * addr, const int oldValue,
+				    const int newValue );
+};
+
+inline bool
+ThreadTeam::compareAndSwap( volatile int * addr, const int oldValue,
+			    const int newValue ) {
+#if defined(SPINDLE_HAVE_PTHREADS) && defined(__GNUC__)
+  return __sync_bool_compare_and_swap( addr, oldValue, newValue );
+#else
+  return lockedCompareAndSwap( addr, oldValue, newValue );
+#endif
+}
+
+SPINDLE_END_NAMESPACE
+
+#endif
@@ -73,6 +73,7 @@ bool
 BreadthFirstSearch::reset() {
   FENTER;
   g = 0;
+  pg = 0;
   nVtxs = 0;
   errMsg = 0;
 
@@ -81,6 +82,7 @@ BreadthFirstSearch::reset() {
   partitionMembership = strict;
 
   nVisited = 0;
+  nDistancesSet = -1;
   nFarthest = 0;
   height = 0;
   width = 0;
@@ -89,6 +91,11 @@ BreadthFirstSearch::reset() {
   maxDegreeVtx = -1;
   minDegreeVtx = -1;
   shortCircuited = false;
+  directionOptimizing = true;
+  nBottomUpLevels = 0;
+  team.setNThreads( 1 );
+  deterministic = true;
+  sharedMaxWidth = 0;
   timer.reset();
 
   algorithmicState = EMPTY;
@@ -107,6 +114,7 @@ BreadthFirstSearch::setGraph( const Graph* graph ) {
     FRETURN( false );
   } else if ( graph->isValid() ) {
     g = graph;
+    pg = 0;
     nVtxs = g->size();
     maxWidth = nVtxs;
     FCALL resetRoots();
@@ -121,6 +129,29 @@ BreadthFirstSearch::setGraph( const Graph* graph ) {
 }
 #undef __FUNC__
 
+#define __FUNC__ "bool BreadthFirstSearch::setGraph( const PackedGraph* graph )"
+bool
+BreadthFirstSearch::setGraph( const PackedGraph* graph ) {
+  FENTER;
+  if ( algorithmicState==INVALID ) {
+    FRETURN( false );
+  } else if ( graph->isValid() ) {
+    g = 0;
+    pg = graph;
+    nVtxs = pg->size();
+    maxWidth = nVtxs;
+    FCALL resetRoots();
+
+    algorithmicState = EMPTY;
+    FRETURN( true );
+  } else {
+    algorithmicState = INVALID;
+    errMsg = invalidGraph;
+    FRETURN( false );
+  }
+}
+#undef __FUNC__
+
 #define __FUNC__ "bool BreadthFirstSearch::resetRoots()"
 bool
 BreadthFirstSearch::resetRoots() {
@@ -151,7 +182,7 @@ BreadthFirstSearch::resetRoots() {
 bool
 BreadthFirstSearch::setRoot( const int root ) {
   FENTER;
-  if ( g == 0 ) { 
+  if ( ( g == 0 ) && ( pg == 0 ) ) { 
     algorithmicState = INVALID;
     errMsg = setGraphBeforeRoot;
     FRETURN(false);
@@ -193,7 +224,7 @@ BreadthFirstSearch::setRoot( const int root ) {
 bool
 BreadthFirstSearch::setRoots( const int* root, const int nRoots ) {
   FENTER;
-  if ( g == 0 ) { 
+  if ( ( g == 0 ) && ( pg == 0 ) ) { 
     algorithmicState = INVALID;
     errMsg = setGraphBeforeRoot;
     FRETURN( false );
@@ -251,16 +282,26 @@ BreadthFirstSearch::execute() {
   current_distance = 0;
   nVisited = 0;
   shortCircuited = false;
+  nBottomUpLevels = 0;
   cur_width = 0; 
   widest_yet = 0;
   // first handle the ``SharedArray<int> distance''
-  {
+  if ( ( distance.size() != nVtxs ) || ( nDistancesSet < 0 ) ) {
     // if doesn't own current array, or size is wrong, 
     //    create and own array of correct size
     FCALL distance.resize( nVtxs );  
     // initialize everything to ``-1''
     FCALL distance.init( -1 );
+  } else { 
+    // only the vertices of the last search have distances to clear,
+    // which keeps many searches over small parts of a graph cheap
+    int * l_distance = distance.begin();
+    const int * l_new2old = new2old.lend();
+    for( int i=0; i<nDistancesSet; ++i ) { 
+      l_distance[ l_new2old[i] ] = -1;
+    }
   }
+  nDistancesSet = -1;  // until this run is over
 
   // similarly for ``SharedArray<int> new2old''
   {
@@ -276,7 +317,11 @@ BreadthFirstSearch::execute() {
   {
     // if doesn't own current array, or size is wrong, 
     //    create and own array of correct size
-    FCALL visited.resize( nVtxs );
+    if ( visited.size() != nVtxs ) {
+      // a new graph: stamps left from the last one (or none at all)
+      FCALL visited.resize( nVtxs );
+      stamp = LARGE_INT;
+    }
     // now  increment the stamp
     if (stamp < LARGE_INT ) {
       stamp++;
@@ -322,15 +367,24 @@ BreadthFirstSearch::execute() {
   
   // 4. run
   bool result;
-  if (partition==0) {
-    result = run();
+  if ( pg != 0 ) {
+    if (partition==0) {
+      result = run( pg );
+    } else if ( partitionMembership == strict ) {
+      result = partitionedRun( pg );
+    } else { 
+      result = loosePartitionedRun( pg );
+    }
+  } else if (partition==0) {
+    result = run( g );
   } else if ( partitionMembership == strict ) {
-    result = partitionedRun();
+    result = partitionedRun( g );
   } else { 
-    result = loosePartitionedRun();
+    result = loosePartitionedRun( g );
   }
   if (result) { 
     algorithmicState = DONE;
+    nDistancesSet = nVisited;
   } else if (errMsg == 0) {
     algorithmicState = INVALID;
     errMsg = executionError;
@@ -341,9 +395,10 @@ BreadthFirstSearch::execute() {
 #undef __FUNC__ 
 
 
-#define __FUNC__ "bool BreadthFirstSearch::run()"
+#define __FUNC__ "template< class G > bool BreadthFirstSearch::run( const G * graph )"
+template< class G >
 bool 
-BreadthFirstSearch::run() {
+BreadthFirstSearch::run( const G * graph ) {
   FENTER;
   int k=0;
   int * l_visited = visited.begin();
@@ -351,13 +406,12 @@ BreadthFirstSearch::run() {
   int * l_new2old = new2old.begin();
   int l_maxDegree = -1;
   int l_maxDegreeVtx = -1;
-  int l_minDegree = g->queryNVtxs()+1;
+  int l_minDegree = graph->queryNVtxs()+1;
   int l_minDegreeVtx = -1;
-  const int * adjHead = g->getAdjHead().lend();
   const int * vtxWeight = 0;
   
-  if (g->getVtxWeight().size() == g->size() ) {
-    vtxWeight = g->getVtxWeight().lend();
+  if (graph->getVtxWeight().size() == graph->size() ) {
+    vtxWeight = graph->getVtxWeight().lend();
     while( k < nVisited ) {
       current_distance++; // current distance is one more
       int prev_width = cur_width;
@@ -365,7 +419,7 @@ BreadthFirstSearch::run() {
       for( int j=0; j<prev_width; j++) { // foreach vertex at distance(current_distance-1)
 	int i = l_new2old[k++];            // increment k here.
 	int curDegree = 0;
-	for(const int * cur=g->begin_adj(i), *stop=g->end_adj(i);
+	for(typename G::const_iterator cur=graph->begin_adj(i), stop=graph->end_adj(i);
 	    cur != stop; ++cur ) { // for all vertices adjacent to i
 	  int adj_i = *cur;
 	  curDegree += vtxWeight[ adj_i ];
@@ -388,7 +442,7 @@ BreadthFirstSearch::run() {
       cur_width = nVisited - prev_nVisited;
       widest_yet = (cur_width > widest_yet) ? cur_width : widest_yet;
       
-      if (cur_width > maxWidth) { 
+      if ( tooWide( cur_width ) ) { 
 	// short-circuit triggered
 	shortCircuited = true;
 	width = widest_yet;
@@ -412,17 +466,22 @@ BreadthFirstSearch::run() {
 	FRETURN( true );
       }
     } // end while k < nVisited
-  } else { // no vtx weights
+  } else if ( ( g != 0 ) && ( team.queryNThreads() > 1 ) ) { 
+    FRETURN( parallelRun() );
+  } else if ( ( g != 0 ) && directionOptimizing ) { 
+    FRETURN( directionOptimizingRun() );
+  } else { // no vtx weights, or a PackedGraph: top-down on one thread
     while( k < nVisited ) {
       current_distance++; // current distance is one more
       int prev_width = cur_width;
       int prev_nVisited = nVisited;
       for( int j=0; j<prev_width; j++) { // foreach vertex at distance(current_distance-1)
 	int i = l_new2old[k++];            // increment k here.
-	int curDegree = adjHead[i+1] - adjHead[i];
-	for(const int * cur=g->begin_adj(i), *stop=g->end_adj(i);
+	int curDegree = 0;
+	for(typename G::const_iterator cur=graph->begin_adj(i), stop=graph->end_adj(i);
 	    cur != stop; ++cur ) { // for all vertices adjacent to i
 	  int adj_i = *cur;
+	  ++curDegree;
 	  if (visited[adj_i]<stamp) {
 	    // if not visited  and either no partition restrictions or adj_i is in cur partition
 	    l_visited[adj_i] = stamp;
@@ -442,7 +501,7 @@ BreadthFirstSearch::run() {
       cur_width = nVisited - prev_nVisited;
       widest_yet = (cur_width > widest_yet) ? cur_width : widest_yet;
       
-      if (cur_width > maxWidth) { 
+      if ( tooWide( cur_width ) ) { 
 	// short-circuit triggered
 	shortCircuited = true;
 	width = widest_yet;
@@ -472,9 +531,339 @@ BreadthFirstSearch::run() {
 #undef __FUNC__
 
 
-#define __FUNC__ "bool BreadthFirstSearch::partitionedRun()"
+#define __FUNC__ "bool BreadthFirstSearch::directionOptimizingRun()"
+//
+// Same output as the unweighted loop in run(), but a level is found
+// "bottom-up" (every unvisited vertex looks for a neighbor in the
+// frontier) whenever that scans fewer edges than expanding the frontier
+// "top-down".  Visited and frontier vertices are kept in bitmaps, which
+// stay in cache far longer than the int arrays.
+//
+// A top-down level lists the children of each frontier vertex in
+// frontier order, and each of them in adjacency order, which is
+// increasing vertex order for a valid Graph.  So a bottom-up level
+// gives every child the earliest frontier vertex among its neighbors
+// and sorts the children by it, keeping them in increasing order
+// otherwise.  This costs a full scan of each child's adjacency
+// instead of stopping at the first frontier neighbor, but the result
+// is identical to a top-down level.
+//
+bool 
+BreadthFirstSearch::directionOptimizingRun() {
+  FENTER;
+  int k=0;
+  int * l_distance = distance.begin();
+  int * l_new2old = new2old.begin();
+  int l_maxDegree = -1;
+  int l_maxDegreeVtx = -1;
+  int l_minDegree = g->queryNVtxs()+1;
+  int l_minDegreeVtx = -1;
+  const int * adjHead = g->getAdjHead().lend();
+  const int * adjList = g->getAdjList().lend();
+
+  const int nWords = ( nVtxs + 31 ) >> 5;
+  FCALL visitedBits.resize( nWords );
+  FCALL visitedBits.init( 0 );
+  FCALL frontierBits.resize( nWords );
+  FCALL frontierBits.init( 0 );
+  unsigned int * l_visitedBits = visitedBits.begin();
+  unsigned int * l_frontierBits = frontierBits.begin();
+  int * l_frontierPos = 0;
+  int * l_unvisited = 0;
+  int * l_count = 0;
+  int nUnvisited = -1;       // list not built until the first bottom-up level
+
+  // number of adjacency entries of unvisited vertices and of the frontier
+  long mUnvisited = adjHead[ nVtxs ] - adjHead[ 0 ];
+  long mFrontier = 0;
+  {for( int j=0; j<nVisited; ++j ) { 
+    const int i = l_new2old[j];
+    l_visitedBits[ i >> 5 ] |= ( 1u << ( i & 31 ) );
+    mFrontier += adjHead[i+1] - adjHead[i];
+  }}
+  mUnvisited -= mFrontier;
+
+  while( k < nVisited ) {
+    current_distance++; // current distance is one more
+    int prev_width = cur_width;
+    int prev_nVisited = nVisited;
+    long mNext = 0;
+
+    if ( mFrontier > mUnvisited + ( nVtxs - nVisited ) ) { 
+      //
+      // bottom-up: the frontier has more edges than the unvisited vertices
+      //
+      ++nBottomUpLevels;
+      if ( l_unvisited == 0 ) { 
+	FCALL frontierPos.resize( nVtxs );
+	FCALL unvisited.resize( nVtxs );
+	FCALL levelCount.resize( nVtxs + 1 );
+	l_frontierPos = frontierPos.begin();
+	l_unvisited = unvisited.begin();
+	l_count = levelCount.begin();
+      }
+      if ( nUnvisited < 0 ) { 
+	nUnvisited = 0;
+	{for( int w=0; w<nWords; ++w ) {
+	  if ( l_visitedBits[w] == ~0u ) { continue; }
+	  for( int i = w << 5, stop = ( i+32 < nVtxs ) ? i+32 : nVtxs; i<stop; ++i ) { 
+	    if ( ( l_visitedBits[ w ] & ( 1u << ( i & 31 ) ) ) == 0 ) {
+	      l_unvisited[ nUnvisited++ ] = i;
+	    }
+	  }
+	}}
+      }
+      {for( int j=0; j<prev_width; ++j ) { 
+	const int i = l_new2old[ k+j ];
+	l_frontierBits[ i >> 5 ] |= ( 1u << ( i & 31 ) );
+	l_frontierPos[ i ] = j;
+	l_count[j] = 0;
+      }}
+      l_count[ prev_width ] = 0;
+      // find each child and its earliest parent, children are appended
+      // to new2old in increasing vertex order for now, their parents
+      // are kept in distance[] until they are sorted.
+      int nLeft = 0;
+      {for( int u=0; u<nUnvisited; ++u ) { 
+	const int v = l_unvisited[u];
+	int parent = prev_width;
+	for( const int * cur = adjList + adjHead[v], *stop = adjList + adjHead[v+1]; 
+	     cur != stop; ++cur ) { 
+	  const int w = *cur;
+	  if ( l_frontierBits[ w >> 5 ] & ( 1u << ( w & 31 ) ) ) {
+	    const int p = l_frontierPos[ w ];
+	    parent = ( p < parent ) ? p : parent;
+	  }
+	}
+	if ( parent < prev_width ) { 
+	  l_distance[ v ] = parent;
+	  ++l_count[ parent+1 ];
+	  l_new2old[ nVisited++ ] = v;
+	} else { 
+	  l_unvisited[ nLeft++ ] = v;
+	}
+      }}
+      nUnvisited = nLeft;
+      // stable counting sort of the children by parent, kept in
+      // levelCount[] then copied back to new2old.
+      {for( int j=0; j<prev_width; ++j ) { l_count[j+1] += l_count[j]; }}
+      int * l_sorted = l_frontierPos; // reuse: only frontier entries were set
+      {for( int j=prev_nVisited; j<nVisited; ++j ) {
+	const int v = l_new2old[j];
+	l_sorted[ prev_nVisited + l_count[ l_distance[v] ]++ ] = v;
+      }}
+      {for( int j=prev_nVisited; j<nVisited; ++j ) {
+	const int v = l_sorted[j];
+	l_new2old[j] = v;
+	l_distance[v] = current_distance;
+	l_visitedBits[ v >> 5 ] |= ( 1u << ( v & 31 ) );
+	mNext += adjHead[v+1] - adjHead[v];
+      }}
+      // the degrees of the frontier, in frontier order
+      {for( int j=0; j<prev_width; j++) {
+	const int i = l_new2old[k++];
+	const int curDegree = adjHead[i+1] - adjHead[i];
+	l_frontierBits[ i >> 5 ] = 0;
+	if ( curDegree < l_minDegree ) {
+	  l_minDegree = curDegree;
+	  l_minDegreeVtx = i;
+	}
+	if ( curDegree > l_maxDegree ) {
+	  l_maxDegree = curDegree;
+	  l_maxDegreeVtx = i;
+	}
+      }}
+    } else { 
+      //
+      // top-down: expand the frontier
+      //
+      for( int j=0; j<prev_width; j++) { // foreach vertex at distance(current_distance-1)
+	int i = l_new2old[k++];            // increment k here.
+	int curDegree = adjHead[i+1] - adjHead[i];
+	for( const int * cur = adjList + adjHead[i], *stop = adjList + adjHead[i+1]; 
+	     cur != stop; ++cur ) { // for all vertices adjacent to i
+	  const int adj_i = *cur;
+	  unsigned int & word = l_visitedBits[ adj_i >> 5 ];
+	  const unsigned int bit = 1u << ( adj_i & 31 );
+	  if ( ( word & bit ) == 0 ) { 
+	    word |= bit;
+	    l_distance[adj_i] = current_distance;
+	    l_new2old[nVisited++] = adj_i;
+	    mNext += adjHead[adj_i+1] - adjHead[adj_i];
+	  } // end if
+	} // end for adj(i)
+	if ( curDegree < l_minDegree ) {
+	  l_minDegree = curDegree;
+	  l_minDegreeVtx = i;
+	}
+	if ( curDegree > l_maxDegree ) {
+	  l_maxDegree = curDegree;
+	  l_maxDegreeVtx = i;
+	}
+      } // end foreach vertex at dist(current_distance-1)
+      nUnvisited = -1; // rebuild the list if we go bottom-up again
+    }
+    mFrontier = mNext;
+    mUnvisited -= mNext;
+
+    cur_width = nVisited - prev_nVisited;
+    widest_yet = (cur_width > widest_yet) ? cur_width : widest_yet;
+    
+    if ( tooWide( cur_width ) ) { 
+      // short-circuit triggered
+      shortCircuited = true;
+      width = widest_yet;
+      height = current_distance;
+      nFarthest = cur_width;
+      minDegree = l_minDegree;
+      maxDegree = l_maxDegree;
+      minDegreeVtx = l_minDegreeVtx;
+      maxDegreeVtx = l_maxDegreeVtx;
+      FRETURN( true );
+    } 
+    if (prev_nVisited == nVisited) { // no more to add
+      // normal termination
+      width = widest_yet;
+      height = current_distance-1;
+      nFarthest = prev_width;
+      minDegree = l_minDegree;
+      maxDegree = l_maxDegree;
+      minDegreeVtx = l_minDegreeVtx;
+      maxDegreeVtx = l_maxDegreeVtx;
+      FRETURN( true );
+    }
+  } // end while k < nVisited
+  FRETURN( false );
+}
+#undef __FUNC__
+
+//
+// shared state of one level of parallelRun().  The frontier is
+// new2old[ frontier .. frontier+width ), cut into nBlocks contiguous
+// blocks at blockBegin[].
+//
+struct BFSLevel { 
+  const int * adjHead;
+  const int * adjList;
+  volatile int * visited;
+  int * new2old;
+  int * distance;
+  volatile int * parent;   // earliest frontier position adjacent to a vertex
+  vector<int> * next;      // next level found by each block
+  const int * blockBegin;
+  int frontier;
+  int stamp;
+  int currentDistance;
+};
+
+//
+// deterministic, pass 1: every unvisited neighbor of the frontier
+// records the position of its earliest frontier neighbor.  Nothing
+// else is written, so all threads see the same visited marks.
+//
+static void
+BFSLevel_findParentsTask( void * arg, const int begin, const int end,
+			  const int ) {
+  BFSLevel * l = (BFSLevel *) arg;
+  for( int blk=begin; blk<end; ++blk ) { 
+    for( int j=l->blockBegin[blk]; j<l->blockBegin[blk+1]; ++j ) { 
+      const int i = l->new2old[ l->frontier + j ];
+      for( const int * cur = l->adjList + l->adjHead[i], *stop = l->adjList + l->adjHead[i+1];
+	   cur != stop; ++cur ) { 
+	const int w = *cur;
+	if ( l->visited[w] == l->stamp ) { continue; }
+	int old = l->parent[w];
+	while( ( j < old ) && ( !ThreadTeam::compareAndSwap( l->parent + w, old, j ) ) ) { 
+	  old = l->parent[w];
+	}
+      }
+    }
+  }
+}
+
+//
+// deterministic, pass 2: every frontier vertex lists the neighbors it
+// is the earliest parent of, in adjacency order.  This is exactly the
+// order in which a single thread appends them.
+//
+static void
+BFSLevel_collectChildrenTask( void * arg, const int begin, const int end,
+			      const int ) {
+  BFSLevel * l = (BFSLevel *) arg;
+  for( int blk=begin; blk<end; ++blk ) { 
+    vector<int>& next = l->next[blk];
+    next.resize( 0 );
+    for( int j=l->blockBegin[blk]; j<l->blockBegin[blk+1]; ++j ) { 
+      const int i = l->new2old[ l->frontier + j ];
+      for( const int * cur = l->adjList + l->adjHead[i], *stop = l->adjList + l->adjHead[i+1];
+	   cur != stop; ++cur ) { 
+	const int w = *cur;
+	if ( ( l->parent[w] == j ) && ( l->visited[w] != l->stamp ) ) { 
+	  next.push_back( w );
+	}
+      }
+    }
+  }
+}
+
+//
+// non-deterministic: the first thread to mark a vertex visited keeps it.
+//
+static void
+BFSLevel_claimChildrenTask( void * arg, const int begin, const int end,
+			    const int ) {
+  BFSLevel * l = (BFSLevel *) arg;
+  for( int blk=begin; blk<end; ++blk ) { 
+    vector<int>& next = l->next[blk];
+    next.resize( 0 );
+    for( int j=l->blockBegin[blk]; j<l->blockBegin[blk+1]; ++j ) { 
+      const int i = l->new2old[ l->frontier + j ];
+      for( const int * cur = l->adjList + l->adjHead[i], *stop = l->adjList + l->adjHead[i+1];
+	   cur != stop; ++cur ) { 
+	const int w = *cur;
+	const int old = l->visited[w];
+	if ( ( old != l->stamp ) && ( ThreadTeam::compareAndSwap( l->visited + w, old, l->stamp ) ) ) { 
+	  next.push_back( w );
+	}
+      }
+    }
+  }
+}
+
+//
+// copy the lists of the blocks after the frontier, blockBegin[] now
+// holds the offset of each list.
+//
+static void
+BFSLevel_appendTask( void * arg, const int begin, const int end,
+		     const int ) {
+  BFSLevel * l = (BFSLevel *) arg;
+  for( int blk=begin; blk<end; ++blk ) { 
+    const vector<int>& next = l->next[blk];
+    int * dest = l->new2old + l->blockBegin[blk];
+    for( vector<int>::const_iterator it = next.begin(), stop = next.end(); it != stop; ++it ) { 
+      const int w = *it;
+      *dest++ = w;
+      l->visited[w] = l->stamp;
+      l->distance[w] = l->currentDistance;
+    }
+  }
+}
+
+#define __FUNC__ "bool BreadthFirstSearch::parallelRun()"
+//
+// Same output as the unweighted loop in run().  Each level is cut into
+// blocks of the frontier that the threads of the team expand into
+// lists of their own, which are then appended to new2old in block
+// order.  Narrow levels are expanded by the calling thread alone.
+//
+// In deterministic mode a vertex belongs to its earliest frontier
+// neighbor, found with an atomic minimum, so the lists come out as a
+// single thread would produce them.  Otherwise a vertex belongs to
+// whichever thread marks it visited first.
+//
 bool 
-BreadthFirstSearch::partitionedRun() {
+BreadthFirstSearch::parallelRun() {
   FENTER;
   int k=0;
   int * l_visited = visited.begin();
@@ -485,9 +874,129 @@ BreadthFirstSearch::partitionedRun() {
   int l_minDegree = g->queryNVtxs()+1;
   int l_minDegreeVtx = -1;
   const int * adjHead = g->getAdjHead().lend();
+  const int * adjList = g->getAdjList().lend();
+
+  // smallest number of frontier vertices worth giving to a thread
+  const int minBlockSize = 256;
+  const int maxBlocks = 4 * team.queryNThreads();
+  vector<int> blockBegin( maxBlocks + 1 );
+  if ( (int) blockNext.size() < maxBlocks ) { 
+    blockNext.resize( maxBlocks );
+  }
+  if ( deterministic ) { 
+    FCALL frontierPos.resize( nVtxs );
+    FCALL frontierPos.init( nVtxs );
+  }
+
+  BFSLevel level;
+  level.adjHead = adjHead;
+  level.adjList = adjList;
+  level.visited = l_visited;
+  level.new2old = l_new2old;
+  level.distance = l_distance;
+  level.parent = ( deterministic ) ? frontierPos.begin() : 0;
+  level.next = &(blockNext[0]);
+  level.blockBegin = &(blockBegin[0]);
+  level.stamp = stamp;
+
+  while( k < nVisited ) {
+    current_distance++; // current distance is one more
+    int prev_width = cur_width;
+    int prev_nVisited = nVisited;
+    int nBlocks = prev_width / minBlockSize;
+    nBlocks = ( nBlocks > maxBlocks ) ? maxBlocks : nBlocks;
+
+    if ( nBlocks > 1 ) { 
+      {for( int blk=0; blk<=nBlocks; ++blk ) { 
+	blockBegin[blk] = (int) ( ( (double) prev_width * blk ) / nBlocks );
+      }}
+      level.frontier = k;
+      level.currentDistance = current_distance;
+      if ( deterministic ) { 
+	team.run( BFSLevel_findParentsTask, &level, nBlocks, 1 );
+	team.run( BFSLevel_collectChildrenTask, &level, nBlocks, 1 );
+      } else { 
+	team.run( BFSLevel_claimChildrenTask, &level, nBlocks, 1 );
+      }
+      {for( int blk=0; blk<nBlocks; ++blk ) { 
+	blockBegin[blk] = nVisited;
+	nVisited += (int) blockNext[blk].size();
+      }}
+      team.run( BFSLevel_appendTask, &level, nBlocks, 1 );
+    } else { 
+      {for( int j=0; j<prev_width; ++j ) { 
+	const int i = l_new2old[k+j];
+	for( const int * cur = adjList + adjHead[i], *stop = adjList + adjHead[i+1]; 
+	     cur != stop; ++cur ) { // for all vertices adjacent to i
+	  const int adj_i = *cur;
+	  if ( l_visited[adj_i] < stamp ) { 
+	    l_visited[adj_i] = stamp;
+	    l_distance[adj_i] = current_distance;
+	    l_new2old[nVisited++] = adj_i;
+	  }
+	}
+      }}
+    }
+    for( int j=0; j<prev_width; j++) { // foreach vertex at distance(current_distance-1)
+      int i = l_new2old[k++];            // increment k here.
+      int curDegree = adjHead[i+1] - adjHead[i];
+      if ( curDegree < l_minDegree ) {
+	l_minDegree = curDegree;
+	l_minDegreeVtx = i;
+      }
+      if ( curDegree > l_maxDegree ) {
+	l_maxDegree = curDegree;
+	l_maxDegreeVtx = i;
+      }
+    } // end foreach vertex at dist(current_distance-1)
+    cur_width = nVisited - prev_nVisited;
+    widest_yet = (cur_width > widest_yet) ? cur_width : widest_yet;
+    
+    if ( tooWide( cur_width ) ) { 
+      // short-circuit triggered
+      shortCircuited = true;
+      width = widest_yet;
+      height = current_distance;
+      nFarthest = cur_width;
+      minDegree = l_minDegree;
+      maxDegree = l_maxDegree;
+      minDegreeVtx = l_minDegreeVtx;
+      maxDegreeVtx = l_maxDegreeVtx;
+      FRETURN( true );
+    } 
+    if (prev_nVisited == nVisited) { // no more to add
+      // normal termination
+      width = widest_yet;
+      height = current_distance-1;
+      nFarthest = prev_width;
+      minDegree = l_minDegree;
+      maxDegree = l_maxDegree;
+      minDegreeVtx = l_minDegreeVtx;
+      maxDegreeVtx = l_maxDegreeVtx;
+      FRETURN( true );
+    }
+  } // end while k < nVisited
+  FRETURN( false );
+}
+#undef __FUNC__
+
+#define __FUNC__ "template< class G > bool BreadthFirstSearch::partitionedRun( const G * graph )"
+template< class G >
+bool 
+BreadthFirstSearch::partitionedRun( const G * graph ) {
+  FENTER;
+  int k=0;
+  int * l_visited = visited.begin();
+  int * l_distance = distance.begin();
+  int * l_new2old = new2old.begin();
+  int l_maxDegree = -1;
+  int l_maxDegreeVtx = -1;
+  int l_minDegree = graph->queryNVtxs()+1;
+  int l_minDegreeVtx = -1;
   const int * vtxWeight = 0;
   
-  if ( g->getVtxWeight().size() == g->size() ) {
+  if ( graph->getVtxWeight().size() == graph->size() ) {
+    vtxWeight = graph->getVtxWeight().lend();
     while( k < nVisited ) {
       current_distance++; // current distance is one more
       int prev_width = cur_width;
@@ -496,7 +1005,7 @@ BreadthFirstSearch::partitionedRun() {
       for( int j=0; j<prev_width; j++) { // foreach vertex at distance(current_distance-1)
 	int i = l_new2old[k++];            // increment k here.
 	int curDegree = 0;
-	for(Graph::const_iterator cur=g->begin_adj(i), stop=g->end_adj(i);
+	for(typename G::const_iterator cur=graph->begin_adj(i), stop=graph->end_adj(i);
 	  cur != stop; ++cur ) { // for all vertices adjacent to i
 	  int adj_i = *cur;
 	  curDegree += vtxWeight[ adj_i ];
@@ -519,7 +1028,7 @@ BreadthFirstSearch::partitionedRun() {
       cur_width = nVisited - prev_nVisited;
       widest_yet = (cur_width > widest_yet) ? cur_width : widest_yet;
       
-      if (cur_width > maxWidth) { 
+      if ( tooWide( cur_width ) ) { 
 	// short-circuit triggered
 	shortCircuited = true;
 	width = widest_yet;
@@ -551,10 +1060,11 @@ BreadthFirstSearch::partitionedRun() {
       
       for( int j=0; j<prev_width; j++) { // foreach vertex at distance(current_distance-1)
 	int i = l_new2old[k++];            // increment k here.
-	int curDegree = adjHead[i+1] - adjHead[i];
-	for(Graph::const_iterator cur=g->begin_adj(i), stop=g->end_adj(i);
+	int curDegree = 0;
+	for(typename G::const_iterator cur=graph->begin_adj(i), stop=graph->end_adj(i);
 	    cur != stop; ++cur ) { // for all vertices adjacent to i
 	  int adj_i = *cur;
+	  ++curDegree;
 	  if ((l_visited[adj_i]<stamp) &&  (partition[adj_i] == curPartition) ) {
 	    // if not visited  and either no partition restrictions or adj_i is in cur partition
 	    l_visited[adj_i] = stamp;
@@ -574,7 +1084,7 @@ BreadthFirstSearch::partitionedRun() {
       cur_width = nVisited - prev_nVisited;
       widest_yet = (cur_width > widest_yet) ? cur_width : widest_yet;
       
-      if (cur_width > maxWidth) { 
+      if ( tooWide( cur_width ) ) { 
 	// short-circuit triggered
 	shortCircuited = true;
 	width = widest_yet;
@@ -603,9 +1113,10 @@ BreadthFirstSearch::partitionedRun() {
 }
 #undef __FUNC__
 
-#define __FUNC__ "bool BreadthFirstSearch::loosePartitionedRun()"
+#define __FUNC__ "template< class G > bool BreadthFirstSearch::loosePartitionedRun( const G * graph )"
+template< class G >
 bool 
-BreadthFirstSearch::loosePartitionedRun() {
+BreadthFirstSearch::loosePartitionedRun( const G * graph ) {
   FENTER;
   int k=0;
   int * l_visited = visited.begin();
@@ -613,12 +1124,12 @@ BreadthFirstSearch::loosePartitionedRun() {
   int * l_new2old = new2old.begin();
   int l_maxDegree = -1;
   int l_maxDegreeVtx = -1;
-  int l_minDegree = g->queryNVtxs()+1;
+  int l_minDegree = graph->queryNVtxs()+1;
   int l_minDegreeVtx = -1;
-  const int * adjHead = g->getAdjHead().lend();
   const int * vtxWeight = 0;
   
-  if ( g->getVtxWeight().size() == g->size() ) {
+  if ( graph->getVtxWeight().size() == graph->size() ) {
+    vtxWeight = graph->getVtxWeight().lend();
     while( k < nVisited ) {
       current_distance++; // current distance is one more
       int prev_width = cur_width;
@@ -628,7 +1139,7 @@ BreadthFirstSearch::loosePartitionedRun() {
 	int i = l_new2old[k++];            // increment k here.
 	int curDegree = 0;
 	bool i_in_partition = ( partition[ i ] == curPartition );
-	for(Graph::const_iterator cur=g->begin_adj(i), stop=g->end_adj(i);
+	for(typename G::const_iterator cur=graph->begin_adj(i), stop=graph->end_adj(i);
 	  cur != stop; ++cur ) { // for all vertices adjacent to i
 	  int adj_i = *cur;
 	  curDegree += vtxWeight[ adj_i ];
@@ -651,7 +1162,7 @@ BreadthFirstSearch::loosePartitionedRun() {
       cur_width = nVisited - prev_nVisited;
       widest_yet = (cur_width > widest_yet) ? cur_width : widest_yet;
       
-      if (cur_width > maxWidth) { 
+      if ( tooWide( cur_width ) ) { 
 	// short-circuit triggered
 	shortCircuited = true;
 	width = widest_yet;
@@ -683,11 +1194,12 @@ BreadthFirstSearch::loosePartitionedRun() {
       
       for( int j=0; j<prev_width; j++) { // foreach vertex at distance(current_distance-1)
 	int i = l_new2old[k++];            // increment k here.
-	int curDegree = adjHead[i+1] - adjHead[i];
+	int curDegree = 0;
 	bool i_in_partition = ( partition[ i ] == curPartition );
-	for(Graph::const_iterator cur=g->begin_adj(i), stop=g->end_adj(i);
+	for(typename G::const_iterator cur=graph->begin_adj(i), stop=graph->end_adj(i);
 	    cur != stop; ++cur ) { // for all vertices adjacent to i
 	  int adj_i = *cur;
+	  ++curDegree;
 	  if ((l_visited[adj_i]<stamp) && ( i_in_partition ||  (partition[adj_i] == curPartition) ) ) {
 	    // if not visited  and either i or adj_i is in cur partition (or both)
 	    l_visited[adj_i] = stamp;
@@ -707,7 +1219,7 @@ BreadthFirstSearch::loosePartitionedRun() {
       cur_width = nVisited - prev_nVisited;
       widest_yet = (cur_width > widest_yet) ? cur_width : widest_yet;
       
-      if (cur_width > maxWidth) { 
+      if ( tooWide( cur_width ) ) { 
 	// short-circuit triggered
 	shortCircuited = true;
 	width = widest_yet;
@@ -748,13 +1260,24 @@ BreadthFirstSearch::enableShortCircuiting( const int max_width ) {
 }
 #undef __FUNC__
 
+#define __FUNC__ "bool BreadthFirstSearch::setSharedMaxWidth( const volatile int * max_width )"
+bool 
+BreadthFirstSearch::setSharedMaxWidth( const volatile int * max_width ) { 
+  FENTER;
+  if ( algorithmicState == INVALID ) { FRETURN( false ); }
+  sharedMaxWidth = max_width;
+  FRETURN( true );
+}
+#undef __FUNC__
+
 #define __FUNC__ "bool BreadthFirstSearch::disableShortCircuiting()"
 bool 
 BreadthFirstSearch::disableShortCircuiting() {
   FENTER;
   if ( algorithmicState == INVALID ) { FRETURN( false ); }
-  if (maxWidth == nVtxs) { FRETURN( false ); } 
+  if ( (maxWidth == nVtxs) && (sharedMaxWidth == 0) ) { FRETURN( false ); } 
   maxWidth = nVtxs;
+  sharedMaxWidth = 0;
   FRETURN( true );
 }
 #undef __FUNC__
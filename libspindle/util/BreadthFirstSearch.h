@@ -36,6 +36,14 @@
 #include "spindle/Graph.h"
 #endif
 
+#ifndef SPINDLE_PACKED_GRAPH_H_
+#include "spindle/PackedGraph.h"
+#endif
+
+#ifndef SPINDLE_THREAD_TEAM_H_
+#include "spindle/ThreadTeam.h"
+#endif
+
 #ifdef REQUIRE_OLD_CXX_HEADER_SUFFIX
 #include "vector.h"
 #else
@@ -83,6 +91,12 @@ protected:
    */
   const Graph* g;              
 
+  /** 
+   * or a const pointer to a packed graph.  Its searches always go
+   * top-down on one thread.
+   */
+  const PackedGraph* pg;
+
   /** Number of vertices in the graph */
   int nVtxs;
 
@@ -101,6 +115,12 @@ protected:
   /** the order in which vertices are visited */
   SharedArray<int> new2old;    
 
+  /** 
+   * distances are set for new2old[0..nDistancesSet) only, so the next
+   * run clears just those; -1 if the whole array must be cleared.
+   */
+  int nDistancesSet;
+
   /** const pointer to a partition array (optional) */
   const int *partition;        
 
@@ -131,6 +151,12 @@ protected:
    */
   int maxWidth;  
   
+  /** 
+   * optional second bound on the width that another thread may lower
+   * during a run (used with short-circuiting)
+   */
+  const volatile int * sharedMaxWidth;
+
   /** true iff the last run was short-circuited */
   bool shortCircuited;
   
@@ -149,16 +175,49 @@ protected:
   /** A basic timer */
   stopwatch timer;
 
+  /** true iff unweighted, unrestricted searches may go bottom-up */
+  bool directionOptimizing;
+
+  /** number of levels found bottom-up on the most recent run */
+  int nBottomUpLevels;
+
+  /** bitmaps of visited and frontier vertices for directionOptimizingRun() */
+  SharedArray<unsigned int> visitedBits;
+  SharedArray<unsigned int> frontierBits;
+
+  /** scratch space for the bottom-up and the threaded levels */
+  SharedArray<int> frontierPos;
+  SharedArray<int> unvisited;
+  SharedArray<int> levelCount;
+
+  /** threads used for the levels of unweighted, unrestricted searches */
+  ThreadTeam team;
+
+  /** true iff threaded searches must number vertices in the serial order */
+  bool deterministic;
+
+  /** next level found by each block of the frontier in parallelRun() */
+  vector< vector<int> > blockNext;
+
 private:
 
-  /** does the actual BFS  */
-  bool run();            
+  /** true iff a level of #levelWidth# vertices short-circuits the run */
+  bool tooWide( const int levelWidth ) const;
+
+  /** does the actual BFS on a Graph or PackedGraph */
+  template< class G > bool run( const G* graph );
+
+  /** does the BFS without vertex weights, switching between top-down and bottom-up */
+  bool directionOptimizingRun();
+
+  /** does the BFS without vertex weights, expanding each level with a thread team */
+  bool parallelRun();
 
   /** does the BFS when partition restrictions are activated */
-  bool partitionedRun(); 
+  template< class G > bool partitionedRun( const G* graph ); 
 
   /** does the BFS when partition restrictions are activated, but allow neighbors */
-  bool loosePartitionedRun(); 
+  template< class G > bool loosePartitionedRun( const G* graph ); 
 
 protected:
 
@@ -207,7 +266,16 @@ public:
   bool enableShortCircuiting( const int max_width );
 
   /**
-   * disable short circuiting mechanism
+   * also short-circuit when a level is wider than #*max_width#.  The
+   * value is read at every level, so another thread may lower it
+   * while the search runs.  Passing 0 removes this bound.
+   * @return true iff BFS not INVALID
+   * @see PseudoDiameter::setNCandidateThreads
+   */
+  bool setSharedMaxWidth( const volatile int * max_width );
+
+  /**
+   * disable short circuiting mechanism (both bounds)
    * @return true ifff BFS not INVALID and no error detected
    */
   bool disableShortCircuiting();
@@ -228,6 +296,46 @@ public:
    */
   bool disablePartitionRestrictions();
 
+  /**
+   * let levels be found bottom-up when the frontier has more edges
+   * than the unvisited vertices (default).  Only used without vertex
+   * weights or partition restrictions.  The results are identical
+   * either way.
+   */
+  void enableDirectionOptimization() { directionOptimizing = true; }
+
+  /**
+   * always expand the frontier top-down
+   */
+  void disableDirectionOptimization() { directionOptimizing = false; }
+
+  /**
+   * expand the levels of searches without vertex weights or partition
+   * restrictions with up to #nThreads# threads.  Levels are always
+   * expanded top-down then.
+   * @return false if #nThreads < 1#
+   * @see ThreadTeam
+   */
+  bool setNThreads( const int nThreads ) { return team.setNThreads( nThreads ); }
+
+  /**
+   * @return number of threads used for each level
+   */
+  int queryNThreads() const { return team.queryNThreads(); }
+
+  /**
+   * threaded searches number the vertices of each level exactly as a
+   * single thread would (default).  This costs a second pass over the
+   * edges of the frontier.
+   */
+  void enableDeterministicOrder() { deterministic = true; }
+
+  /**
+   * threaded searches find the same levels as a single thread, but the
+   * order within a level may change from run to run.
+   */
+  void disableDeterministicOrder() { deterministic = false; }
+
   /**
    * set the graph to operate on.
    * @return true iff BFS not INVALID, graph is valid, and no error detected.
@@ -235,6 +343,15 @@ public:
    */
   bool setGraph( const Graph* graph );               
 
+  /**
+   * set a packed graph to operate on instead.  The results are the
+   * same as for the Graph it was packed from, but levels are always
+   * expanded top-down on one thread.
+   * @return true iff BFS not INVALID, graph is valid, and no error detected.
+   * @param graph must point to a valid graph object for the lifetime of the BFS.
+   */
+  bool setGraph( const PackedGraph* graph );
+
   /**
    * set the root for the BFS
    * @return true iff BFS not INVALID and no error detected
@@ -298,6 +415,11 @@ public:
    */
   int queryWidth() const { return width; }        
 
+  /**
+   * @return number of levels found bottom-up on last run.
+   */
+  int queryNBottomUpLevels() const { return nBottomUpLevels; }
+
   /**
    * @return true iff the BFS was short-circuited
    */
@@ -334,7 +456,8 @@ public:
   const SharedArray<int>& getNew2Old() const;
   
   /**
-   * @return non-const reference to the Hew2Old array
+   * @return non-const reference to the Hew2Old array.  The next
+   * #execute()# clears distances through it, so do not change it.
    */
   SharedArray<int>& getNew2Old();
   
@@ -344,7 +467,9 @@ public:
   const SharedArray<int>& getDistance() const;
 
   /**
-   * @return non-const reference to the distance array
+   * @return non-const reference to the distance array.  The next
+   * #execute()# only clears the distances of visited vertices, so
+   * do not change the others.
    */
   SharedArray<int>& getDistance();
 
@@ -359,6 +484,12 @@ private:
   
 };
 
+inline bool
+BreadthFirstSearch::tooWide( const int levelWidth ) const {
+  return ( levelWidth > maxWidth ) || 
+    ( ( sharedMaxWidth != 0 ) && ( levelWidth > *sharedMaxWidth ) );
+}
+
 SPINDLE_END_NAMESPACE
 
 #endif
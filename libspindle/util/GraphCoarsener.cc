@@ -0,0 +1,380 @@
+//
+// GraphCoarsener.cc
+//
+// $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+//
+
+#include "spindle/GraphCoarsener.h"
+
+#ifndef SPINDLE_MAP_UTILS_H_
+#include "spindle/MapUtils.h"
+#endif
+
+#include "pair.h"
+#include "algo.h"
+#include "spindle/spindle_func.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+#ifdef __FUNC__
+#undef __FUNC__
+#endif
+
+static char invalidGraph[] = "Invalid graph detected.";
+static char invalidLevel[] = "Could not create a valid coarse level.";
+
+GraphCoarsener::GraphCoarsener() {
+  incrementInstanceCount( GraphCoarsener::MetaData );
+  reset();
+}
+
+GraphCoarsener::GraphCoarsener( const Graph* graph ) {
+  incrementInstanceCount( GraphCoarsener::MetaData );
+  reset();
+  setGraph( graph );
+}
+
+GraphCoarsener::~GraphCoarsener() {
+  clearLevels();
+  decrementInstanceCount( GraphCoarsener::MetaData );
+}
+
+void
+GraphCoarsener::clearLevels() {
+  {for( int i=0; i<(int)graphs.size(); ++i ) {
+    delete graphs[i];
+  }}
+  {for( int i=0; i<(int)maps.size(); ++i ) {
+    delete maps[i];
+  }}
+  graphs.resize(0);
+  maps.resize(0);
+}
+
+bool
+GraphCoarsener::reset() {
+  algorithmicState = EMPTY;
+  errMsg = 0;
+  sGraph = 0;
+  minCoarseNVtxs = 100;
+  maxNLevels = 32;
+  maxCoarseningRatio = 0.95;
+  executionTimer.reset();
+  clearLevels();
+  return true;
+}
+
+bool
+GraphCoarsener::setGraph( const Graph* graph ) {
+  if ( algorithmicState == INVALID ) { return false; }
+  if ( ( graph == 0 ) || ( !graph->isValid() ) ) {
+    algorithmicState = INVALID;
+    errMsg = invalidGraph;
+    return false;
+  }
+  clearLevels();
+  sGraph = graph;
+  algorithmicState = READY;
+  return true;
+}
+
+bool
+GraphCoarsener::setMinCoarseNVtxs( const int n ) {
+  if ( n < 1 ) { return false; }
+  minCoarseNVtxs = n;
+  return true;
+}
+
+bool
+GraphCoarsener::setMaxNLevels( const int n ) {
+  if ( n < 1 ) { return false; }
+  maxNLevels = n;
+  return true;
+}
+
+bool
+GraphCoarsener::setMaxCoarseningRatio( const float ratio ) {
+  if ( ( ratio <= 0.0 ) || ( ratio > 1.0 ) ) { return false; }
+  maxCoarseningRatio = ratio;
+  return true;
+}
+
+int
+GraphCoarsener::queryNLevels() const {
+  if ( algorithmicState != DONE ) {
+    return 0;
+  }
+  return graphs.size() + 1;
+}
+
+const Graph*
+GraphCoarsener::getGraph( const int level ) const {
+  if ( ( algorithmicState != DONE ) || ( level < 0 ) || ( level > (int)graphs.size() ) ) {
+    return 0;
+  }
+  return ( level == 0 ) ? sGraph : graphs[ level-1 ];
+}
+
+const CompressionMap*
+GraphCoarsener::getCompressionMap( const int level ) const {
+  if ( ( algorithmicState != DONE ) || ( level < 0 ) || ( level >= (int)maps.size() ) ) {
+    return 0;
+  }
+  return maps[ level ];
+}
+
+bool
+GraphCoarsener::execute() {
+  if ( algorithmicState != READY ) { return false; }
+  executionTimer.start();
+  clearLevels();
+
+  const Graph* g = sGraph;
+  SharedArray<int> fine2coarse;
+  while( ( (int)graphs.size() + 1 < maxNLevels ) && ( g->size() > minCoarseNVtxs ) ) {
+    const int n = g->size();
+    fine2coarse.resize( n );
+    const int nCoarse = matchVertices( g, fine2coarse.begin() );
+    if ( nCoarse > maxCoarseningRatio * n ) {
+      break;  // matching has stalled
+    }
+    CompressionMap * cmap = new CompressionMap( n, nCoarse );
+    cmap->getFine2Coarse().import( fine2coarse.lend(), n );
+    cmap->validate();
+    if ( !cmap->isValid() ) {
+      delete cmap;
+      executionTimer.stop();
+      algorithmicState = INVALID;
+      errMsg = invalidLevel;
+      return false;
+    }
+    bool noEdges = false;
+    Graph * cgraph = createCoarseGraph( g, fine2coarse.lend(), nCoarse, noEdges );
+    if ( noEdges ) {
+      // every edge collapsed; nothing left worth ordering at this level
+      delete cmap;
+      break;
+    }
+    if ( cgraph == 0 ) {
+      delete cmap;
+      executionTimer.stop();
+      algorithmicState = INVALID;
+      errMsg = invalidLevel;
+      return false;
+    }
+    maps.push_back( cmap );
+    graphs.push_back( cgraph );
+    g = cgraph;
+  }
+  executionTimer.stop();
+  algorithmicState = DONE;
+  return true;
+}
+
+//
+// Visit the vertices in order.  Each unmatched vertex is matched with
+// the unmatched neighbor it shares the heaviest edge with; ties go to
+// the lighter neighbor so coarse vertex weights stay even.  A vertex
+// with no unmatched neighbor stays alone.  Coarse vertices are numbered
+// in order of their first fine vertex, as GraphCompressor does.
+//
+int
+GraphCoarsener::matchVertices( const Graph* g, int * fine2coarse ) const {
+  const int n = g->size();
+  const int * adjHead = g->getAdjHead().lend();
+  const int * adjList = g->getAdjList().lend();
+  const int * edgeWeight = ( g->getEdgeWeight().size() == adjHead[n] ) ?
+    g->getEdgeWeight().lend() : 0 ;
+  const int * vtxWeight = ( g->getVtxWeight().size() == n ) ?
+    g->getVtxWeight().lend() : 0 ;
+
+  {for( int i=0; i<n; ++i ) {
+    fine2coarse[i] = -1;
+  }}
+  int nCoarse = 0;
+  {for( int i=0; i<n; ++i ) {
+    if ( fine2coarse[i] >= 0 ) {
+      continue;
+    }
+    int best = -1;
+    int bestEdge = 0;
+    int bestVtx = 0;
+    for( int jj=adjHead[i]; jj<adjHead[i+1]; ++jj ) {
+      const int j = adjList[jj];
+      if ( ( j == i ) || ( fine2coarse[j] >= 0 ) ) {
+	continue;
+      }
+      const int ew = ( edgeWeight == 0 ) ? 1 : edgeWeight[jj];
+      const int vw = ( vtxWeight == 0 ) ? 1 : vtxWeight[j];
+      if ( ( best == -1 ) || ( ew > bestEdge ) ||
+	   ( ( ew == bestEdge ) && ( vw < bestVtx ) ) ) {
+	best = j;
+	bestEdge = ew;
+	bestVtx = vw;
+      }
+    }
+    fine2coarse[i] = nCoarse;
+    if ( best >= 0 ) {
+      fine2coarse[best] = nCoarse;
+    }
+    ++nCoarse;
+  }}
+  return nCoarse;
+}
+
+//
+// Adjacencies of all vertices in a group are merged: edges inside the
+// group are dropped, parallel edges to another group become one edge
+// whose weight is their sum.  Returns 0 and sets noEdges if no edges
+// remain, or returns 0 if the coarse graph does not validate.
+//
+Graph*
+GraphCoarsener::createCoarseGraph( const Graph* g, const int * fine2coarse,
+				   const int nCoarse, bool& noEdges ) const {
+  const int n = g->size();
+  const int * adjHead = g->getAdjHead().lend();
+  const int * adjList = g->getAdjList().lend();
+  const int * edgeWeight = ( g->getEdgeWeight().size() == adjHead[n] ) ?
+    g->getEdgeWeight().lend() : 0 ;
+  const int * vtxWeight = ( g->getVtxWeight().size() == n ) ?
+    g->getVtxWeight().lend() : 0 ;
+
+  // list the fine vertices of each coarse vertex
+  vector<int> memberHead( nCoarse + 1, 0 );
+  vector<int> members( n );
+  {for( int i=0; i<n; ++i ) {
+    ++memberHead[ fine2coarse[i] + 1 ];
+  }}
+  {for( int c=0; c<nCoarse; ++c ) {
+    memberHead[c+1] += memberHead[c];
+  }}
+  {
+    vector<int> next( memberHead.begin(), memberHead.end() - 1 );
+    for( int i=0; i<n; ++i ) {
+      members[ next[ fine2coarse[i] ]++ ] = i;
+    }
+  }
+
+  int * cVtxWeight = new int[ nCoarse ];
+  vector<int> cAdjHead( nCoarse + 1 );
+  vector< pair<int,int> > cAdj;    // (coarse neighbor, edge weight)
+  cAdj.reserve( adjHead[n] );
+  vector<int> position( nCoarse, -1 );
+  {for( int c=0; c<nCoarse; ++c ) {
+    const int rowStart = cAdj.size();
+    cAdjHead[c] = rowStart;
+    cVtxWeight[c] = 0;
+    for( int m=memberHead[c]; m<memberHead[c+1]; ++m ) {
+      const int i = members[m];
+      cVtxWeight[c] += ( vtxWeight == 0 ) ? 1 : vtxWeight[i];
+      for( int jj=adjHead[i]; jj<adjHead[i+1]; ++jj ) {
+	const int cj = fine2coarse[ adjList[jj] ];
+	if ( cj == c ) {
+	  continue;  // edge inside the group
+	}
+	const int ew = ( edgeWeight == 0 ) ? 1 : edgeWeight[jj];
+	if ( position[cj] < rowStart ) {
+	  position[cj] = cAdj.size();
+	  cAdj.push_back( pair<int,int>( cj, ew ) );
+	} else {
+	  cAdj[ position[cj] ].second += ew;
+	}
+      }
+    }
+    // Graph::validate() requires sorted adjacency lists
+    sort( cAdj.begin() + rowStart, cAdj.end(), pair_first_less<int,int>() );
+  }}
+  const int cNNZ = cAdj.size();
+  cAdjHead[ nCoarse ] = cNNZ;
+  noEdges = ( cNNZ == 0 );
+  if ( noEdges ) {
+    delete[] cVtxWeight;
+    return 0;
+  }
+
+  int * head = new int[ nCoarse + 1 ];
+  int * list = new int[ cNNZ ];
+  int * cEdgeWeight = new int[ cNNZ ];
+  {for( int c=0; c<=nCoarse; ++c ) {
+    head[c] = cAdjHead[c];
+  }}
+  {for( int k=0; k<cNNZ; ++k ) {
+    list[k] = cAdj[k].first;
+    cEdgeWeight[k] = cAdj[k].second;
+  }}
+  Graph * cgraph = new Graph( nCoarse, head, list, cVtxWeight, cEdgeWeight );
+  cgraph->validate();
+  if ( !cgraph->isValid() ) {
+    delete cgraph;
+    return 0;
+  }
+  return cgraph;
+}
+
+PermutationMap*
+GraphCoarsener::createFinePermutation( const PermutationMap* perm,
+				       const int level ) const {
+  if ( ( algorithmicState != DONE ) || ( perm == 0 ) || ( !perm->isValid() ) ||
+       ( level < 0 ) || ( level > (int)maps.size() ) ) {
+    return 0;
+  }
+  PermutationMap * cur = new PermutationMap( *perm );
+  for( int l=level-1; l>=0; --l ) {
+    PermutationMap * finer = MapUtils::createUncompressedPermutationMap( cur, maps[l] );
+    delete cur;
+    if ( finer == 0 ) {
+      return 0;
+    }
+    cur = finer;
+  }
+  return cur;
+}
+
+bool
+GraphCoarsener::projectToFine( const int level, const int * coarseValues,
+			       int * fineValues ) const {
+  if ( ( algorithmicState != DONE ) || ( coarseValues == 0 ) || ( fineValues == 0 ) ||
+       ( level < 0 ) || ( level > (int)maps.size() ) ) {
+    return false;
+  }
+  if ( level == 0 ) {
+    const int n = sGraph->size();
+    {for( int i=0; i<n; ++i ) {
+      fineValues[i] = coarseValues[i];
+    }}
+    return true;
+  }
+  vector<int> values( coarseValues, coarseValues + maps[level-1]->queryNCompressed() );
+  vector<int> finer;
+  for( int l=level-1; l>=0; --l ) {
+    const int nFine = maps[l]->queryNUncompressed();
+    const int * fine2coarse = maps[l]->getFine2Coarse().lend();
+    finer.resize( nFine );
+    {for( int i=0; i<nFine; ++i ) {
+      finer[i] = values[ fine2coarse[i] ];
+    }}
+    values.swap( finer );
+  }
+  {for( int i=0; i<(int)values.size(); ++i ) {
+    fineValues[i] = values[i];
+  }}
+  return true;
+}
+
+SPINDLE_IMPLEMENT_DYNAMIC( GraphCoarsener, SpindleAlgorithm )
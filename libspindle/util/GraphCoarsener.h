@@ -0,0 +1,156 @@
+//
+// GraphCoarsener.h
+//
+// $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+//
+
+#ifndef SPINDLE_GRAPH_COARSENER_H_
+#define SPINDLE_GRAPH_COARSENER_H_
+
+#ifndef SPINDLE_SYSTEM_H_
+#include "spindle/SpindleSystem.h"
+#endif
+
+#ifndef SPINDLE_ALGORITHM_H_
+#include "spindle/SpindleAlgorithm.h"
+#endif
+
+#ifndef SPINDLE_GRAPH_H_
+#include "spindle/Graph.h"
+#endif
+
+#ifndef SPINDLE_COMPRESSION_MAP_H_
+#include "spindle/CompressionMap.h"
+#endif
+
+#ifndef SPINDLE_PERMUTATION_MAP_H_
+#include "spindle/PermutationMap.h"
+#endif
+
+#ifdef REQUIRE_OLD_CXX_HEADER_SUFFIX
+#include "vector.h"
+#else
+#include <vector>
+using std::vector;
+#endif
+
+SPINDLE_BEGIN_NAMESPACE
+
+/**
+ * @memo builds a multilevel hierarchy of coarse graphs by heavy edge matching
+ * @type class
+ *
+ * Where #GraphCompressor# only merges indistinguishable vertices, this
+ * class merges each vertex with the unmatched neighbor it shares the
+ * heaviest edge with, which roughly halves the graph at every level
+ * whatever its structure.  Level 0 is the input graph; level #i+1# is
+ * built from level #i# and is related to it by a #CompressionMap#.
+ *
+ * Every coarse graph carries vertex weights (the number of original
+ * vertices, or the sum of the original weights) and edge weights (the
+ * number of original edges, or the sum of their weights, between the two
+ * groups).  Missing weights on the input graph count as 1.
+ *
+ * Coarsening stops when a level has at most #minCoarseNVtxs# vertices,
+ * when a level shrinks by less than #maxCoarseningRatio#, when
+ * #maxNLevels# levels exist, or when a coarse graph would have no edges.
+ *
+ * An ordering computed on a coarse level is carried back to the input
+ * graph with #createFinePermutation()#, which numbers the vertices that
+ * make up each coarse vertex consecutively.  Vertex labels (e.g.
+ * partitions) are carried back with #projectToFine()#.
+ *
+ * @see GraphCompressor
+ * @see CompressionMap
+ * @author agent
+ * @version #$Id$#
+ */
+class GraphCoarsener : public SpindleAlgorithm {
+private:
+  const Graph* sGraph;                // source graph (level 0)
+  vector< Graph* > graphs;            // graphs[i] is level i+1
+  vector< CompressionMap* > maps;     // maps[i] is level i to level i+1
+  int minCoarseNVtxs;
+  int maxNLevels;
+  float maxCoarseningRatio;
+  stopwatch executionTimer;
+
+  void clearLevels();
+  int matchVertices( const Graph* g, int * fine2coarse ) const;
+  Graph* createCoarseGraph( const Graph* g, const int * fine2coarse,
+			    const int nCoarse, bool& noEdges ) const;
+
+public:
+  /** default constructor */
+  GraphCoarsener();
+  /** convenience constructor */
+  GraphCoarsener( const Graph* graph );
+  /** destructor, deletes all coarse graphs and maps */
+  virtual ~GraphCoarsener();
+
+  /** set the graph to coarsen */
+  bool setGraph( const Graph* graph );
+
+  /** stop once a level has at most this many vertices (default 100) */
+  bool setMinCoarseNVtxs( const int n );
+  /** create at most this many levels, counting the input (default 32) */
+  bool setMaxNLevels( const int n );
+  /**
+   * stop once a level has more than #ratio# times the vertices of the
+   * level it was built from (default 0.95)
+   */
+  bool setMaxCoarseningRatio( const float ratio );
+
+  /**
+   * build the levels.  Returns false, and becomes INVALID, if a coarse
+   * map or graph fails to validate.
+   */
+  virtual bool execute();
+  virtual bool reset();
+
+  /** number of levels, including the input graph, or 0 if not done */
+  int queryNLevels() const;
+
+  /** grant const access to a level, 0 is the input graph */
+  const Graph* getGraph( const int level ) const;
+
+  /** grant const access to the map from #level# to #level+1# */
+  const CompressionMap* getCompressionMap( const int level ) const;
+
+  /**
+   * create a permutation on the input graph from a permutation #perm# of
+   * level #level#.  The caller owns the result.  Returns 0 on error.
+   */
+  PermutationMap* createFinePermutation( const PermutationMap* perm,
+					 const int level ) const;
+
+  /**
+   * copy a value per vertex of level #level# to every input vertex it
+   * contains.  #fineValues# must have room for the input graph.
+   */
+  bool projectToFine( const int level, const int * coarseValues,
+		      int * fineValues ) const;
+
+  const stopwatch& getExecutionTimer() const { return executionTimer; }
+
+  SPINDLE_DECLARE_DYNAMIC( GraphCoarsener )
+
+};
+
+SPINDLE_END_NAMESPACE
+
+#endif
@@ -141,65 +141,181 @@ GraphCompressor::createCompressedGraph()  {
 #undef __FUNC__
 
 
+//
+// order independent hash of one vertex index.  Mixing each index before
+// summing keeps e.g. {1,4} and {2,3} apart, which the plain sum of the
+// indices did not; on meshes that put most vertices in a few huge buckets.
+//
+static inline unsigned int
+hashVertex( unsigned int x ) {
+  x ^= x >> 16;
+  x *= 0x85ebca6bU;
+  x ^= x >> 13;
+  x *= 0xc2b2ae35U;
+  x ^= x >> 16;
+  return x;
+}
+
+//
+// sort vals[] by keys[] with three stable counting passes of 11 bits.
+// Both arrays are permuted; work arrays are supplied by the caller.
+//
+static void
+radixSort( const int n, unsigned int * keys, int * vals,
+	   unsigned int * keysWork, int * valsWork ) {
+  const int radixBits = 11;
+  const int radix = 1 << radixBits;
+  vector<int> count( radix );
+  for( int shift=0; shift<32; shift+=radixBits ) {
+    {for( int d=0; d<radix; ++d ) {
+      count[d] = 0;
+    }}
+    {for( int i=0; i<n; ++i ) {
+      ++count[ ( keys[i] >> shift ) & ( radix-1 ) ];
+    }}
+    int sum = 0;
+    {for( int d=0; d<radix; ++d ) {
+      const int c = count[d];
+      count[d] = sum;
+      sum += c;
+    }}
+    {for( int i=0; i<n; ++i ) {
+      const int pos = count[ ( keys[i] >> shift ) & ( radix-1 ) ]++;
+      keysWork[pos] = keys[i];
+      valsWork[pos] = vals[i];
+    }}
+    {for( int i=0; i<n; ++i ) {
+      keys[i] = keysWork[i];
+      vals[i] = valsWork[i];
+    }}
+  }
+}
+
+bool
+GraphCompressor::setNThreads( const int nThreads ) {
+  return team.setNThreads( nThreads );
+}
+
 int
 GraphCompressor::createCompressionMap() {
   //
   // initialize data
   //
-  typedef vector< pair< int , int > > SorterType;
-
   const int n = sGraph->size();
   const int * adjHead = sGraph->getAdjHead().lend();
   const int * adjList = sGraph->getAdjList().lend();
-  int curCompressedVtx = 0;
-  SorterType sorter;
 
-  sorter.reserve(n);
   fine2Coarse.resize( n );
   fine2Coarse.init( -1 );
   temp.resize( n );
   temp.init(-1);
 
   // hash the adjacency lists
-  { 
-    // purify complains here using egcs 1.1.x.  Don't know why
-    for( int i=0; i<n; ++i ) {
-      int hashValue = (adjHead[i] == adjHead[i+1]) ? 0 : i+1;
-      // if item has no adjacencies, mark its hash value as 0.
-      // Thus, they will all get merged into one node
-      for( int jj=adjHead[i]; jj<adjHead[i+1]; ++jj ) {
-	hashValue += (adjList[jj] + 1) ;  // add one to distinguish from zero
-      }
-      sorter.push_back( pair<int,int>( hashValue, i ) );
+  vector<unsigned int> hashValue( n );
+  sortedVtxs.resize( n );
+  {for( int i=0; i<n; ++i ) {
+    // if item has no adjacencies, mark its hash value as 0.
+    unsigned int h = (adjHead[i] == adjHead[i+1]) ? 0 : hashVertex( i+1 );
+    for( int jj=adjHead[i]; jj<adjHead[i+1]; ++jj ) {
+      h += hashVertex( adjList[jj] + 1 );  // add one to distinguish from zero
     }
-  }
+    hashValue[i] = h;
+    sortedVtxs[i] = i;
+  }}
 
   //
   // Sort the vertices by their hash number
   //
-  sort( sorter.begin(), sorter.end(),  pair_first_less< int , int >() );
+  {
+    vector<unsigned int> keysWork( n );
+    vector<int> valsWork( n );
+    radixSort( n, &hashValue[0], &sortedVtxs[0], &keysWork[0], &valsWork[0] );
+  }
 
-  // 
-  // Now examine pairs of vertices with the same hash value
   //
-  SorterType::const_iterator cur = sorter.begin();
-  SorterType::const_iterator candidate;
-  SorterType::const_iterator stop = sorter.end();
-  int * adjTo = temp.begin();
-
-  for( ; cur != stop; ++cur ) {  // for all vtxs in sorter
-    int i = (*cur).second;
-    if ( fine2Coarse[i] >= 0 ) { // skip if its already been mapped
-      continue; 
+  // Find the runs of vertices with the same hash value.  Each run is
+  // checked independently of the others.
+  //
+  bucketBegin.resize(0);
+  bucketEnd.resize(0);
+  {for( int i=0; i<n; ) {
+    int j = i+1;
+    while( ( j<n ) && ( hashValue[j] == hashValue[i] ) ) {
+      ++j;
+    }
+    if ( j-i > 1 ) {
+      bucketBegin.push_back( i );
+      bucketEnd.push_back( j );
     }
-    fine2Coarse[i] = curCompressedVtx;
-    int hash_i = (*cur).first;   // get hash value for current
-    int nadj_i = adjHead[i+1] - adjHead[i];
+    i = j;
+  }}
+  const int nThreads = team.queryNThreads();
+  threadAdjTo.resize( nThreads - 1 );
+  {for( int t=0; t<nThreads-1; ++t ) {
+    threadAdjTo[t].resize( n );
+    {for( int i=0; i<n; ++i ) {
+      threadAdjTo[t][i] = -1;
+    }}
+  }}
+  team.run( verifyBucketsTask, this, bucketBegin.size() );
+
+  //
+  // Now every vertex is mapped to the first vertex of its group (or
+  // nothing, if it is alone).  Number the groups in order of appearance.
+  //
+  int * newNumber = temp.begin();
+  {for( int i=0; i<n; ++i ) {
+    newNumber[i] = -1;
+  }}
+  int curCompressedVtx = 0;
+  {for( int i=0; i<n; ++i ) {
+    const int rep = ( fine2Coarse[i] < 0 ) ? i : fine2Coarse[i];
+    if ( newNumber[ rep ] < 0 ) {
+      newNumber[ rep ] = curCompressedVtx++;
+    }
+    fine2Coarse[i] = newNumber[ rep ];
+  }}
+  threadAdjTo.resize(0);
+  return curCompressedVtx;
+}
+
+void
+GraphCompressor::verifyBucketsTask( void * arg, const int begin, const int end,
+				    const int threadID ) {
+  GraphCompressor * gc = (GraphCompressor *) arg;
+  int * adjTo = ( threadID == 0 ) ? gc->temp.begin() : &(gc->threadAdjTo[ threadID-1 ][0]);
+  for( int b=begin; b<end; ++b ) {
+    gc->verifyBucket( gc->bucketBegin[b], gc->bucketEnd[b], adjTo );
+  }
+}
+
+//
+// examine the vertices sortedVtxs[begin,end), which all have the same
+// hash value.  Sets fine2Coarse[j] = i when j is indistinguishable from
+// an earlier vertex i of the run.  Reads and writes only vertices of this
+// run and the scatter array adjTo, so runs can be checked concurrently.
+//
+void
+GraphCompressor::verifyBucket( const int begin, const int end, int * adjTo ) {
+  const int * adjHead = sGraph->getAdjHead().lend();
+  const int * adjList = sGraph->getAdjList().lend();
+  int * fine2coarse = fine2Coarse.begin();
+  const int * vtx = &sortedVtxs[0];
+
+  for( int cur=begin; cur<end; ++cur ) {  // for all vtxs in the run
+    const int i = vtx[cur];
+    if ( fine2coarse[i] >= 0 ) { // skip if its already been mapped
+      continue;
+    }
+    fine2coarse[i] = i;
+    const int nadj_i = adjHead[i+1] - adjHead[i];
     bool scatteredAdjList = false; // 
-    for( candidate = cur + 1;( candidate != stop) && ( hash_i == (*candidate).first )  ;
-	 ++candidate ) { 
-      // for all other vertices in sorter with same hash value
-      int j = (*candidate).second;
+    for( int candidate=cur+1; candidate<end; ++candidate ) {
+      // for all other vertices in the run
+      const int j = vtx[candidate];
+      if ( fine2coarse[j] >= 0 ) {
+	continue;
+      }
       if ( nadj_i != (adjHead[j+1] - adjHead[j]) ) { 
 	// if i and j don't have same size adjlist
 	continue;  // j cannot be compressed into i
@@ -223,12 +339,10 @@ GraphCompressor::createCompressionMap() {
 	}
       }}
       if ( compressThem == true ) { 
-	fine2Coarse[j] = curCompressedVtx;
+	fine2coarse[j] = i;
       }
     } // end for all candidates of the same  hash value
-    ++curCompressedVtx;
   } // end for all vertices
-  return curCompressedVtx;
 }
     
 /*
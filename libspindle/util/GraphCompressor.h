@@ -49,6 +49,10 @@
 #include "spindle/PermutationMap.h"
 #endif
 
+#ifndef SPINDLE_THREAD_TEAM_H_
+#include "spindle/ThreadTeam.h"
+#endif
+
 #ifdef REQUIRE_OLD_CXX_HEADER_SUFFIX
 #include "vector.h"
 #else
@@ -67,9 +71,19 @@ private:
   stopwatch executionTimer;
   stopwatch cGraphCreationTimer;
 
+  ThreadTeam team;                // verifies hash buckets concurrently
+  vector<int> sortedVtxs;         // vertices sorted by hash value
+  vector<int> bucketBegin;        // runs of sortedVtxs with equal hash
+  vector<int> bucketEnd;          //   (only runs of two or more)
+  vector< vector<int> > threadAdjTo; // scatter arrays for threads 1,2,...
+
 public:
   GraphCompressor();
 
+  // verification of hash buckets is spread over this many threads
+  bool setNThreads( const int nThreads );
+  int queryNThreads() const { return team.queryNThreads(); }
+
   bool setGraph(const Graph* SGraph);
   Graph* createCompressedGraph();
 
@@ -85,6 +99,9 @@ public:
 
 private:
   int createCompressionMap();
+  static void verifyBucketsTask( void * arg, const int begin, const int end,
+				 const int threadID );
+  void verifyBucket( const int begin, const int end, int * adjTo );
   int permuteCompressionMap();
   int computeCompressedGraphStorage() const ;
   bool computeCompressedGraphIndices( Graph* cgraph ) const ;
@@ -0,0 +1,227 @@
+//
+// MultifrontalAnalysis.cc
+//
+// $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+//
+
+#include "spindle/MultifrontalAnalysis.h"
+
+#ifndef SPINDLE_SYMBOLIC_FACTORIZATION_H_
+#include "spindle/SymbolicFactorization.h"
+#endif
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+static char invalidSymbFact[] = "Symbolic factorization is not done.";
+static char invalidPerm[] = "Could not create a valid permutation.";
+
+MultifrontalAnalysis::MultifrontalAnalysis() {
+  incrementInstanceCount( MultifrontalAnalysis::MetaData );
+  perm = 0;
+  reset();
+}
+
+MultifrontalAnalysis::MultifrontalAnalysis( const SymbolicFactorization* sf ) {
+  incrementInstanceCount( MultifrontalAnalysis::MetaData );
+  perm = 0;
+  reset();
+  setSymbolicFactorization( sf );
+}
+
+MultifrontalAnalysis::~MultifrontalAnalysis() {
+  delete perm;
+  decrementInstanceCount( MultifrontalAnalysis::MetaData );
+}
+
+bool
+MultifrontalAnalysis::reset() {
+  algorithmicState = EMPTY;
+  errMsg = 0;
+  symbfact = 0;
+  flops = 0.0;
+  peakStackSize = 0;
+  optimalPeakStackSize = 0;
+  delete perm;
+  perm = 0;
+  return true;
+}
+
+bool
+MultifrontalAnalysis::setSymbolicFactorization( const SymbolicFactorization* sf ) {
+  if ( algorithmicState == INVALID ) { return false; }
+  if ( ( sf == 0 ) || ( ! sf->isDone() ) ) {
+    algorithmicState = INVALID;
+    errMsg = invalidSymbFact;
+    return false;
+  }
+  symbfact = sf;
+  algorithmicState = READY;
+  return true;
+}
+
+const PermutationMap*
+MultifrontalAnalysis::getPermutation() const {
+  return ( algorithmicState == DONE ) ? perm : 0;
+}
+
+//
+// Liu's recurrence for the peak of the subtree rooted at a supernode
+// whose children, visited in the order [first,last), have the given
+// subtree peaks and update matrices.
+//
+static long
+subtreePeak( const int * first, const int * last, const long * peak,
+	     const long * update, const long front ) {
+  long stack = 0;      // update matrices of the children done so far
+  long sPeak = 0;
+  for( const int * c=first; c<last; ++c ) { 
+    if ( stack + peak[*c] > sPeak ) { 
+      sPeak = stack + peak[*c];
+    }
+    stack += update[*c];
+  }
+  if ( stack + front > sPeak ) { 
+    sPeak = stack + front;
+  }
+  return sPeak;
+}
+
+bool
+MultifrontalAnalysis::execute() {
+  if ( algorithmicState != READY ) { return false; }
+
+  const int n = symbfact->getColCount().size();
+  const int nSuper = symbfact->queryNSupernodes();
+  const int * begin = symbfact->getSupernodeBegin().lend();
+  const int * parent = symbfact->getSupernodeParent().lend();
+  const int * nRows = symbfact->getSupernodeNRows().lend();
+
+  // sizes of the frontal and update matrices, and the flop count
+  SharedArray<long> front( nSuper );
+  SharedArray<long> update( nSuper );
+  flops = 0.0;
+  {for( int s=0; s<nSuper; ++s ) { 
+    const long m = nRows[s];
+    const long w = begin[s+1] - begin[s];
+    front[s] = ( m * ( m+1 ) ) / 2;
+    update[s] = ( ( m-w ) * ( m-w+1 ) ) / 2;
+    for( long k=0; k<w; ++k ) { 
+      const double c = m - k;
+      flops += ( c-1.0 ) * ( c+2.0 );
+    }
+  }}
+
+  // children of each supernode, in increasing order
+  SharedArray<int> childHead( nSuper+1 );
+  SharedArray<int> childList( nSuper );
+  childHead.init( 0 );
+  {for( int s=0; s<nSuper; ++s ) { 
+    if ( parent[s] != -1 ) { 
+      childHead[ parent[s]+1 ]++;
+    }
+  }}
+  {for( int s=0; s<nSuper; ++s ) { 
+    childHead[s+1] += childHead[s];
+  }}
+  {
+    SharedArray<int> next( nSuper );
+    next.import( childHead.lend(), nSuper );
+    {for( int s=0; s<nSuper; ++s ) { 
+      if ( parent[s] != -1 ) { 
+	childList[ next[ parent[s] ]++ ] = s;
+      }
+    }}
+  }
+
+  // Children are numbered before their parents, so one sweep gives
+  // every subtree peak.  Roots leave nothing on the stack, so the peak
+  // of the forest is the largest peak of a tree.
+  SharedArray<long> peak( nSuper );
+  int * child = childList.begin();
+  peakStackSize = 0;
+  {for( int s=0; s<nSuper; ++s ) { 
+    peak[s] = subtreePeak( child + childHead[s], child + childHead[s+1],
+			   peak.lend(), update.lend(), front[s] );
+    if ( peak[s] > peakStackSize ) { 
+      peakStackSize = peak[s];
+    }
+  }}
+
+  // Again, with the children of each supernode sorted by decreasing
+  // peak minus update matrix.  The children's peaks are already the 
+  // optimal ones when their parent is sorted.  Ties keep the postorder.
+  optimalPeakStackSize = 0;
+  {for( int s=0; s<nSuper; ++s ) { 
+    {for( int k=childHead[s]+1; k<childHead[s+1]; ++k ) { 
+      const int c = child[k];
+      const long key = peak[c] - update[c];
+      int kk = k;
+      while ( ( kk > childHead[s] ) 
+	      && ( peak[ child[kk-1] ] - update[ child[kk-1] ] < key ) ) { 
+	child[kk] = child[kk-1];
+	--kk;
+      }
+      child[kk] = c;
+    }}
+    peak[s] = subtreePeak( child + childHead[s], child + childHead[s+1],
+			   peak.lend(), update.lend(), front[s] );
+    if ( peak[s] > optimalPeakStackSize ) { 
+      optimalPeakStackSize = peak[s];
+    }
+  }}
+
+  // Postorder the supernodal tree with the new child order and list the
+  // columns of each supernode.  The roots keep their order.
+  delete perm;
+  perm = new PermutationMap( n );
+  int * new2old = perm->getNew2Old().begin();
+  const int * sfNew2Old = symbfact->getPermutationMap()->getNew2Old().lend();
+  SharedArray<int> stack( nSuper );
+  SharedArray<int> nextChild( nSuper );
+  int pos = 0;
+  {for( int root=0; root<nSuper; ++root ) { 
+    if ( parent[root] != -1 ) { continue; }
+    int top = 0;
+    stack[top] = root;
+    nextChild[root] = childHead[root];
+    while ( top >= 0 ) { 
+      const int s = stack[top];
+      if ( nextChild[s] < childHead[s+1] ) { 
+	const int c = childList[ nextChild[s]++ ];
+	stack[ ++top ] = c;
+	nextChild[c] = childHead[c];
+      } else { 
+	for( int jj=begin[s]; jj<begin[s+1]; ++jj ) { 
+	  new2old[ pos++ ] = sfNew2Old[jj];
+	}
+	--top;
+      }
+    }
+  }}
+  perm->validate();
+  if ( ( pos != n ) || ( ! perm->isValid() ) ) { 
+    algorithmicState = INVALID;
+    errMsg = invalidPerm;
+    return false;
+  }
+  algorithmicState = DONE;
+  return true;
+}
+
+SPINDLE_IMPLEMENT_DYNAMIC( MultifrontalAnalysis, SpindleAlgorithm )
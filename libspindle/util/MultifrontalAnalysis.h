@@ -0,0 +1,116 @@
+//
+// MultifrontalAnalysis.h
+//
+// $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+//
+
+#ifndef SPINDLE_MULTIFRONTAL_ANALYSIS_H_
+#define SPINDLE_MULTIFRONTAL_ANALYSIS_H_
+
+#ifndef SPINDLE_H_
+#include "spindle/spindle.h"
+#endif
+
+#ifndef SPINDLE_ALGORITHM_H_
+#include "spindle/SpindleAlgorithm.h"
+#endif
+
+#ifndef SPINDLE_AUTO_ARRAY_H_
+#include "spindle/SharedArray.h"
+#endif
+
+#ifndef SPINDLE_PERMUTATION_H_
+#include "spindle/PermutationMap.h"
+#endif
+
+SPINDLE_BEGIN_NAMESPACE
+
+class SymbolicFactorization;
+
+/**
+ * @memo predicts the cost of a multifrontal factorization
+ * @type class
+ *
+ * Given a #SymbolicFactorization# that is done, this class computes the
+ * number of floating point operations for a Cholesky factorization with
+ * the supernode partition it holds (explicit zeros of relaxed supernodes
+ * included) and the peak size of the stack of update matrices in a
+ * multifrontal factorization.
+ *
+ * Each supernode is assembled into a dense frontal matrix with as many
+ * rows as its dense block.  What is left after eliminating the
+ * supernode's columns is its update matrix, which stays on the stack
+ * until the parent is assembled.  Sizes are in entries of the lower
+ * triangles.  While a supernode is assembled, its frontal matrix and the
+ * update matrices of all its children are in memory.
+ *
+ * The stack depends on the order in which the children of each supernode
+ * are visited.  #queryPeakStackSize()# is for the postorder the symbolic
+ * factorization uses.  #queryOptimalPeakStackSize()# is for the order of
+ * Liu (ACM TOMS 12(3), 1986), which visits the children by decreasing
+ * difference of their subtree peak and update matrix.
+ * #getPermutation()# gives that order as a permutation of the original
+ * graph.  It is an equivalent reordering: the factor is the same size.
+ *
+ * @see SymbolicFactorization
+ * @author agent
+ * @version #$Id$#
+ */
+class MultifrontalAnalysis : public SpindleAlgorithm {
+private:
+  const SymbolicFactorization* symbfact;
+  double flops;
+  long peakStackSize;
+  long optimalPeakStackSize;
+  PermutationMap* perm;
+
+public:
+  /** default constructor */
+  MultifrontalAnalysis();
+  /** convenience constructor */
+  MultifrontalAnalysis( const SymbolicFactorization* sf );
+  /** destructor */
+  virtual ~MultifrontalAnalysis();
+
+  /** set the symbolic factorization, which must be done */
+  bool setSymbolicFactorization( const SymbolicFactorization* sf );
+
+  virtual bool execute();
+  virtual bool reset();
+
+  /** floating point operations, counted as in #SymbolicFactorization::queryWork()# */
+  double queryFlops() const { return flops; }
+
+  /** peak stack size (in entries) for the symbolic factorization's postorder */
+  long queryPeakStackSize() const { return peakStackSize; }
+
+  /** peak stack size (in entries) with the children in Liu's order */
+  long queryOptimalPeakStackSize() const { return optimalPeakStackSize; }
+
+  /** 
+   * the new2old permutation of the original graph that visits the 
+   * children in Liu's order, or 0 if not done 
+   */
+  const PermutationMap* getPermutation() const;
+
+  SPINDLE_DECLARE_DYNAMIC( MultifrontalAnalysis )
+
+};
+
+SPINDLE_END_NAMESPACE
+
+#endif
@@ -34,6 +34,10 @@ using namespace std;
 #include "spindle/Graph.h"
 #endif
 
+#ifndef SPINDLE_PACKED_GRAPH_H_
+#include "spindle/PackedGraph.h"
+#endif
+
 #ifndef SPINDLE_BFS_H_
 #include "spindle/BreadthFirstSearch.h"
 #endif
@@ -50,6 +54,7 @@ SPINDLE_IMPLEMENT_DYNAMIC( PseudoDiameter, SpindleAlgorithm )
 
 PseudoDiameter::PseudoDiameter() {
   g = 0;
+  pg = 0;
   shrinkingStrategy = 0;
   forwardBFS = 0;
   reverseBFS = 0;
@@ -58,6 +63,7 @@ PseudoDiameter::PseudoDiameter() {
 
 PseudoDiameter::PseudoDiameter( const Graph* graph ) {
   g = 0;
+  pg = 0;
   shrinkingStrategy = 0;
   forwardBFS = 0;
   reverseBFS = 0;
@@ -75,6 +81,9 @@ PseudoDiameter::~PseudoDiameter() {
   if ( shrinkingStrategy != 0 ) {
     delete shrinkingStrategy;
   }
+  {for( int i=0; i<(int) candidateBFS.size(); ++i ) {
+    delete candidateBFS[i];
+  }}
 }
 
 bool  
@@ -82,6 +91,7 @@ PseudoDiameter::reset(){
   errMsg = 0;
   algorithmicState = EMPTY;
   g = 0;
+  pg = 0;
   nVtxs = 0;
   root = -1;
   startVtx = -1;
@@ -97,6 +107,8 @@ PseudoDiameter::reset(){
   partition = 0;
   curPartition = -1;
   partitionMembership = strict;
+  nCandidateThreads = 1;
+  candidateStats.resize(0);
 
   if ( shrinkingStrategy == 0 ) {
     ReidScottShrinkingStrategy *reidScott = new ReidScottShrinkingStrategy();
@@ -123,9 +135,46 @@ PseudoDiameter::setGraph( const Graph* graph ) {
     return false;
   } else if ( graph->isValid() ) {
     g = graph;
+    pg = 0;
     nVtxs = g->size();
     forwardBFS->setGraph( g );
     reverseBFS->setGraph( g );
+    // a bound from the last graph means nothing for this one
+    forwardBFS->disableShortCircuiting();
+    reverseBFS->disableShortCircuiting();
+    {for( int i=0; i<(int) candidateBFS.size(); ++i ) {
+      candidateBFS[i]->setGraph( g );
+    }}
+    if ( algorithmicState == DONE ) {
+      // if setting the graph after a run, 
+      // the previous root becomes invalid
+      root = -1;
+    }
+    algorithmicState = READY;
+    return true;
+  } else { 
+    algorithmicState = INVALID;
+    errMsg = invalidGraph;
+    return false; 
+  }
+}
+
+bool
+PseudoDiameter::setGraph( const PackedGraph* graph ) {
+  if ( algorithmicState == INVALID ) {
+    return false;
+  } else if ( graph->isValid() ) {
+    g = 0;
+    pg = graph;
+    nVtxs = pg->size();
+    forwardBFS->setGraph( pg );
+    reverseBFS->setGraph( pg );
+    // a bound from the last graph means nothing for this one
+    forwardBFS->disableShortCircuiting();
+    reverseBFS->disableShortCircuiting();
+    {for( int i=0; i<(int) candidateBFS.size(); ++i ) {
+      candidateBFS[i]->setGraph( pg );
+    }}
     if ( algorithmicState == DONE ) {
       // if setting the graph after a run, 
       // the previous root becomes invalid
@@ -140,6 +189,11 @@ PseudoDiameter::setGraph( const Graph* graph ) {
   }
 }
 
+int
+PseudoDiameter::deg( const int i ) const {
+  return ( pg != 0 ) ? pg->deg( i ) : g->deg( i );
+}
+
 bool
 PseudoDiameter::setRoot( const int new_root ) {
   switch ( algorithmicState ) {
@@ -205,6 +259,10 @@ PseudoDiameter::enablePartitionRestrictions( const int partitionMap[], Partition
     forwardBFS->enablePartitionRestrictions( partitionMap, BreadthFirstSearch::loose );
     reverseBFS->enablePartitionRestrictions( partitionMap, BreadthFirstSearch::loose );
   }
+  {for( int i=0; i<(int) candidateBFS.size(); ++i ) {
+    candidateBFS[i]->enablePartitionRestrictions( partitionMap, ( partitionMembership == strict ) ? 
+						  BreadthFirstSearch::strict : BreadthFirstSearch::loose );
+  }}
   return true; 
 }
 
@@ -215,6 +273,29 @@ PseudoDiameter::disablePartitionRestrictions( ) {
   partition = 0; // NOTE:  PseudoDiameter does not own partition vector
   forwardBFS->disablePartitionRestrictions();
   reverseBFS->disablePartitionRestrictions();
+  {for( int i=0; i<(int) candidateBFS.size(); ++i ) {
+    candidateBFS[i]->disablePartitionRestrictions();
+  }}
+  return true;
+}
+
+bool
+PseudoDiameter::setNThreads( const int nThreads ) {
+  if ( algorithmicState == INVALID ) { return false; }
+  return forwardBFS->setNThreads( nThreads ) && reverseBFS->setNThreads( nThreads );
+}
+
+int
+PseudoDiameter::queryNThreads() const {
+  return forwardBFS->queryNThreads();
+}
+
+bool
+PseudoDiameter::setNCandidateThreads( const int nThreads ) {
+  if ( algorithmicState == INVALID ) { return false; }
+  if ( !candidateTeam.setNThreads( nThreads ) ) { return false; }
+  candidateTeam.setMinChunkSize( 1 );
+  nCandidateThreads = nThreads;
   return true;
 }
 
@@ -242,11 +323,11 @@ bool PseudoDiameter::execute() {
   if ( root == -1 ) {
     if ( partition == 0 ) {  // if no partition restrictions, try each node
       int min_idx = 0;
-      int min_deg = g->deg(min_idx);
+      int min_deg = deg(min_idx);
       for (int i=1; i<nVtxs; i++) {
-	if ( g->deg(i) < min_deg ) {
+	if ( deg(i) < min_deg ) {
 	  min_idx = i;
-	  min_deg = g->deg(min_idx);
+	  min_deg = deg(min_idx);
 	}
       }
       root = min_idx;
@@ -254,9 +335,9 @@ bool PseudoDiameter::execute() {
       int min_idx = -1;
       int min_deg = INT_MAX;
       for (int i=1; i<nVtxs; i++) {
-	if ( (partition[i] == curPartition)  && (g->deg(i) < min_deg ) ){
+	if ( (partition[i] == curPartition)  && (deg(i) < min_deg ) ){
 	  min_idx = i;
-	  min_deg = g->deg(min_idx);
+	  min_deg = deg(min_idx);
 	}
       }
       if ( min_idx == -1 ) { 
@@ -294,9 +375,10 @@ bool PseudoDiameter::run() {
   // 1. initialization
   //
   startVtx = root;
+  candidateStats.resize(0);
   candidates.reserve( nVtxs );
   endVtx = -1;  // NOTE:  endVtx = -1 indicates that an adequate endVtx is not found
-  if(g->deg(root) == 0) { // if root vertex is not connected to anything.
+  if(deg(root) == 0) { // if root vertex is not connected to anything.
     endVtx = root; 
     nVisited = 1;
     return true;
@@ -374,11 +456,19 @@ bool PseudoDiameter::run() {
     } // end if ( partition != 0 && partitionMembership == loose
 	
     // now shrink the list of strict members to the partition to a smaller list of candidates
-    shrinkingStrategy->shrink( vtx_begin, vtx_end, g, candidates );  // loads candidates
+    if ( pg != 0 ) { 
+      shrinkingStrategy->shrink( vtx_begin, vtx_end, pg, candidates );  // loads candidates
+    } else { 
+      shrinkingStrategy->shrink( vtx_begin, vtx_end, g, candidates );  // loads candidates
+    }
 
     //
     // 6. For each candidate vertex in ``candidates'' do a backward BFS
     //
+    if ( ( nCandidateThreads > 1 ) && ( candidates.size() > 1 ) ) {
+      chk = searchCandidates( maxHeight, minWidth, justswapped ); if (chk==false) { return false; }
+      continue;
+    }
     for(vector<int>::const_iterator start=candidates.begin(), stop=candidates.end();
 	start != stop; ++start) {
       int candidate = *start;
@@ -390,6 +480,12 @@ bool PseudoDiameter::run() {
       chk = reverseBFS->setRoot(candidate); if (chk==false) { return false; }
       chk = reverseBFS->execute();          if (chk==false) { return false; }
       nBFS++;
+      CandidateStats stats;
+      stats.vtx = candidate;
+      stats.height = reverseBFS->queryHeight();
+      stats.width = reverseBFS->queryWidth();
+      stats.shortCircuited = reverseBFS->hasShortCircuited();
+      candidateStats.push_back( stats );
       
       // 6.a.  if backward bfs short circuited, continue
       if (reverseBFS->hasShortCircuited()) {
@@ -441,9 +537,160 @@ bool PseudoDiameter::run() {
   return true;
 }
 
+//
+// shared state of the concurrent searches from the candidates
+//
+struct CandidateSearches { 
+  const int * candidates;
+  BreadthFirstSearch ** bfs;
+  volatile int * bound;    // bound[c] is the narrowest earlier finished search
+  bool * ok;
+  int nCandidates;
+};
+
+static void
+PseudoDiameter_candidateTask( void * arg, const int begin, const int end,
+			      const int ) { 
+  CandidateSearches * s = (CandidateSearches *) arg;
+  for( int c=begin; c<end; ++c ) { 
+    BreadthFirstSearch * bfs = s->bfs[c];
+    s->ok[c] = bfs->setRoot( s->candidates[c] ) && bfs->execute();
+    if ( ( !s->ok[c] ) || ( bfs->hasShortCircuited() ) ) { 
+      continue;
+    }
+    // later candidates need not go wider than this one
+    const int width = bfs->queryWidth();
+    for( int later=c+1; later<s->nCandidates; ++later ) { 
+      int old = s->bound[later];
+      while( ( width < old ) && 
+	     ( !ThreadTeam::compareAndSwap( s->bound + later, old, width ) ) ) { 
+	old = s->bound[later];
+      }
+    }
+  }
+}
+
+//
+// Does step 6 of run() with a search per candidate, all at once.  The
+// candidates are then considered in order just like in run().
+//
+// When run() gets to candidate c, it short-circuits at the narrowest
+// width of the earlier candidates that were not short-circuited.
+// Here, c short-circuits at the narrowest width of those that have
+// finished, which is never narrower.  So every search that stops here
+// would stop in run() too, and the others give run() all it needs.
+// Only the candidates run() gets to are counted and recorded, so the
+// searches done in vain after a flip do not show up in the statistics.
+//
+bool 
+PseudoDiameter::searchCandidates( const int maxHeight, int& minWidth, bool& flipped ) { 
+  const int nCandidates = candidates.size();
+  while( (int) candidateBFS.size() < nCandidates ) { 
+    BreadthFirstSearch * bfs = new BreadthFirstSearch();
+    if ( pg != 0 ) { 
+      bfs->setGraph( pg );
+    } else { 
+      bfs->setGraph( g );
+    }
+    if ( partition != 0 ) { 
+      bfs->enablePartitionRestrictions( partition, ( partitionMembership == strict ) ? 
+					BreadthFirstSearch::strict : BreadthFirstSearch::loose );
+    }
+    candidateBFS.push_back( bfs );
+  }
+  candidateBound.resize( nCandidates );
+  {for( int c=0; c<nCandidates; ++c ) { 
+    candidateBound[c] = nVtxs;
+    candidateBFS[c]->disableShortCircuiting();
+    candidateBFS[c]->setSharedMaxWidth( &(candidateBound[c]) );
+  }}
+
+  CandidateSearches searches;
+  searches.candidates = &(candidates[0]);
+  searches.bfs = &(candidateBFS[0]);
+  searches.bound = &(candidateBound[0]);
+  bool * okFlags = new bool[ nCandidates ];
+  searches.ok = okFlags;
+  searches.nCandidates = nCandidates;
+#ifdef SPINDLE_TRACE_IS_THREAD_SAFE
+  candidateTeam.run( PseudoDiameter_candidateTask, &searches, nCandidates );
+#else
+  // the searches trace their calls, run one after another
+  ThreadTeam( 1 ).run( PseudoDiameter_candidateTask, &searches, nCandidates );
+#endif
+
+  {for( int c=0; c<nCandidates; ++c ) { 
+    candidateBFS[c]->setSharedMaxWidth( 0 );
+  }}
+
+  bool result = true;
+  int best = -1;
+  int lastBound = -1;  // short-circuit bound run() sets for the last candidate
+  flipped = false;
+  {for( int c=0; c<nCandidates; ++c ) { 
+    BreadthFirstSearch * bfs = candidateBFS[c];
+    if ( !okFlags[c] ) { 
+      result = false;
+      break;
+    }
+    nBFS++;
+    CandidateStats stats;
+    stats.vtx = candidates[c];
+    stats.height = bfs->queryHeight();
+    stats.width = bfs->queryWidth();
+    // run() would have stopped this search at the narrowest earlier width
+    stats.shortCircuited = bfs->hasShortCircuited() || 
+      ( ( endVtx != -1 ) && ( stats.width > minWidth ) );
+    candidateStats.push_back( stats );
+    lastBound = ( endVtx == -1 ) ? -1 : minWidth;
+    // 6.a.  if backward bfs short circuited, continue
+    if ( stats.shortCircuited ) { 
+      nShortCircuits++;
+      continue;
+    }
+    // 6.b.  else if bfs is higher and narrower, make candidate the new start
+    if ( ( stats.height > maxHeight ) && ( stats.width < minWidth ) ) { 
+      startVtx = candidates[c];
+      endVtx = -1;
+      // now the candidate's search is the forward one
+      const int nThreads = forwardBFS->queryNThreads();
+      candidateBFS[c] = forwardBFS;
+      forwardBFS = bfs;
+      forwardBFS->setNThreads( nThreads );
+      candidateBFS[c]->setNThreads( 1 );
+      flipped = true;
+      nFlips++;
+      break;  // run() searches none of the later candidates
+    }
+    // 6.c   else if bfs is narrower than any previous bfs, make candidate the end
+    if ( stats.width < minWidth ) { 
+      endVtx = candidates[c];
+      minWidth = stats.width;
+      best = c;
+    }
+  }}
+  delete[] okFlags;
+  if ( ( result ) && ( !flipped ) && ( best >= 0 ) ) { 
+    // keep the search from endVtx as the reverse one
+    const int nThreads = reverseBFS->queryNThreads();
+    BreadthFirstSearch * bfs = candidateBFS[best];
+    candidateBFS[best] = reverseBFS;
+    reverseBFS = bfs;
+    reverseBFS->setNThreads( nThreads );
+    candidateBFS[best]->setNThreads( 1 );
+    // leave it short-circuiting like run() leaves its reverse search,
+    // since it may become the forward search of the next execute()
+    if ( lastBound > 0 ) { 
+      reverseBFS->enableShortCircuiting( lastBound );
+    }
+  }
+  return result;
+}
+
+template< class G >
 void
 PseudoDiamShrinkingStrategy::pack_large_set( const int * src_begin, const int * src_end, 
-					     const Graph *g ) {
+					     const G *g ) {
   // make sure there is enough space
   large_set.reserve( src_end - src_begin );
   small_set.reserve( src_end - src_begin );
@@ -462,9 +709,27 @@ PseudoDiamShrinkingStrategy::pack_large_set( const int * src_begin, const int *
   sort(large_set.begin(), large_set.end(), pair_first_less<int,int>() );
 }
 
+template void 
+PseudoDiamShrinkingStrategy::pack_large_set( const int *, const int *, const Graph * );
+template void 
+PseudoDiamShrinkingStrategy::pack_large_set( const int *, const int *, const PackedGraph * );
+
 bool
 SloanShrinkingStrategy::shrink( const int * src_begin, const int * src_end, 
 				const Graph * g, vector< int >& dest ) {
+  return shrinkOn( src_begin, src_end, g, dest );
+}
+
+bool
+SloanShrinkingStrategy::shrink( const int * src_begin, const int * src_end, 
+				const PackedGraph * g, vector< int >& dest ) {
+  return shrinkOn( src_begin, src_end, g, dest );
+}
+
+template< class G >
+bool
+SloanShrinkingStrategy::shrinkOn( const int * src_begin, const int * src_end, 
+				  const G * g, vector< int >& dest ) {
   pack_large_set( src_begin, src_end, g );
   int sz = large_set.size();
   dest.resize(0);
@@ -486,6 +751,19 @@ SloanShrinkingStrategy::shrink( const int * src_begin, const int * src_end,
 bool
 DuffReidScottShrinkingStrategy::shrink( const int * src_begin, const int * src_end, 
 					const Graph * g, vector< int >& dest ) {
+  return shrinkOn( src_begin, src_end, g, dest );
+}
+
+bool
+DuffReidScottShrinkingStrategy::shrink( const int * src_begin, const int * src_end, 
+					const PackedGraph * g, vector< int >& dest ) {
+  return shrinkOn( src_begin, src_end, g, dest );
+}
+
+template< class G >
+bool
+DuffReidScottShrinkingStrategy::shrinkOn( const int * src_begin, const int * src_end, 
+					  const G * g, vector< int >& dest ) {
   pack_large_set( src_begin, src_end, g );
   back_insert_iterator< vector< pair< int, int > > >  insert_small_set(small_set);
   unique_copy( large_set.begin(), large_set.end(), insert_small_set , pair_first_equal<int,int>() );
@@ -535,6 +813,19 @@ ReidScottShrinkingStrategy::getNVtxsMax() const {
 bool
 ReidScottShrinkingStrategy::shrink( const int * src_begin, const int * src_end, 
 				    const Graph * g, vector< int >& dest ) {
+  return shrinkOn( src_begin, src_end, g, dest );
+}
+
+bool
+ReidScottShrinkingStrategy::shrink( const int * src_begin, const int * src_end, 
+				    const PackedGraph * g, vector< int >& dest ) {
+  return shrinkOn( src_begin, src_end, g, dest );
+}
+
+template< class G >
+bool
+ReidScottShrinkingStrategy::shrinkOn( const int * src_begin, const int * src_end, 
+				      const G * g, vector< int >& dest ) {
   dest.resize(0);
   pack_large_set( src_begin, src_end, g );
   temp.resize(0);
@@ -29,6 +29,10 @@
 #include "spindle/SpindleAlgorithm.h"
 #endif
 
+#ifndef SPINDLE_THREAD_TEAM_H_
+#include "spindle/ThreadTeam.h"
+#endif
+
 //#ifndef SPINDLE_BFS_H_
 //#include "spindle/BreadthFirstSearch.h"
 //#endif
@@ -51,6 +55,8 @@ SPINDLE_BEGIN_NAMESPACE
 
 class Graph; // forward declaration
 
+class PackedGraph; // forward declaration
+
 class BreadthFirstSearch; // forward declaration
 
 class PseudoDiamShrinkingStrategy; // defined later
@@ -73,6 +79,18 @@ public:
    */
   typedef enum { strict, loose } PartitionMembership; 
 
+  /** outcome of the reverse search from one candidate endVtx */
+  struct CandidateStats { 
+    /** the candidate vertex */
+    int vtx;
+    /** height of its search, or of the level where it stopped */
+    int height;
+    /** widest level of its search, up to where it stopped */
+    int width;
+    /** true iff the search was short-circuited */
+    bool shortCircuited;
+  };
+
 protected:
   //This first set of data types are requred to compute the pseudo diameter
 
@@ -82,6 +100,10 @@ protected:
    * the lifetime of this object.
    */
   const Graph * g;
+
+  /** or a packed graph, under the same terms */
+  const PackedGraph * pg;
+
   /** Forward Breadth First Search object */
   BreadthFirstSearch * forwardBFS;
 
@@ -138,10 +160,31 @@ protected:
 
   /** vector to maintain a list of candidate endVtxs */
   vector<int> candidates;
+
+  /** threads that search from several candidates at once */
+  ThreadTeam candidateTeam;
+
+  /** number of candidates searched at once, 1 searches one after another */
+  int nCandidateThreads;
+
+  /** one search per candidate, when they are searched at once */
+  vector< BreadthFirstSearch * > candidateBFS;
+
+  /** width bound of each candidate, lowered as earlier candidates finish */
+  vector<int> candidateBound;
+
+  /** the search from each candidate, in the order they were tried */
+  vector< CandidateStats > candidateStats;
+
+  /** does the reverse searches from all candidates at once */
+  bool searchCandidates( const int maxHeight, int& minWidth, bool& flipped );
   
   /** does the actual work after #execute()# handles initialization */
   bool run();  
 
+  /** degree of vertex #i# in #g# or #pg# */
+  int deg( const int i ) const;
+
 public:
   /** construct an empty class */
   PseudoDiameter();
@@ -173,6 +216,14 @@ public:
    */
   bool setGraph( const Graph* graph );
 
+  /**
+   * set a packed input graph instead
+   * @return true only iff no error detected
+   * @param is a pointer to a valid packed graph
+   * @see PackedGraph
+   */
+  bool setGraph( const PackedGraph* graph );
+
   /**
    * Set shrinking strategy
    * @return true iff no error detected
@@ -217,6 +268,37 @@ public:
    */
   bool disablePartitionRestrictions();
 
+  /**
+   * expand the levels of the forward and reverse searches with up to
+   * #nThreads# threads.  The endpoints found do not depend on it.
+   * @return false if #nThreads < 1#
+   * @see BreadthFirstSearch::setNThreads
+   */
+  bool setNThreads( const int nThreads );
+
+  /** @return number of threads used by each search */
+  int queryNThreads() const;
+
+  /**
+   * search from up to #nThreads# candidate endVtxs at once.  A
+   * candidate's search short-circuits as soon as a level is wider than
+   * the narrowest finished search from an earlier candidate, so the
+   * endpoints are the same as when the candidates are tried one after
+   * another (#nThreads==1#, the default).  Searches from candidates
+   * after a new startVtx may be done in vain.
+   * @return false if #nThreads < 1#
+   */
+  bool setNCandidateThreads( const int nThreads );
+
+  /** @return number of candidates searched at once */
+  int queryNCandidateThreads() const { return nCandidateThreads; }
+
+  /**
+   * @return the searches from candidate endVtxs on the last run, in
+   * the order the candidates were considered.
+   */
+  const vector< CandidateStats >& getCandidateStats() const { return candidateStats; }
+
   /**
    * set the partition ID that the Pseudodiam should restrict itself to
    * @return true iff partition restrictions are enabled
@@ -306,7 +388,8 @@ protected:
    * @param src_end points to one-past-end of the array.
    * @param g points to a valid graph
    */
-  void pack_large_set( const int * src_begin, const int * src_end, const Graph *g );
+  template< class G >
+  void pack_large_set( const int * src_begin, const int * src_end, const G *g );
   
 public:
   /**
@@ -322,6 +405,13 @@ public:
 		       const int * src_end, 
 		       const Graph   * g, 
 		             vector< int >& dest ) = 0;
+  /**
+   * pure virtual function, the same on a packed graph
+   */
+  virtual bool shrink( const int * src_begin,
+		       const int * src_end, 
+		       const PackedGraph * g, 
+		             vector< int >& dest ) = 0;
   /** destructor */
   virtual ~PseudoDiamShrinkingStrategy() {}
 };
@@ -347,7 +437,13 @@ public:
    */
   virtual bool shrink( const int * src_begin, const int * src_end, 
 		       const Graph * g, vector< int >& dest );
+  /// the same on a packed graph
+  virtual bool shrink( const int * src_begin, const int * src_end, 
+		       const PackedGraph * g, vector< int >& dest );
   virtual ~SloanShrinkingStrategy() {}
+private:
+  template< class G >
+  bool shrinkOn( const int * src_begin, const int * src_end, const G * g, vector< int >& dest );
 };
 
 /**
@@ -370,7 +466,13 @@ public:
    */
   virtual bool shrink( const int * src_begin, const int * src_end, 
 		       const Graph * g, vector< int >& dest );
+  /// the same on a packed graph
+  virtual bool shrink( const int * src_begin, const int * src_end, 
+		       const PackedGraph * g, vector< int >& dest );
   virtual ~DuffReidScottShrinkingStrategy() {}
+private:
+  template< class G >
+  bool shrinkOn( const int * src_begin, const int * src_end, const G * g, vector< int >& dest );
 };
 
 /** 
@@ -425,7 +527,13 @@ public:
    */
   virtual bool shrink( const int * src_begin, const int * src_end, 
 		       const Graph* g, vector< int >& dest );
+  /// the same on a packed graph
+  virtual bool shrink( const int * src_begin, const int * src_end, 
+		       const PackedGraph* g, vector< int >& dest );
   virtual ~ReidScottShrinkingStrategy() {}
+private:
+  template< class G >
+  bool shrinkOn( const int * src_begin, const int * src_end, const G * g, vector< int >& dest );
 };
 
 SPINDLE_END_NAMESPACE 
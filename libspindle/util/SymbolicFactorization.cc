@@ -41,6 +41,9 @@ static char invalidPermFromEtree[] = "execution error detected: problem creating
 
 SymbolicFactorization::SymbolicFactorization() {
   incrementInstanceCount( SymbolicFactorization::MetaData );
+  nThreads = 1;
+  maxSupernodeZeros = 0;
+  maxSupernodeZeroFraction = 0.0;
   reset();
 }
 
@@ -52,10 +55,31 @@ SymbolicFactorization::~SymbolicFactorization() {
 bool
 SymbolicFactorization::reset() {
   graph = 0;
+  nSupernodes = 0;
   algorithmicState= EMPTY;
   return true;
 }
 
+bool
+SymbolicFactorization::setNThreads( const int n ) {
+  if ( n < 1 ) { 
+    return false;
+  }
+  nThreads = n;
+  return true;
+}
+
+bool
+SymbolicFactorization::setSupernodeRelaxation( const int maxZeros, 
+					       const float maxZeroFraction ) {
+  if ( ( maxZeros < 0 ) || ( maxZeroFraction < 0.0 ) ) { 
+    return false;
+  }
+  maxSupernodeZeros = maxZeros;
+  maxSupernodeZeroFraction = maxZeroFraction;
+  return true;
+}
+
 bool
 SymbolicFactorization::setGraph( const Graph* g ) {
   if ( algorithmicState==INVALID ) { 
@@ -139,11 +163,11 @@ SymbolicFactorization::execute() {
   // First we need an etree.
   if ( perm.isNull()  && etree.isNull() ) {  // if need etree and perm
     // create an etree based on the implicit ordering of the matrix
-    etree.take( new ETree( graph ) );
+    etree.take( ( nThreads > 1 ) ? new ETree( graph, perm, nThreads ) : new ETree( graph ) );
     etree->validate();
   } else if ( perm.notNull() ) { 
     // create an elimination tree based on the permutation
-    etree.take( new ETree( graph, perm ) );
+    etree.take( ( nThreads > 1 ) ? new ETree( graph, perm, nThreads ) : new ETree( graph, perm ) );
     etree->validate();
   }
 
@@ -158,14 +182,8 @@ SymbolicFactorization::execute() {
   // that is a postordering of the etree
   perm.take( new PermutationMap( graph->size() ) );
   const SharedPtr<ETree>& const_etree = etree; // HACK to force const-access
-  //  int * dest = perm->getNew2Old().begin();
-  //  for( ETree::const_postorder_iterator it = const_etree->begin_postorder(), 
-  //	 stop_it = const_etree->end_postorder(); it != stop_it; ++it ) { 
-  //    *dest++ = *it;
-  //    cout << *it << endl;
-  //  }
-  copy( const_etree->begin_postorder(), const_etree->end_postorder(), 
-	perm->getNew2Old().begin() ); 
+  // same order as const_etree->begin_postorder() ... end_postorder()
+  const_etree->createPostorder( perm->getNew2Old().begin(), nThreads );
   perm->validate();
   if ( ! perm->isValid() ) {
     algorithmicState = INVALID;
@@ -184,11 +202,42 @@ SymbolicFactorization::execute() {
   return okay;
 }
 
+//
+// Find the least common ancestor of the row subtree leaf `j' with the
+// previous leaf `jprev' of the same row subtree.  `ancestor' is a
+// disjoint set forest over the vertices already processed, with path
+// compression.
+//
+static inline int
+findSetWithCompression( int jprev, int * ancestor ) {
+  int q = jprev;
+  while ( q != ancestor[q] ) { 
+    q = ancestor[q];
+  }
+  // compress the path
+  for( int s = jprev; s != q; ) { 
+    const int next = ancestor[s];
+    ancestor[s] = q;
+    s = next;
+  }
+  return q;
+}
+
 bool
 SymbolicFactorization::run() {
   // PRECONDITION:  graph, permutation, and etree are all valid
+  //                permutation is a postordering of the etree
   // POSTCONDITION: colCount and rowCount contain # nonzeros in factor
   //                graph, permutation and etree are unchanged
+  //
+  // This is the algorithm of Gilbert, Ng and Peyton (SIMAX 15(4), 1994).
+  // Row `ii' of the factor is the subtree of the etree spanned by the
+  // entries of row `ii' of the matrix.  Only the leaves of these row
+  // subtrees (the "skeleton" of the matrix) matter.  Each leaf adds one
+  // to its column count and each least common ancestor of consecutive
+  // leaves subtracts one; summing up the tree gives the column counts.
+  // The row counts are the lengths of the paths from each leaf to the
+  // previous least common ancestor.  O(nnz(A) alpha(nnz(A),n)) overall.
 
   // HACK to force const access.
   const SharedPtr<PermutationMap>& const_perm = perm;
@@ -201,52 +250,187 @@ SymbolicFactorization::run() {
   register const int* new2old = const_perm->getNew2Old().lend();
   register const int* parent = const_etree->getParent().lend();
 
-  // resize rowCount and colCount, initialize them to all 1's
   rowCount.resize(n);
   rowCount.init(1);
   colCount.resize(n);
-  colCount.init(1);
+  colCount.init(0);
 
   register int * row_count = rowCount.begin();
   register int * col_count = colCount.begin();
 
-  // get a temporary array for the vertex coloring
-  SharedArray<int> color(n);
-  color.init(-1);
-  register int * color_array = color.begin();
-
   // programmer's note: `ii' & `jj' refers to vertices in the new ordering
   //                     `i' &  `j' refers to the same vertices in the old ordering.
-  for( int ii=0; ii<n; ++ii ) {
-    color_array[ii] = ii;
-    
-    // get the row index in the original matrix
-    int i = new2old[ii];
-
-    // for each element in the corresponding adjacency list
-    for(const int *jp = graph->begin_adj(i), *stop_jp = graph->end_adj(i);
-	 jp < stop_jp; ++jp ) {
-      int j = *jp;
-      int jj = old2new[ j ];
-      
-      if ( jj < ii ) { // ii is an ancestor of jj in the permutation
-	while ( color_array[jj] < ii ) { 
-	  row_count[ii]++;
-	  col_count[jj]++;
-	  color_array[jj] = ii;
-	  jj = old2new[ parent[ j ] ]; // this is right
-	  if ( jj == -1 ) { // if got to root.
-	    break;
-	  }
-	  j = new2old[ jj ];
-	} // end while
-      } // end if
-    } // end forall j adj to i
-  } // end for all ii in new ordering
+  // Since the new ordering is a postordering, every subtree is a
+  // contiguous range of vertices ending in its root.
+
+  // workspace: etree in the new ordering, first descendant, depth in the
+  // etree, the most recent leaf and first descendant seen in each row 
+  // subtree, and the disjoint sets for the least common ancestors.
+  SharedArray<int> workspace( 6*n );
+  register int * par = workspace.begin();
+  register int * first = par + n;
+  register int * level = first + n;
+  register int * prevLeaf = level + n;
+  register int * maxFirst = prevLeaf + n;
+  register int * ancestor = maxFirst + n;
+
+  {for( int ii=0; ii<n; ++ii ) { 
+    const int p = parent[ new2old[ii] ];
+    par[ii] = ( ( p < 0 ) || ( p == new2old[ii] ) ) ? -1 : old2new[p];
+    if ( ( par[ii] != -1 ) && ( par[ii] <= ii ) ) { 
+      errMsg = invalidPermFromEtree;
+      return false; // not a postorder
+    }
+    first[ii] = -1;
+    prevLeaf[ii] = -1;
+    maxFirst[ii] = -1;
+    ancestor[ii] = ii;
+  }}
+  {for( int ii=0; ii<n; ++ii ) { 
+    // a vertex whose first descendant is unset is a leaf of the etree
+    if ( first[ii] == -1 ) { 
+      col_count[ii] = 1;
+    }
+    for( int jj=ii; ( jj != -1 ) && ( first[jj] == -1 ); jj = par[jj] ) { 
+      first[jj] = ii;
+    }
+  }}
+  {for( int ii=n-1; ii>=0; --ii ) { 
+    level[ii] = ( par[ii] == -1 ) ? 0 : level[ par[ii] ] + 1;
+  }}
+
+  // examine the entries below the diagonal, one column at a time
+  for( int jj=0; jj<n; ++jj ) { 
+    if ( par[jj] != -1 ) { 
+      col_count[ par[jj] ]--; // jj is not a root
+    }
+    const int j = new2old[jj];
+    for(const int *ip = graph->begin_adj(j), *stop_ip = graph->end_adj(j);
+	 ip < stop_ip; ++ip ) {
+      const int ii = old2new[ *ip ];
+      // jj is a leaf of row subtree ii only if none of its descendants
+      // has been seen in that row
+      if ( ( ii <= jj ) || ( first[jj] <= maxFirst[ii] ) ) { 
+	continue;
+      }
+      maxFirst[ii] = first[jj];
+      const int jprev = prevLeaf[ii];
+      prevLeaf[ii] = jj;
+      col_count[jj]++;
+      if ( jprev == -1 ) { // first leaf in row subtree
+	row_count[ii] += level[jj] - level[ii];
+      } else {             // subsequent leaf, find the overlap
+	const int q = findSetWithCompression( jprev, ancestor );
+	row_count[ii] += level[jj] - level[q];
+	col_count[q]--;
+      }
+    }
+    if ( par[jj] != -1 ) { 
+      ancestor[jj] = par[jj];
+    }
+  }
+
+  // sum the differences up the tree
+  {for( int jj=0; jj<n; ++jj ) {
+    if ( par[jj] != -1 ) { 
+      col_count[ par[jj] ] += col_count[jj];
+    }
+  }}
+  if ( ! createSupernodes( par ) ) { 
+    return false;
+  }
   algorithmicState = DONE;
   return true;
 }
 
+bool
+SymbolicFactorization::createSupernodes( const int * par ) {
+  // PRECONDITION:  colCount is set, par[] is the etree in the postordering
+  // POSTCONDITION: supernode partition and assembly tree are set
+  //
+  // Since the ordering is a postordering, every supernode is a range of
+  // consecutive columns.  Column jj+1 continues the supernode of jj when 
+  // it is the only child of jj+1 and the structures nest.  
+  // Amalgamation only ever merges a supernode with the one that ends 
+  // just before it, if that one is its child, so the ranges stay 
+  // consecutive.
+  const int n = graph->size();
+  const int * col_count = colCount.lend();
+
+  SharedArray<int> nChildren( n );
+  nChildren.init( 0 );
+  {for( int jj=0; jj<n; ++jj ) { 
+    if ( par[jj] != -1 ) { 
+      nChildren[ par[jj] ]++;
+    }
+  }}
+
+  supernodeBegin.resize( n+1 );
+  supernodeMap.resize( n );
+  supernodeNRows.resize( n );
+  int * begin = supernodeBegin.begin();
+  int * nRows = supernodeNRows.begin();
+
+  // nnz[s] counts the entries of the supernode that are really in the
+  // factor, the rest of its dense block are explicit zeros.
+  SharedArray<long> actual( n );
+  const bool relaxed = ( maxSupernodeZeros > 0 ) || ( maxSupernodeZeroFraction > 0.0 );
+  nSupernodes = 0;
+  for( int jj=0; jj<n; ) { 
+    // find the fundamental supernode starting at jj
+    int last = jj;
+    long nnz = col_count[jj];
+    while ( ( last+1 < n ) && ( par[last] == last+1 ) 
+	    && ( nChildren[last+1] == 1 ) 
+	    && ( col_count[last] == col_count[last+1] + 1 ) ) { 
+      ++last;
+      nnz += col_count[last];
+    }
+    const int width = last - jj + 1;
+    const int nBelow = col_count[last] - 1;
+
+    // try to merge with the previous supernode, if it is a child.  A
+    // child that nests without zeros but is not the only one is not
+    // part of a fundamental supernode, so only relaxation merges it.
+    if ( relaxed && ( nSupernodes > 0 ) && ( par[ jj-1 ] != -1 ) 
+	 && ( par[ jj-1 ] >= jj ) && ( par[ jj-1 ] <= last ) ) { 
+      const int s = nSupernodes - 1;
+      const long w = last - begin[s] + 1; 
+      const long dense = ( w * ( w+1 ) ) / 2 + w * nBelow;
+      const long zeros = dense - ( actual[s] + nnz );
+      if ( ( zeros <= maxSupernodeZeros ) 
+	   || ( zeros <= maxSupernodeZeroFraction * dense ) ) { 
+	actual[s] += nnz;
+	nRows[s] = w + nBelow;
+	jj = last+1;
+	continue;
+      }
+    }
+    begin[ nSupernodes ] = jj;
+    actual[ nSupernodes ] = nnz;
+    nRows[ nSupernodes ] = width + nBelow;
+    ++nSupernodes;
+    jj = last+1;
+  }
+  begin[ nSupernodes ] = n;
+
+  int * map = supernodeMap.begin();
+  {for( int s=0; s<nSupernodes; ++s ) { 
+    for( int jj=begin[s]; jj<begin[s+1]; ++jj ) { 
+      map[jj] = s;
+    }
+  }}
+  supernodeParent.resize( nSupernodes );
+  int * sParent = supernodeParent.begin();
+  {for( int s=0; s<nSupernodes; ++s ) { 
+    const int p = par[ begin[s+1]-1 ];
+    sParent[s] = ( p == -1 ) ? -1 : map[p];
+  }}
+  supernodeBegin.resize( nSupernodes+1 );
+  supernodeNRows.resize( nSupernodes );
+  return true;
+}
+
 long
 SymbolicFactorization::querySize() {
   const int n = colCount.size();
@@ -262,6 +446,22 @@ SymbolicFactorization::querySize() {
   }
 }
 
+long
+SymbolicFactorization::querySupernodalSize() {
+  if ( algorithmicState == DONE ) {
+    long temp = 0;
+    const int *begin = supernodeBegin.lend();
+    const int *nRows = supernodeNRows.lend();
+    for( int s=0; s<nSupernodes; ++s ) {
+      const long w = begin[s+1] - begin[s];
+      temp += ( w * ( w+1 ) ) / 2 + w * ( nRows[s] - w );
+    }
+    return temp;
+  } else {
+    return false; 
+  }
+}
+
 long
 SymbolicFactorization::queryFill() {
   const int n = colCount.size();
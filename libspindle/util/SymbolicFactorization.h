@@ -60,7 +60,17 @@ private:
   SharedArray<int> rowCount;
   SharedArray<int> colCount;
 
+  int nThreads;
+  int maxSupernodeZeros;
+  float maxSupernodeZeroFraction;
+  int nSupernodes;
+  SharedArray<int> supernodeBegin;   // columns of s are [begin[s],begin[s+1])
+  SharedArray<int> supernodeMap;     // column -> supernode
+  SharedArray<int> supernodeParent;  // assembly tree
+  SharedArray<int> supernodeNRows;   // rows in the dense block of s
+
   bool run();
+  bool createSupernodes( const int * par );
 public:
   SymbolicFactorization();
   virtual ~SymbolicFactorization();
@@ -71,6 +81,9 @@ public:
   bool setETree( const ETree* et );  // must be ready
   bool setPermutationMap(  const PermutationMap* p ); // must be ready
 
+  // build the etree and its postorder with this many threads
+  bool setNThreads( const int n );
+
   // to compute the symbolic factorization
   virtual bool execute(); // may create new permutation and etree as needed
 
@@ -90,6 +103,28 @@ public:
   const SharedPtr<ETree>& getETree() const { return etree; }
   SharedPtr<ETree>& getETree() { return etree; }
 
+  // number of nonzeros in each row and column of the factor,
+  // including the diagonal, indexed in the postordering.
+  const SharedArray<int>& getRowCount() const { return rowCount; }
+  const SharedArray<int>& getColCount() const { return colCount; }
+
+  // Supernodes are computed along with the counts.  Fundamental
+  // supernodes are chains of columns with nested structure.  A supernode
+  // is merged with the child ending just before it if the resulting
+  // dense block holds at most maxZeros explicit zeros, or at most
+  // maxZeroFraction of its entries are zero.  Default is (0, 0.0), 
+  // which merges nothing and gives the fundamental supernodes.
+  bool setSupernodeRelaxation( const int maxZeros, const float maxZeroFraction );
+
+  // supernode output, all in terms of the postordering.
+  // A supernode's dense block has its columns' rows plus the rows below.
+  int queryNSupernodes() const { return nSupernodes; }
+  const SharedArray<int>& getSupernodeBegin() const { return supernodeBegin; } // n_s+1
+  const SharedArray<int>& getSupernodeMap() const { return supernodeMap; } // n
+  const SharedArray<int>& getSupernodeParent() const { return supernodeParent; } // n_s, roots are -1
+  const SharedArray<int>& getSupernodeNRows() const { return supernodeNRows; } // n_s
+  long querySupernodalSize(); // = entries in all dense blocks
+
   long queryFill(); // = sum_{i=0}^{n} colCount[i] NNZ(A)
   long querySize(); // = sum_{i=0}^{n} colCount[i]
   double queryWork(); // = sum_{i=0}^{n} colCount[i]^2
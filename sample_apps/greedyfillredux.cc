@@ -294,11 +294,7 @@ int main(int argc, char *argv[]) {
 	    ordering.setRandomizeGraph( false );
 	  } else {  // if seed != -1
 	    unsigned int u_seed = seed;
-#ifdef __STL_NO_DRAND48
-	    srand( u_seed );
-#else
-	    srand48( u_seed );
-#endif
+	    ordering.setRandomSeed( u_seed );
 	  } // end else (if seed != -1)
 	} // end else (if strseed may be numeric)
       } // end if strseed != 0
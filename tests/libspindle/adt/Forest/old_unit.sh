@@ -13,12 +13,12 @@ do
     --bindir=*) bindir="$optionarg" ;;
     esac
 done
-echo "NPARTS 3"
+echo "NPARTS 4"
 final_result='UNRESOLVED'
 
 i='1';
 
-for test_i in test01 test02 test03; do
+for test_i in test01 test02 test03 test04; do
     echo "PART $i"
     if test -x ${bindir}/${test_i}.exe ; then 
 	${bindir}/${test_i}.exe > ${bindir}/${test_i}.tmp 2>&1 ;
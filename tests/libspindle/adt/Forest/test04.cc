@@ -0,0 +1,95 @@
+//
+// test04.cc
+//
+// tests building an EliminationForest and its postorder with several 
+// threads against the serial construction and postorder iterator.
+//
+
+#include <iostream.h>
+#include "spindle/Graph.h"
+#include "spindle/EliminationForest.h"
+#include "spindle/PermutationMap.h"
+#include "spindle/MinPriorityEngine.h"
+
+#include "samples/grid_mesh.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+//
+// compare the etree built with nThreads to the serial one, and the
+// postorder of each to the postorder iterator
+//
+static int
+compare( const Graph& graph, const SharedPtr<PermutationMap>& perm, const int nThreads ) {
+  const int n = graph.size();
+  EliminationForest * serial = ( perm.isNull() ) ? new EliminationForest( &graph ) 
+    : new EliminationForest( &graph, perm );
+  EliminationForest parallel( &graph, perm, nThreads );
+  serial->validate();
+  parallel.validate();
+  int nDiffs = 0;
+  if ( ( ! serial->isValid() ) || ( ! parallel.isValid() ) ) { 
+    ++nDiffs;
+  }
+  const int * p1 = serial->getParent().lend();
+  const int * p2 = parallel.getParent().lend();
+  {for( int i=0; i<n; ++i ) {
+    if ( p1[i] != p2[i] ) { ++nDiffs; }
+  }}
+  int * post = new int[n];
+  parallel.createPostorder( post, nThreads );
+  int k = 0;
+  for( EliminationForest::const_postorder_iterator it = serial->begin_postorder(); 
+       it != serial->end_postorder(); ++it, ++k ) {
+    if ( ( k >= n ) || ( post[k] != *it ) ) { ++nDiffs; }
+  }
+  if ( k != n ) { ++nDiffs; }
+  delete[] post;
+  delete serial;
+  return nDiffs;
+}
+
+int main() {
+  ios::sync_with_stdio();
+
+  const int k = 40;
+  const int n = k*k;
+  int * adjHead = new int[ n+1 ];
+  int * adjList = new int[ 4*n ];
+  makeFivePointGrid( k, adjHead, adjList );
+
+  Graph graph( n, (const int*) adjHead, (const int*) adjList );
+  graph.validate();
+  if ( ! graph.isValid() ) {
+    cerr << "Cannot create valid graph." << endl;
+  }
+
+  SharedPtr<PermutationMap> natural;
+  SharedPtr<PermutationMap> scrambled( new PermutationMap( n ) );
+  {
+    int * new2old = scrambled->getNew2Old().begin();
+    {for( int i=0; i<n; ++i ) {
+      new2old[i] = ( i*7 ) % n;
+    }}
+    scrambled->validate();
+  }
+  MinPriorityEngine mmd( &graph );
+  mmd.setRandomizeGraph( false );
+  mmd.execute();
+  SharedPtr<PermutationMap> mindeg;
+  mindeg.borrow( mmd.getPermutation() );
+
+  const int threads[] = { 1, 2, 3, 4, 7 };
+  {for( int t=0; t<5; ++t ) {
+    cout << threads[t] << " threads: " 
+	 << compare( graph, natural, threads[t] ) << " "
+	 << compare( graph, scrambled, threads[t] ) << " "
+	 << compare( graph, mindeg, threads[t] ) << " differences." << endl;
+  }}
+
+  delete[] adjHead;
+  delete[] adjList;
+  return 0;
+}
@@ -0,0 +1,103 @@
+//
+//  adt/Graph/drivers/tests/test13.cc -- tests QuotientGraph::NodeView
+//
+//  $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+// checks that the unchecked NodeView of an uneliminated snode, and the
+// clique of an enode, agree with the checked
+// enode_begin()/enode_end()/snode_begin()/snode_end() accessors
+//
+
+#include "spindle/Graph.h"
+
+#include "spindle/QuotientGraph.h"
+
+#include "samples/small_mesh.h"
+
+#include <iostream.h>
+
+#ifdef __FUNC__
+#undef __FUNC__
+#endif
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+static void
+compareViews( const QuotientGraph& g ) {
+  for ( int i=0; i<nvtxs; ++i ) {
+    if ( !g.isPrincipal( i ) ) {
+      continue;
+    }
+    if ( g.isEliminated( i ) ) {
+      // an enode has no view, only its clique
+      cout << "  " << i << ": (0," << g.clique_end(i) - g.clique_begin(i)
+	   << "," << g.queryWeight(i) << ")";
+      if ( ( g.enode_begin(i) != g.enode_end(i) ) ||
+	   ( g.clique_begin(i) != g.snode_begin(i) ) ||
+	   ( g.clique_end(i) != g.snode_end(i) ) ) {
+	cout << " MISMATCH";
+      }
+      cout << endl;
+      continue;
+    }
+    const QuotientGraph::NodeView view = g.lendNodeView( i );
+    cout << "  " << i << ": (" << view.nEnodes() << "," << view.nSnodes()
+	 << "," << view.weight << ")";
+    if ( ( view.enode_begin() != g.enode_begin(i) ) ||
+	 ( view.enode_end() != g.enode_end(i) ) ||
+	 ( view.snode_begin() != g.snode_begin(i) ) ||
+	 ( view.snode_end() != g.snode_end(i) ) ||
+	 ( view.weight != g.queryWeight(i) ) ) {
+      cout << " MISMATCH";
+    }
+    cout << endl;
+  }
+}
+
+#define __FUNC__ "int main()"
+int main() {
+  FENTER;
+  Graph graph( nvtxs, Aptr, Aind );
+  graph.validate();
+  if ( !graph.isValid() ) {
+    cerr << "cannot form valid graph" << endl;
+  }
+
+  QuotientGraph g( &graph );
+
+  QuotientGraph::VertexList reachableVtxs, mergedVtxs;
+
+  cout << "Original Graph" << endl;
+  compareViews( g );
+
+  cout << "Eliminate 0, 2, 6, 8" << endl;
+  g.eliminateSupernode( 0 );
+  g.eliminateSupernode( 2 );
+  g.eliminateSupernode( 6 );
+  g.eliminateSupernode( 8 );
+  g.update( reachableVtxs, mergedVtxs );
+  compareViews( g );
+
+  cout << "Eliminate 4" << endl;
+  g.eliminateSupernode( 4 );
+  g.update( reachableVtxs, mergedVtxs );
+  compareViews( g );
+
+  FRETURN(0);
+}
+#undef __FUNC__
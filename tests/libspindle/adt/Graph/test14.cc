@@ -0,0 +1,196 @@
+//
+// test14.cc -- PackedGraph decodes to the same graph, and searches and
+//              orderings on it match those on the Graph
+//
+
+#include <iostream.h>
+#include "spindle/spindle.h"
+#include "spindle/SpindleSystem.h"
+#include "spindle/Graph.h"
+#include "spindle/PackedGraph.h"
+#include "spindle/PermutationMap.h"
+#include "spindle/BreadthFirstSearch.h"
+#include "spindle/PseudoDiameter.h"
+#include "spindle/RCMEngine.h"
+#include "spindle/SloanEngine.h"
+#include "spindle/MinPriorityEngine.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+//
+// an nx by ny grid with an edge from every 7th vertex to one far away,
+// so some differences take more than a byte, and two isolated vertices
+// at the end.  The vertices are weighted if asked.
+//
+static Graph *
+makeGraph( const int nx, const int ny, const bool weighted ) {
+  const int nGrid = nx * ny;
+  const int n = nGrid + 2;
+  int * adjHead = new int[ n + 1 ];
+  int * adjList = new int[ 6 * n ];
+  int * vtxWeight = new int[ n ];
+  int k = 0;
+  for( int v=0; v<n; ++v ) {
+    adjHead[v] = k;
+    vtxWeight[v] = v % 4 + 1;
+    if ( v >= nGrid ) {
+      continue;
+    }
+    const int x = v % nx;
+    const int y = v / nx;
+    const int far = ( v + nGrid / 2 ) % nGrid;
+    int nbrs[6];
+    int nNbrs = 0;
+    if ( y > 0 ) { nbrs[ nNbrs++ ] = v - nx; }
+    if ( x > 0 ) { nbrs[ nNbrs++ ] = v - 1; }
+    if ( x < nx-1 ) { nbrs[ nNbrs++ ] = v + 1; }
+    if ( y < ny-1 ) { nbrs[ nNbrs++ ] = v + nx; }
+    if ( ( v % 7 == 0 ) || ( far % 7 == 0 ) ) { nbrs[ nNbrs++ ] = far; }
+    // insertion sort, dropping duplicates
+    for( int i=0; i<nNbrs; ++i ) {
+      int j = k;
+      while( ( j > adjHead[v] ) && ( adjList[j-1] > nbrs[i] ) ) {
+	--j;
+      }
+      if ( ( j > adjHead[v] ) && ( adjList[j-1] == nbrs[i] ) ) {
+	continue;
+      }
+      for( int m=k; m>j; --m ) {
+	adjList[m] = adjList[m-1];
+      }
+      adjList[j] = nbrs[i];
+      ++k;
+    }
+  }
+  adjHead[n] = k;
+  Graph * graph = new Graph( n, (const int *) adjHead, (const int *) adjList,
+			     weighted ? (const int *) vtxWeight : (const int *) 0,
+			     (const int *) 0 );
+  graph->validate();
+  delete[] adjHead;
+  delete[] adjList;
+  delete[] vtxWeight;
+  return graph;
+}
+
+static bool
+same( const int * a, const int * b, const int n ) {
+  for( int i=0; i<n; ++i ) {
+    if ( a[i] != b[i] ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool
+sameGraph( const Graph& a, const Graph& b ) {
+  const int n = a.queryNVtxs();
+  return a.isValid() && b.isValid() && ( n == b.queryNVtxs() ) &&
+    same( a.getAdjHead().lend(), b.getAdjHead().lend(), n+1 ) &&
+    same( a.getAdjList().lend(), b.getAdjList().lend(), a.getAdjHead()[n] ) &&
+    ( a.getVtxWeight().size() == b.getVtxWeight().size() ) &&
+    same( a.getVtxWeight().lend(), b.getVtxWeight().lend(), a.getVtxWeight().size() );
+}
+
+static bool
+sameOrder( const OrderingAlgorithm& a, const OrderingAlgorithm& b, const int n ) {
+  return ( a.getPermutation() != 0 ) && ( b.getPermutation() != 0 ) &&
+    same( a.getPermutation()->getNew2Old().lend(),
+	  b.getPermutation()->getNew2Old().lend(), n );
+}
+
+static const char *
+yes( const bool b ) {
+  return b ? "yes" : "no";
+}
+
+int main() {
+  SpindleSystem::setErrorFile( 0 );
+
+  for( int w=0; w<2; ++w ) {
+    const bool weighted = ( w == 1 );
+    Graph * graph = makeGraph( 40, 25, weighted );
+    const int n = graph->queryNVtxs();
+    PackedGraph packed( graph );
+    cout << ( weighted ? "weighted" : "unweighted" ) << " graph, "
+	 << n << " vertices, " << graph->queryNNonZeros() << " nonzeros" << endl;
+    cout << "  packed = " << yes( packed.isValid() )
+	 << ", under 2 bytes per nonzero = "
+	 << yes( packed.queryNBytes() < 2 * graph->queryNNonZeros() ) << endl;
+
+    // neighbors and degrees
+    bool adjOk = ( packed.queryNVtxs() == n ) && ( packed.queryNEdges() == graph->queryNEdges() );
+    for( int i=0; adjOk && ( i<n ); ++i ) {
+      Graph::const_iterator g = graph->begin_adj(i);
+      PackedGraph::const_iterator p = packed.begin_adj(i);
+      for( ; ( g != graph->end_adj(i) ) && ( p != packed.end_adj(i) ); ++g, ++p ) {
+	adjOk = adjOk && ( *g == *p );
+      }
+      adjOk = adjOk && ( g == graph->end_adj(i) ) && ( p == packed.end_adj(i) ) &&
+	( graph->deg(i) == packed.deg(i) ) &&
+	( packed.nAdj(i) == graph->end_adj(i) - graph->begin_adj(i) );
+    }
+    Graph * unpacked = packed.createGraph();
+    cout << "  neighbors and degrees match = " << yes( adjOk )
+	 << ", unpacks to the same graph = " << yes( sameGraph( *graph, *unpacked ) ) << endl;
+    delete unpacked;
+
+    // searches
+    BreadthFirstSearch bfsG;
+    BreadthFirstSearch bfsP;
+    bfsG.setGraph( graph );
+    bfsP.setGraph( &packed );
+    bfsG.setRoot( 17 );
+    bfsP.setRoot( 17 );
+    const bool bfsOk = bfsG.execute() && bfsP.execute() &&
+      ( bfsG.queryNVisited() == bfsP.queryNVisited() ) &&
+      same( bfsG.getNew2Old().lend(), bfsP.getNew2Old().lend(), bfsG.queryNVisited() ) &&
+      same( bfsG.getDistance().lend(), bfsP.getDistance().lend(), n ) &&
+      ( bfsG.queryMinDegreeVtx() == bfsP.queryMinDegreeVtx() );
+    PseudoDiameter diamG;
+    PseudoDiameter diamP;
+    diamG.setGraph( graph );
+    diamP.setGraph( &packed );
+    diamG.setRoot( 17 );
+    diamP.setRoot( 17 );
+    const bool diamOk = diamG.execute() && diamP.execute() &&
+      ( diamG.queryEndpoints() == diamP.queryEndpoints() );
+    cout << "  same search = " << yes( bfsOk ) << ", same endpoints = " << yes( diamOk ) << endl;
+
+    // orderings
+    RCMEngine rcmG;
+    RCMEngine rcmP;
+    rcmG.setGraph( graph );
+    const bool rcmSet = rcmP.setGraph( &packed );
+    const bool rcmOk = rcmSet && rcmG.execute() && rcmP.execute() && sameOrder( rcmG, rcmP, n );
+    rcmG.enableDegreeSorting();
+    rcmP.enableDegreeSorting();
+    rcmG.setNThreads( 3 );
+    rcmP.setNThreads( 3 );
+    rcmG.setGraph( graph );
+    rcmP.setGraph( &packed );
+    const bool sortedOk = rcmG.execute() && rcmP.execute() && sameOrder( rcmG, rcmP, n );
+    SloanEngine sloanG;
+    SloanEngine sloanP;
+    sloanG.setGraph( graph );
+    const bool sloanSet = sloanP.setGraph( &packed );
+    const bool sloanOk = sloanSet && sloanG.execute() && sloanP.execute() &&
+      sameOrder( sloanG, sloanP, n );
+    cout << "  same RCM = " << yes( rcmOk ) << ", sorted by degree = " << yes( sortedOk )
+	 << ", same Sloan = " << yes( sloanOk ) << endl;
+
+    // orderings that need the whole graph refuse it
+    MinPriorityEngine mmd;
+    OrderingAlgorithm * ordering = &mmd;
+    cout << "  minimum degree takes it = " << yes( ordering->setGraph( &packed ) ) << endl;
+    delete graph;
+  }
+
+  Graph invalid;
+  PackedGraph packed;
+  cout << "packs an invalid graph = " << yes( packed.pack( &invalid ) )
+       << ", valid = " << yes( packed.isValid() ) << endl;
+}
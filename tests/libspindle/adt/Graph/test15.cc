@@ -0,0 +1,73 @@
+//
+// test15.cc -- a graph needing more quotient graph work space than the
+//              offsets can address is refused with a warning
+//
+// A subclass lowers the limit with the protected setOffsetLimit() so
+// that a small mesh trips the same check a graph with 2^31 entries would.
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <iostream.h>
+#include "spindle/Graph.h"
+#include "spindle/QuotientGraph.h"
+#include "spindle/MinPriorityEngine.h"
+
+#include "samples/small_mesh.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+static const char *
+yes( const bool b ) {
+  return b ? "yes" : "no";
+}
+
+//
+// a quotient graph whose offsets stop at limit
+//
+class LimitedQuotientGraph : public QuotientGraph {
+public:
+  LimitedQuotientGraph( const Graph * graph, const double limit ) : QuotientGraph( 0 ) {
+    setOffsetLimit( limit );
+    setGraph( graph );
+  }
+};
+
+int main() {
+  SpindleSystem::setErrorFile( 0 );
+  Graph graph( nvtxs, (const int *) Aptr, (const int *) Aind );
+  graph.validate();
+  if ( !graph.isValid() ) {
+    cerr << "cannot form valid graph" << endl;
+    return -1;
+  }
+
+  // collect the warning to look at its text
+  FILE * warnings = tmpfile();
+  if ( warnings == 0 ) {
+    cerr << "cannot open a temporary file" << endl;
+    return -1;
+  }
+  SpindleSystem::setWarnFile( warnings );
+  LimitedQuotientGraph limited( &graph, 2 * nvtxs );
+  SpindleSystem::setWarnFile( 0 );
+
+  char text[ 4096 ];
+  rewind( warnings );
+  const size_t nRead = fread( text, 1, sizeof(text)-1, warnings );
+  text[ nRead ] = '\0';
+  fclose( warnings );
+  cout << "with offsets limited to " << 2 * nvtxs << ":" << endl;
+  cout << "  quotient graph valid = " << yes( limited.isValid() ) << endl;
+  cout << "  warning names --enable-large-graphs = "
+       << yes( strstr( text, "--enable-large-graphs" ) != 0 ) << endl;
+
+  // other quotient graphs keep the default
+  QuotientGraph qgraph( &graph );
+  MinPriorityEngine unlimited( &graph );
+  cout << "with the default limit:" << endl;
+  cout << "  quotient graph valid = " << yes( qgraph.isValid() ) << endl;
+  cout << "  minimum degree succeeds = " << yes( unlimited.execute() ) << endl;
+}
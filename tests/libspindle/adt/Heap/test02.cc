@@ -0,0 +1,121 @@
+//
+// test02.cc -- DaryHeap against a brute force priority queue
+//
+//
+
+#include "spindle/DaryHeap.h"
+#include <iostream.h>
+#include <stdio.h>
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+static unsigned int seed = 12345;
+
+static int
+nextRandom( const int n ) {
+  seed = seed * 1103515245 + 12345;
+  return (int) ( ( seed >> 16 ) % n );
+}
+
+// largest key in the reference, ties broken by smallest item; -1 if empty
+static int
+referenceMax( const int * refKey, const bool * in, const int n ) {
+  int best = -1;
+  for( int i=0; i<n; ++i ) {
+    if ( in[i] && ( ( best < 0 ) || ( refKey[i] > refKey[best] ) ) ) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+int main() {
+  ios::sync_with_stdio();
+  const int n = 300;
+  DaryHeap heap( n, n );
+  int * refKey = new int[ n ];
+  bool * in = new bool[ n ];
+  int items[ 16 ];
+  int deltas[ 16 ];
+  for( int i=0; i<n; ++i ) { in[i] = false; }
+
+  int nMismatch = 0;
+  int nExtracted = 0;
+  int nBatches = 0;
+  for( int step=0; step<20000; ++step ) {
+    const int op = nextRandom( 10 );
+    if ( op < 4 ) {
+      const int it = nextRandom( n );
+      const int k = nextRandom( 1000 ) - 500;
+      const bool ok = ( heap.insert( k, it ) == 0 );
+      if ( ok == in[it] ) { ++nMismatch; }
+      if ( !in[it] ) { in[it] = true; refKey[it] = k; }
+    } else if ( op < 6 ) {
+      // batch of increments, sometimes with repeats and decreases
+      const int m = 1 + nextRandom( 16 );
+      int nIn = 0;
+      for( int i=0; i<m; ++i ) {
+	items[i] = nextRandom( n );
+	deltas[i] = ( nextRandom( 4 ) == 0 ) ? -nextRandom( 50 ) : nextRandom( 50 );
+	if ( in[ items[i] ] ) { ++nIn; }
+      }
+      const int result = heap.incrementPriorities( items, deltas, m );
+      if ( ( result == 0 ) != ( nIn == m ) ) { ++nMismatch; }
+      for( int i=0; i<m; ++i ) {
+	if ( in[ items[i] ] ) { refKey[ items[i] ] += deltas[i]; }
+      }
+      ++nBatches;
+    } else if ( op < 7 ) {
+      const int it = nextRandom( n );
+      const int d = nextRandom( 100 ) - 50;
+      const bool ok = ( heap.incrementPriority( d, it ) == 0 );
+      if ( ok != in[it] ) { ++nMismatch; }
+      if ( in[it] ) { refKey[it] += d; }
+    } else {
+      const int best = referenceMax( refKey, in, n );
+      int k, it;
+      if ( heap.peekMax( k, it ) != ( best >= 0 ) ) { ++nMismatch; }
+      const int got = heap.extractMax();
+      if ( best < 0 ) {
+	if ( got != -1 ) { ++nMismatch; }
+	continue;
+      }
+      // equal keys may come out in any order
+      if ( ( got < 0 ) || ( !in[got] ) || ( refKey[got] != refKey[best] ) || ( k != refKey[best] ) ) {
+	++nMismatch;
+      } else {
+	in[got] = false;
+	++nExtracted;
+      }
+    }
+    int nIn = 0;
+    for( int i=0; i<n; ++i ) { if ( in[i] ) { ++nIn; } }
+    if ( nIn != heap.size() ) { ++nMismatch; }
+  }
+  // drain the heap: keys must come out in nonincreasing order
+  int last = 0;
+  bool first = true;
+  while ( heap.size() > 0 ) {
+    int k, it;
+    heap.peekMax( k, it );
+    if ( ( !first ) && ( k > last ) ) { ++nMismatch; }
+    if ( heap.extractMax() != it ) { ++nMismatch; }
+    last = k;
+    first = false;
+  }
+
+  cout << "extracted " << nExtracted << " items, applied " << nBatches << " batches" << endl;
+  cout << "mismatches with brute force: " << nMismatch << endl;
+
+  DaryHeap small( 10, 10 );
+  for( int i=0; i<6; ++i ) { small.insert( 10*i, i ); }
+  const int bumpItems[] = { 0, 1, 0 };
+  const int bumpDeltas[] = { 30, 100, 30 };
+  small.incrementPriorities( bumpItems, bumpDeltas, 3 );
+  small.print( stdout );
+
+  delete[] refKey;
+  delete[] in;
+}
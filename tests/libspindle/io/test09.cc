@@ -0,0 +1,139 @@
+//
+// test09.cc -- MatrixMarketFile reads with several threads, and from pipes
+//
+//
+
+#include <iostream.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector.h>
+#include <algo.h>
+#include "spindle/spindle.h"
+#include "spindle/MatrixMarketFile.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+struct Entry {
+  int i;
+  int j;
+  double val;
+};
+
+// column major, keeping duplicates in file order with stable_sort
+struct EntryColSort {
+  bool operator()( const Entry& a, const Entry& b ) const {
+    return ( a.j < b.j ) || ( ( a.j == b.j ) && ( a.i < b.i ) );
+  }
+};
+
+static unsigned int seed = 12345;
+static unsigned int
+nextRandom() {
+  seed = seed * 1103515245u + 12345u;
+  return ( seed >> 8 );
+}
+
+//
+// write nnz random entries in assorted number formats, remember what
+// they should read as.
+//
+static FILE *
+makeFile( const int nRows, const int nCols, const int nnz, vector<Entry>& entries ) {
+  FILE * fp = tmpfile();
+  if ( fp == 0 ) { return 0; }
+  fprintf( fp, "%%%%MatrixMarket matrix coordinate real general\n" );
+  fprintf( fp, "%% random entries, with duplicates\n" );
+  fprintf( fp, "%d %d %d\n", nRows, nCols, nnz );
+  char token[64];
+  for( int k=0; k<nnz; ++k ) {
+    Entry e;
+    e.i = nextRandom() % nRows;
+    e.j = nextRandom() % nCols;
+    const double x = ( (int) ( nextRandom() % 2000001 ) - 1000000 ) / 1024.0
+      * ( 1 + nextRandom() % 7 ) / 3.0;
+    switch( k % 6 ) {
+    case 0: sprintf( token, "%.17g", x ); break;
+    case 1: sprintf( token, "%.6e", x ); break;
+    case 2: sprintf( token, "%d", (int) x ); break;
+    case 3: sprintf( token, "%.3E", x * 1e-30 ); break;
+    case 4: sprintf( token, "%.5fD%+03d", x / 1000.0, 3 ); break;
+    default: sprintf( token, "%.2f", x ); break;
+    }
+    if ( k % 5 == 0 ) {
+      fprintf( fp, "\t%d\t%d\t%s\r\n", e.i+1, e.j+1, token );
+    } else {
+      fprintf( fp, "%d %d %s\n", e.i+1, e.j+1, token );
+    }
+    if ( k % 97 == 0 ) {
+      fprintf( fp, "\n" );
+    }
+    char * d = strchr( token, 'D' );
+    if ( d != 0 ) { *d = 'E'; }
+    e.val = strtod( token, 0 );
+    entries.push_back( e );
+  }
+  rewind( fp );
+  return fp;
+}
+
+// number of entries where matrix differs from entries
+static int
+compare( const MatrixBase& matrix, vector<Entry> entries ) {
+  stable_sort( entries.begin(), entries.end(), EntryColSort() );
+  const int * colPtr = matrix.getColPtr().lend();
+  const int * rowIdx = matrix.getRowIdx().lend();
+  const double * values = matrix.getRealValues().lend();
+  int nDiffer = 0;
+  for( int j=0; j<matrix.queryNCols(); ++j ) {
+    for( int k=colPtr[j]; k<colPtr[j+1]; ++k ) {
+      if ( ( entries[k].j != j ) || ( entries[k].i != rowIdx[k] ) ||
+	   ( entries[k].val != values[k] ) ) {
+	++nDiffer;
+      }
+    }
+  }
+  return nDiffer + ( (int) entries.size() - colPtr[ matrix.queryNCols() ] );
+}
+
+int main() {
+  vector<Entry> entries;
+  FILE * fp = makeFile( 97, 61, 20000, entries );
+  if ( fp == 0 ) {
+    cerr << "Error: Cannot create temporary file." << endl;
+    return -1;
+  }
+  const int nThreads[] = { 1, 4 };
+  for( int t=0; t<2; ++t ) {
+    MatrixMarketFile matrix;
+    matrix.setNThreads( nThreads[t] );
+    rewind( fp );
+    if ( !matrix.read( fp ) ) {
+      cerr << "Error: Cannot read with " << nThreads[t] << " threads." << endl;
+      return -1;
+    }
+    cout << nThreads[t] << " threads: " << matrix.queryNNonZeros() << " entries, differs in "
+	 << compare( matrix, entries ) << " places" << endl;
+  }
+  fclose( fp );
+
+  // a pipe can't be mapped, so it is read into memory instead
+  MatrixMarketFile fromFile;
+  fromFile.open( "input/simple.matrixmarket", "r" );
+  fromFile.read();
+  fromFile.close();
+  MatrixMarketFile fromPipe;
+  fromPipe.setNThreads( 3 );
+  fromPipe.open( "cat input/simple.matrixmarket |", "r" );
+  fromPipe.read();
+  fromPipe.close();
+  bool same = ( fromFile.queryNNonZeros() == fromPipe.queryNNonZeros() ) &&
+    ( fromFile.queryNNonZeros() > 0 );
+  for( int k=0; same && ( k<fromFile.queryNNonZeros() ); ++k ) {
+    same = ( fromFile.getRowIdx()[k] == fromPipe.getRowIdx()[k] ) &&
+      ( fromFile.getRealValues()[k] == fromPipe.getRealValues()[k] );
+  }
+  cout << "pipe same as file = " << ( same ? "yes" : "no" ) << endl;
+}
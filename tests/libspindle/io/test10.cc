@@ -0,0 +1,127 @@
+//
+// test10.cc -- ChacoFile reads long lines, weights, and vertex numbers
+//
+//
+
+#include <iostream.h>
+#include <stdio.h>
+#include "spindle/spindle.h"
+#include "spindle/ChacoFile.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+//
+// a ring of n vertices plus a hub (vertex 1) adjacent to all others.
+// The hub's line is far longer than any fixed line buffer.  Every
+// third line lists its neighbors backwards.
+//
+static int vtxWeightOf( const int i ) { return i % 7 + 1; }
+static int edgeWeightOf( const int i, const int j ) { return ( i + j ) % 5 + 1; }
+
+static void
+neighbors( const int n, const int i, int * adj, int& degree ) {
+  degree = 0;
+  if ( i == 0 ) {
+    for( int j=1; j<n; ++j ) { adj[ degree++ ] = j; }
+    return;
+  }
+  adj[ degree++ ] = 0;
+  const int prev = ( i == 1 ) ? n-1 : i-1;
+  const int next = ( i == n-1 ) ? 1 : i+1;
+  adj[ degree++ ] = ( prev < next ) ? prev : next;
+  adj[ degree++ ] = ( prev < next ) ? next : prev;
+}
+
+static FILE *
+makeFile( const int n, int * adj ) {
+  FILE * fp = tmpfile();
+  if ( fp == 0 ) { return 0; }
+  fprintf( fp, "%% hub and ring\n%d %d 11\n", n, 2*(n-1) );
+  for( int i=0; i<n; ++i ) {
+    int degree;
+    neighbors( n, i, adj, degree );
+    fprintf( fp, "%d", vtxWeightOf( i ) );
+    for( int k=0; k<degree; ++k ) {
+      const int j = ( i % 3 == 0 ) ? adj[ degree-1-k ] : adj[k];
+      fprintf( fp, ( k % 2 ) ? " %d %d" : "\t%d  %d", j+1, edgeWeightOf( i, j ) );
+    }
+    fprintf( fp, ( i % 4 == 0 ) ? " \r\n" : "\n" );
+    if ( i % 1000 == 500 ) {
+      fprintf( fp, "%% a comment between vertices\n" );
+    }
+  }
+  rewind( fp );
+  return fp;
+}
+
+// number of places where graph differs from the hub and ring
+static int
+compare( const ChacoFile& graph, const int n, int * adj ) {
+  if ( ( graph.queryNVtxs() != n ) || graph.getVtxWeight().isNull() ||
+       graph.getEdgeWeight().isNull() ) {
+    return -1;
+  }
+  const int * adjHead = graph.getAdjHead().lend();
+  const int * adjList = graph.getAdjList().lend();
+  const int * vtxWeight = graph.getVtxWeight().lend();
+  const int * edgeWeight = graph.getEdgeWeight().lend();
+  int nDiffer = 0;
+  for( int i=0; i<n; ++i ) {
+    int degree;
+    neighbors( n, i, adj, degree );
+    if ( ( adjHead[i+1] - adjHead[i] != degree ) || ( vtxWeight[i] != vtxWeightOf( i ) ) ) {
+      ++nDiffer;
+      continue;
+    }
+    for( int k=0; k<degree; ++k ) {
+      const int j = adjHead[i] + k;
+      if ( ( adjList[j] != adj[k] ) || ( edgeWeight[j] != edgeWeightOf( i, adj[k] ) ) ) {
+	++nDiffer;
+      }
+    }
+  }
+  return nDiffer;
+}
+
+int main() {
+  const int n = 30000;
+  int * adj = new int[ n ];
+  FILE * fp = makeFile( n, adj );
+  if ( fp == 0 ) {
+    cerr << "Error: Cannot create temporary file." << endl;
+    return -1;
+  }
+  const int nThreads[] = { 1, 4 };
+  for( int t=0; t<2; ++t ) {
+    ChacoFile graph;
+    graph.setNThreads( nThreads[t] );
+    rewind( fp );
+    if ( !graph.read( fp ) ) {
+      cerr << "Error: Cannot read with " << nThreads[t] << " threads." << endl;
+      return -1;
+    }
+    cout << nThreads[t] << " threads: " << graph.queryNVtxs() << " vertices, "
+	 << graph.getAdjHead()[n] << " edge entries, differs in "
+	 << compare( graph, n, adj ) << " places" << endl;
+  }
+  fclose( fp );
+  delete[] adj;
+
+  // with vertex numbers, line k describes vertex 4,2,3,1
+  fp = tmpfile();
+  fprintf( fp, "4 3 100\n4 2\n2 1 3 4\n3 2\n1 2\n" );
+  rewind( fp );
+  ChacoFile numbered;
+  numbered.read( fp );
+  fclose( fp );
+  cout << "numbered:";
+  for( int i=0; i<numbered.queryNVtxs(); ++i ) {
+    cout << " " << i+1 << ":";
+    for( int j=numbered.getAdjHead()[i]; j<numbered.getAdjHead()[i+1]; ++j ) {
+      cout << " " << numbered.getAdjList()[j]+1;
+    }
+  }
+  cout << endl;
+}
@@ -0,0 +1,88 @@
+//
+// test11.cc -- Harwell Boeing values in D, scaled, and sign-only exponents,
+//              and implied decimal points
+//
+//
+
+#include <iostream.h>
+#include <stdio.h>
+#include <string.h>
+#include "spindle/spindle.h"
+#include "spindle/HarwellBoeingFile.h"
+#include "spindle/FortranEmulator.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+//
+// a 3x3 matrix with five values and one dense right hand side.
+// The values are in 1P,3D12.4 so the last, without an exponent, is
+// scaled by 1/10.
+//
+static const char * hbFile =
+"values in assorted Fortran forms                                        test11  \n"
+"             5             1             1             2             1\n"
+"RUA                        3             3             5             0\n"
+"(4I3)           (5I3)           (1P,3D12.4)         (3F8.2)             \n"
+"F                          1             0\n"
+"  1  3  4  6\n"
+"  1  3  2  1  3\n"
+"  1.5000D+00 -2.5000d+00  3.0000E-01\n"
+"  1.2500+003      2.5000\r\n"
+"    1.00   -2.00    3.00\n";
+
+int main() {
+  FILE * fp = tmpfile();
+  if ( fp == 0 ) {
+    cerr << "Error: Cannot create temporary file." << endl;
+    return -1;
+  }
+  fputs( hbFile, fp );
+  rewind( fp );
+  HarwellBoeingFile matrix;
+  if ( !matrix.read( fp ) ) {
+    cerr << "Error: Cannot read Harwell Boeing file." << endl;
+    return -1;
+  }
+  fclose( fp );
+  for( int j=0; j<matrix.queryNCols(); ++j ) {
+    for( int k=matrix.getColPtr()[j]; k<matrix.getColPtr()[j+1]; ++k ) {
+      printf( "(%d,%d) = %g\n", matrix.getRowIdx()[k], j, matrix.getRealValues()[k] );
+    }
+  }
+  printf( "rhs =" );
+  for( int i=0; i<matrix.queryNRows(); ++i ) {
+    printf( " %g", matrix.getRHS_realValues()[i] );
+  }
+  printf( "\n" );
+
+  // bad fields and formats are refused
+  FortranEmulator::Format format;
+  const char * formats[] = { "(16I5)", "(1P4E20.12)", "( 26A3 )", "(-1P,2F6.1)", "(E12)" };
+  for( int f=0; f<5; ++f ) {
+    const bool ok = FortranEmulator::compile( formats[f], format );
+    printf( "%s: %s", formats[f], ok ? "ok" : "refused" );
+    if ( ok ) {
+      printf( " %d%c%d.%d scale %d", format.perLine, format.type, format.width,
+	      format.digits, format.scale );
+    }
+    printf( "\n" );
+  }
+  // without a decimal point, the last digits are the fraction
+  FortranEmulator::compile( "(3F8.3)", format );
+  const char * implied = "   12345    -250     1.5\n    12E2       7\n";
+  const char * q = implied;
+  double values[5];
+  if ( FortranEmulator::readArray( q, implied + strlen( implied ), format, 2, values, 5 ) ) {
+    printf( "implied decimals = %g %g %g %g %g\n", values[0], values[1], values[2],
+	    values[3], values[4] );
+  }
+  FortranEmulator::compile( "(3I4)", format );
+  const char * bad = "   1   x   3\n";
+  const char * p = bad;
+  int array[3];
+  printf( "bad field read = %s\n",
+	  FortranEmulator::readArray( p, bad + strlen( bad ), format, 1, array, 3 ) ?
+	  "yes" : "no" );
+}
@@ -0,0 +1,218 @@
+//
+// test12.cc -- SnapshotFile round trips Graphs and Matrices
+//
+//
+
+#include <iostream.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "spindle/spindle.h"
+#include "spindle/SpindleSystem.h"
+#include "spindle/SnapshotFile.h"
+#include "spindle/Graph.h"
+#include "spindle/Matrix.h"
+#include "spindle/MatrixMarketFile.h"
+
+#include "samples/grid_mesh.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+//
+// an nx by ny grid, weighted, whose last vertex is isolated
+//
+static Graph *
+makeGrid( const int nx, const int ny ) {
+  const int n = nx * ny + 1;
+  int * adjHead = new int[ n + 1 ];
+  int * adjList = new int[ 4 * n ];
+  int * vtxWeight = new int[ n ];
+  int * edgeWeight = new int[ 4 * n ];
+  const int k = appendGrid( nx, ny, 1, false, 0, 0, adjHead, adjList );
+  adjHead[n-1] = k;
+  adjHead[n] = k;
+  for( int v=0; v<n; ++v ) {
+    vtxWeight[v] = v % 3 + 1;
+  }
+  for( int j=0; j<k; ++j ) {
+    edgeWeight[j] = j % 5 + 1;
+  }
+  Graph * graph = new Graph( n, (const int *) adjHead, (const int *) adjList,
+			     (const int *) vtxWeight, (const int *) edgeWeight );
+  graph->validate();
+  delete[] adjHead;
+  delete[] adjList;
+  delete[] vtxWeight;
+  delete[] edgeWeight;
+  return graph;
+}
+
+template < class T >
+static bool
+same( const SharedArray<T>& a, const SharedArray<T>& b ) {
+  if ( a.size() != b.size() ) {
+    return false;
+  }
+  for( int i=0; i<a.size(); ++i ) {
+    if ( a[i] != b[i] ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool
+same( const Graph& a, const Graph& b ) {
+  return a.isValid() && b.isValid() && ( a.queryNVtxs() == b.queryNVtxs() ) &&
+    same( a.getAdjHead(), b.getAdjHead() ) && same( a.getAdjList(), b.getAdjList() ) &&
+    same( a.getAdjSelf(), b.getAdjSelf() ) && ( a.queryNEdges() == b.queryNEdges() ) &&
+    same( a.getVtxWeight(), b.getVtxWeight() ) && same( a.getEdgeWeight(), b.getEdgeWeight() );
+}
+
+// copy nBytes of from into a new temporary file, byte swapping words after the magic
+static FILE *
+copy( FILE * from, const long nBytes, const bool swap ) {
+  FILE * to = tmpfile();
+  rewind( from );
+  char * buffer = new char[ nBytes ];
+  fread( buffer, 1, nBytes, from );
+  if ( swap ) {
+    for( long i=8; i+4<=nBytes; i+=4 ) {
+      char c = buffer[i];   buffer[i] = buffer[i+3];   buffer[i+3] = c;
+      c = buffer[i+1];      buffer[i+1] = buffer[i+2]; buffer[i+2] = c;
+    }
+  }
+  fwrite( buffer, 1, nBytes, to );
+  delete[] buffer;
+  rewind( to );
+  return to;
+}
+
+// copy of from with the header's checked flag (the int at byte 48)
+// cleared, so that the reader does not trust it
+static FILE *
+uncheck( FILE * from, const long nBytes ) {
+  FILE * to = copy( from, nBytes, false );
+  const int flags = 0;
+  fseek( to, 48, SEEK_SET );
+  fwrite( &flags, sizeof(int), 1, to );
+  rewind( to );
+  return to;
+}
+
+// unchecked copy of from with the int at byte offset at replaced by value
+static FILE *
+corrupt( FILE * from, const long nBytes, const long at, const int value ) {
+  FILE * to = uncheck( from, nBytes );
+  fseek( to, at, SEEK_SET );
+  fwrite( &value, sizeof(int), 1, to );
+  rewind( to );
+  return to;
+}
+
+int main() {
+  SpindleSystem::setErrorFile( 0 );
+
+  // graph
+  Graph * grid = makeGrid( 30, 20 );
+  FILE * fp = tmpfile();
+  SnapshotFile out;
+  cout << "write graph = " << ( out.write( fp, grid ) ? "yes" : "no" ) << endl;
+  const long nBytes = ftell( fp );
+  {
+    rewind( fp );
+    SnapshotFile in;
+    Graph graph;
+    const bool ok = in.read( fp ) && ( in.queryKind() == SnapshotFile::GRAPH ) &&
+      in.lend( &graph );
+    cout << "read graph = " << ( ok ? "yes" : "no" )
+	 << ", checked = " << ( in.isChecked() ? "yes" : "no" )
+	 << ", same = " << ( same( *grid, graph ) ? "yes" : "no" )
+	 << ", borrowed = " << ( graph.getAdjList().notMine() ? "yes" : "no" ) << endl;
+  }
+  {
+    FILE * swapped = copy( fp, nBytes, true );
+    SnapshotFile in;
+    Graph graph;
+    const bool ok = in.read( swapped ) && in.lend( &graph );
+    cout << "read swapped graph = " << ( ok ? "yes" : "no" )
+	 << ", same = " << ( same( *grid, graph ) ? "yes" : "no" )
+	 << ", zero copy = " << ( in.isZeroCopy() ? "yes" : "no" ) << endl;
+    fclose( swapped );
+  }
+  {
+    // an unchecked copy is validated, and comes out the same
+    FILE * unchecked = uncheck( fp, nBytes );
+    SnapshotFile in;
+    Graph graph;
+    const bool ok = in.read( unchecked ) && in.lend( &graph );
+    cout << "read unchecked graph = " << ( ok ? "yes" : "no" )
+	 << ", checked = " << ( in.isChecked() ? "yes" : "no" )
+	 << ", same = " << ( same( *grid, graph ) ? "yes" : "no" ) << endl;
+    fclose( unchecked );
+  }
+  {
+    FILE * shortFile = copy( fp, nBytes - 4, false );
+    SnapshotFile in;
+    cout << "read truncated = " << ( in.read( shortFile ) ? "yes" : "no" ) << endl;
+    fclose( shortFile );
+  }
+  {
+    // the header is 64 bytes, and each array starts on a 64 byte boundary
+    const long headAt = 64;
+    const long listAt = headAt + ( ( ( grid->queryNVtxs() + 1 ) * 4 + 63 ) / 64 ) * 64;
+    FILE * badHead = corrupt( fp, nBytes, headAt + 5*4, 1000000 );
+    FILE * badList = corrupt( fp, nBytes, listAt + 3*4, grid->queryNVtxs() );
+    FILE * negList = corrupt( fp, nBytes, listAt + 7*4, -1 );
+    SnapshotFile in1;
+    SnapshotFile in2;
+    SnapshotFile in3;
+    Graph graph2;
+    Graph graph3;
+    cout << "read decreasing pointers = " << ( in1.read( badHead ) ? "yes" : "no" ) << endl;
+    cout << "read vertex out of range = " << ( in2.read( badList ) ? "yes" : "no" )
+	 << ", lend = " << ( in2.lend( &graph2 ) ? "yes" : "no" ) << endl;
+    cout << "read negative vertex = " << ( in3.read( negList ) ? "yes" : "no" )
+	 << ", lend = " << ( in3.lend( &graph3 ) ? "yes" : "no" ) << endl;
+    fclose( badHead );
+    fclose( badList );
+    fclose( negList );
+  }
+  {
+    FILE * notSnapshot = tmpfile();
+    fprintf( notSnapshot, "%%%%MatrixMarket matrix coordinate real general\n"
+	     "2 2 1\n1 1 1.0\n                                                     \n" );
+    rewind( notSnapshot );
+    SnapshotFile in;
+    cout << "read text = " << ( in.read( notSnapshot ) ? "yes" : "no" ) << endl;
+    fclose( notSnapshot );
+  }
+  fclose( fp );
+  delete grid;
+
+  // matrix
+  MatrixMarketFile mm;
+  mm.open( "input/simple.matrixmarket", "r" );
+  mm.read();
+  mm.close();
+  Matrix original( &mm );
+  original.validate();
+  fp = tmpfile();
+  cout << "write matrix = " << ( out.write( fp, &original ) ? "yes" : "no" ) << endl;
+  rewind( fp );
+  {
+    SnapshotFile in;
+    Matrix matrix;
+    Graph graph;
+    const bool ok = in.read( fp ) && in.lend( &matrix );
+    cout << "read matrix = " << ( ok ? "yes" : "no" )
+	 << ", checked = " << ( in.isChecked() ? "yes" : "no" )
+	 << ", same = " << ( ( same( original.getColPtr(), matrix.getColPtr() ) &&
+			       same( original.getRowIdx(), matrix.getRowIdx() ) &&
+			       same( original.getRealValues(), matrix.getRealValues() ) ) ?
+			     "yes" : "no" )
+	 << ", as graph = " << ( in.lend( &graph ) ? "yes" : "no" ) << endl;
+  }
+  fclose( fp );
+}
@@ -0,0 +1,102 @@
+//
+// test13.cc -- ChacoFile writes what it reads: vertex weights only,
+//              edge weights only, and both
+//
+//
+
+#include <iostream.h>
+#include <stdio.h>
+#include <string.h>
+#include "spindle/spindle.h"
+#include "spindle/ChacoFile.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+static bool
+same( const SharedArray<int>& a, const SharedArray<int>& b ) {
+  if ( a.size() != b.size() ) {
+    return false;
+  }
+  for( int i=0; i<a.size(); ++i ) {
+    if ( a.lend()[i] != b.lend()[i] ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool
+sameGraph( const ChacoFile& a, const ChacoFile& b ) {
+  return ( a.queryNVtxs() == b.queryNVtxs() ) &&
+    same( a.getAdjHead(), b.getAdjHead() ) && same( a.getAdjList(), b.getAdjList() ) &&
+    same( a.getVtxWeight(), b.getVtxWeight() ) && same( a.getEdgeWeight(), b.getEdgeWeight() );
+}
+
+static const char *
+yes( const bool b ) {
+  return b ? "yes" : "no";
+}
+
+//
+// reads text, writes it back out with the given code (-1 for the
+// weights the graph has), and reads that.  Prints the header written.
+//
+static bool
+roundTrip( const char * text, const int code ) {
+  FILE * in = tmpfile();
+  FILE * out = tmpfile();
+  if ( ( in == 0 ) || ( out == 0 ) ) {
+    cerr << "Error: Cannot create temporary file." << endl;
+    return false;
+  }
+  fputs( text, in );
+  rewind( in );
+  ChacoFile original;
+  ChacoFile copy;
+  const bool readOk = original.read( in );
+  original.setCode( code );
+  const bool writeOk = readOk && original.write( out );
+  rewind( out );
+  char line[ 256 ];
+  char header[ 256 ];
+  header[0] = '\0';
+  while( fgets( line, sizeof(line), out ) != 0 ) {
+    if ( line[0] != '%' ) {
+      strcpy( header, line );
+      break;
+    }
+  }
+  if ( header[0] != '\0' ) {
+    header[ strlen(header)-1 ] = '\0';
+  }
+  rewind( out );
+  const bool copyOk = writeOk && copy.read( out );
+  fclose( in );
+  fclose( out );
+  cout << "  code " << code << ": header \"" << header << "\", read back = " << yes( copyOk )
+       << ", vertex weights = " << yes( copy.getVtxWeight().notNull() )
+       << ", edge weights = " << yes( copy.getEdgeWeight().notNull() );
+  if ( code == -1 ) {
+    cout << ", same graph = " << yes( copyOk && sameGraph( original, copy ) );
+  }
+  cout << endl;
+  return copyOk;
+}
+
+int main() {
+  // a path 1-2-3-4 with a chord 1-3
+  const char * vtxWeighted = "4 4 10\n5 2 3\n6 1 3\n7 1 2 4\n8 3\n";
+  const char * edgeWeighted = "4 4 1\n2 11 3 13\n1 11 3 23\n1 13 2 23 4 34\n3 34\n";
+  const char * bothWeighted = "4 4 11\n5 2 11 3 13\n6 1 11 3 23\n7 1 13 2 23 4 34\n8 3 34\n";
+  cout << "vertex weights only:" << endl;
+  roundTrip( vtxWeighted, -1 );
+  roundTrip( vtxWeighted, 11 );
+  cout << "edge weights only:" << endl;
+  roundTrip( edgeWeighted, -1 );
+  roundTrip( edgeWeighted, 11 );
+  cout << "both:" << endl;
+  roundTrip( bothWeighted, -1 );
+  roundTrip( bothWeighted, 0 );
+}
@@ -0,0 +1,81 @@
+//
+// test07.cc -- compile-time vs. runtime minimum priority strategies
+//
+// $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+//
+
+#include <iostream.h>
+#include "spindle/Graph.h"
+#include "spindle/MinPriorityEngine.h"
+#include "spindle/MinPriorityEngineT.h"
+#include "spindle/MinPriorityStrategies.h"
+#include "samples/fe_mesh.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+//
+// order the graph once through the virtual strategy and once through
+// the compiled-in strategy; the permutations must match exactly.
+//
+template< class Strategy >
+bool compare( const Graph& graph, const char* name, MinPriorityStrategies* runtime ) {
+  MinPriorityEngine dynamic( &graph );
+  dynamic.setRandomizeGraph( false );
+  dynamic.setPriorityStrategy( runtime );
+  dynamic.execute();
+
+  MinPriorityEngineT< Strategy > fixed( &graph );
+  fixed.setRandomizeGraph( false );
+  fixed.execute();
+
+  const PermutationMap * perm1 = dynamic.getPermutation();
+  const PermutationMap * perm2 = fixed.getPermutation();
+  if ( ( perm1 == 0 ) || ( !perm1->isValid() ) ||
+       ( perm2 == 0 ) || ( !perm2->isValid() ) ) {
+    cerr << "Error: could not confirm a valid permutation." << endl;
+    return false;
+  }
+  const int * new2Old1 = perm1->getNew2Old().lend();
+  const int * new2Old2 = perm2->getNew2Old().lend();
+  bool same = true;
+  cout << name << ":";
+  for ( int i=0; i<nvtxs; ++i ) {
+    cout << " " << new2Old2[i];
+    if ( new2Old1[i] != new2Old2[i] ) {
+      same = false;
+    }
+  }
+  cout << endl << name << ( same ? " matches" : " DIFFERS" ) << endl;
+  return same;
+}
+
+int main() {
+  Graph graph(nvtxs, (const int*) Aptr, (const int*)Aind);
+  graph.validate();
+  if ( ! graph.isValid() ) {
+    cerr << "Error: Cannot create valid graph." << endl;
+  }
+
+  compare< MinPriority_ExternalDegree >( graph, "MMD",
+					 new MinPriority_ExternalDegree( nvtxs ) );
+  compare< MinPriority_ApproximateDegree >( graph, "AMD",
+					    new MinPriority_ApproximateDegree( nvtxs ) );
+  compare< MinPriority_AMF >( graph, "AMF", new MinPriority_AMF( nvtxs ) );
+  compare< MinPriority_MMDF >( graph, "MMDF", new MinPriority_MMDF( nvtxs ) );
+}
@@ -0,0 +1,85 @@
+//
+// test08.cc -- multithreaded multiple minimum degree on a grid
+//
+// $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+//
+
+#include <iostream.h>
+#include "spindle/Graph.h"
+#include "spindle/MinPriorityEngine.h"
+#include "spindle/MinPriorityStrategies.h"
+
+#include "samples/grid_mesh.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+static int *
+orderIt( const Graph& graph, const int nThreads ) {
+  MinPriorityEngine ordering( &graph );
+  ordering.setRandomizeGraph( false );
+  ordering.setPriorityStrategy( new MinPriority_ExternalDegree( graph.queryNVtxs() ) );
+  ordering.setNThreads( nThreads );
+  ordering.execute();
+
+  const PermutationMap * perm = ordering.getPermutation();
+  if ( ( perm == 0 ) || ( !perm->isValid() ) ) {
+    cerr << "Error: could not confirm a valid permutation." << endl;
+    return 0;
+  }
+  const int n = graph.queryNVtxs();
+  int * new2Old = new int[ n ];
+  const int * p = perm->getNew2Old().lend();
+  for( int i=0; i<n; ++i ) {
+    new2Old[i] = p[i];
+  }
+  return new2Old;
+}
+
+int main() {
+  const int k = 100;
+  const int n = k*k;
+  int * adjHead = new int[ n+1 ];
+  int * adjList = new int[ 4*n ];
+  makeFivePointGrid( k, adjHead, adjList );
+
+  Graph graph( n, (const int*) adjHead, (const int*) adjList );
+  graph.validate();
+  if ( ! graph.isValid() ) {
+    cerr << "Error: Cannot create valid graph." << endl;
+  }
+
+  int * serial = orderIt( graph, 1 );
+  int * threaded = orderIt( graph, 4 );
+  if ( serial == 0 || threaded == 0 ) {
+    return -1;
+  }
+  int nDiffer = 0;
+  for( int i=0; i<n; ++i ) {
+    if ( serial[i] != threaded[i] ) {
+      ++nDiffer;
+    }
+  }
+  cout << "ordered " << n << " vertices with 1 and 4 threads" << endl;
+  cout << "positions that differ: " << nDiffer << endl;
+
+  delete[] serial;
+  delete[] threaded;
+  delete[] adjHead;
+  delete[] adjList;
+}
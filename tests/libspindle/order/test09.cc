@@ -0,0 +1,169 @@
+//
+// test09.cc -- nested dissection on a 3D grid
+//
+// $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+//
+
+#include <iostream.h>
+#include "spindle/Graph.h"
+#include "spindle/NestedDissectionEngine.h"
+#include "spindle/MinPriorityEngine.h"
+#include "spindle/SymbolicFactorization.h"
+
+#include "samples/grid_mesh.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+static long
+factorSize( const Graph& graph, const PermutationMap* perm ) {
+  SymbolicFactorization symbfact;
+  if ( ( !symbfact.setGraph( &graph ) ) ||
+       ( !symbfact.setPermutationMap( perm ) ) ||
+       ( !symbfact.execute() ) ) {
+    cerr << "Error doing symbolic factorization." << endl;
+    return -1;
+  }
+  return symbfact.querySize();
+}
+
+//
+// order a k-by-k-by-k grid with nested dissection on 1 and 4 threads
+// and compare with minimum degree.  Returns false on any failure.
+//
+static bool
+orderGrid( const int k ) {
+  const int n = k*k*k;
+  int * adjHead = new int[ n+1 ];
+  int * adjList = new int[ 6*n ];
+  makeSevenPointGrid( k, adjHead, adjList );
+
+  Graph graph( n, (const int*) adjHead, (const int*) adjList );
+  delete[] adjHead;
+  delete[] adjList;
+  graph.validate();
+  if ( ! graph.isValid() ) {
+    cerr << "Error: Cannot create valid graph." << endl;
+    return false;
+  }
+
+  NestedDissectionEngine nd1( &graph );
+  nd1.setMaxLeafSize( 64 );
+  NestedDissectionEngine nd4( &graph );
+  nd4.setMaxLeafSize( 64 );
+  nd4.setNThreads( 4 );
+  if ( ( !nd1.execute() ) || ( !nd4.execute() ) ) {
+    cerr << "Error: nested dissection failed on a " << k << "^3 grid." << endl;
+    return false;
+  }
+
+  const PermutationMap * perm1 = nd1.getPermutation();
+  const PermutationMap * perm4 = nd4.getPermutation();
+  if ( ( perm1 == 0 ) || ( !perm1->isValid() ) ||
+       ( perm4 == 0 ) || ( !perm4->isValid() ) ) {
+    cerr << "Error: could not confirm a valid permutation." << endl;
+    return false;
+  }
+  const int * new2Old1 = perm1->getNew2Old().lend();
+  const int * new2Old4 = perm4->getNew2Old().lend();
+  int nDiffer = 0;
+  for( int i=0; i<n; ++i ) {
+    if ( new2Old1[i] != new2Old4[i] ) {
+      ++nDiffer;
+    }
+  }
+  cout << "ordered " << n << " vertices with 1 and 4 threads" << endl;
+  cout << "positions that differ: " << nDiffer << endl;
+  cout << "levels = " << nd1.queryNLevels() << ", leaves = " << nd1.queryNLeaves()
+       << ", separator vertices = " << nd1.queryNSeparatorVtxs() << endl;
+
+  MinPriorityEngine mmd( &graph );
+  mmd.setRandomizeGraph( false );
+  if ( !mmd.execute() ) {
+    cerr << "Error: minimum degree failed." << endl;
+    return false;
+  }
+
+  const long ndSize = factorSize( graph, perm1 );
+  const long mmdSize = factorSize( graph, mmd.getPermutation() );
+  cout << "size of factor with nested dissection = " << ndSize << endl;
+  cout << "size of factor with minimum degree    = " << mmdSize << endl;
+  return ( ndSize > 0 ) && ( mmdSize > 0 );
+}
+
+//
+// order a graph on which one vertex is adjacent to all the others:
+// a wheel (a hub and a cycle) or a clique.  Neither has a level
+// structure deeper than two levels from that vertex.
+//
+static bool
+orderHub( const int n, const bool clique ) {
+  int * adjHead = new int[ n+1 ];
+  int * adjList = new int[ n*n ];
+  int nnz = 0;
+  for( int v=0; v<n; ++v ) {
+    adjHead[ v ] = nnz;
+    for( int w=0; w<n; ++w ) {
+      const bool onCycle = ( v > 0 ) && ( w > 0 ) &&
+	( ( w == v+1 ) || ( w == v-1 ) || ( w-v == n-2 ) || ( v-w == n-2 ) );
+      if ( ( w != v ) && ( clique || ( v == 0 ) || ( w == 0 ) || onCycle ) ) {
+	adjList[ nnz++ ] = w;
+      }
+    }
+  }
+  adjHead[ n ] = nnz;
+
+  Graph graph( n, (const int*) adjHead, (const int*) adjList );
+  delete[] adjHead;
+  delete[] adjList;
+  graph.validate();
+  if ( ! graph.isValid() ) {
+    cerr << "Error: Cannot create valid graph." << endl;
+    return false;
+  }
+  NestedDissectionEngine nd;
+  nd.setCompressionRatio( 0.0 );  // a clique would compress to one vertex
+  nd.setMaxLeafSize( 16 );
+  nd.setGraph( &graph );
+  if ( !nd.execute() ) {
+    cerr << "Error: nested dissection failed on a " << n << " vertex "
+	 << ( clique ? "clique" : "wheel" ) << "." << endl;
+    return false;
+  }
+  const PermutationMap * perm = nd.getPermutation();
+  if ( ( perm == 0 ) || ( !perm->isValid() ) ) {
+    cerr << "Error: could not confirm a valid permutation." << endl;
+    return false;
+  }
+  cout << ( clique ? "clique" : "wheel" ) << " of " << n << " vertices: levels = "
+       << nd.queryNLevels() << ", leaves = " << nd.queryNLeaves()
+       << ", separator vertices = " << nd.queryNSeparatorVtxs()
+       << ", size of factor = " << factorSize( graph, perm ) << endl;
+  return true;
+}
+
+int main() {
+  // 16^3 and up have leaves whose local numbering is not sorted
+  if ( ( !orderGrid( 12 ) ) || ( !orderGrid( 16 ) ) ) {
+    return -1;
+  }
+  // larger than a leaf, but no interior level to cut along
+  if ( ( !orderHub( 100, false ) ) || ( !orderHub( 100, true ) ) ) {
+    return -1;
+  }
+}
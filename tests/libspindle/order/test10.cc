@@ -0,0 +1,125 @@
+//
+// test10.cc -- sloan with the bucket queue, the 4-ary heap and the binary heap
+//
+// $Id$
+//
+//  agent
+//  Copyright(c) 2026.  All rights reserved.
+//
+//  Permission to use, copy, modify, distribute and sell this software and
+//  its documentation for any purpose is hereby granted without fee,
+//  provided that the above copyright notice appear in all copies and
+//  that both that copyright notice and this permission notice appear
+//  in supporting documentation.  The author makes no
+//  representations about the suitability of this software for any
+//  purpose.  It is provided "as is" without express or implied warranty.
+//
+///////////////////////////////////////////////////////////////////////
+//
+//
+
+#include <iostream.h>
+#include "spindle/Graph.h"
+#include "spindle/SloanEngine.h"
+
+#include "samples/grid_mesh.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+//
+// build the adjacency of two disjoint nine point grids, k1-by-k1 and
+// k2-by-k2, with the vertices of the second one numbered first
+//
+static int
+makeGrids( const int k1, const int k2, int * adjHead, int * adjList ) {
+  const int nnz = appendGrid( k2, k2, 1, true, 0, 0, adjHead, adjList );
+  adjHead[ k2*k2 + k1*k1 ] = appendGrid( k1, k1, 1, true, k2*k2, nnz, adjHead, adjList );
+  return k2*k2 + k1*k1;
+}
+
+static bool
+runSloan( const Graph& graph, const bool useBuckets, const bool useDaryHeap, int * new2Old,
+	  double& sumSquares, int& maxWavefront, bool& usedBuckets ) {
+  SloanEngine sloan( &graph );
+  if ( useBuckets ) {
+    sloan.enableBucketQueue();
+  } else {
+    sloan.disableBucketQueue();
+  }
+  if ( useDaryHeap ) {
+    sloan.enableDaryHeap();
+  }
+  if ( !sloan.execute() ) { return false; }
+  const PermutationMap * perm = sloan.getPermutation();
+  if ( ( perm == 0 ) || ( !perm->isValid() ) ) { return false; }
+  const int n = graph.queryNVtxs();
+  const int * p = perm->getNew2Old().lend();
+  const int * wf = sloan.getWavefront().lend();
+  sumSquares = 0;
+  maxWavefront = 0;
+  for( int i=0; i<n; ++i ) {
+    new2Old[i] = p[i];
+    sumSquares += ((double)wf[i]) * wf[i];
+    maxWavefront = ( wf[i] > maxWavefront ) ? wf[i] : maxWavefront;
+  }
+  usedBuckets = sloan.queryUsedBucketQueue();
+  return true;
+}
+
+int main() {
+  const int k1 = 40;
+  const int k2 = 15;
+  const int nMax = k1*k1 + k2*k2;
+  int * adjHead = new int[ nMax+1 ];
+  int * adjList = new int[ 8*nMax ];
+  const int n = makeGrids( k1, k2, adjHead, adjList );
+
+  Graph graph( n, (const int*) adjHead, (const int*) adjList );
+  graph.validate();
+  if ( ! graph.isValid() ) {
+    cerr << "Error: Cannot create valid graph." << endl;
+  }
+
+  int * heapNew2Old = new int[ n ];
+  int * bucketNew2Old = new int[ n ];
+  int * daryNew2Old = new int[ n ];
+  double heapSquares, bucketSquares, darySquares;
+  int heapMax, bucketMax, daryMax;
+  bool heapUsedBuckets, bucketUsedBuckets, daryUsedBuckets;
+  if ( ( !runSloan( graph, false, false, heapNew2Old, heapSquares, heapMax, heapUsedBuckets ) ) ||
+       ( !runSloan( graph, true, false, bucketNew2Old, bucketSquares, bucketMax, bucketUsedBuckets ) ) ||
+       ( !runSloan( graph, false, true, daryNew2Old, darySquares, daryMax, daryUsedBuckets ) ) ) {
+    cerr << "Error: could not confirm a valid permutation." << endl;
+    return -1;
+  }
+
+  // each grid must still be numbered as one contiguous block
+  int nSplit = 0;
+  for( int i=1; i<n; ++i ) {
+    if ( ( bucketNew2Old[i-1] < k2*k2 ) != ( bucketNew2Old[i] < k2*k2 ) ) {
+      ++nSplit;
+    }
+  }
+
+  cout << "ordered " << n << " vertices in two components" << endl;
+  cout << "heap run used buckets:   " << ( heapUsedBuckets ? "yes" : "no" ) << endl;
+  cout << "bucket run used buckets: " << ( bucketUsedBuckets ? "yes" : "no" ) << endl;
+  cout << "component boundaries crossed: " << nSplit << endl;
+  cout << "max wavefront with heap    = " << heapMax << endl;
+  cout << "max wavefront with buckets = " << bucketMax << endl;
+  const double ratio = bucketSquares / heapSquares;
+  cout << "mean square wavefront within 5% of the heap: "
+       << ( ( ratio > 0.95 && ratio < 1.05 ) ? "yes" : "no" ) << endl;
+  const double daryRatio = darySquares / heapSquares;
+  cout << "4-ary heap run used buckets: " << ( daryUsedBuckets ? "yes" : "no" ) << endl;
+  cout << "mean square wavefront with the 4-ary heap within 5% of the binary heap: "
+       << ( ( daryRatio > 0.95 && daryRatio < 1.05 ) ? "yes" : "no" ) << endl;
+
+  delete[] heapNew2Old;
+  delete[] bucketNew2Old;
+  delete[] daryNew2Old;
+  delete[] adjHead;
+  delete[] adjList;
+}
@@ -0,0 +1,185 @@
+//
+// src/order/drivers/tests/test11.cc
+//
+//
+// compares RCM orderings with the neighbors of each vertex sorted by
+// degree against a plain queue based Cuthill-McKee, and orderings
+// computed with several threads against single threaded ones.
+
+#include <iostream.h>
+#include "spindle/Graph.h"
+#include "spindle/RCMEngine.h"
+#include "spindle/PermutationMap.h"
+#include "samples/small_mesh.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+static unsigned int seed = 1357;
+
+static int
+nextRandom( const int n ) {
+  seed = seed * 1103515245 + 12345;
+  return (int) ( ( seed >> 16 ) % n );
+}
+
+//
+// build a k-by-k-by-k seven point grid.  If shortcuts is set, a random
+// tenth of the vertices also get one extra neighbor from a random
+// matching, so the degrees vary.
+//
+static int
+makeGraph( const int k, const bool shortcuts, int * adjHead, int * adjList ) {
+  const int n = k*k*k;
+  int * partner = new int[n];
+  {for( int v=0; v<n; ++v ) { partner[v] = -1; }}
+  if ( shortcuts ) {
+    {for( int t=0; t<n/20; ++t ) {
+      const int v = nextRandom( n );
+      const int w = nextRandom( n );
+      if ( ( v != w ) && ( partner[v] < 0 ) && ( partner[w] < 0 ) ) {
+	partner[v] = w;
+	partner[w] = v;
+      }
+    }}
+  }
+  int nnz = 0;
+  for( int i=0; i<k; ++i ) {
+    for( int j=0; j<k; ++j ) {
+      for( int l=0; l<k; ++l ) {
+	const int v = (i*k+j)*k+l;
+	adjHead[ v ] = nnz;
+	if ( i>0 )   { adjList[ nnz++ ] = v-k*k; }
+	if ( j>0 )   { adjList[ nnz++ ] = v-k; }
+	if ( l>0 )   { adjList[ nnz++ ] = v-1; }
+	if ( l<k-1 ) { adjList[ nnz++ ] = v+1; }
+	if ( j<k-1 ) { adjList[ nnz++ ] = v+k; }
+	if ( i<k-1 ) { adjList[ nnz++ ] = v+k*k; }
+	// insert the partner in sorted order, unless it is already there
+	const int p = partner[v];
+	if ( p >= 0 ) {
+	  int pos = nnz;
+	  while ( ( pos > adjHead[v] ) && ( adjList[pos-1] > p ) ) { --pos; }
+	  if ( ( pos == adjHead[v] ) || ( adjList[pos-1] != p ) ) {
+	    for( int t=nnz; t>pos; --t ) { adjList[t] = adjList[t-1]; }
+	    adjList[pos] = p;
+	    ++nnz;
+	  }
+	}
+      }
+    }
+  }
+  adjHead[ n ] = nnz;
+  delete[] partner;
+  return n;
+}
+
+//
+// reverse Cuthill-McKee of a connected graph from root, the unnumbered
+// neighbors of each vertex taken by increasing degree, then by number.
+//
+static void
+referenceRCM( const int n, const int * adjHead, const int * adjList,
+	      const int root, int * new2old ) {
+  bool * numbered = new bool[n];
+  {for( int v=0; v<n; ++v ) { numbered[v] = false; }}
+  int * queue = new int[n];
+  int head = 0;
+  int tail = 0;
+  queue[ tail++ ] = root;
+  numbered[ root ] = true;
+  while ( head < tail ) {
+    const int v = queue[ head++ ];
+    const int first = tail;
+    for( int p=adjHead[v]; p<adjHead[v+1]; ++p ) {
+      const int w = adjList[p];
+      if ( numbered[w] ) { continue; }
+      numbered[w] = true;
+      // insertion sort by degree, stable for equal degrees
+      const int deg = adjHead[w+1] - adjHead[w];
+      int pos = tail++;
+      while ( ( pos > first ) && ( adjHead[ queue[pos-1]+1 ] - adjHead[ queue[pos-1] ] > deg ) ) {
+	queue[pos] = queue[pos-1];
+	--pos;
+      }
+      queue[pos] = w;
+    }
+  }
+  {for( int i=0; i<n; ++i ) { new2old[i] = queue[ n-1-i ]; }}
+  delete[] queue;
+  delete[] numbered;
+}
+
+// number of positions where the ordering differs from reference
+static int
+differences( const Graph& graph, const int nThreads, const bool sorted,
+	     const int * reference, int * root ) {
+  RCMEngine rcm( &graph );
+  rcm.setNThreads( nThreads );
+  if ( sorted ) { rcm.enableDegreeSorting(); }
+  if ( !rcm.execute() ) { return -1; }
+  if ( root != 0 ) { *root = rcm.getPseudoDiameter()->queryEndpoints().second; }
+  const int * new2old = rcm.getPermutation()->getNew2Old().lend();
+  int nDiffer = 0;
+  {for( int i=0; i<graph.size(); ++i ) {
+    if ( new2old[i] != reference[i] ) { ++nDiffer; }
+  }}
+  return nDiffer;
+}
+
+int main() {
+  const int k = 30;
+  const int nMax = k*k*k;
+  int * adjHead = new int[ nMax+1 ];
+  int * adjList = new int[ 7*nMax ];
+  int * reference = new int[ nMax ];
+
+  for( int pass=0; pass<2; ++pass ) {
+    const int n = makeGraph( k, ( pass == 1 ), adjHead, adjList );
+    Graph graph( n, (const int*) adjHead, (const int*) adjList );
+    graph.validate();
+    if ( ! graph.isValid() ) {
+      cerr << "Error: Cannot create valid graph." << endl;
+      return -1;
+    }
+    RCMEngine plain( &graph );
+    if ( !plain.execute() ) {
+      cerr << "Error: RCM failed." << endl;
+      return -1;
+    }
+    const int root = plain.getPseudoDiameter()->queryEndpoints().second;
+    {for( int i=0; i<n; ++i ) { reference[i] = plain.getPermutation()->getNew2Old()[i]; }}
+    int nPlain = 0;
+    {for( int t=2; t<=4; ++t ) {
+      nPlain += differences( graph, t, false, reference, 0 );
+    }}
+
+    referenceRCM( n, adjHead, adjList, root, reference );
+    int nSorted = 0;
+    bool sameRoot = true;
+    {for( int t=1; t<=4; ++t ) {
+      int sortedRoot = -1;
+      nSorted += differences( graph, t, true, reference, &sortedRoot );
+      sameRoot = sameRoot && ( sortedRoot == root );
+    }}
+
+    cout << ( ( pass == 0 ) ? "plain grid:" : "grid with random shortcuts:" ) << endl;
+    cout << "  threaded RCM differences = " << nPlain << endl;
+    cout << "  degree sorted RCM differences = " << nSorted
+	 << ( sameRoot ? "" : " (different roots)" ) << endl;
+  }
+  delete[] adjHead;
+  delete[] adjList;
+  delete[] reference;
+
+  Graph mesh( nvtxs, Aptr, Aind );
+  mesh.validate();
+  RCMEngine ordering( &mesh );
+  ordering.enableDegreeSorting();
+  ordering.execute();
+  const int * new2old = ordering.getPermutation()->getNew2Old().lend();
+  for( int i=0; i<9; i++ ) {
+    cout << "new2old[" << i << "] = " << new2old[i] << endl;
+  }
+}
@@ -0,0 +1,199 @@
+//
+// test12.cc -- ordering a batch of graphs on several threads
+//
+//
+
+#include <iostream.h>
+#include "spindle/Graph.h"
+#include "spindle/PermutationMap.h"
+#include "spindle/BatchOrdering.h"
+#include "spindle/MinPriorityEngine.h"
+#include "spindle/SloanEngine.h"
+#include "spindle/RCMEngine.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+//
+// an m-by-k five point grid, plus the diagonals of some cells chosen by
+// a hash of their corners and the salt, so the graphs differ.  If split
+// is set, the bottom row is cut off from the rest.
+//
+static Graph *
+makeGraph( const int m, const int k, const unsigned int salt, const bool split ) {
+  const int n = m*k;
+  int * adjHead = new int[ n+1 ];
+  int * adjList = new int[ 8*n ];
+  int nnz = 0;
+  for( int i=0; i<m; ++i ) {
+    for( int j=0; j<k; ++j ) {
+      const int v = i*k+j;
+      adjHead[ v ] = nnz;
+      for( int di=-1; di<=1; ++di ) {
+	for( int dj=-1; dj<=1; ++dj ) {
+	  const int ii = i+di;
+	  const int jj = j+dj;
+	  if ( ( di==0 && dj==0 ) || ii<0 || ii>=m || jj<0 || jj>=k ) { continue; }
+	  if ( split && ( ( i == m-1 ) != ( ii == m-1 ) ) ) { continue; }
+	  const int w = ii*k+jj;
+	  const unsigned int lo = ( v<w ) ? v : w;
+	  const unsigned int hi = ( v<w ) ? w : v;
+	  const unsigned int h = ( lo * 2654435761u ) ^ ( hi * 40503u ) ^ salt;
+	  if ( ( di != 0 ) && ( dj != 0 ) && ( ( ( h >> 7 ) % 3 ) != 0 ) ) { continue; }
+	  adjList[ nnz++ ] = w;
+	}
+      }
+    }
+  }
+  adjHead[ n ] = nnz;
+  Graph * graph = new Graph( n, (const int*) adjHead, (const int*) adjList );
+  graph->validate();
+  delete[] adjHead;
+  delete[] adjList;
+  return graph;
+}
+
+//
+// one factory per kind of engine, each engine set up the same way
+// a fresh one is set up in freshOrdering()
+//
+class MinDegreeFactory : public BatchOrdering::EngineFactory {
+public:
+  OrderingAlgorithm * create() const {
+    MinPriorityEngine * engine = new MinPriorityEngine();
+    engine->setRandomizeGraph( false );
+    return engine;
+  }
+};
+
+// shuffles its input, with its own generator
+class ShuffledMinDegreeFactory : public BatchOrdering::EngineFactory {
+public:
+  OrderingAlgorithm * create() const { return new MinPriorityEngine(); }
+};
+
+class SloanFactory : public BatchOrdering::EngineFactory {
+public:
+  OrderingAlgorithm * create() const { return new SloanEngine(); }
+};
+
+class RCMFactory : public BatchOrdering::EngineFactory {
+public:
+  OrderingAlgorithm * create() const { return new RCMEngine(); }
+};
+
+static PermutationMap *
+freshOrdering( const int kind, const Graph * graph ) {
+  OrderingAlgorithm * engine;
+  if ( kind == 0 ) {
+    MinPriorityEngine * mmd = new MinPriorityEngine( graph );
+    mmd->setRandomizeGraph( false );
+    engine = mmd;
+  } else if ( kind == 1 ) {
+    engine = new SloanEngine( graph );
+  } else if ( kind == 3 ) {
+    engine = new MinPriorityEngine( graph );
+  } else {
+    engine = new RCMEngine( graph );
+  }
+  PermutationMap * perm = 0;
+  if ( engine->execute() ) {
+    perm = engine->givePermutation();
+  }
+  delete engine;
+  return perm;
+}
+
+static BatchOrdering::EngineFactory *
+newFactory( const int kind ) {
+  switch( kind ) {
+  case 0: return new MinDegreeFactory();
+  case 1: return new SloanFactory();
+  case 3: return new ShuffledMinDegreeFactory();
+  default: return new RCMFactory();
+  }
+}
+
+// number of graphs whose batch ordering differs from a fresh one
+static int
+differences( const BatchOrdering& batch, PermutationMap * const * fresh,
+	     const Graph * const * graphs, const int nGraphs ) {
+  int nDiffer = 0;
+  for( int g=0; g<nGraphs; ++g ) {
+    const PermutationMap * perm = batch.getPermutation( g );
+    if ( ( perm == 0 ) || ( fresh[g] == 0 ) || ( !perm->isValid() ) ) {
+      ++nDiffer;
+      continue;
+    }
+    const int * p1 = perm->getNew2Old().lend();
+    const int * p2 = fresh[g]->getNew2Old().lend();
+    for( int i=0; i<graphs[g]->queryNVtxs(); ++i ) {
+      if ( p1[i] != p2[i] ) {
+	++nDiffer;
+	break;
+      }
+    }
+  }
+  return nDiffer;
+}
+
+int main() {
+  // two batches, the second one with larger graphs
+  const int nGraphs = 40;
+  const Graph * graphs[ 2 ][ nGraphs ];
+  for( int b=0; b<2; ++b ) {
+    for( int g=0; g<nGraphs; ++g ) {
+      const int m = 2 + ( g*7 ) % 13 + 10*b;
+      const int k = 3 + ( g*5 ) % 17 + 10*b;
+      graphs[b][g] = makeGraph( m, k, 977*g + b, ( g % 4 ) == 3 );
+      if ( ! graphs[b][g]->isValid() ) {
+	cerr << "Error: Cannot create valid graph." << endl;
+	return -1;
+      }
+    }
+  }
+  const char * names[] = { "minimum degree", "Sloan", "RCM", "shuffled minimum degree" };
+
+  for( int kind=0; kind<4; ++kind ) {
+    cout << names[kind] << ":";
+    PermutationMap * fresh[ 2 ][ nGraphs ];
+    for( int b=0; b<2; ++b ) {
+      for( int g=0; g<nGraphs; ++g ) {
+	fresh[b][g] = freshOrdering( kind, graphs[b][g] );
+      }
+    }
+    for( int nThreads=1; nThreads<=3; nThreads+=2 ) {
+      BatchOrdering batch( newFactory( kind ) );
+      batch.setNThreads( nThreads );
+      int nDiffer = 0;
+      int nFailed = 0;
+      for( int b=0; b<2; ++b ) {
+	if ( !batch.execute( graphs[b], nGraphs ) ) { nFailed += batch.queryNFailed(); }
+	nDiffer += differences( batch, fresh[b], graphs[b], nGraphs );
+      }
+      cout << "  " << nThreads << " thread(s): " << nFailed << " failed, "
+	   << nDiffer << " differ;";
+    }
+    cout << endl;
+    for( int b=0; b<2; ++b ) {
+      for( int g=0; g<nGraphs; ++g ) {
+	delete fresh[b][g];
+      }
+    }
+  }
+
+  // the permutations are the caller's once given away
+  BatchOrdering batch( new RCMFactory() );
+  batch.execute( graphs[0], 3 );
+  PermutationMap * perm = batch.givePermutation( 1 );
+  cout << "given away: " << ( ( perm != 0 ) && ( batch.getPermutation( 1 ) == 0 ) ? "yes" : "no" )
+       << ", batch size = " << batch.size() << endl;
+  delete perm;
+
+  for( int b=0; b<2; ++b ) {
+    for( int g=0; g<nGraphs; ++g ) {
+      delete graphs[b][g];
+    }
+  }
+}
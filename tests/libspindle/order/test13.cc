@@ -0,0 +1,126 @@
+//
+// test13.cc -- one minimum priority engine reused for a sequence of graphs
+//
+//
+
+#include <iostream.h>
+#include "spindle/Graph.h"
+#include "spindle/PermutationMap.h"
+#include "spindle/MinPriorityEngine.h"
+#include "spindle/MinPriorityEngineT.h"
+#include "spindle/MinPriorityStrategies.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+//
+// an m-by-k five point grid, plus the diagonals of some cells chosen by
+// a hash of their corners and the salt, so the graphs differ.  If split
+// is set, the bottom row is cut off from the rest.
+//
+static Graph *
+makeGraph( const int m, const int k, const unsigned int salt, const bool split ) {
+  const int n = m*k;
+  int * adjHead = new int[ n+1 ];
+  int * adjList = new int[ 8*n ];
+  int nnz = 0;
+  for( int i=0; i<m; ++i ) {
+    for( int j=0; j<k; ++j ) {
+      const int v = i*k+j;
+      adjHead[ v ] = nnz;
+      for( int di=-1; di<=1; ++di ) {
+	for( int dj=-1; dj<=1; ++dj ) {
+	  const int ii = i+di;
+	  const int jj = j+dj;
+	  if ( ( di==0 && dj==0 ) || ii<0 || ii>=m || jj<0 || jj>=k ) { continue; }
+	  if ( split && ( ( i == m-1 ) != ( ii == m-1 ) ) ) { continue; }
+	  const int w = ii*k+jj;
+	  const unsigned int lo = ( v<w ) ? v : w;
+	  const unsigned int hi = ( v<w ) ? w : v;
+	  const unsigned int h = ( lo * 2654435761u ) ^ ( hi * 40503u ) ^ salt;
+	  if ( ( di != 0 ) && ( dj != 0 ) && ( ( ( h >> 7 ) % 3 ) != 0 ) ) { continue; }
+	  adjList[ nnz++ ] = w;
+	}
+      }
+    }
+  }
+  adjHead[ n ] = nnz;
+  Graph * graph = new Graph( n, (const int*) adjHead, (const int*) adjList );
+  graph->validate();
+  delete[] adjHead;
+  delete[] adjList;
+  return graph;
+}
+
+// 0: multiple minimum degree, 1: approximate minimum degree, 2: compiled-in AMD
+static MinPriorityEngine *
+newEngine( const int kind ) {
+  MinPriorityEngine * engine;
+  if ( kind == 2 ) {
+    engine = new MinPriorityEngineT< MinPriority_ApproximateDegree >();
+  } else {
+    engine = new MinPriorityEngine();
+    if ( kind == 1 ) {
+      engine->setPriorityStrategy( new MinPriority_ApproximateDegree() );
+    }
+  }
+  engine->setRandomizeGraph( false );
+  return engine;
+}
+
+// number of positions where the orderings of the two engines differ
+static int
+differences( MinPriorityEngine * reused, const int kind, const Graph * graph ) {
+  MinPriorityEngine * fresh = newEngine( kind );
+  int nDiffer = 0;
+  if ( ( !fresh->setGraph( graph ) ) || ( !fresh->execute() ) ||
+       ( !reused->setGraph( graph ) ) || ( !reused->execute() ) ) {
+    nDiffer = graph->queryNVtxs();
+  } else {
+    const int * p1 = fresh->getPermutation()->getNew2Old().lend();
+    const int * p2 = reused->getPermutation()->getNew2Old().lend();
+    for( int i=0; i<graph->queryNVtxs(); ++i ) {
+      if ( p1[i] != p2[i] ) { ++nDiffer; }
+    }
+  }
+  delete fresh;
+  return nDiffer;
+}
+
+int main() {
+  // smaller, equal and larger graphs than the one before
+  const int nGraphs = 7;
+  const int shapes[ nGraphs ][ 2 ] = 
+    { { 30, 30 }, { 10, 12 }, { 30, 30 }, { 40, 35 }, { 5, 5 }, { 25, 41 }, { 40, 35 } };
+  const Graph * graphs[ nGraphs ];
+  for( int g=0; g<nGraphs; ++g ) {
+    graphs[g] = makeGraph( shapes[g][0], shapes[g][1], 131*g, ( g % 3 ) == 1 );
+    if ( ! graphs[g]->isValid() ) {
+      cerr << "Error: Cannot create valid graph." << endl;
+      return -1;
+    }
+  }
+  const char * names[] = { "MMD", "AMD", "compiled-in AMD" };
+
+  for( int kind=0; kind<3; ++kind ) {
+    MinPriorityEngine * reused = newEngine( kind );
+    int nDiffer = 0;
+    for( int g=0; g<nGraphs; ++g ) {
+      nDiffer += differences( reused, kind, graphs[g] );
+    }
+    // everything is allocated again after the memory is released
+    int nDifferReleased = 0;
+    for( int g=nGraphs-1; g>=0; g -= 2 ) {
+      reused->releaseMemory();
+      nDifferReleased += differences( reused, kind, graphs[g] );
+    }
+    cout << names[kind] << ": reused differs in " << nDiffer << " places, "
+	 << "after release in " << nDifferReleased << endl;
+    delete reused;
+  }
+
+  for( int g=0; g<nGraphs; ++g ) {
+    delete graphs[g];
+  }
+}
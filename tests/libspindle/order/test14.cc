@@ -0,0 +1,128 @@
+//
+// test14.cc -- orderings computed with all arrays in a SpindleArena
+//
+//
+
+#include <iostream.h>
+#include "spindle/Graph.h"
+#include "spindle/PermutationMap.h"
+#include "spindle/MinPriorityEngine.h"
+#include "spindle/RCMEngine.h"
+#include "spindle/SpindleArena.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+//
+// an m-by-k five point grid, plus the diagonals of some cells chosen by
+// a hash of their corners and the salt.
+//
+static Graph *
+makeGraph( const int m, const int k, const unsigned int salt ) {
+  const int n = m*k;
+  int * adjHead = new int[ n+1 ];
+  int * adjList = new int[ 8*n ];
+  int nnz = 0;
+  for( int i=0; i<m; ++i ) {
+    for( int j=0; j<k; ++j ) {
+      const int v = i*k+j;
+      adjHead[ v ] = nnz;
+      for( int di=-1; di<=1; ++di ) {
+	for( int dj=-1; dj<=1; ++dj ) {
+	  const int ii = i+di;
+	  const int jj = j+dj;
+	  if ( ( di==0 && dj==0 ) || ii<0 || ii>=m || jj<0 || jj>=k ) { continue; }
+	  const int w = ii*k+jj;
+	  const unsigned int lo = ( v<w ) ? v : w;
+	  const unsigned int hi = ( v<w ) ? w : v;
+	  const unsigned int h = ( lo * 2654435761u ) ^ ( hi * 40503u ) ^ salt;
+	  if ( ( di != 0 ) && ( dj != 0 ) && ( ( ( h >> 7 ) % 3 ) != 0 ) ) { continue; }
+	  adjList[ nnz++ ] = w;
+	}
+      }
+    }
+  }
+  adjHead[ n ] = nnz;
+  Graph * graph = new Graph( n, (const int*) adjHead, (const int*) adjList );
+  graph->validate();
+  delete[] adjHead;
+  delete[] adjList;
+  return graph;
+}
+
+// order the graph with MMD and RCM, append both new2old's to result
+static bool
+order( const Graph * graph, vector<int>& result ) {
+  MinPriorityEngine mmd( graph );
+  mmd.setRandomizeGraph( false );
+  RCMEngine rcm( graph );
+  if ( ( !mmd.execute() ) || ( !rcm.execute() ) ) { return false; }
+  const int * p = mmd.getPermutation()->getNew2Old().lend();
+  result.insert( result.end(), p, p + graph->size() );
+  p = rcm.getPermutation()->getNew2Old().lend();
+  result.insert( result.end(), p, p + graph->size() );
+  return true;
+}
+
+int main() {
+  const int shapes[][2] = { { 30, 30 }, { 12, 70 }, { 90, 80 } };
+  SpindleArena arena( 64*1024 );
+  int nDiffer = 0;
+  bool used = true;
+  bool bigBlocks = false;
+  for( int g=0; g<3; ++g ) {
+    vector<int> onHeap;
+    vector<int> inArena;
+    Graph * graph = makeGraph( shapes[g][0], shapes[g][1], 17*g );
+    if ( ( ! graph->isValid() ) || ( !order( graph, onHeap ) ) ) {
+      cerr << "Error: Cannot order graph on the heap." << endl;
+      return -1;
+    }
+    delete graph;
+    {
+      SpindleArena::Scope scope( &arena );
+      graph = makeGraph( shapes[g][0], shapes[g][1], 17*g );
+      if ( ( ! graph->isValid() ) || ( !order( graph, inArena ) ) ) {
+	cerr << "Error: Cannot order graph in the arena." << endl;
+	return -1;
+      }
+    }
+    used = used && ( arena.queryNBytesUsed() > 0 );
+    bigBlocks = bigBlocks || ( arena.queryNBlocks() > 1 );
+    // arena memory may be freed after the scope, up to release()
+    delete graph;
+    arena.release();
+    used = used && ( arena.queryNBytesReserved() == 0 );
+    for( int i=0; i<(int) onHeap.size(); ++i ) {
+      if ( onHeap[i] != inArena[i] ) { ++nDiffer; }
+    }
+  }
+  // without a scope, arrays come from the heap again
+  Graph * graph = makeGraph( 10, 10, 0 );
+  used = used && ( arena.queryNBytesUsed() == 0 );
+  delete graph;
+
+  // only the thread the arena is current on takes space back
+  bool reuse = true;
+  {
+    SharedArray<int> * a = 0;
+    {
+      SpindleArena::Scope scope( &arena );
+      a = new SharedArray<int>( 100 );
+    }
+    const size_t nUsed = arena.queryNBytesUsed();
+    delete a;
+    reuse = reuse && ( nUsed > 0 ) && ( arena.queryNBytesUsed() == nUsed );
+    SpindleArena::Scope scope( &arena );
+    a = new SharedArray<int>( 100 );
+    delete a;
+    reuse = reuse && ( arena.queryNBytesUsed() == nUsed );
+  }
+  arena.release();
+
+  cout << "arena differs in " << nDiffer << " places" << endl;
+  cout << "arena used and released = " << ( used ? "yes" : "no" ) << endl;
+  cout << "several blocks = " << ( bigBlocks ? "yes" : "no" ) << endl;
+  cout << "space reused only by the current arena = " << ( reuse ? "yes" : "no" ) << endl;
+}
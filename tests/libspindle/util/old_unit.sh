@@ -14,12 +14,12 @@ do
     esac
 done
 
-echo "NPARTS 4"
+echo "NPARTS 12"
 final_result='UNRESOLVED'
 
 i='1';
 
-for test_i in  test01 test02 test03 test04; do
+for test_i in  test01 test02 test03 test04 test05 test06 test07 test08 test09 test10 test11 test12; do
     echo "PART $i"
     if test -x ${bindir}/${test_i}.exe ; then 
 	${bindir}/${test_i}.exe > ${bindir}/${test_i}.tmp 2>&1 ;
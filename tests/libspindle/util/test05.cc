@@ -0,0 +1,89 @@
+//
+// src/util/drivers/tests/test05.cc
+//
+//
+// tests GraphCoarsener
+
+#include <iostream.h>
+#include "spindle/Graph.h"
+#include "spindle/GraphCoarsener.h"
+#include "spindle/RCMEngine.h"
+
+#include "samples/grid_mesh.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+int main() {
+  ios::sync_with_stdio();
+
+  const int k = 20;
+  const int n = k*k;
+  int * adjHead = new int[ n+1 ];
+  int * adjList = new int[ 4*n ];
+  makeFivePointGrid( k, adjHead, adjList );
+
+  Graph graph( n, (const int*) adjHead, (const int*) adjList );
+  graph.validate();
+  if ( ! graph.isValid() ) {
+    cerr << "Cannot create valid graph." << endl;
+  }
+
+  GraphCoarsener coarsener( &graph );
+  coarsener.setMinCoarseNVtxs( 20 );
+  if ( ! coarsener.execute() ) {
+    cerr << "Coarsening failed." << endl;
+    return -1;
+  }
+
+  // vertex weights must add up to n at every level, and the edge
+  // weights to the number of fine edges not yet collapsed.
+  const int nLevels = coarsener.queryNLevels();
+  cout << "Coarsened into " << nLevels << " levels." << endl;
+  for( int level=1; level<nLevels; ++level ) {
+    const Graph * g = coarsener.getGraph( level );
+    int totalVtxWeight = 0;
+    int totalEdgeWeight = 0;
+    {for( int i=0; i<g->size(); ++i ) {
+      totalVtxWeight += g->getVtxWeight()[i];
+    }}
+    {for( int i=0; i<g->getAdjList().size(); ++i ) {
+      totalEdgeWeight += g->getEdgeWeight()[i];
+    }}
+    cout << "  level " << level << ": " << g->size() << " vertices, "
+	 << g->queryNEdges() << " edges, vertex weight " << totalVtxWeight
+	 << ", edge weight " << totalEdgeWeight/2 << endl;
+  }
+
+  // order the coarsest graph and carry the ordering back up
+  const int coarsest = nLevels - 1;
+  RCMEngine rcm( coarsener.getGraph( coarsest ) );
+  rcm.execute();
+  PermutationMap * perm = coarsener.createFinePermutation( rcm.getPermutation(), coarsest );
+  if ( ( perm == 0 ) || ( !perm->isValid() ) || ( perm->size() != n ) ) {
+    cerr << "Could not create fine permutation." << endl;
+    return -1;
+  }
+  cout << "Fine permutation of " << perm->size() << " vertices is valid." << endl;
+
+  // a coarse labelling must reach every fine vertex
+  const int nCoarse = coarsener.getGraph( coarsest )->size();
+  int * coarseLabel = new int[ nCoarse ];
+  int * fineLabel = new int[ n ];
+  {for( int i=0; i<nCoarse; ++i ) {
+    coarseLabel[i] = ( 2*i < nCoarse ) ? 0 : 1;
+  }}
+  coarsener.projectToFine( coarsest, coarseLabel, fineLabel );
+  int nOnes = 0;
+  {for( int i=0; i<n; ++i ) {
+    nOnes += fineLabel[i];
+  }}
+  cout << "Projected labels: " << n - nOnes << " zeros, " << nOnes << " ones." << endl;
+
+  delete perm;
+  delete[] coarseLabel;
+  delete[] fineLabel;
+  delete[] adjHead;
+  delete[] adjList;
+}
@@ -0,0 +1,118 @@
+//
+// src/util/drivers/tests/test06.cc
+//
+//
+// tests GraphCompressor on a grid with three unknowns per node,
+// with one and with several threads
+
+#include <iostream.h>
+#include "spindle/Graph.h"
+#include "spindle/GraphCompressor.h"
+
+#include "samples/grid_mesh.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+//
+// build a k-by-k five point grid where every grid point carries
+// nDof unknowns, all coupled to each other and to every unknown of
+// the neighboring grid points.
+//
+static void
+makeGrid( const int k, const int nDof, int * adjHead, int * adjList ) {
+  int * gridHead = new int[ k*k+1 ];
+  int * gridList = new int[ 4*k*k ];
+  makeFivePointGrid( k, gridHead, gridList );
+  int nnz = 0;
+  for( int g=0; g<k*k; ++g ) {
+    // the grid point itself goes in order among its neighbors
+    int nbr[5];
+    int nNbrs = 0;
+    bool placed = false;
+    for( int p=gridHead[g]; p<gridHead[g+1]; ++p ) {
+      if ( ( !placed ) && ( gridList[p] > g ) ) {
+	nbr[ nNbrs++ ] = g;
+	placed = true;
+      }
+      nbr[ nNbrs++ ] = gridList[p];
+    }
+    if ( !placed ) {
+      nbr[ nNbrs++ ] = g;
+    }
+    for( int d=0; d<nDof; ++d ) {
+      const int v = g*nDof + d;
+      adjHead[ v ] = nnz;
+      for( int p=0; p<nNbrs; ++p ) {
+	for( int e=0; e<nDof; ++e ) {
+	  const int w = nbr[p]*nDof + e;
+	  if ( w != v ) {
+	    adjList[ nnz++ ] = w;
+	  }
+	}
+      }
+    }
+  }
+  adjHead[ k*k*nDof ] = nnz;
+  delete[] gridHead;
+  delete[] gridList;
+}
+
+int main() {
+  ios::sync_with_stdio();
+
+  const int k = 30;
+  const int nDof = 3;
+  const int n = k*k*nDof;
+  int * adjHead = new int[ n+1 ];
+  int * adjList = new int[ 5*nDof*n ];
+  makeGrid( k, nDof, adjHead, adjList );
+
+  Graph graph( n, (const int*) adjHead, (const int*) adjList );
+  graph.validate();
+  if ( ! graph.isValid() ) {
+    cerr << "Cannot create valid graph." << endl;
+  }
+
+  GraphCompressor serial;
+  serial.setGraph( &graph );
+  serial.execute();
+  cout << "Compressed " << n << " vertices into "
+       << serial.queryCompressedNVtxs() << " with 1 thread." << endl;
+
+  GraphCompressor threaded;
+  threaded.setNThreads( 4 );
+  threaded.setGraph( &graph );
+  threaded.execute();
+  cout << "Compressed " << n << " vertices into "
+       << threaded.queryCompressedNVtxs() << " with 4 threads." << endl;
+
+  const int * map1 = serial.getFine2Coarse()->lend();
+  const int * map4 = threaded.getFine2Coarse()->lend();
+  int nDiffs = 0;
+  int nWrong = 0;
+  {for( int i=0; i<n; ++i ) {
+    if ( map1[i] != map4[i] ) {
+      ++nDiffs;
+    }
+    if ( map1[i] != i/nDof ) {
+      ++nWrong;
+    }
+  }}
+  cout << "Maps differ in " << nDiffs << " places." << endl;
+  cout << nWrong << " vertices mapped to the wrong grid point." << endl;
+
+  Graph * cgraph = threaded.createCompressedGraph();
+  if ( cgraph == 0 ) {
+    cerr << "Cannot create compressed graph." << endl;
+    return -1;
+  }
+  cout << "Compressed graph has " << cgraph->size() << " vertices and "
+       << cgraph->queryNEdges() << " edges." << endl;
+  delete cgraph;
+
+  delete[] adjHead;
+  delete[] adjList;
+  return 0;
+}
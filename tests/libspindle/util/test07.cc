@@ -0,0 +1,134 @@
+//
+// src/util/drivers/tests/test07.cc
+//
+//
+// tests the row and column counts of SymbolicFactorization against
+// a direct traversal of the elimination tree
+
+#include <iostream.h>
+#include "spindle/Graph.h"
+#include "spindle/EliminationForest.h"
+#include "spindle/SymbolicFactorization.h"
+#include "spindle/MinPriorityEngine.h"
+
+#include "samples/grid_mesh.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+//
+// count the nonzeros of the factor by walking up the elimination tree
+// from every entry of the matrix, and compare with symbfact.
+//
+static int
+countMismatches( const Graph& graph, const SymbolicFactorization& symbfact ) {
+  const int n = graph.size();
+  const int * old2new = symbfact.getPermutationMap()->getOld2New().lend();
+  const int * new2old = symbfact.getPermutationMap()->getNew2Old().lend();
+  const int * parent = symbfact.getETree()->getParent().lend();
+  int * rowCount = new int[n];
+  int * colCount = new int[n];
+  int * color = new int[n];
+  {for( int ii=0; ii<n; ++ii ) {
+    rowCount[ii] = 1;
+    colCount[ii] = 1;
+    color[ii] = -1;
+  }}
+  for( int ii=0; ii<n; ++ii ) {
+    color[ii] = ii;
+    const int i = new2old[ii];
+    for( const int * jp = graph.begin_adj(i); jp < graph.end_adj(i); ++jp ) {
+      int j = *jp;
+      while ( ( old2new[j] < ii ) && ( color[ old2new[j] ] < ii ) ) {
+	rowCount[ii]++;
+	colCount[ old2new[j] ]++;
+	color[ old2new[j] ] = ii;
+	j = parent[j];
+      }
+    }
+  }
+  const int * symbRowCount = symbfact.getRowCount().lend();
+  const int * symbColCount = symbfact.getColCount().lend();
+  int nMismatches = 0;
+  {for( int ii=0; ii<n; ++ii ) {
+    if ( rowCount[ii] != symbRowCount[ii] ) { ++nMismatches; }
+    if ( colCount[ii] != symbColCount[ii] ) { ++nMismatches; }
+  }}
+  delete[] rowCount;
+  delete[] colCount;
+  delete[] color;
+  return nMismatches;
+}
+
+static void
+report( const char * name, const Graph& graph, SymbolicFactorization& symbfact ) {
+  cout << name << ": " << endl;
+  cout << "     Size of the factor     = " << symbfact.querySize() << endl;
+  cout << "     Size of fill           = " << symbfact.queryFill() << endl;
+  cout << "     Count mismatches       = " << countMismatches( graph, symbfact ) << endl;
+}
+
+int main() {
+  ios::sync_with_stdio();
+
+  const int k = 15;
+  const int n = k*k;
+  int * adjHead = new int[ n+1 ];
+  int * adjList = new int[ 8*n ];
+  makeNinePointGrid( k, adjHead, adjList );
+
+  Graph graph( n, (const int*) adjHead, (const int*) adjList );
+  graph.validate();
+  if ( ! graph.isValid() ) {
+    cerr << "Cannot create valid graph." << endl;
+  }
+
+  // natural ordering
+  {
+    SymbolicFactorization symbfact;
+    symbfact.setGraph( &graph );
+    if ( ! symbfact.execute() ) {
+      cerr << "Error doing symbolic factorization." << endl;
+      exit(-1);
+    }
+    report( "Natural ordering", graph, symbfact );
+  }
+
+  // a scrambled ordering
+  {
+    PermutationMap scrambled( n );
+    int * new2old = scrambled.getNew2Old().begin();
+    {for( int i=0; i<n; ++i ) {
+      new2old[i] = ( i*7 ) % n;
+    }}
+    scrambled.validate();
+    SymbolicFactorization symbfact;
+    symbfact.setGraph( &graph );
+    symbfact.setPermutationMap( &scrambled );
+    if ( ! symbfact.execute() ) {
+      cerr << "Error doing symbolic factorization." << endl;
+      exit(-1);
+    }
+    report( "Scrambled ordering", graph, symbfact );
+  }
+
+  // a minimum degree ordering
+  {
+    MinPriorityEngine mmd( &graph );
+    mmd.setRandomizeGraph( false );
+    mmd.execute();
+    SymbolicFactorization symbfact;
+    symbfact.setGraph( &graph );
+    symbfact.setPermutationMap( mmd.getPermutation() );
+    if ( ! symbfact.execute() ) {
+      cerr << "Error doing symbolic factorization." << endl;
+      exit(-1);
+    }
+    report( "Minimum degree ordering", graph, symbfact );
+  }
+
+  delete[] adjHead;
+  delete[] adjList;
+  return 0;
+}
@@ -0,0 +1,104 @@
+//
+// src/util/drivers/tests/test08.cc
+//
+//
+// tests the supernode partition and assembly tree of SymbolicFactorization
+
+#include <iostream.h>
+#include "spindle/Graph.h"
+#include "spindle/EliminationForest.h"
+#include "spindle/SymbolicFactorization.h"
+#include "spindle/MinPriorityEngine.h"
+
+#include "samples/grid_mesh.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+//
+// check that the supernodes cover the columns in order, that the
+// assembly tree points upwards, and that every supernode's dense block
+// holds all of its columns.  Returns the number of problems found.
+//
+static int
+checkSupernodes( SymbolicFactorization& symbfact ) {
+  const int nSuper = symbfact.queryNSupernodes();
+  const int * begin = symbfact.getSupernodeBegin().lend();
+  const int * map = symbfact.getSupernodeMap().lend();
+  const int * parent = symbfact.getSupernodeParent().lend();
+  const int * nRows = symbfact.getSupernodeNRows().lend();
+  const int * colCount = symbfact.getColCount().lend();
+  const int n = symbfact.getColCount().size();
+  int nProblems = 0;
+  if ( ( begin[0] != 0 ) || ( begin[nSuper] != n ) ) { ++nProblems; }
+  for( int s=0; s<nSuper; ++s ) {
+    if ( begin[s] >= begin[s+1] ) { ++nProblems; }
+    if ( ( parent[s] != -1 ) && ( parent[s] <= s ) ) { ++nProblems; }
+    for( int jj=begin[s]; jj<begin[s+1]; ++jj ) {
+      if ( map[jj] != s ) { ++nProblems; }
+      if ( colCount[jj] > nRows[s] - ( jj - begin[s] ) ) { ++nProblems; }
+    }
+  }
+  return nProblems;
+}
+
+int main() {
+  ios::sync_with_stdio();
+
+  const int k = 15;
+  const int n = k*k;
+  int * adjHead = new int[ n+1 ];
+  int * adjList = new int[ 8*n ];
+  makeNinePointGrid( k, adjHead, adjList );
+
+  Graph graph( n, (const int*) adjHead, (const int*) adjList );
+  graph.validate();
+  if ( ! graph.isValid() ) {
+    cerr << "Cannot create valid graph." << endl;
+  }
+
+  MinPriorityEngine mmd( &graph );
+  mmd.setRandomizeGraph( false );
+  mmd.execute();
+
+  // fundamental supernodes store exactly the factor
+  {
+    SymbolicFactorization symbfact;
+    symbfact.setGraph( &graph );
+    symbfact.setPermutationMap( mmd.getPermutation() );
+    if ( ! symbfact.execute() ) {
+      cerr << "Error doing symbolic factorization." << endl;
+      exit(-1);
+    }
+    cout << "Fundamental supernodes: " << endl;
+    cout << "     Number of supernodes   = " << symbfact.queryNSupernodes() << endl;
+    cout << "     Size of the factor     = " << symbfact.querySize() << endl;
+    cout << "     Size of dense blocks   = " << symbfact.querySupernodalSize() << endl;
+    cout << "     Problems found         = " << checkSupernodes( symbfact ) << endl;
+  }
+
+  // relaxed supernodes trade explicit zeros for fewer, larger blocks
+  {
+    SymbolicFactorization symbfact;
+    symbfact.setGraph( &graph );
+    symbfact.setPermutationMap( mmd.getPermutation() );
+    symbfact.setSupernodeRelaxation( 4, 0.1 );
+    if ( ! symbfact.execute() ) {
+      cerr << "Error doing symbolic factorization." << endl;
+      exit(-1);
+    }
+    cout << "Relaxed supernodes: " << endl;
+    cout << "     Number of supernodes   = " << symbfact.queryNSupernodes() << endl;
+    cout << "     Size of the factor     = " << symbfact.querySize() << endl;
+    cout << "     Size of dense blocks   = " << symbfact.querySupernodalSize() << endl;
+    cout << "     Problems found         = " << checkSupernodes( symbfact ) << endl;
+    if ( symbfact.setSupernodeRelaxation( -1, 0.0 ) ) {
+      cout << "Negative relaxation accepted." << endl;
+    }
+  }
+
+  delete[] adjHead;
+  delete[] adjList;
+  return 0;
+}
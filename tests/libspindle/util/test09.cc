@@ -0,0 +1,78 @@
+//
+// src/util/drivers/tests/test09.cc
+//
+//
+// tests MultifrontalAnalysis
+
+#include <iostream.h>
+#include "spindle/Graph.h"
+#include "spindle/SymbolicFactorization.h"
+#include "spindle/MultifrontalAnalysis.h"
+#include "spindle/MinPriorityEngine.h"
+#include "spindle/NestedDissectionEngine.h"
+
+#include "samples/grid_mesh.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+static void
+analyze( const char * name, const Graph& graph, const PermutationMap* perm ) {
+  SymbolicFactorization symbfact;
+  symbfact.setGraph( &graph );
+  symbfact.setPermutationMap( perm );
+  if ( ! symbfact.execute() ) {
+    cerr << "Error doing symbolic factorization." << endl;
+    exit(-1);
+  }
+  MultifrontalAnalysis analysis( &symbfact );
+  if ( ! analysis.execute() ) {
+    cerr << "Error doing multifrontal analysis." << endl;
+    exit(-1);
+  }
+  cout << name << ": " << endl;
+  cout << "     Amount of work (flops) = " << symbfact.queryWork() << endl;
+  cout << "     Multifrontal flops     = " << analysis.queryFlops() << endl;
+  cout << "     Peak stack, postorder  = " << analysis.queryPeakStackSize() << endl;
+  cout << "     Peak stack, Liu order  = " << analysis.queryOptimalPeakStackSize() << endl;
+
+  // the reordering must not change the factor
+  SymbolicFactorization reordered;
+  reordered.setGraph( &graph );
+  reordered.setPermutationMap( analysis.getPermutation() );
+  reordered.execute();
+  cout << "     Same size reordered    = " 
+       << ( ( reordered.querySize() == symbfact.querySize() ) ? "yes" : "no" ) 
+       << endl;
+}
+
+int main() {
+  ios::sync_with_stdio();
+
+  const int k = 31;
+  const int n = k*k;
+  int * adjHead = new int[ n+1 ];
+  int * adjList = new int[ 8*n ];
+  makeNinePointGrid( k, adjHead, adjList );
+
+  Graph graph( n, (const int*) adjHead, (const int*) adjList );
+  graph.validate();
+  if ( ! graph.isValid() ) {
+    cerr << "Cannot create valid graph." << endl;
+  }
+
+  MinPriorityEngine mmd( &graph );
+  mmd.setRandomizeGraph( false );
+  mmd.execute();
+  analyze( "Minimum degree ordering", graph, mmd.getPermutation() );
+
+  NestedDissectionEngine nd( &graph );
+  nd.setMaxLeafSize( 16 );
+  nd.execute();
+  analyze( "Nested dissection ordering", graph, nd.getPermutation() );
+
+  delete[] adjHead;
+  delete[] adjList;
+  return 0;
+}
@@ -0,0 +1,150 @@
+//
+// src/util/drivers/tests/test10.cc
+//
+//
+// compares direction optimizing breadth first searches against
+// plain top-down ones.
+
+#include <iostream.h>
+#include "spindle/Graph.h"
+#include "spindle/BreadthFirstSearch.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+static unsigned int seed = 4321;
+
+static int
+nextRandom( const int n ) {
+  seed = seed * 1103515245 + 12345;
+  return (int) ( ( seed >> 16 ) % n );
+}
+
+//
+// build a k-by-k-by-k seven point grid.  If shortcuts is set, every
+// vertex also gets one extra neighbor from a random perfect matching,
+// which makes the levels of a search very wide.
+//
+static int
+makeGraph( const int k, const bool shortcuts, int * adjHead, int * adjList ) {
+  const int n = k*k*k;
+  int * partner = new int[n];
+  {for( int v=0; v<n; ++v ) { partner[v] = -1; }}
+  if ( shortcuts ) {
+    int * perm = new int[n];
+    {for( int v=0; v<n; ++v ) { perm[v] = v; }}
+    {for( int v=n-1; v>0; --v ) {
+      const int r = nextRandom( v+1 );
+      const int t = perm[v]; perm[v] = perm[r]; perm[r] = t;
+    }}
+    {for( int v=0; v+1<n; v+=2 ) {
+      partner[ perm[v] ] = perm[v+1];
+      partner[ perm[v+1] ] = perm[v];
+    }}
+    delete[] perm;
+  }
+  int nnz = 0;
+  for( int i=0; i<k; ++i ) {
+    for( int j=0; j<k; ++j ) {
+      for( int l=0; l<k; ++l ) {
+	const int v = (i*k+j)*k+l;
+	adjHead[ v ] = nnz;
+	if ( i>0 )   { adjList[ nnz++ ] = v-k*k; }
+	if ( j>0 )   { adjList[ nnz++ ] = v-k; }
+	if ( l>0 )   { adjList[ nnz++ ] = v-1; }
+	if ( l<k-1 ) { adjList[ nnz++ ] = v+1; }
+	if ( j<k-1 ) { adjList[ nnz++ ] = v+k; }
+	if ( i<k-1 ) { adjList[ nnz++ ] = v+k*k; }
+	// insert the partner in sorted order, unless it is already there
+	const int p = partner[v];
+	if ( p >= 0 ) {
+	  int pos = nnz;
+	  while ( ( pos > adjHead[v] ) && ( adjList[pos-1] > p ) ) { --pos; }
+	  if ( ( pos == adjHead[v] ) || ( adjList[pos-1] != p ) ) {
+	    for( int t=nnz; t>pos; --t ) { adjList[t] = adjList[t-1]; }
+	    adjList[pos] = p;
+	    ++nnz;
+	  }
+	}
+      }
+    }
+  }
+  adjHead[ n ] = nnz;
+  delete[] partner;
+  return n;
+}
+
+// run both searches from the same roots, return the number of differences
+static int
+compare( BreadthFirstSearch& topDown, BreadthFirstSearch& optimized,
+	 const int * roots, const int nRoots, const int n ) {
+  topDown.setRoots( roots, nRoots );
+  optimized.setRoots( roots, nRoots );
+  if ( ( !topDown.execute() ) || ( !optimized.execute() ) ) { return -1; }
+  int nDiffer = 0;
+  if ( topDown.queryNVisited() != optimized.queryNVisited() ) { ++nDiffer; }
+  if ( topDown.queryNFarthest() != optimized.queryNFarthest() ) { ++nDiffer; }
+  if ( topDown.queryHeight() != optimized.queryHeight() ) { ++nDiffer; }
+  if ( topDown.queryWidth() != optimized.queryWidth() ) { ++nDiffer; }
+  if ( topDown.hasShortCircuited() != optimized.hasShortCircuited() ) { ++nDiffer; }
+  if ( topDown.queryMaxDegreeVtx() != optimized.queryMaxDegreeVtx() ) { ++nDiffer; }
+  if ( topDown.queryMinDegreeVtx() != optimized.queryMinDegreeVtx() ) { ++nDiffer; }
+  const int * dist1 = topDown.getDistance().lend();
+  const int * dist2 = optimized.getDistance().lend();
+  const int * new2old1 = topDown.getNew2Old().lend();
+  const int * new2old2 = optimized.getNew2Old().lend();
+  {for( int i=0; i<n; ++i ) {
+    if ( dist1[i] != dist2[i] ) { ++nDiffer; }
+  }}
+  {for( int i=0; i<topDown.queryNVisited(); ++i ) {
+    if ( new2old1[i] != new2old2[i] ) { ++nDiffer; }
+  }}
+  return nDiffer;
+}
+
+int main() {
+  const int k = 24;
+  const int nMax = k*k*k;
+  int * adjHead = new int[ nMax+1 ];
+  int * adjList = new int[ 7*nMax ];
+
+  for( int shortcuts=0; shortcuts<2; ++shortcuts ) {
+    const int n = makeGraph( k, ( shortcuts == 1 ), adjHead, adjList );
+    Graph graph( n, (const int*) adjHead, (const int*) adjList );
+    graph.validate();
+    if ( ! graph.isValid() ) {
+      cerr << "Error: Cannot create valid graph." << endl;
+      return -1;
+    }
+    BreadthFirstSearch topDown( &graph );
+    topDown.disableDirectionOptimization();
+    BreadthFirstSearch optimized( &graph );
+
+    const int corner = 0;
+    const int center = ( (k/2)*k + k/2 )*k + k/2;
+    const int twoRoots[] = { corner, n-1 };
+    int nDiffer = 0;
+    int nBottomUp = 0;
+    nDiffer += compare( topDown, optimized, &corner, 1, n );
+    nBottomUp += optimized.queryNBottomUpLevels();
+    nDiffer += compare( topDown, optimized, &center, 1, n );
+    nBottomUp += optimized.queryNBottomUpLevels();
+    const int centerWidth = optimized.queryWidth();
+    nDiffer += compare( topDown, optimized, twoRoots, 2, n );
+    nBottomUp += optimized.queryNBottomUpLevels();
+    // short circuit on the widest level of the search from the center
+    const int limit = centerWidth - 1;
+    topDown.enableShortCircuiting( limit );
+    optimized.enableShortCircuiting( limit );
+    nDiffer += compare( topDown, optimized, &center, 1, n );
+    const bool shortCircuited = optimized.hasShortCircuited();
+
+    cout << ( shortcuts ? "grid with random shortcuts: " : "plain grid: " )
+	 << "differences = " << nDiffer
+	 << ", bottom-up levels used = " << ( ( nBottomUp > 0 ) ? "yes" : "no" )
+	 << ", short-circuited = " << ( shortCircuited ? "yes" : "no" ) << endl;
+  }
+  delete[] adjHead;
+  delete[] adjList;
+}
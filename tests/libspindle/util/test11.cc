@@ -0,0 +1,178 @@
+//
+// src/util/drivers/tests/test11.cc
+//
+//
+// compares breadth first searches, pseudo-diameters and RCM orderings
+// computed with several threads against single threaded ones.
+
+#include <iostream.h>
+#include "spindle/Graph.h"
+#include "spindle/BreadthFirstSearch.h"
+#include "spindle/PseudoDiameter.h"
+#include "spindle/RCMEngine.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+static unsigned int seed = 2468;
+
+static int
+nextRandom( const int n ) {
+  seed = seed * 1103515245 + 12345;
+  return (int) ( ( seed >> 16 ) % n );
+}
+
+//
+// build a k-by-k-by-k seven point grid.  If shortcuts is set, every
+// vertex also gets one extra neighbor from a random perfect matching,
+// which makes the levels of a search very wide.
+//
+static int
+makeGraph( const int k, const bool shortcuts, int * adjHead, int * adjList ) {
+  const int n = k*k*k;
+  int * partner = new int[n];
+  {for( int v=0; v<n; ++v ) { partner[v] = -1; }}
+  if ( shortcuts ) {
+    int * perm = new int[n];
+    {for( int v=0; v<n; ++v ) { perm[v] = v; }}
+    {for( int v=n-1; v>0; --v ) {
+      const int r = nextRandom( v+1 );
+      const int t = perm[v]; perm[v] = perm[r]; perm[r] = t;
+    }}
+    {for( int v=0; v+1<n; v+=2 ) {
+      partner[ perm[v] ] = perm[v+1];
+      partner[ perm[v+1] ] = perm[v];
+    }}
+    delete[] perm;
+  }
+  int nnz = 0;
+  for( int i=0; i<k; ++i ) {
+    for( int j=0; j<k; ++j ) {
+      for( int l=0; l<k; ++l ) {
+	const int v = (i*k+j)*k+l;
+	adjHead[ v ] = nnz;
+	if ( i>0 )   { adjList[ nnz++ ] = v-k*k; }
+	if ( j>0 )   { adjList[ nnz++ ] = v-k; }
+	if ( l>0 )   { adjList[ nnz++ ] = v-1; }
+	if ( l<k-1 ) { adjList[ nnz++ ] = v+1; }
+	if ( j<k-1 ) { adjList[ nnz++ ] = v+k; }
+	if ( i<k-1 ) { adjList[ nnz++ ] = v+k*k; }
+	// insert the partner in sorted order, unless it is already there
+	const int p = partner[v];
+	if ( p >= 0 ) {
+	  int pos = nnz;
+	  while ( ( pos > adjHead[v] ) && ( adjList[pos-1] > p ) ) { --pos; }
+	  if ( ( pos == adjHead[v] ) || ( adjList[pos-1] != p ) ) {
+	    for( int t=nnz; t>pos; --t ) { adjList[t] = adjList[t-1]; }
+	    adjList[pos] = p;
+	    ++nnz;
+	  }
+	}
+      }
+    }
+  }
+  adjHead[ n ] = nnz;
+  delete[] partner;
+  return n;
+}
+
+// run both searches from the same root, return the number of differences
+static int
+compare( BreadthFirstSearch& serial, BreadthFirstSearch& threaded,
+	 const int root, const int n, const bool sameOrder ) {
+  serial.setRoot( root );
+  threaded.setRoot( root );
+  if ( ( !serial.execute() ) || ( !threaded.execute() ) ) { return -1; }
+  int nDiffer = 0;
+  if ( serial.queryNVisited() != threaded.queryNVisited() ) { ++nDiffer; }
+  if ( serial.queryNFarthest() != threaded.queryNFarthest() ) { ++nDiffer; }
+  if ( serial.queryHeight() != threaded.queryHeight() ) { ++nDiffer; }
+  if ( serial.queryWidth() != threaded.queryWidth() ) { ++nDiffer; }
+  const int * dist1 = serial.getDistance().lend();
+  const int * dist2 = threaded.getDistance().lend();
+  const int * new2old1 = serial.getNew2Old().lend();
+  const int * new2old2 = threaded.getNew2Old().lend();
+  {for( int i=0; i<n; ++i ) {
+    if ( dist1[i] != dist2[i] ) { ++nDiffer; }
+  }}
+  {for( int i=0; i<serial.queryNVisited(); ++i ) {
+    if ( sameOrder ) {
+      if ( new2old1[i] != new2old2[i] ) { ++nDiffer; }
+    } else {
+      // same level at each position
+      if ( dist1[ new2old1[i] ] != dist2[ new2old2[i] ] ) { ++nDiffer; }
+    }
+  }}
+  return nDiffer;
+}
+
+static int
+rcmDifferences( const Graph& graph, const int nThreads, const int * reference ) {
+  RCMEngine rcm( &graph );
+  rcm.setNThreads( nThreads );
+  if ( !rcm.execute() ) { return -1; }
+  const int * new2old = rcm.getPermutation()->getNew2Old().lend();
+  int nDiffer = 0;
+  {for( int i=0; i<graph.size(); ++i ) {
+    if ( new2old[i] != reference[i] ) { ++nDiffer; }
+  }}
+  return nDiffer;
+}
+
+int main() {
+  const int k = 30;
+  const int nMax = k*k*k;
+  int * adjHead = new int[ nMax+1 ];
+  int * adjList = new int[ 7*nMax ];
+
+  for( int pass=0; pass<2; ++pass ) {
+    const int n = makeGraph( k, ( pass == 1 ), adjHead, adjList );
+    Graph graph( n, (const int*) adjHead, (const int*) adjList );
+    graph.validate();
+    if ( ! graph.isValid() ) {
+      cerr << "Error: Cannot create valid graph." << endl;
+      return -1;
+    }
+    BreadthFirstSearch serial( &graph );
+    BreadthFirstSearch threaded( &graph );
+    threaded.setNThreads( 4 );
+    const int roots[] = { 0, n-1, ( (k/2)*k + k/2 )*k + k/2, 12345 };
+
+    int nDeterministic = 0;
+    int nUnordered = 0;
+    {for( int r=0; r<4; ++r ) {
+      threaded.enableDeterministicOrder();
+      nDeterministic += compare( serial, threaded, roots[r], n, true );
+      threaded.disableDeterministicOrder();
+      nUnordered += compare( serial, threaded, roots[r], n, false );
+    }}
+
+    PseudoDiameter diam1( &graph );
+    PseudoDiameter diam4( &graph );
+    diam4.setNThreads( 4 );
+    diam1.execute();
+    diam4.execute();
+    const bool sameEndpoints = ( diam1.queryEndpoints() == diam4.queryEndpoints() )
+      && ( diam1.queryDiameter() == diam4.queryDiameter() );
+
+    RCMEngine rcm( &graph );
+    if ( !rcm.execute() ) {
+      cerr << "Error: RCM failed." << endl;
+      return -1;
+    }
+    const int * reference = rcm.getPermutation()->getNew2Old().lend();
+    int nRCM = 0;
+    {for( int t=2; t<=5; ++t ) {
+      nRCM += rcmDifferences( graph, t, reference );
+    }}
+
+    cout << ( ( pass == 0 ) ? "plain grid:" : "grid with random shortcuts:" ) << endl;
+    cout << "  deterministic BFS differences = " << nDeterministic << endl;
+    cout << "  unordered BFS differences = " << nUnordered << endl;
+    cout << "  same pseudo-diameter = " << ( sameEndpoints ? "yes" : "no" ) << endl;
+    cout << "  RCM differences = " << nRCM << endl;
+  }
+  delete[] adjHead;
+  delete[] adjList;
+}
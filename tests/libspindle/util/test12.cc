@@ -0,0 +1,113 @@
+//
+// src/util/drivers/tests/test12.cc
+//
+//
+// compares pseudo-diameters computed with the candidate endVtxs
+// searched all at once against ones searched one after another.
+
+#include <iostream.h>
+#include "spindle/Graph.h"
+#include "spindle/PseudoDiameter.h"
+
+#ifdef HAVE_NAMESPACES
+using namespace SPINDLE_NAMESPACE;
+#endif
+
+//
+// an m-by-k five point grid, plus the diagonals of some cells chosen by
+// a hash of their corners, so that levels have uneven widths.
+//
+static bool
+hasDiagonal( const int v, const int w ) {
+  const unsigned int h = ( (unsigned int) v * 2654435761u ) ^ ( (unsigned int) w * 40503u );
+  return ( ( h >> 7 ) % 3 ) == 0;
+}
+
+static int
+makeGraph( const int m, const int k, int * adjHead, int * adjList ) {
+  int nnz = 0;
+  for( int i=0; i<m; ++i ) {
+    for( int j=0; j<k; ++j ) {
+      const int v = i*k+j;
+      adjHead[ v ] = nnz;
+      for( int di=-1; di<=1; ++di ) {
+	for( int dj=-1; dj<=1; ++dj ) {
+	  const int ii = i+di;
+	  const int jj = j+dj;
+	  if ( ( di==0 && dj==0 ) || ii<0 || ii>=m || jj<0 || jj>=k ) { continue; }
+	  const int w = ii*k+jj;
+	  if ( ( di != 0 ) && ( dj != 0 ) &&
+	       ( !hasDiagonal( ( v<w ) ? v : w, ( v<w ) ? w : v ) ) ) { continue; }
+	  adjList[ nnz++ ] = w;
+	}
+      }
+    }
+  }
+  adjHead[ m*k ] = nnz;
+  return m*k;
+}
+
+static PseudoDiamShrinkingStrategy *
+newStrategy( const int s ) {
+  switch( s ) {
+  case 0: return new SloanShrinkingStrategy();
+  case 1: return new DuffReidScottShrinkingStrategy();
+  default: return new ReidScottShrinkingStrategy( 5 );
+  }
+}
+
+int main() {
+  const int shapes[][2] = { { 40, 40 }, { 15, 90 }, { 60, 25 } };
+  const char * names[] = { "Sloan", "Duff-Reid-Scott", "Reid-Scott" };
+  int * adjHead = new int[ 40*40+1 ];
+  int * adjList = new int[ 8*40*40 ];
+
+  for( int s=0; s<3; ++s ) {
+    int nDiffer = 0;
+    int nRuns = 0;
+    int nConcurrent = 0;
+    for( int shape=0; shape<3; ++shape ) {
+      const int n = makeGraph( shapes[shape][0], shapes[shape][1], adjHead, adjList );
+      Graph graph( n, (const int*) adjHead, (const int*) adjList );
+      graph.validate();
+      if ( ! graph.isValid() ) {
+	cerr << "Error: Cannot create valid graph." << endl;
+	return -1;
+      }
+      PseudoDiameter serial( &graph );
+      PseudoDiameter concurrent( &graph );
+      serial.setShrinkingStrategy( newStrategy( s ) );
+      concurrent.setShrinkingStrategy( newStrategy( s ) );
+      concurrent.setNCandidateThreads( 4 );
+      for( int root=0; root<n; root += 97 ) {
+	serial.setRoot( root );
+	concurrent.setRoot( root );
+	if ( ( !serial.execute() ) || ( !concurrent.execute() ) ) {
+	  cerr << "Error: PseudoDiameter failed." << endl;
+	  return -1;
+	}
+	++nRuns;
+	if ( serial.queryEndpoints() != concurrent.queryEndpoints() ) { ++nDiffer; }
+	if ( serial.queryDiameter() != concurrent.queryDiameter() ) { ++nDiffer; }
+	if ( serial.queryMinMaxWidth() != concurrent.queryMinMaxWidth() ) { ++nDiffer; }
+	if ( serial.queryRevMaxWidth() != concurrent.queryRevMaxWidth() ) { ++nDiffer; }
+	if ( serial.queryNFlips() != concurrent.queryNFlips() ) { ++nDiffer; }
+	if ( serial.queryNBFS() != concurrent.queryNBFS() ) { ++nDiffer; }
+	if ( serial.queryNShortCircuits() != concurrent.queryNShortCircuits() ) { ++nDiffer; }
+	// the same candidates were tried, and the same ones stopped early
+	const vector< PseudoDiameter::CandidateStats >& stats1 = serial.getCandidateStats();
+	const vector< PseudoDiameter::CandidateStats >& stats2 = concurrent.getCandidateStats();
+	if ( stats1.size() != stats2.size() ) { ++nDiffer; }
+	for( int c=0; ( c < (int) stats1.size() ) && ( c < (int) stats2.size() ); ++c ) {
+	  if ( ( stats1[c].vtx != stats2[c].vtx ) ||
+	       ( stats1[c].shortCircuited != stats2[c].shortCircuited ) ) { ++nDiffer; }
+	}
+	if ( stats2.size() > 1 ) { ++nConcurrent; }
+      }
+    }
+    cout << names[s] << ": " << nRuns << " runs, differences = " << nDiffer
+	 << ", several candidates = " << ( ( nConcurrent > 0 ) ? "yes" : "no" ) << endl;
+  }
+  delete[] adjHead;
+  delete[] adjList;
+}